@@ -52,7 +52,7 @@ tools = get_cpp(src_dir + os.sep + 'tstools')
 plugins = get_cpp(src_dir + os.sep + 'tsplugins')
 
 # "Other" MSBuild projects (ie. not tools, not plugins).
-others = ['config', 'utests-tsduckdll', 'utests-tsducklib', 'tsduckdll', 'tsducklib', 'tsp_static', 'tsprofiling', 'tsmux', 'setpath']
+others = ['config', 'utests-tsduckdll', 'utests-tsducklib', 'tsduckdll', 'tsducklib', 'tsp_static', 'tsprofiling', 'tsbench', 'tsmux', 'setpath']
 
 # MSBuild / Visual Studio solution description.
 cxx_project_guid = '8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942'
@@ -69,6 +69,7 @@ ms_deps = {
     'utests-tsducklib': {'deps': ['tsducklib']},
     'tsp_static': {'deps': ['tsducklib']},
     'tsprofiling': {'deps': ['tsduckdll']},
+    'tsbench': {'deps': ['tsduckdll'] + plugins},
     'tsmux': {'deps': ['tsduckdll'] + plugins},
     'setpath': {'deps': ['tsducklib']}
 }
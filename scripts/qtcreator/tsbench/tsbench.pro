@@ -0,0 +1,3 @@
+CONFIG += util
+TARGET = tsbench
+include(../tsduck.pri)
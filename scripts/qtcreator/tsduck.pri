@@ -111,6 +111,8 @@ tsplugin {
     QMAKE_POST_LINK += cp $${TARGET}$$SO ../tsp $$escape_expand(\\n\\t)
     QMAKE_POST_LINK += mkdir -p ../tsprofiling $$escape_expand(\\n\\t)
     QMAKE_POST_LINK += cp $${TARGET}$$SO ../tsprofiling $$escape_expand(\\n\\t)
+    QMAKE_POST_LINK += mkdir -p ../tsbench $$escape_expand(\\n\\t)
+    QMAKE_POST_LINK += cp $${TARGET}$$SO ../tsbench $$escape_expand(\\n\\t)
 }
 libtsduck {
     # Applications using libtsduck shall use "CONFIG += libtsduck".
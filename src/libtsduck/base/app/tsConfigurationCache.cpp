@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Header of a cache file:
+//
+//   offset  size  content
+//   ------  ----  -------
+//        0     4  magic number, "TSBC"
+//        4     2  format version
+//        6     2  kind of cached file
+//        8     8  size of the text configuration file
+//       16     8  hash of the text configuration file
+//       24     4  payload size
+//       28     4  reserved, zero
+//
+//----------------------------------------------------------------------------
+
+#include "tsConfigurationCache.h"
+#include "tsMemory.h"
+
+#if !defined(TS_CXX17)
+constexpr uint32_t ts::ConfigurationCache::MAGIC;
+constexpr uint16_t ts::ConfigurationCache::VERSION;
+constexpr size_t ts::ConfigurationCache::HEADER_SIZE;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Compute a 64-bit hash of the content of a text file.
+//----------------------------------------------------------------------------
+
+uint64_t ts::ConfigurationCache::Hash(const uint8_t* data, size_t size)
+{
+    // FNV-1a, applied on 64-bit words instead of bytes, for speed.
+    constexpr uint64_t prime = 0x00000100000001B3;
+    uint64_t hash = 0xCBF29CE484222325;
+    for (; size >= 8; data += 8, size -= 8) {
+        hash = (hash ^ GetUInt64LE(data)) * prime;
+    }
+    for (; size > 0; ++data, --size) {
+        hash = (hash ^ *data) * prime;
+    }
+    return hash;
+}
+
+
+//----------------------------------------------------------------------------
+// Open the binary cache of a configuration file.
+//----------------------------------------------------------------------------
+
+bool ts::ConfigurationCache::open(const UString& source, Kind kind, Report& report)
+{
+    close();
+
+    // Map the cache file and check its header.
+    const UString name(CacheFileName(source));
+    if (!_file.open(name)) {
+        return false;
+    }
+    const uint8_t* const header = _file.data();
+    if (_file.size() < HEADER_SIZE ||
+        GetUInt32LE(header) != MAGIC ||
+        GetUInt16LE(header + 4) != VERSION ||
+        GetUInt16LE(header + 6) != uint16_t(kind) ||
+        GetUInt32LE(header + 24) != _file.size() - HEADER_SIZE)
+    {
+        report.debug(u"ignoring invalid cache file %s", {name});
+        close();
+        return false;
+    }
+
+    // Check that the cache was built from the current content of the text file.
+    MemoryMappedFile text;
+    if (!text.open(source) || GetUInt64LE(header + 8) != text.size() || GetUInt64LE(header + 16) != Hash(text.data(), text.size())) {
+        report.debug(u"ignoring outdated cache file %s", {name});
+        close();
+        return false;
+    }
+
+    report.debug(u"using cache file %s", {name});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Close the binary cache.
+//----------------------------------------------------------------------------
+
+void ts::ConfigurationCache::close()
+{
+    _file.close();
+}
+
+
+//----------------------------------------------------------------------------
+// Create the binary cache of a configuration file.
+//----------------------------------------------------------------------------
+
+bool ts::ConfigurationCache::Save(const UString& source, Kind kind, const ByteBlock& payload, Report& report)
+{
+    if (payload.size() > 0xFFFFFFFF) {
+        report.error(u"cache payload too large for %s", {source});
+        return false;
+    }
+
+    MemoryMappedFile text;
+    if (!text.open(source, true, report)) {
+        return false;
+    }
+
+    ByteBlock data;
+    data.reserve(HEADER_SIZE + payload.size());
+    data.appendUInt32LE(MAGIC);
+    data.appendUInt16LE(VERSION);
+    data.appendUInt16LE(uint16_t(kind));
+    data.appendUInt64LE(text.size());
+    data.appendUInt64LE(Hash(text.data(), text.size()));
+    data.appendUInt32LE(uint32_t(payload.size()));
+    data.appendUInt32LE(0);
+    data.append(payload);
+    assert(data.size() == HEADER_SIZE + payload.size());
+
+    return data.saveToFile(CacheFileName(source), &report);
+}
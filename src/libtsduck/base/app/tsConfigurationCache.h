@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Precompiled binary cache of a TSDuck configuration file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsMemoryMappedFile.h"
+#include "tsByteBlock.h"
+
+namespace ts {
+    //!
+    //! Precompiled binary cache of a TSDuck configuration file.
+    //! @ingroup app
+    //!
+    //! Configuration files such as ".names" files or XML models are text files which
+    //! are parsed by each TSDuck command which uses them. To reduce the startup time
+    //! of short-lived commands, a precompiled binary representation can be generated
+    //! at build time in a file with the same name and a ".bin" suffix, in the same
+    //! directory. The binary cache is memory-mapped and used only when it matches
+    //! the text file it was built from (same size and same hash of the content).
+    //! Otherwise, the caller shall parse the text file as usual.
+    //!
+    //! A cache file starts with a 32-byte header, followed by a kind-specific payload.
+    //! All integer values are little endian and all strings are UTF-8. Therefore,
+    //! a cache file is portable across platforms.
+    //!
+    class TSDUCKDLL ConfigurationCache
+    {
+        TS_NOCOPY(ConfigurationCache);
+    public:
+        //!
+        //! Kind of cached configuration file.
+        //!
+        enum class Kind : uint16_t {
+            NAMES = 1,  //!< Cache of a ".names" file, see ts::NamesFile.
+            XML   = 2,  //!< Cache of an XML document, see ts::xml::Document.
+        };
+
+        //!
+        //! Constructor.
+        //!
+        ConfigurationCache() = default;
+
+        //!
+        //! Get the name of the binary cache for a configuration file.
+        //! @param [in] source Name of the text configuration file.
+        //! @return Name of the corresponding binary cache file.
+        //!
+        static UString CacheFileName(const UString& source) { return source + u".bin"; }
+
+        //!
+        //! Open the binary cache of a configuration file.
+        //! Nothing is reported when there is no valid cache for the file.
+        //! @param [in] source Name of the text configuration file.
+        //! @param [in] kind Expected kind of the cache file.
+        //! @param [in,out] report Where to report debug messages.
+        //! @return True if a valid binary cache was found, false otherwise.
+        //!
+        bool open(const UString& source, Kind kind, Report& report);
+
+        //!
+        //! Close the binary cache.
+        //! All previously returned addresses become invalid.
+        //!
+        void close();
+
+        //!
+        //! Check if a binary cache is open.
+        //! @return True if a binary cache is open.
+        //!
+        bool isOpen() const { return _file.isOpen(); }
+
+        //!
+        //! Get the address of the payload of the binary cache.
+        //! @return The address of the payload or a null pointer if no cache is open.
+        //!
+        const uint8_t* data() const { return _file.isOpen() ? _file.data() + HEADER_SIZE : nullptr; }
+
+        //!
+        //! Get the size of the payload of the binary cache.
+        //! @return The size in bytes of the payload.
+        //!
+        size_t size() const { return _file.isOpen() ? _file.size() - HEADER_SIZE : 0; }
+
+        //!
+        //! Create the binary cache of a configuration file.
+        //! @param [in] source Name of the text configuration file.
+        //! @param [in] kind Kind of the cache file.
+        //! @param [in] payload Kind-specific binary representation of the configuration file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        static bool Save(const UString& source, Kind kind, const ByteBlock& payload, Report& report);
+
+    private:
+        static constexpr uint32_t MAGIC = 0x43425354;   // "TSBC" in little endian.
+        static constexpr uint16_t VERSION = 1;          // Format version.
+        static constexpr size_t HEADER_SIZE = 32;
+
+        MemoryMappedFile _file {};
+
+        // Compute a 64-bit hash of the content of a text file (FNV-1a on 64-bit words).
+        static uint64_t Hash(const uint8_t* data, size_t size);
+    };
+}
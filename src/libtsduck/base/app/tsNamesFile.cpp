@@ -13,6 +13,34 @@
 #include "tsMutex.h"
 #include "tsGuardMutex.h"
 #include "tsSingletonManager.h"
+#include "tsMemory.h"
+
+#if !defined(TS_CXX17)
+constexpr size_t ts::NamesFile::CACHE_HEADER_SIZE;
+constexpr size_t ts::NamesFile::CACHE_SECTION_SIZE;
+constexpr size_t ts::NamesFile::CACHE_ENTRY_SIZE;
+#endif
+
+// Layout of the binary cache of a names file (all integers are little endian):
+//
+//   header:
+//     uint32 section_count
+//     uint32 entry_count
+//     uint32 strings_size
+//   sections: section_count times, sorted by UTF-8 name
+//     uint32 name_offset    (in strings)
+//     uint32 name_size
+//     uint32 bits
+//     uint32 inherit_offset (in strings)
+//     uint32 inherit_size
+//     uint32 first_entry    (index in entries)
+//     uint32 entry_count
+//   entries: entry_count times, grouped by section, sorted by first value in each section
+//     uint64 first_value
+//     uint64 last_value
+//     uint32 name_offset    (in strings)
+//     uint32 name_size
+//   strings: strings_size bytes, UTF-8
 
 
 //----------------------------------------------------------------------------
@@ -214,22 +242,33 @@ ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions) :
     _log(CERR),
     _configFile(SearchConfigurationFile(fileName)),
     _configErrors(0),
-    _sections()
+    _merged(false),
+    _sections(),
+    _cache()
 {
+    // Get list of extension names, if required.
+    UStringList files;
+    if (mergeExtensions) {
+        AllInstances::Instance()->getExtensionFiles(files);
+    }
+
     // Locate the configuration file.
     if (_configFile.empty()) {
         // Cannot load configuration, names will not be available.
         _log.error(u"configuration file '%s' not found", {fileName});
     }
+    else if (files.empty() && _cache.open(_configFile, ConfigurationCache::Kind::NAMES, _log) && checkCache()) {
+        // Use the binary cache. It is not used when extensions must be merged.
+        _log.debug(u"using cache of names file %s", {_configFile});
+    }
     else {
+        _cache.close();
         loadFile(_configFile);
     }
 
     // Merge extensions if required.
-    if (mergeExtensions) {
-        // Get list of extension names.
-        UStringList files;
-        AllInstances::Instance()->getExtensionFiles(files);
+    if (!files.empty()) {
+        _merged = true;
         for (const auto& name : files) {
             const UString path(SearchConfigurationFile(name));
             if (path.empty()) {
@@ -553,39 +592,48 @@ ts::UString ts::NamesFile::Formatted(Value value, const UString& name, NamesFlag
 
 
 //----------------------------------------------------------------------------
-// Get the section and name from a value, empty if not found.
+// Get the name from a value, empty if not found.
 //----------------------------------------------------------------------------
 
-void ts::NamesFile::getName(const UString& sectionName, Value value, ConfigSection*& section, UString& name) const
+bool ts::NamesFile::getName(const UString& sectionName, Value value, size_t& bits, UString& name) const
 {
     // Normalized section name.
     UString sname(NormalizedSectionName(sectionName));
+    UString inherit;
 
     // Limit the number of inheritance levels to avoid infinite loop.
     int levels = 16;
 
     // Loop on inherited sections, until a name is found.
     for (;;) {
-        // Get the section.
-        const auto it = _sections.find(sname);
-        if (it == _sections.end()) {
-            // Section not found, no name.
-            section = nullptr;
-            name.clear();
-            return;
-        }
-
         // Get the name of the value in the section.
-        section = it->second;
-        name = section->getName(value);
+        if (_cache.isOpen()) {
+            if (!getCachedName(sname, value, bits, inherit, name)) {
+                // Section not found, no name.
+                name.clear();
+                return false;
+            }
+        }
+        else {
+            const auto it = _sections.find(sname);
+            if (it == _sections.end()) {
+                // Section not found, no name.
+                name.clear();
+                return false;
+            }
+            const ConfigSection* section = it->second;
+            bits = section->bits;
+            inherit = section->inherit;
+            name = section->getName(value);
+        }
 
         // Return when name found or no "superclass" or too many levels of inheritance.
-        if (!name.empty() || section->inherit.empty() || levels-- <= 0) {
-            return;
+        if (!name.empty() || inherit.empty() || levels-- <= 0) {
+            return true;
         }
 
         // Loop on "superclass".
-        sname = NormalizedSectionName(section->inherit);
+        sname = NormalizedSectionName(inherit);
     }
 }
 
@@ -596,9 +644,9 @@ void ts::NamesFile::getName(const UString& sectionName, Value value, ConfigSecti
 
 bool ts::NamesFile::nameExists(const UString& sectionName, Value value) const
 {
-    ConfigSection* section = nullptr;
+    size_t bits = 0;
     UString name;
-    getName(sectionName, value, section, name);
+    getName(sectionName, value, bits, name);
     return !name.empty();
 }
 
@@ -609,16 +657,15 @@ bool ts::NamesFile::nameExists(const UString& sectionName, Value value) const
 
 ts::UString ts::NamesFile::nameFromSection(const UString& sectionName, Value value, NamesFlags flags, size_t bits, Value alternateValue) const
 {
-    ConfigSection* section = nullptr;
+    size_t section_bits = 0;
     UString name;
-    getName(sectionName, value, section, name);
 
-    if (section == nullptr) {
+    if (!getName(sectionName, value, section_bits, name)) {
         // Non-existent section, no name.
         return Formatted(value, UString(), flags, bits, alternateValue);
     }
     else {
-        return Formatted(value, name, flags, bits != 0 ? bits : section->bits, alternateValue);
+        return Formatted(value, name, flags, bits != 0 ? bits : section_bits, alternateValue);
     }
 }
 
@@ -629,17 +676,16 @@ ts::UString ts::NamesFile::nameFromSection(const UString& sectionName, Value val
 
 ts::UString ts::NamesFile::nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, NamesFlags flags, size_t bits, Value alternateValue) const
 {
-    ConfigSection* section = nullptr;
+    size_t section_bits = 0;
     UString name;
-    getName(sectionName, value1, section, name);
 
-    if (section == nullptr) {
+    if (!getName(sectionName, value1, section_bits, name)) {
         // Non-existent section, no name.
         return Formatted(value1, UString(), flags, bits, alternateValue);
     }
     else if (!name.empty()) {
         // value1 has a name
-        return Formatted(value1, name, flags, bits != 0 ? bits : section->bits, alternateValue);
+        return Formatted(value1, name, flags, bits != 0 ? bits : section_bits, alternateValue);
     }
     else {
         // value1 has no name, use value2, restart from the beginning in case of inheritance.
@@ -648,6 +694,175 @@ ts::UString ts::NamesFile::nameFromSectionWithFallback(const UString& sectionNam
 }
 
 
+//----------------------------------------------------------------------------
+// Check the consistency of the binary cache.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::checkCache() const
+{
+    const uint8_t* const data = _cache.data();
+    const size_t size = _cache.size();
+    if (size < CACHE_HEADER_SIZE) {
+        return false;
+    }
+    const size_t section_count = GetUInt32LE(data);
+    const size_t entry_count = GetUInt32LE(data + 4);
+    const size_t strings_size = GetUInt32LE(data + 8);
+    if (size != CACHE_HEADER_SIZE + section_count * CACHE_SECTION_SIZE + entry_count * CACHE_ENTRY_SIZE + strings_size) {
+        return false;
+    }
+
+    // Check that all indexes and offsets are in range.
+    const uint8_t* sec = data + CACHE_HEADER_SIZE;
+    for (size_t i = 0; i < section_count; ++i, sec += CACHE_SECTION_SIZE) {
+        if (size_t(GetUInt32LE(sec)) + GetUInt32LE(sec + 4) > strings_size ||
+            size_t(GetUInt32LE(sec + 12)) + GetUInt32LE(sec + 16) > strings_size ||
+            size_t(GetUInt32LE(sec + 20)) + GetUInt32LE(sec + 24) > entry_count)
+        {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < entry_count; ++i, sec += CACHE_ENTRY_SIZE) {
+        if (size_t(GetUInt32LE(sec + 16)) + GetUInt32LE(sec + 20) > strings_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Lookup a section and a name in the binary cache.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::getCachedName(const UString& sectionName, Value value, size_t& bits, UString& inherit, UString& name) const
+{
+    const uint8_t* const data = _cache.data();
+    const size_t section_count = GetUInt32LE(data);
+    const size_t entry_count = GetUInt32LE(data + 4);
+    const uint8_t* const sections = data + CACHE_HEADER_SIZE;
+    const uint8_t* const entries = sections + section_count * CACHE_SECTION_SIZE;
+    const char* const strings = reinterpret_cast<const char*>(entries + entry_count * CACHE_ENTRY_SIZE);
+
+    // Binary search of the section, sorted by UTF-8 name.
+    const std::string sname(sectionName.toUTF8());
+    const uint8_t* sec = nullptr;
+    size_t low = 0;
+    size_t high = section_count;
+    while (sec == nullptr && low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const uint8_t* const cur = sections + mid * CACHE_SECTION_SIZE;
+        const int cmp = sname.compare(0, std::string::npos, strings + GetUInt32LE(cur), GetUInt32LE(cur + 4));
+        if (cmp < 0) {
+            high = mid;
+        }
+        else if (cmp > 0) {
+            low = mid + 1;
+        }
+        else {
+            sec = cur;
+        }
+    }
+    if (sec == nullptr) {
+        return false;
+    }
+    bits = GetUInt32LE(sec + 8);
+    inherit.assignFromUTF8(strings + GetUInt32LE(sec + 12), GetUInt32LE(sec + 16));
+
+    // Binary search of the last entry with a first value lower than or equal to the value.
+    const uint8_t* const first = entries + GetUInt32LE(sec + 20) * CACHE_ENTRY_SIZE;
+    low = 0;
+    high = GetUInt32LE(sec + 24);
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (GetUInt64LE(first + mid * CACHE_ENTRY_SIZE) <= value) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    name.clear();
+    if (low > 0) {
+        const uint8_t* const entry = first + (low - 1) * CACHE_ENTRY_SIZE;
+        if (value <= GetUInt64LE(entry + 8)) {
+            name.assignFromUTF8(strings + GetUInt32LE(entry + 16), GetUInt32LE(entry + 20));
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Create the precompiled binary cache of the configuration file.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::saveCache(Report& report) const
+{
+    if (_configFile.empty()) {
+        report.error(u"no names file to cache");
+        return false;
+    }
+    else if (_configErrors > 0 || _merged) {
+        report.error(u"cannot cache %s, %s", {_configFile, _merged ? u"merged with extensions" : u"contains errors"});
+        return false;
+    }
+    else if (_cache.isOpen()) {
+        report.verbose(u"cache of %s is up to date", {_configFile});
+        return true;
+    }
+
+    // Sort the sections by UTF-8 name.
+    std::vector<std::pair<std::string, const ConfigSection*>> sections;
+    size_t entry_count = 0;
+    for (const auto& it : _sections) {
+        sections.push_back(std::make_pair(it.first.toUTF8(), it.second));
+        entry_count += it.second->entries.size();
+    }
+    std::sort(sections.begin(), sections.end(),
+              [](const std::pair<std::string, const ConfigSection*>& a, const std::pair<std::string, const ConfigSection*>& b) { return a.first < b.first; });
+
+    // Build the sections, entries and strings separately.
+    ByteBlock bsections;
+    ByteBlock bentries;
+    std::string strings;
+    size_t entry_index = 0;
+    for (const auto& sec : sections) {
+        const std::string inherit(sec.second->inherit.toUTF8());
+        bsections.appendUInt32LE(uint32_t(strings.size()));
+        bsections.appendUInt32LE(uint32_t(sec.first.size()));
+        strings.append(sec.first);
+        bsections.appendUInt32LE(uint32_t(sec.second->bits));
+        bsections.appendUInt32LE(uint32_t(strings.size()));
+        bsections.appendUInt32LE(uint32_t(inherit.size()));
+        strings.append(inherit);
+        bsections.appendUInt32LE(uint32_t(entry_index));
+        bsections.appendUInt32LE(uint32_t(sec.second->entries.size()));
+        for (const auto& ent : sec.second->entries) {
+            const std::string name(ent.second->name.toUTF8());
+            bentries.appendUInt64LE(ent.first);
+            bentries.appendUInt64LE(ent.second->last);
+            bentries.appendUInt32LE(uint32_t(strings.size()));
+            bentries.appendUInt32LE(uint32_t(name.size()));
+            strings.append(name);
+            entry_index++;
+        }
+    }
+    assert(entry_index == entry_count);
+
+    ByteBlock payload;
+    payload.appendUInt32LE(uint32_t(sections.size()));
+    payload.appendUInt32LE(uint32_t(entry_count));
+    payload.appendUInt32LE(uint32_t(strings.size()));
+    payload.append(bsections);
+    payload.append(bentries);
+    payload.append(strings.data(), strings.size());
+
+    report.verbose(u"creating cache of %s, %d sections, %d names", {_configFile, sections.size(), entry_count});
+    return ConfigurationCache::Save(_configFile, ConfigurationCache::Kind::NAMES, payload, report);
+}
+
+
 //----------------------------------------------------------------------------
 // Get the name of an OUI (IEEE-assigned Organizationally Unique Identifier).
 //----------------------------------------------------------------------------
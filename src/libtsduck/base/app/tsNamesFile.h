@@ -16,6 +16,7 @@
 #include "tsEnumUtils.h"
 #include "tsReport.h"
 #include "tsVersionInfo.h"
+#include "tsConfigurationCache.h"
 
 namespace ts {
     //!
@@ -43,6 +44,12 @@ namespace ts {
     //!
     //! Representation of a ".names" file, containing names for identifiers.
     //! In an instance of NamesFile, all names are loaded from one configuration file.
+    //!
+    //! When a valid precompiled binary cache exists for the configuration file
+    //! (see ts::ConfigurationCache), the names are directly looked up in the
+    //! memory-mapped cache and the text file is not parsed. This is not possible
+    //! when names files from TSDuck extensions must be merged.
+    //!
     //! @ingroup app
     //!
     class TSDUCKDLL NamesFile
@@ -128,6 +135,22 @@ namespace ts {
         //!
         size_t errorCount() const { return _configErrors; }
 
+        //!
+        //! Check if the names were loaded from a precompiled binary cache.
+        //! @return True if the names were loaded from a precompiled binary cache.
+        //!
+        bool isCached() const { return _cache.isOpen(); }
+
+        //!
+        //! Create the precompiled binary cache of the configuration file.
+        //! The cache is created in the same directory as the configuration file.
+        //! If the names were loaded from a valid cache, the cache is already up to date.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error. It is an error if the configuration
+        //! file was not found, contained errors or was merged with extension files.
+        //!
+        bool saveCache(Report& report) const;
+
         //!
         //! Check if a name exists in a specified section.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
@@ -250,8 +273,19 @@ namespace ts {
         // Load a configuration file and merge its content into this instance.
         void loadFile(const UString& fileName);
 
-        // Get the section and name from a value, empty if not found. Section can be null.
-        void getName(const UString& sectionName, Value value, ConfigSection*& section, UString& name) const;
+        // Get the name from a value, empty if not found. Return false if the section is not found.
+        bool getName(const UString& sectionName, Value value, size_t& bits, UString& name) const;
+
+        // Layout of the binary cache (see comments in source file).
+        static constexpr size_t CACHE_HEADER_SIZE = 12;
+        static constexpr size_t CACHE_SECTION_SIZE = 28;
+        static constexpr size_t CACHE_ENTRY_SIZE = 24;
+
+        // Check the consistency of the binary cache.
+        bool checkCache() const;
+
+        // Lookup a section and a name in the binary cache. Return false if the section is not found.
+        bool getCachedName(const UString& sectionName, Value value, size_t& bits, UString& inherit, UString& name) const;
 
         // Normalized section name.
         static UString NormalizedSectionName(const UString& sectionName) { return sectionName.toTrimmed().toLower(); }
@@ -260,7 +294,9 @@ namespace ts {
         Report&          _log;           // Error logger.
         const UString    _configFile;    // Configuration file path.
         size_t           _configErrors;  // Number of errors in configuration file.
-        ConfigSectionMap _sections;      // Configuration sections.
+        bool             _merged;        // Extension files were merged.
+        ConfigSectionMap _sections;      // Configuration sections, when loaded from the text file.
+        ConfigurationCache _cache;       // Binary cache, when loaded from the cache.
     };
 
     //!
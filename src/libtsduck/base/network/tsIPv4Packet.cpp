@@ -13,9 +13,42 @@
 // Constructors and destructors.
 //----------------------------------------------------------------------------
 
-ts::IPv4Packet::IPv4Packet(const void* data, size_t size)
+ts::IPv4Packet::IPv4Packet(const void* data, size_t size, ShareMode mode)
 {
-    reset(data, size);
+    reset(data, size, mode);
+}
+
+ts::IPv4Packet::IPv4Packet(const IPv4Packet& other) :
+    _valid(other._valid),
+    _proto_type(other._proto_type),
+    _ip_header_size(other._ip_header_size),
+    _proto_header_size(other._proto_header_size),
+    _source_port(other._source_port),
+    _destination_port(other._destination_port),
+    _ptr(other._ptr),
+    _size(other._size),
+    _data(other._data)
+{
+    // If the content is not shared, point to our own copy.
+    if (other._ptr == other._data.data()) {
+        _ptr = _data.data();
+    }
+}
+
+ts::IPv4Packet& ts::IPv4Packet::operator=(const IPv4Packet& other)
+{
+    if (&other != this) {
+        _valid = other._valid;
+        _proto_type = other._proto_type;
+        _ip_header_size = other._ip_header_size;
+        _proto_header_size = other._proto_header_size;
+        _source_port = other._source_port;
+        _destination_port = other._destination_port;
+        _size = other._size;
+        _data = other._data;
+        _ptr = other._ptr == other._data.data() ? _data.data() : other._ptr;
+    }
+    return *this;
 }
 
 void ts::IPv4Packet::clear()
@@ -26,6 +59,8 @@ void ts::IPv4Packet::clear()
     _proto_header_size = 0;
     _source_port = 0;
     _destination_port = 0;
+    _ptr = nullptr;
+    _size = 0;
     _data.clear();
 }
 
@@ -34,7 +69,7 @@ void ts::IPv4Packet::clear()
 // Reinitialize the IPv4 packet with new content.
 //----------------------------------------------------------------------------
 
-bool ts::IPv4Packet::reset(const void* data, size_t size)
+bool ts::IPv4Packet::reset(const void* data, size_t size, ShareMode mode)
 {
     // Clear previous content.
     clear();
@@ -85,7 +120,14 @@ bool ts::IPv4Packet::reset(const void* data, size_t size)
     }
 
     // Packet is valid.
-    _data.copy(data, size);
+    if (mode == ShareMode::SHARE) {
+        _ptr = ip;
+    }
+    else {
+        _data.copy(data, size);
+        _ptr = _data.data();
+    }
+    _size = size;
     return _valid = true;
 }
 
@@ -97,8 +139,8 @@ bool ts::IPv4Packet::reset(const void* data, size_t size)
 bool ts::IPv4Packet::fragmented() const
 {
     return _valid && (
-        (_data[IPv4_FRAGMENT_OFFSET] & 0x20) != 0 ||                      // "More Fragments" bit set
-        (GetUInt16BE(_data.data() + IPv4_FRAGMENT_OFFSET) & 0x1FFF) != 0  // "Fragment Offset" not zero
+        (_ptr[IPv4_FRAGMENT_OFFSET] & 0x20) != 0 ||                      // "More Fragments" bit set
+        (GetUInt16BE(_ptr + IPv4_FRAGMENT_OFFSET) & 0x1FFF) != 0  // "Fragment Offset" not zero
     );
 }
 
@@ -110,8 +152,8 @@ bool ts::IPv4Packet::fragmented() const
 ts::IPv4Address ts::IPv4Packet::sourceAddress() const
 {
     if (_valid) {
-        assert(_data.size() >= IPv4_SRC_ADDR_OFFSET + 4);
-        return IPv4Address(GetUInt32BE(&_data[IPv4_SRC_ADDR_OFFSET]));
+        assert(_size >= IPv4_SRC_ADDR_OFFSET + 4);
+        return IPv4Address(GetUInt32BE(&_ptr[IPv4_SRC_ADDR_OFFSET]));
     }
     else {
         return IPv4Address(); // invalid address
@@ -121,8 +163,8 @@ ts::IPv4Address ts::IPv4Packet::sourceAddress() const
 ts::IPv4Address ts::IPv4Packet::destinationAddress() const
 {
     if (_valid) {
-        assert(_data.size() >= IPv4_DEST_ADDR_OFFSET + 4);
-        return IPv4Address(GetUInt32BE(&_data[IPv4_DEST_ADDR_OFFSET]));
+        assert(_size >= IPv4_DEST_ADDR_OFFSET + 4);
+        return IPv4Address(GetUInt32BE(&_ptr[IPv4_DEST_ADDR_OFFSET]));
     }
     else {
         return IPv4Address(); // invalid address
@@ -132,8 +174,8 @@ ts::IPv4Address ts::IPv4Packet::destinationAddress() const
 ts::IPv4SocketAddress ts::IPv4Packet::sourceSocketAddress() const
 {
     if (_valid) {
-        assert(_data.size() >= IPv4_SRC_ADDR_OFFSET + 4);
-        return IPv4SocketAddress(GetUInt32BE(&_data[IPv4_SRC_ADDR_OFFSET]), _source_port);
+        assert(_size >= IPv4_SRC_ADDR_OFFSET + 4);
+        return IPv4SocketAddress(GetUInt32BE(&_ptr[IPv4_SRC_ADDR_OFFSET]), _source_port);
     }
     else {
         return IPv4SocketAddress(); // invalid address
@@ -143,8 +185,8 @@ ts::IPv4SocketAddress ts::IPv4Packet::sourceSocketAddress() const
 ts::IPv4SocketAddress ts::IPv4Packet::destinationSocketAddress() const
 {
     if (_valid) {
-        assert(_data.size() >= IPv4_DEST_ADDR_OFFSET + 4);
-        return IPv4SocketAddress(GetUInt32BE(&_data[IPv4_DEST_ADDR_OFFSET]), _destination_port);
+        assert(_size >= IPv4_DEST_ADDR_OFFSET + 4);
+        return IPv4SocketAddress(GetUInt32BE(&_ptr[IPv4_DEST_ADDR_OFFSET]), _destination_port);
     }
     else {
         return IPv4SocketAddress(); // invalid address
@@ -158,27 +200,27 @@ ts::IPv4SocketAddress ts::IPv4Packet::destinationSocketAddress() const
 
 uint32_t ts::IPv4Packet::tcpSequenceNumber() const
 {
-    return isTCP() ? GetUInt32BE(&_data[_ip_header_size + TCP_SEQUENCE_OFFSET]) : 0;
+    return isTCP() ? GetUInt32BE(&_ptr[_ip_header_size + TCP_SEQUENCE_OFFSET]) : 0;
 }
 
 bool ts::IPv4Packet::tcpSYN() const
 {
-    return isTCP() && (_data[_ip_header_size + TCP_FLAGS_OFFSET] & 0x02) != 0;
+    return isTCP() && (_ptr[_ip_header_size + TCP_FLAGS_OFFSET] & 0x02) != 0;
 }
 
 bool ts::IPv4Packet::tcpACK() const
 {
-    return isTCP() && (_data[_ip_header_size + TCP_FLAGS_OFFSET] & 0x10) != 0;
+    return isTCP() && (_ptr[_ip_header_size + TCP_FLAGS_OFFSET] & 0x10) != 0;
 }
 
 bool ts::IPv4Packet::tcpRST() const
 {
-    return isTCP() && (_data[_ip_header_size + TCP_FLAGS_OFFSET] & 0x04) != 0;
+    return isTCP() && (_ptr[_ip_header_size + TCP_FLAGS_OFFSET] & 0x04) != 0;
 }
 
 bool ts::IPv4Packet::tcpFIN() const
 {
-    return isTCP() && (_data[_ip_header_size + TCP_FLAGS_OFFSET] & 0x01) != 0;
+    return isTCP() && (_ptr[_ip_header_size + TCP_FLAGS_OFFSET] & 0x01) != 0;
 }
 
 
@@ -35,20 +35,41 @@ namespace ts {
         //!
         IPv4Packet() = default;
 
+        //!
+        //! Copy constructor.
+        //! @param [in] other Another instance to copy. If @a other references shared
+        //! content, the new instance references the same shared content.
+        //!
+        IPv4Packet(const IPv4Packet& other);
+
         //!
         //! Constructor from raw content.
         //! @param [in] data Address of the IP packet data.
         //! @param [in] size Size of the IP packet data.
+        //! @param [in] mode The packet data are either copied (ShareMode::COPY) into the
+        //! object or referenced (ShareMode::SHARE). In the latter case, the referenced memory
+        //! area must remain valid and unmodified as long as the packet is used.
+        //!
+        IPv4Packet(const void* data, size_t size, ShareMode mode = ShareMode::COPY);
+
+        //!
+        //! Assignment operator.
+        //! @param [in] other Another instance to copy. If @a other references shared
+        //! content, this object references the same shared content.
+        //! @return A reference to this object.
         //!
-        IPv4Packet(const void* data, size_t size);
+        IPv4Packet& operator=(const IPv4Packet& other);
 
         //!
         //! Reinitialize the IPv4 packet with new content.
         //! @param [in] data Address of the IP packet data.
         //! @param [in] size Size of the IP packet data.
+        //! @param [in] mode The packet data are either copied (ShareMode::COPY) into the
+        //! object or referenced (ShareMode::SHARE). In the latter case, the referenced memory
+        //! area must remain valid and unmodified as long as the packet is used.
         //! @return True on success, false if the packet is invalid.
         //!
-        bool reset(const void* data, size_t size);
+        bool reset(const void* data, size_t size, ShareMode mode = ShareMode::COPY);
 
         //!
         //! Clear the packet content.
@@ -83,19 +104,19 @@ namespace ts {
         //! Get the address of the IPv4 packet content.
         //! @return The address of the IPv4 packet content or a null pointer if the packet is invalid.
         //!
-        const uint8_t* data() const { return _valid ? _data.data() : nullptr; }
+        const uint8_t* data() const { return _valid ? _ptr : nullptr; }
 
         //!
         //! Get the size in bytes of the IPv4 packet content.
         //! @return The size in bytes of the IPv4 packet content.
         //!
-        size_t size() const { return _valid ? _data.size() : 0; }
+        size_t size() const { return _valid ? _size : 0; }
 
         //!
         //! Get the address of the IPv4 header.
         //! @return The address of the IPv4 header or a null pointer if the packet is invalid.
         //!
-        const uint8_t* ipHeader() const { return _valid ? _data.data() : nullptr; }
+        const uint8_t* ipHeader() const { return _valid ? _ptr : nullptr; }
 
         //!
         //! Get the size in bytes of the IPv4 header.
@@ -107,7 +128,7 @@ namespace ts {
         //! Get the address of the sub-protocol header (TCP header, UDP header, etc).
         //! @return The address of the sub-protocol header or a null pointer if the packet is invalid.
         //!
-        const uint8_t* protocolHeader() const { return _valid ? _data.data() + _ip_header_size : nullptr; }
+        const uint8_t* protocolHeader() const { return _valid ? _ptr + _ip_header_size : nullptr; }
 
         //!
         //! Get the size in bytes of the sub-protocol header (TCP header, UDP header, etc).
@@ -119,13 +140,13 @@ namespace ts {
         //! Get the address of the sub-protocol payload data (TCP data, UDP data, etc).
         //! @return The address of the sub-protocol header payload data or a null pointer if the packet is invalid.
         //!
-        const uint8_t* protocolData() const { return _valid ? _data.data() + _ip_header_size + _proto_header_size : nullptr; }
+        const uint8_t* protocolData() const { return _valid ? _ptr + _ip_header_size + _proto_header_size : nullptr; }
 
         //!
         //! Get the size in bytes of the sub-protocol payload data (TCP data, UDP data, etc).
         //! @return The size in bytes of the sub-protocol payload data.
         //!
-        size_t protocolDataSize() const { return _valid ? _data.size() - _ip_header_size - _proto_header_size : 0; }
+        size_t protocolDataSize() const { return _valid ? _size - _ip_header_size - _proto_header_size : 0; }
 
         //!
         //! Check if the IPv4 packet is fragmented.
@@ -238,6 +259,8 @@ namespace ts {
         size_t    _proto_header_size {0};
         Port      _source_port {0};
         Port      _destination_port {0};
-        ByteBlock _data {};
+        const uint8_t* _ptr {nullptr};  // Address of packet content, either _data or shared.
+        size_t    _size {0};            // Size of packet content.
+        ByteBlock _data {};             // Packet content, when not shared.
     };
 }
@@ -43,7 +43,7 @@ bool ts::PcapFile::error(Report& report, const UString& fmt, std::initializer_li
 
 bool ts::PcapFile::open(const UString& filename, Report& report)
 {
-    if (_in != nullptr) {
+    if (isOpen()) {
         report.error(u"already open");
         return false;
     }
@@ -57,6 +57,7 @@ bool ts::PcapFile::open(const UString& filename, Report& report)
     _ipv4_packets_size = 0;
     _first_timestamp = -1;
     _last_timestamp = -1;
+    _map_pos = 0;
 
     // Open the file.
     if (filename.empty() || filename == u"-") {
@@ -67,6 +68,10 @@ bool ts::PcapFile::open(const UString& filename, Report& report)
         _in = &std::cin;
         _name = u"standard input";
     }
+    else if (_map.open(filename, true)) {
+        // Regular file, memory-mapped, no input stream.
+        _name = filename;
+    }
     else {
         _file.open(filename.toUTF8().c_str(), std::ios::in | std::ios::binary);
         if (!_file) {
@@ -78,13 +83,13 @@ bool ts::PcapFile::open(const UString& filename, Report& report)
     }
 
     // Read the file header, starting with a 4-byte "magic" number.
-    uint8_t magic[4];
-    if (!readall(magic, sizeof(magic), report) || !readHeader(GetUInt32BE(magic), report)) {
+    const uint8_t* magic = nullptr;
+    if (!read(4, magic, report) || !readHeader(GetUInt32BE(magic), report)) {
         close();
         return false;
     }
 
-    report.debug(u"opened %s, %s format version %d.%d, %s endian", {_name, _ng ? u"pcap-ng" : u"pcap", _major, _minor, _be ? u"big" : u"little"});
+    report.debug(u"opened %s, %s format version %d.%d, %s endian%s", {_name, _ng ? u"pcap-ng" : u"pcap", _major, _minor, _be ? u"big" : u"little", isMemoryMapped() ? u", memory-mapped" : u""});
     return true;
 }
 
@@ -99,11 +104,40 @@ void ts::PcapFile::close()
         _file.close();
     }
     _in = nullptr;
+    _map.close();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next "size" bytes in the file.
+//----------------------------------------------------------------------------
+
+bool ts::PcapFile::read(size_t size, const uint8_t*& data, Report& report)
+{
+    if (_map.isOpen()) {
+        // Memory-mapped file: return a pointer in the mapping.
+        if (size > _map.size() - _map_pos) {
+            // Truncated file, consider that we reached the end of file.
+            data = nullptr;
+            _map_pos = _file_size = _map.size();
+            return error(report);
+        }
+        data = _map.data() + _map_pos;
+        _map_pos += size;
+        _file_size = _map_pos;
+        return true;
+    }
+    else {
+        // Input stream: read in the reusable buffer.
+        _buffer.resize(size);
+        data = _buffer.data();
+        return readall(_buffer.data(), size, report);
+    }
 }
 
 
 //----------------------------------------------------------------------------
-// Read exactly "size" bytes. Return false if not enough bytes before eof.
+// Read exactly "size" bytes from the input stream.
 //----------------------------------------------------------------------------
 
 bool ts::PcapFile::readall(uint8_t* data, size_t size, Report& report)
@@ -146,8 +180,8 @@ bool ts::PcapFile::readHeader(uint32_t magic, Report& report)
         case PCAPNS_MAGIC_BE:
         case PCAPNS_MAGIC_LE: {
             // This is a pcap file. Read 20 additional bytes for the rest of the header.
-            uint8_t header[20];
-            if (!readall(header, sizeof(header), report)) {
+            const uint8_t* header = nullptr;
+            if (!read(20, header, report)) {
                 return error(report);
             }
             _ng = false;
@@ -163,15 +197,16 @@ bool ts::PcapFile::readHeader(uint32_t magic, Report& report)
         case PCAPNG_MAGIC: {
             // This is a pcap-ng file. Read the complete section header, compute endianness.
             _ng = true;
-            ByteBlock header;
-            if (!readNgBlockBody(magic, header, report)) {
+            const uint8_t* header = nullptr;
+            size_t header_size = 0;
+            if (!readNgBlockBody(magic, header, header_size, report)) {
                 return error(report);
             }
-            if (header.size() < 16) {
+            if (header_size < 12) {
                 return error(report, u"invalid pcap-ng file, truncated section header in %s", {_name});
             }
-            _major = get16(header.data() + 4);
-            _minor = get16(header.data() + 6);
+            _major = get16(header);
+            _minor = get16(header + 2);
             _if.clear(); // will read interface descriptions in dedicated blocks.
             break;
         }
@@ -242,28 +277,25 @@ bool ts::PcapFile::analyzeNgInterface(const uint8_t* data, size_t size, Report&
 // Read a pcap-ng block. The 32-bit block type has already been read.
 //----------------------------------------------------------------------------
 
-bool ts::PcapFile::readNgBlockBody(uint32_t block_type, ByteBlock& body, Report& report)
+bool ts::PcapFile::readNgBlockBody(uint32_t block_type, const uint8_t*& body, size_t& body_size, Report& report)
 {
-    body.clear();
-
-    // Read the first "Block Total Length" field.
-    uint8_t lenfield[4];
-    if (!readall(lenfield, sizeof(lenfield), report)) {
+    body = nullptr;
+    body_size = 0;
+
+    // Read the first "Block Total Length" field. If the block type is Section Header,
+    // also read the first 4 bytes of the body to get the endianness.
+    const bool section = block_type == PCAPNG_SECTION_HEADER;
+    const size_t head_size = section ? 8 : 4;
+    const uint8_t* head = nullptr;
+    if (!read(head_size, head, report)) {
         return error(report);
     }
 
-    // If the block type is Section Header, then the endianness is given by the first 4 bytes.
-    if (block_type == PCAPNG_SECTION_HEADER) {
+    if (section) {
         // Pcap-ng files have an endian-neutral block-type value for section header.
         // The byte order is defined by the 'byte-order magic' at the beginning of the section header block body.
-        body.resize(4);
-        if (!readall(body.data(), body.size(), report)) {
-            body.clear();
-            return error(report);
-        }
-        const uint32_t order_magic = GetUInt32BE(body.data());
+        const uint32_t order_magic = GetUInt32BE(head + 4);
         if (order_magic != PCAPNG_ORDER_BE && order_magic != PCAPNG_ORDER_LE) {
-            body.clear();
             return error(report, u"invalid pcap-ng file, unknown 'byte-order magic' 0x%X in %s", {order_magic, _name});
         }
         _be = order_magic == PCAPNG_ORDER_BE;
@@ -271,29 +303,25 @@ bool ts::PcapFile::readNgBlockBody(uint32_t block_type, ByteBlock& body, Report&
 
     // Interpret the packet size. The packet size include 12 additional bytes
     // for the block type and the two block length fields.
-    const size_t size = get32(lenfield);
-    if (size % 4 != 0 || size < 12 + body.size()) {
-        body.clear();
+    const size_t size = get32(head);
+    if (size % 4 != 0 || size < 8 + head_size) {
         return error(report, u"invalid pcap-ng block length %d in %s", {size, _name});
     }
 
-    // Read the rest of the block body.
-    const size_t start = body.size();
-    body.resize(size - 12);
-    if (!readall(body.data() + start, body.size() - start, report)) {
-        body.clear();
+    // Read the rest of the block body and the last "Block Total Length" field in one operation.
+    const size_t rest_size = size - 4 - head_size;
+    const uint8_t* rest = nullptr;
+    if (!read(rest_size, rest, report)) {
         return error(report);
     }
 
-    // Read and check the last "Block Total Length" field.
-    if (!readall(lenfield, sizeof(lenfield), report)) {
-        return error(report);
-    }
-    const size_t last_size = get32(lenfield);
+    // Check the last "Block Total Length" field.
+    const size_t last_size = get32(rest + rest_size - 4);
     if (size != last_size) {
-        body.clear();
         return error(report, u"inconsistent pcap-ng block length in %s, leading length: %d, trailing length: %d", {_name, size, last_size});
     }
+    body = rest;
+    body_size = rest_size - 4;
     return true;
 }
 
@@ -309,7 +337,7 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
     timestamp = -1;
 
     // Check that the file is open.
-    if (_in == nullptr) {
+    if (!isOpen()) {
         report.error(u"no pcap file open");
         return false;
     }
@@ -321,8 +349,9 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
     // Loop on file blocks until an IPv4 packet is found.
     for (;;) {
 
-        // The captured packet will go there.
-        ByteBlock buffer;
+        // The captured packet is there. It is either in the memory-mapped file or in the read buffer.
+        const uint8_t* buffer = nullptr;
+        size_t buffer_size = 0;
         size_t cap_start = 0;  // captured packet start index in buffer
         size_t cap_size = 0;   // captured packet size
         size_t orig_size = 0;  // original packet size (on network)
@@ -332,8 +361,8 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
         // We are at the beginning of a data block.
         if (_ng) {
             // Pcap-ng file, read block type value.
-            uint8_t type_field[4];
-            if (!readall(type_field, sizeof(type_field), report)) {
+            const uint8_t* type_field = nullptr;
+            if (!read(4, type_field, report)) {
                 return error(report);
             }
             const uint32_t type = get32(type_field);
@@ -345,25 +374,25 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
                 continue; // loop to next packet block
             }
             // Read one data block.
-            if (!readNgBlockBody(type, buffer, report)) {
+            if (!readNgBlockBody(type, buffer, buffer_size, report)) {
                 return error(report);
             }
             if (type == PCAPNG_INTERFACE_DESC) {
                 // Process an interface description.
-                if (!analyzeNgInterface(buffer.data(), buffer.size(), report)) {
+                if (!analyzeNgInterface(buffer, buffer_size, report)) {
                     return error(report);
                 }
                 continue; // loop to next packet block
             }
-            else if ((type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_OBSOLETE_PACKET) && buffer.size() >= 20) {
+            else if ((type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_OBSOLETE_PACKET) && buffer_size >= 20) {
                 _packet_count++;
                 cap_start = 20;
-                cap_size = std::min<size_t>(get32(buffer.data() + 12), buffer.size() - 20);
-                orig_size = get32(buffer.data() + 16);
-                if_index = type == PCAPNG_OBSOLETE_PACKET ? get16(buffer.data()) : get32(buffer.data());
+                cap_size = std::min<size_t>(get32(buffer + 12), buffer_size - 20);
+                orig_size = get32(buffer + 16);
+                if_index = type == PCAPNG_OBSOLETE_PACKET ? get16(buffer) : get32(buffer);
                 if (if_index < _if.size() && _if[if_index].time_units != 0) {
                     const SubSecond units = _if[if_index].time_units;
-                    const SubSecond tstamp = SubSecond(uint64_t(get32(buffer.data() + 4)) << 32) + SubSecond(get32(buffer.data() + 8));
+                    const SubSecond tstamp = SubSecond(uint64_t(get32(buffer + 4)) << 32) + SubSecond(get32(buffer + 8));
                     // Take care to overflow in tstamp * MilliSecPerSec. Sometimes, the timestamp is a full time
                     // since 1970 with time unit being 1,000,000,000. The value is close to the 64-bit max.
                     if (units == MicroSecPerSec) {
@@ -383,11 +412,11 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
                     }
                 }
             }
-            else if (type == PCAPNG_SIMPLE_PACKET && buffer.size() >= 4) {
+            else if (type == PCAPNG_SIMPLE_PACKET && buffer_size >= 4) {
                 _packet_count++;
                 cap_start = 4;
-                orig_size = get32(buffer.data());
-                cap_size = std::min(orig_size, buffer.size() - 4);
+                orig_size = get32(buffer);
+                cap_size = std::min(orig_size, buffer_size - 4);
             }
             else {
                 // This data block does not contain a captured packet, ignore it.
@@ -397,8 +426,8 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
         else {
             // Pcap file, beginning of a packet block. Read the 16-byte header.
             _packet_count++;
-            uint8_t header[16];
-            if (!readall(header, sizeof(header), report)) {
+            const uint8_t* header = nullptr;
+            if (!read(16, header, report)) {
                 return error(report);
             }
             const uint32_t tstamp = get32(header);
@@ -410,8 +439,8 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
             timestamp = (MicroSecond(tstamp) * MicroSecPerSec) + (SubSecond(sub_tstamp) * MicroSecPerSec) / _if[0].time_units;
 
             // Read packet data.
-            buffer.resize(cap_size);
-            if (!readall(buffer.data(), buffer.size(), report)) {
+            buffer_size = cap_size;
+            if (!read(buffer_size, buffer, report)) {
                 return error(report);
             }
         }
@@ -423,11 +452,9 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
             continue; // loop to next packet block
         }
 
-        // Get link type, adjust timestamp.
-        InterfaceDesc ifd;
-        if (if_index < _if.size()) {
-            ifd = _if[if_index];
-        }
+        // Get link type, adjust timestamp. Interface descriptions are indexed by interface id, don't copy them.
+        static const InterfaceDesc default_ifd {};
+        const InterfaceDesc& ifd(if_index < _if.size() ? _if[if_index] : default_ifd);
         if (timestamp >= 0) {
             timestamp += ifd.time_offset;
             if (_first_timestamp < 0) {
@@ -437,21 +464,21 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
         }
 
         report.log(2, u"pcap data block: %d bytes, captured packet at offset %d, %d bytes (original: %d bytes), link type: %d",
-                   {buffer.size(), cap_start, cap_size, orig_size, ifd.link_type});
+                   {buffer_size, cap_start, cap_size, orig_size, ifd.link_type});
 
         // Analyze the captured packet, trying to find an IPv4 datagram.
-        if (ifd.link_type == LINKTYPE_NULL && cap_size > 4 && get32(buffer.data() + cap_start) == 2) {
+        if (ifd.link_type == LINKTYPE_NULL && cap_size > 4 && get32(buffer + cap_start) == 2) {
             // BSD loopback encapsulation; the link layer header is a 4-byte field, in host byte order, containing 2 for IPv4 packets.
             cap_start += 4;
             cap_size -= 4;
         }
-        else if (ifd.link_type == LINKTYPE_LOOP && cap_size > 4 && GetUInt32BE(buffer.data() + cap_start) == 2) {
+        else if (ifd.link_type == LINKTYPE_LOOP && cap_size > 4 && GetUInt32BE(buffer + cap_start) == 2) {
             // OpenBSD loopback encapsulation; the link-layer header is a 4-byte field, in network byte order, containing 2 for IPv4 packets/
             cap_start += 4;
             cap_size -= 4;
         }
         else if ((ifd.link_type == LINKTYPE_ETHERNET || ifd.link_type == LINKTYPE_NULL || ifd.link_type == LINKTYPE_LOOP) &&
-                 cap_size > ETHER_HEADER_SIZE + ifd.fcs_size && GetUInt16BE(buffer.data() + cap_start + ETHER_TYPE_OFFSET) == ETHERTYPE_IPv4)
+                 cap_size > ETHER_HEADER_SIZE + ifd.fcs_size && GetUInt16BE(buffer + cap_start + ETHER_TYPE_OFFSET) == ETHERTYPE_IPv4)
         {
             // Ethernet frame: 14-byte header: destination MAC (6 bytes), source MAC (6 bytes), ether type (2 bytes, 0x0800 for IPv4).
             // This should apply to LINKTYPE_ETHERNET only. However, in some pcap files (not pcap-ng), it has been noticed that
@@ -469,7 +496,7 @@ bool ts::PcapFile::readIPv4(IPv4Packet& packet, MicroSecond& timestamp, Report&
 
         // A possible IPv4 datagram was found.
         if (cap_size > 0) {
-            if (packet.reset(buffer.data() + cap_start, cap_size)) {
+            if (packet.reset(buffer + cap_start, cap_size, _zero_copy ? ShareMode::SHARE : ShareMode::COPY)) {
                 _ipv4_packet_count++;
                 _ipv4_packets_size += cap_size;
                 return true;
@@ -14,6 +14,8 @@
 #pragma once
 #include "tsReport.h"
 #include "tsMemory.h"
+#include "tsByteBlock.h"
+#include "tsMemoryMappedFile.h"
 #include "tsTime.h"
 #include "tsIPv4Packet.h"
 #include "tsPcap.h"
@@ -27,6 +29,13 @@ namespace ts {
     //! This class reads a pcap or pcapng file and extracts IPv4 frames.
     //! All metadata and all other types of frames are ignored.
     //!
+    //! When the file is a regular file, it is memory-mapped whenever possible and the
+    //! capture records are analyzed in place. Otherwise (standard input, pipe, mapping
+    //! failure), the file is read sequentially into an internal buffer which is reused
+    //! for all records. In both cases, the extracted IPv4 packets are copied by default.
+    //! In zero-copy mode (see setZeroCopy()), the returned IPv4 packets directly reference
+    //! the data in the file mapping or in the internal buffer.
+    //!
     //! @see https://tools.ietf.org/pdf/draft-gharris-opsawg-pcap-02.pdf (PCAP)
     //! @see https://datatracker.ietf.org/doc/draft-gharris-opsawg-pcap/ (PCAP tracker)
     //! @see https://tools.ietf.org/pdf/draft-tuexen-opsawg-pcapng-04.pdf (PCAP-ng)
@@ -58,7 +67,29 @@ namespace ts {
         //! Check if the file is open.
         //! @return True if the file is open, false otherwise.
         //!
-        bool isOpen() const { return _in != nullptr; }
+        bool isOpen() const { return _in != nullptr || _map.isOpen(); }
+
+        //!
+        //! Check if the file is memory-mapped.
+        //! @return True if the file is open and memory-mapped.
+        //!
+        bool isMemoryMapped() const { return _map.isOpen(); }
+
+        //!
+        //! Set the zero-copy mode.
+        //! In zero-copy mode, the IPv4Packet objects which are returned by readIPv4() reference
+        //! the data in the file (see ts::ShareMode::SHARE) instead of copying them. The content
+        //! of a returned packet remains valid until the next call to readIPv4() or close() only.
+        //! By default, the zero-copy mode is off.
+        //! @param [in] on True to enable zero-copy, false to copy the returned packets.
+        //!
+        void setZeroCopy(bool on) { _zero_copy = on; }
+
+        //!
+        //! Check if the zero-copy mode is set.
+        //! @return True if the zero-copy mode is set.
+        //!
+        bool zeroCopy() const { return _zero_copy; }
 
         //!
         //! Get the file name.
@@ -164,8 +195,12 @@ namespace ts {
         };
 
         bool          _error {false};          // Error was set, may be logical error, not a file error.
-        std::istream* _in {nullptr};           // Point to actual input stream.
+        bool          _zero_copy {false};      // Return IPv4 packets which reference the file data.
+        std::istream* _in {nullptr};           // Point to actual input stream, null when memory-mapped.
         std::ifstream _file {};                // Input file (when it is a named file).
+        ByteBlock     _buffer {};              // Read buffer when the file is not memory-mapped.
+        MemoryMappedFile _map {};              // Memory-mapped file (when it is a named regular file).
+        size_t        _map_pos {0};            // Current read position in memory-mapped file.
         UString       _name {};                // Saved file name for messages.
         bool          _be {false};             // The file use a big-endian representation.
         bool          _ng {false};             // Pcapng format (not pcap).
@@ -183,9 +218,13 @@ namespace ts {
         // Report an error (if fmt is not empty), set error indicator, return false.
         bool error(Report& report, const UString& fmt = UString(), std::initializer_list<ArgMixIn> args = {});
 
-        // Read exactly "size" bytes. Return false if not enough bytes before eof.
+        // Read exactly "size" bytes from the input stream. Return false if not enough bytes before eof.
         bool readall(uint8_t* data, size_t size, Report& report);
 
+        // Get the next "size" bytes in the file, either in the memory-mapped file or in the read buffer.
+        // The returned data remain valid until the next read. Return false if not enough bytes before eof.
+        bool read(size_t size, const uint8_t*& data, Report& report);
+
         // Read a file / section header, starting from a magic number which was read as big endian.
         bool readHeader(uint32_t magic, Report& report);
 
@@ -194,8 +233,9 @@ namespace ts {
 
         // Read a pcap-ng block. The 32-bit block type has already been read.
         // Start at "Block total length". Read complete block, including the two length fields.
-        // Return only the block body.
-        bool readNgBlockBody(uint32_t block_type, ByteBlock& body, Report& report);
+        // Return only the block body. In a section header, the body starts after the byte-order magic.
+        // The returned data remain valid until the next read.
+        bool readNgBlockBody(uint32_t block_type, const uint8_t*& body, size_t& body_size, Report& report);
 
         // Read 32 or 16 bits using the endianness.
         uint16_t get16(const void* addr) const { return _be ? GetUInt16BE(addr) : GetUInt16LE(addr); }
@@ -118,6 +118,11 @@ namespace ts {
                              const AbortInterface* abort = nullptr,
                              Report& report = CERR,
                              MicroSecond* timestamp = nullptr) override;
+        virtual bool receive(Message* msgs,
+                             size_t max_count,
+                             size_t& ret_count,
+                             const AbortInterface* abort = nullptr,
+                             Report& report = CERR) override;
 
     private:
         bool              _dest_is_parameter {true};   // Destination address is a command line parameter, not an option.
@@ -138,6 +143,9 @@ namespace ts {
         IPv4SocketAddress _first_source {};            // Socket address of first received packet.
         IPv4SocketAddressSet _sources {};              // Set of all detected packet sources.
 
+        // Check if a received message matches the filtering criteria.
+        bool checkMessage(const IPv4SocketAddress& sender, const IPv4SocketAddress& destination, MicroSecond timestamp, Report& report);
+
         // Get the command line argument for the destination parameter.
         const UChar* destinationOptionName() const { return _dest_is_parameter ? u"" : u"ip-udp"; }
     };
@@ -19,6 +19,13 @@
     volatile ::LPFN_WSARECVMSG ts::UDPSocket::_wsaRevcMsg = 0;
 #endif
 
+#if !defined(TS_CXX17)
+constexpr size_t ts::UDPSocket::DEFAULT_BATCH_SIZE;
+#if defined(TS_LINUX)
+constexpr size_t ts::UDPSocket::MMSG_ANCIL_SIZE;
+#endif
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -87,6 +94,7 @@ bool ts::UDPSocket::close(Report& report)
     }
 
     // Close socket
+    _txtime = false;
     return Socket::close(report);
 }
 
@@ -240,6 +248,39 @@ bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable scheduled transmission times on outgoing packets.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::TransmitTimeSupported()
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ts::UDPSocket::enableTransmitTime(Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    // Transmission times use the same clock as ts::Monotonic.
+    ::sock_txtime txtime;
+    TS_ZERO(txtime);
+    txtime.clockid = CLOCK_MONOTONIC;
+    if (::setsockopt(getSocket(), SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) != 0) {
+        report.error(u"socket option SO_TXTIME: " + SysSocketErrorCodeMessage());
+        return false;
+    }
+    _txtime = true;
+    return true;
+#else
+    report.error(u"scheduled transmission times are not supported on this system");
+    return false;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option.
 //----------------------------------------------------------------------------
@@ -426,6 +467,146 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPv4SocketAddress&
 }
 
 
+//----------------------------------------------------------------------------
+// Send a message to the default destination at a given time.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendAt(const void* data, size_t size, NanoSecond txtime, Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+
+    if (!_txtime) {
+        return send(data, size, _default_destination, report);
+    }
+
+    ::sockaddr addr;
+    _default_destination.copy(addr);
+
+    ::iovec iov;
+    iov.iov_base = const_cast<void*>(data);
+    iov.iov_len = size;
+
+    // Ancillary data: one SCM_TXTIME message with a 64-bit time in nanoseconds.
+    union {
+        ::cmsghdr align;
+        uint8_t data[CMSG_SPACE(sizeof(uint64_t))];
+    } control;
+    TS_ZERO(control);
+
+    ::msghdr hdr;
+    TS_ZERO(hdr);
+    hdr.msg_name = &addr;
+    hdr.msg_namelen = sizeof(addr);
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control.data;
+    hdr.msg_controllen = sizeof(control.data);
+
+    ::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_TXTIME;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+    const uint64_t time = uint64_t(std::max<NanoSecond>(txtime, 0));
+    ::memcpy(CMSG_DATA(cmsg), &time, sizeof(time));
+
+    while (::sendmsg(getSocket(), &hdr, 0) < 0) {
+        const SysSocketErrorCode err = LastSysSocketErrorCode();
+        if (err != EINTR) {
+            report.error(u"error sending UDP message: " + SysSocketErrorCodeMessage(err));
+            return false;
+        }
+    }
+    return true;
+
+#else
+
+    // No scheduled transmission time, send immediately.
+    return send(data, size, _default_destination, report);
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Resize a work area for batch send or receive when necessary.
+//----------------------------------------------------------------------------
+
+#if defined(TS_LINUX)
+void ts::UDPSocket::MMsgArea::resize(size_t count, size_t ancil_size)
+{
+    if (hdr.size() < count) {
+        hdr.resize(count);
+        iov.resize(count);
+        addr.resize(count);
+    }
+    if (ancil.size() < count * ancil_size) {
+        ancil.resize(count * ancil_size);
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Send a batch of messages.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::send(const Message* msgs, size_t count, Report& report)
+{
+#if defined(TS_LINUX)
+
+    // Resize work areas when necessary. No ancillary data on send.
+    _send_mmsg.resize(count, 0);
+
+    // Build the array of messages for sendmmsg().
+    for (size_t i = 0; i < count; ++i) {
+        const IPv4SocketAddress& dest(msgs[i].destination.hasAddress() ? msgs[i].destination : _default_destination);
+        dest.copy(_send_mmsg.addr[i]);
+        _send_mmsg.iov[i].iov_base = msgs[i].data;
+        _send_mmsg.iov[i].iov_len = msgs[i].size;
+        TS_ZERO(_send_mmsg.hdr[i]);
+        _send_mmsg.hdr[i].msg_hdr.msg_name = &_send_mmsg.addr[i];
+        _send_mmsg.hdr[i].msg_hdr.msg_namelen = sizeof(::sockaddr);
+        _send_mmsg.hdr[i].msg_hdr.msg_iov = &_send_mmsg.iov[i];
+        _send_mmsg.hdr[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Loop until all messages are sent. A partial send occurs when the
+    // socket buffer is full or on error after the first message.
+    size_t next = 0;
+    while (next < count) {
+        const int sent = ::sendmmsg(getSocket(), &_send_mmsg.hdr[next], static_cast<unsigned int>(count - next), 0);
+        if (sent < 0) {
+            const SysSocketErrorCode err = LastSysSocketErrorCode();
+            if (err != EINTR) {
+                report.error(u"error sending UDP message: " + SysSocketErrorCodeMessage(err));
+                return false;
+            }
+        }
+        else if (sent == 0) {
+            // No progress, would loop forever.
+            report.error(u"error sending UDP message, no message sent");
+            return false;
+        }
+        else {
+            next += size_t(sent);
+        }
+    }
+    return true;
+
+#else
+
+    // No batch sending, send messages one by one.
+    for (size_t i = 0; i < count; ++i) {
+        if (!send(msgs[i].data, msgs[i].size, msgs[i].destination.hasAddress() ? msgs[i].destination : _default_destination, report)) {
+            return false;
+        }
+    }
+    return true;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 // If abort interface is non-zero, invoke it when I/O is interrupted
@@ -485,6 +666,133 @@ bool ts::UDPSocket::receive(void* data,
 }
 
 
+//----------------------------------------------------------------------------
+// Receive a batch of messages.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::receive(Message* msgs, size_t max_count, size_t& ret_count, const AbortInterface* abort, Report& report)
+{
+    ret_count = 0;
+    if (msgs == nullptr || max_count == 0) {
+        return true;
+    }
+
+    // Loop on unsollicited interrupts
+    for (;;) {
+
+        // Wait for messages.
+        const SysSocketErrorCode err = receiveBatch(msgs, max_count, ret_count, report);
+
+        if (abort != nullptr && abort->aborting()) {
+            // Aborting, no error message.
+            return false;
+        }
+        else if (err == SYS_SUCCESS) {
+            // Sometimes, we get "successful" empty message coming from nowhere. Ignore them.
+            size_t count = 0;
+            for (size_t i = 0; i < ret_count; ++i) {
+                if (msgs[i].size > 0 || msgs[i].sender.hasAddress()) {
+                    if (count < i) {
+                        MoveMessage(msgs[count], msgs[i]);
+                    }
+                    count++;
+                }
+            }
+            ret_count = count;
+            if (ret_count > 0) {
+                return true;
+            }
+        }
+#if !defined(TS_WINDOWS)
+        else if (err == EINTR) {
+            // Got a signal, not a user interrupt, will ignore it
+            report.debug(u"signal, not user interrupt");
+        }
+#endif
+        else {
+            // Abort on non-interrupt errors.
+            if (isOpen()) {
+                // Report the error only if the error does not result from a close in another thread.
+                report.error(u"error receiving from UDP socket: %s", {SysSocketErrorCodeMessage(err)});
+            }
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Move a received message into the buffer of a previous message in a batch.
+//----------------------------------------------------------------------------
+
+void ts::UDPSocket::MoveMessage(Message& dest, const Message& src)
+{
+    dest.size = std::min(src.size, dest.max_size);
+    dest.sender = src.sender;
+    dest.destination = src.destination;
+    dest.timestamp = src.timestamp;
+    ::memmove(dest.data, src.data, dest.size);
+}
+
+
+//----------------------------------------------------------------------------
+// Perform one batch receive operation.
+//----------------------------------------------------------------------------
+
+ts::SysSocketErrorCode ts::UDPSocket::receiveBatch(Message* msgs, size_t max_count, size_t& ret_count, Report& report)
+{
+    ret_count = 0;
+
+#if defined(TS_LINUX)
+
+    // Resize work areas when necessary.
+    _recv_mmsg.resize(max_count, MMSG_ANCIL_SIZE);
+
+    // Build the array of messages for recvmmsg().
+    for (size_t i = 0; i < max_count; ++i) {
+        TS_ZERO(_recv_mmsg.addr[i]);
+        _recv_mmsg.iov[i].iov_base = msgs[i].data;
+        _recv_mmsg.iov[i].iov_len = msgs[i].max_size;
+        TS_ZERO(_recv_mmsg.hdr[i]);
+        _recv_mmsg.hdr[i].msg_hdr.msg_name = &_recv_mmsg.addr[i];
+        _recv_mmsg.hdr[i].msg_hdr.msg_namelen = sizeof(::sockaddr);
+        _recv_mmsg.hdr[i].msg_hdr.msg_iov = &_recv_mmsg.iov[i];
+        _recv_mmsg.hdr[i].msg_hdr.msg_iovlen = 1;
+        _recv_mmsg.hdr[i].msg_hdr.msg_control = &_recv_mmsg.ancil[i * MMSG_ANCIL_SIZE];
+        _recv_mmsg.hdr[i].msg_hdr.msg_controllen = MMSG_ANCIL_SIZE;
+    }
+
+    // Wait for the first message, then get all available messages without waiting.
+    const int count = ::recvmmsg(getSocket(), _recv_mmsg.hdr.data(), static_cast<unsigned int>(max_count), MSG_WAITFORONE, nullptr);
+    if (count < 0) {
+        return LastSysSocketErrorCode();
+    }
+
+    // Analyze all received messages.
+    for (size_t i = 0; i < size_t(count); ++i) {
+        msgs[i].size = size_t(_recv_mmsg.hdr[i].msg_len);
+        msgs[i].sender = IPv4SocketAddress(_recv_mmsg.addr[i]);
+        msgs[i].destination.clear();
+        msgs[i].timestamp = -1;
+        getAncillaryData(_recv_mmsg.hdr[i].msg_hdr, msgs[i].destination, &msgs[i].timestamp);
+    }
+    ret_count = size_t(count);
+    return SYS_SUCCESS;
+
+#else
+
+    // No batch receive, get one message only.
+    msgs[0].timestamp = -1;
+    const SysSocketErrorCode err = receiveOne(msgs[0].data, msgs[0].max_size, msgs[0].size, msgs[0].sender, msgs[0].destination, report, &msgs[0].timestamp);
+    if (err == SYS_SUCCESS) {
+        ret_count = 1;
+    }
+    return err;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Perform one receive operation. Hide the system mud.
 //----------------------------------------------------------------------------
@@ -600,13 +908,33 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
         return LastSysSocketErrorCode();
     }
 
+    // Browse returned ancillary data.
+    getAncillaryData(hdr, destination, timestamp);
+
+#endif // Windows vs. UNIX
+
+    // Successfully received a message
+    ret_size = size_t(insize);
+    sender = IPv4SocketAddress(sender_sock);
+
+    return SYS_SUCCESS;
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze the ancillary data of a received message (UNIX only).
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+void ts::UDPSocket::getAncillaryData(::msghdr& hdr, IPv4SocketAddress& destination, MicroSecond* timestamp) const
+{
     TS_PUSH_WARNING()
     TS_GCC_NOWARNING(zero-as-null-pointer-constant) // invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
 #if defined(TS_OPENBSD)
     TS_LLVM_NOWARNING(cast-align) // invalid definition of CMSG_NXTHDR on OpenBSD
 #endif
 
-    // Browse returned ancillary data.
     for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
 
         // Look for destination IP address.
@@ -638,12 +966,6 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
     }
 
     TS_POP_WARNING()
-
-#endif // Windows vs. UNIX
-
-    // Successfully received a message
-    ret_size = size_t(insize);
-    sender = IPv4SocketAddress(sender_sock);
-
-    return SYS_SUCCESS;
 }
+
+#endif
@@ -18,6 +18,7 @@
 #include "tsAbortInterface.h"
 #include "tsReport.h"
 #include "tsMemory.h"
+#include "tsByteBlock.h"
 
 #if defined(DOXYGEN) || defined(TS_OPENBSD) || defined(TS_NETBSD) || defined(TS_DRAGONFLYBSD)
     //!
@@ -201,6 +202,28 @@ namespace ts {
         //!
         bool setReceiveTimestamps(bool on, Report& report = CERR);
 
+        //!
+        //! Enable scheduled transmission times on outgoing packets.
+        //!
+        //! When enabled, sendAt() can be used to specify the time at which each packet is
+        //! transmitted by the kernel. The transmission time is honored only when the queuing
+        //! discipline of the network interface supports it (typically @e fq or @e etf on Linux).
+        //! Otherwise, the packets are sent immediately.
+        //!
+        //! This option is supported on Linux only (socket option SO_TXTIME). It fails on other systems.
+        //!
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendAt()
+        //!
+        bool enableTransmitTime(Report& report = CERR);
+
+        //!
+        //! Check if scheduled transmission times are supported on this system.
+        //! @return True if enableTransmitTime() is supported on this system.
+        //!
+        static bool TransmitTimeSupported();
+
         //!
         //! Enable or disable the broadcast option.
         //!
@@ -278,6 +301,27 @@ namespace ts {
         //!
         bool dropMembership(Report& report = CERR);
 
+        //!
+        //! Default number of messages in a batch of messages which are sent or received in one system call.
+        //!
+        static constexpr size_t DEFAULT_BATCH_SIZE = 16;
+
+        //!
+        //! Description of a message in a batch of messages which are sent or received together.
+        //! @see send(const Message*, size_t, Report&)
+        //! @see receive(Message*, size_t, size_t&, const AbortInterface*, Report&)
+        //!
+        class TSDUCKDLL Message
+        {
+        public:
+            void*             data {nullptr};  //!< Address of the message buffer.
+            size_t            max_size {0};    //!< Size in bytes of the message buffer, on receive only.
+            size_t            size {0};        //!< Size in bytes of the message. Set on receive, input on send.
+            IPv4SocketAddress sender {};       //!< Socket address of the sender, set on receive only.
+            IPv4SocketAddress destination {};  //!< Socket address of the destination. On send, use default destination if unset.
+            MicroSecond       timestamp {-1};  //!< Receive timestamp in micro-seconds, negative if unavailable, set on receive only.
+        };
+
         //!
         //! Send a message to a destination address and port.
         //!
@@ -301,6 +345,22 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, Report& report = CERR);
 
+        //!
+        //! Send a message to the default destination address and port at a given time.
+        //!
+        //! When enableTransmitTime() was successfully called, the message is transmitted
+        //! by the kernel at the specified time. Otherwise, the message is sent immediately.
+        //!
+        //! @param [in] data Address of the message to send.
+        //! @param [in] size Size in bytes of the message to send.
+        //! @param [in] txtime Transmission time in nanoseconds, using the same clock as the
+        //! class Monotonic (CLOCK_MONOTONIC on Linux).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see enableTransmitTime()
+        //!
+        bool sendAt(const void* data, size_t size, NanoSecond txtime, Report& report = CERR);
+
         //!
         //! Receive a message.
         //!
@@ -328,10 +388,59 @@ namespace ts {
                              Report& report = CERR,
                              MicroSecond* timestamp = nullptr);
 
+        //!
+        //! Send a batch of messages.
+        //!
+        //! On Linux, all messages are sent using one single system call (sendmmsg).
+        //! On other systems, the messages are sent one by one.
+        //!
+        //! @param [in] msgs Array of messages to send. In each message, @a data and @a size
+        //! are used. If @a destination is unset, the message is sent to the default destination.
+        //! @param [in] count Number of messages to send.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool send(const Message* msgs, size_t count, Report& report = CERR);
+
+        //!
+        //! Receive a batch of messages.
+        //!
+        //! The method waits for at least one message. Then, all messages which are already
+        //! available, up to @a max_count, are returned without waiting for more. On Linux, all
+        //! messages are received using one single system call (recvmmsg). On other systems,
+        //! only one message is returned.
+        //!
+        //! @param [in,out] msgs Array of messages. In each message, @a data and @a max_size
+        //! shall be set on input. All other fields are returned. Spurious messages are removed
+        //! from the array by moving the content of the next messages into their buffers.
+        //! Therefore, all buffers shall have the same size.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] ret_count Number of received messages, always non-zero on success.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted
+        //! (in case of user-interrupt, return, otherwise retry).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see setReceiveTimestamps()
+        //!
+        virtual bool receive(Message* msgs,
+                             size_t max_count,
+                             size_t& ret_count,
+                             const AbortInterface* abort = nullptr,
+                             Report& report = CERR);
+
         // Implementation of Socket interface.
         virtual bool open(Report& report = CERR) override;
         virtual bool close(Report& report = CERR) override;
 
+    protected:
+        //!
+        //! Move a received message into the buffer of a previous message in a batch.
+        //! This is used to remove spurious messages from a batch of received messages.
+        //! @param [in,out] dest Destination message. Its buffer receives the content of @a src.
+        //! @param [in] src Source message.
+        //!
+        static void MoveMessage(Message& dest, const Message& src);
+
     private:
         // Encapsulate a Plain Old C Structure.
         template <typename STRUCT>
@@ -389,10 +498,35 @@ namespace ts {
         SSMReqSet         _ssmcast {};  // Current set of source-specific multicast memberships
 #endif
         MReqSet           _mcast {};    // Current set of multicast memberships
+        bool              _txtime {false};  // Scheduled transmission times are enabled (SO_TXTIME)
+
+        // Work areas for batch send and receive (mmsghdr, iovec, sockaddr, ancillary data).
+        // Send and receive use distinct work areas so that one thread can send while another one receives.
+#if defined(TS_LINUX)
+        struct MMsgArea
+        {
+            std::vector<::mmsghdr>  hdr {};
+            std::vector<::iovec>    iov {};
+            std::vector<::sockaddr> addr {};
+            ByteBlock               ancil {};
+            void resize(size_t count, size_t ancil_size);
+        };
+        MMsgArea _send_mmsg {};
+        MMsgArea _recv_mmsg {};
+        static constexpr size_t MMSG_ANCIL_SIZE = 256;
+#endif
 
         // Perform one receive operation. Hide the system mud.
         SysSocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, IPv4SocketAddress& sender, IPv4SocketAddress& destination, Report& report, MicroSecond* timestamp);
 
+        // Perform one batch receive operation.
+        SysSocketErrorCode receiveBatch(Message* msgs, size_t max_count, size_t& ret_count, Report& report);
+
+        // Analyze the ancillary data of a received message (UNIX only).
+#if !defined(TS_WINDOWS)
+        void getAncillaryData(::msghdr& hdr, IPv4SocketAddress& destination, MicroSecond* timestamp) const;
+#endif
+
         // Furiously idiotic Windows feature, see comment in receiveOne()
 #if defined(TS_WINDOWS)
         static volatile ::LPFN_WSARECVMSG _wsaRevcMsg;
@@ -7,6 +7,12 @@
 //----------------------------------------------------------------------------
 
 #include "tsAsyncReport.h"
+#include "tsGuardCondition.h"
+#include "tsTime.h"
+
+#if !defined(TS_CXX17)
+constexpr size_t ts::AsyncReport::PREALLOCATED_MESSAGE_SIZE;
+#endif
 
 
 //----------------------------------------------------------------------------
@@ -16,10 +22,16 @@
 ts::AsyncReport::AsyncReport(int max_severity, const AsyncReportArgs& args) :
     Report(max_severity),
     Thread(ThreadAttributes().setPriority(ThreadAttributes::GetMinimumPriority())),
-    _log_queue(args.log_msg_count),
+    _records(std::max<size_t>(2, args.log_msg_count)),
     _time_stamp(args.timed_log),
     _synchronous(args.sync_log)
 {
+    // Preallocate the log records. Most messages will fit without reallocation.
+    for (size_t i = 0; i < _records.size(); ++i) {
+        _records[i].sequence = i;
+        _records[i].message.reserve(PREALLOCATED_MESSAGE_SIZE);
+    }
+
     // Start the logging thread
     start();
 }
@@ -44,7 +56,7 @@ void ts::AsyncReport::terminate()
     if (!_terminated) {
         // Insert an "end of report" message in the queue.
         // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage(true, 0, UString()));
+        waitEnqueue(true, 0, UString());
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -68,10 +80,129 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
     ::OutputDebugStringW(msgNewLine.wc_str());
 #endif
 
-    if (!_terminated) {
-        // Enqueue the message immediately (timeout = 0), drop message on overflow.
-        // On the contrary, in synchronous mode, wait infinitely until the message is queued.
-        _log_queue.enqueue(new LogMessage(false, severity, msg), _synchronous ? Infinite : 0);
+    if (!_terminated && !enqueue(false, severity, msg)) {
+        if (_synchronous) {
+            // In synchronous mode, wait until the message is queued.
+            waitEnqueue(false, severity, msg);
+        }
+        else {
+            // Drop message on overflow.
+            _dropped++;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Try to enqueue a message in the ring.
+//----------------------------------------------------------------------------
+
+bool ts::AsyncReport::enqueue(bool terminate, int severity, const UString& msg)
+{
+    // Reserve a position in the ring, without lock.
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    LogRecord* rec = nullptr;
+    for (;;) {
+        rec = &_records[pos % _records.size()];
+        const size_t seq = rec->sequence.load(std::memory_order_acquire);
+        if (seq == pos) {
+            // The record is free, try to get it.
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+            // Otherwise, another thread got it first, pos was updated, retry.
+        }
+        else if (seq < pos) {
+            // The record at this position is not yet read by the logging thread: the ring is full.
+            return false;
+        }
+        else {
+            // Another thread got this position, retry with the new position.
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Fill the record and publish it for the logging thread.
+    rec->terminate = terminate;
+    rec->severity = severity;
+    rec->message.assign(msg);
+    rec->sequence.store(pos + 1, std::memory_order_seq_cst);
+
+    // Wake up the logging thread if it is idle.
+    if (_idle.load(std::memory_order_seq_cst)) {
+        GuardCondition lock(_mutex, _condition);
+        lock.signal();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Enqueue a message, wait for a free record when the ring is full.
+//----------------------------------------------------------------------------
+
+void ts::AsyncReport::waitEnqueue(bool terminate, int severity, const UString& msg)
+{
+    GuardCondition lock(_mutex, _free_condition);
+    _waiting++;
+    while (!_terminated && !enqueue(terminate, severity, msg)) {
+        // The timeout is a safety net only, the logging thread signals the condition when a record is freed.
+        lock.waitCondition(100);
+    }
+    _waiting--;
+}
+
+
+//----------------------------------------------------------------------------
+// Dequeue a message from the ring, in the logging thread.
+//----------------------------------------------------------------------------
+
+bool ts::AsyncReport::ready() const
+{
+    return _records[_dequeue_pos % _records.size()].sequence.load(std::memory_order_seq_cst) == _dequeue_pos + 1;
+}
+
+void ts::AsyncReport::dequeue(bool& terminate, int& severity, UString& msg)
+{
+    // Wait for a message to be ready.
+    if (!ready()) {
+        // The ring is empty, report dropped messages, if any, before sleeping.
+        reportDropped();
+        GuardCondition lock(_mutex, _condition);
+        _idle.store(true, std::memory_order_seq_cst);
+        while (!ready()) {
+            // The timeout is a safety net only, producers signal the condition when we are idle.
+            lock.waitCondition(100);
+        }
+        _idle.store(false, std::memory_order_relaxed);
+    }
+
+    // Read the record and free it for the application threads.
+    LogRecord& rec(_records[_dequeue_pos % _records.size()]);
+    terminate = rec.terminate;
+    severity = rec.severity;
+    msg.swap(rec.message);
+    rec.sequence.store(_dequeue_pos + _records.size(), std::memory_order_seq_cst);
+    _dequeue_pos++;
+
+    // Wake up application threads which wait for a free record.
+    if (_waiting.load(std::memory_order_seq_cst) > 0) {
+        GuardCondition lock(_mutex, _free_condition);
+        lock.signal();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Report dropped messages, in the context of the logging thread.
+//----------------------------------------------------------------------------
+
+void ts::AsyncReport::reportDropped()
+{
+    const size_t dropped = _dropped;
+    if (dropped > _reported_dropped) {
+        asyncThreadLog(Severity::Warning, UString::Format(u"%'d log messages dropped, logging queue overflow", {dropped - _reported_dropped}));
+        _reported_dropped = dropped;
     }
 }
 
@@ -82,20 +213,28 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
+    bool terminate = false;
+    int severity = Severity::Info;
+    UString message;
+    message.reserve(PREALLOCATED_MESSAGE_SIZE);
 
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
 
-    while (_log_queue.dequeue(msg) && !msg->terminate) {
+    for (;;) {
+        dequeue(terminate, severity, message);
+        if (terminate) {
+            break;
+        }
 
-        asyncThreadLog(msg->severity, msg->message);
+        asyncThreadLog(severity, message);
 
         // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
+        if (severity == Severity::Fatal) {
             ::exit(EXIT_FAILURE);
         }
     }
+    reportDropped();
 
     if (_max_severity >= Severity::Debug) {
         asyncThreadLog(Severity::Debug, u"Report logging thread terminated");
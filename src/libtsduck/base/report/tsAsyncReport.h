@@ -14,8 +14,8 @@
 #pragma once
 #include "tsReport.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
-#include "tsNullMutex.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
 #include "tsThread.h"
 
 namespace ts {
@@ -28,11 +28,16 @@ namespace ts {
     //! to the caller without waiting. The messages are logged later in one single
     //! low-priority thread.
     //!
-    //! In case of a huge amount of errors, there is no avalanche effect. If a caller
-    //! cannot immediately enqueue a message or if the internal queue of messages is
-    //! full, the message is dropped. In other words, reporting messages is guaranteed
-    //! to never block, slow down or crash the application. Messages are dropped when
-    //! necessary to avoid that kind of problem.
+    //! In case of a huge amount of errors, there is no avalanche effect. If the internal
+    //! queue of messages is full, the message is dropped. In other words, reporting messages
+    //! is guaranteed to never block, slow down or crash the application. Messages are dropped
+    //! when necessary to avoid that kind of problem. The number of dropped messages is reported
+    //! in a warning message as soon as the logging thread catches up.
+    //!
+    //! The internal queue is a lock-free ring of preallocated log records. Application threads
+    //! never wait for each other or for the logging thread when they log messages. A mutex is
+    //! used only to wake up the logging thread when it is idle and, in synchronous mode, to
+    //! wait for a free record when the queue is full.
     //!
     //! Messages are displayed on the standard error device by default.
     //!
@@ -79,6 +84,12 @@ namespace ts {
         //!
         bool getSynchronous() const { return _synchronous; }
 
+        //!
+        //! Get the number of messages which were dropped because the internal queue was full.
+        //! @return The number of dropped messages since the creation of this object.
+        //!
+        size_t droppedMessages() const { return _dropped; }
+
         //!
         //! Synchronously terminate the report thread.
         //! Automatically performed in destructor.
@@ -113,22 +124,50 @@ namespace ts {
         // This hook is invoked in the context of the logging thread.
         virtual void main() override;
 
-        // The application threads send that type of message to the logging thread
-        struct LogMessage
-        {
-            LogMessage(bool t, int s, const UString& m) : terminate(t), severity(s), message(m) {}
+        // Preallocated size of messages, in characters.
+        static constexpr size_t PREALLOCATED_MESSAGE_SIZE = 128;
 
+        // Preallocated log record in the ring. The message string keeps its capacity from one use to another.
+        // The sequence number implements a bounded multi-producer queue (one atomic operation per message):
+        // - sequence == position: the record is free for the producer at this position.
+        // - sequence == position + 1: the record is filled and ready for the logging thread.
+        struct LogRecord
+        {
+            std::atomic<size_t> sequence {0};
             bool    terminate {false};  // ask the logging thread to terminate
             int     severity {Severity::Info};
             UString message {};
         };
-        typedef SafePtr <LogMessage, NullMutex> LogMessagePtr;
-        typedef MessageQueue <LogMessage, NullMutex> LogMessageQueue;
+
+        // Try to enqueue a message in the ring, return false if the ring is full.
+        bool enqueue(bool terminate, int severity, const UString& msg);
+
+        // Enqueue a message in the ring, wait until a record is freed by the logging thread if the ring is full.
+        void waitEnqueue(bool terminate, int severity, const UString& msg);
+
+        // Dequeue a message from the ring in the logging thread, wait if the ring is empty.
+        // The message string is swapped with the one in the record to avoid reallocation.
+        void dequeue(bool& terminate, int& severity, UString& msg);
+
+        // Check if a message is ready in the ring.
+        bool ready() const;
+
+        // Report dropped messages, in the context of the logging thread.
+        void reportDropped();
 
         // Private members:
-        LogMessageQueue _log_queue {};
-        volatile bool   _time_stamp {false};
-        volatile bool   _synchronous {false};
-        volatile bool   _terminated {false};
+        std::vector<LogRecord> _records;                // Ring of log records.
+        std::atomic<size_t>    _enqueue_pos {0};        // Next position to fill by application threads.
+        size_t                 _dequeue_pos {0};        // Next position to read by the logging thread.
+        std::atomic<size_t>    _dropped {0};            // Number of dropped messages.
+        size_t                 _reported_dropped {0};   // Number of dropped messages which were already reported.
+        std::atomic<bool>      _idle {false};           // The logging thread is waiting for messages.
+        std::atomic<size_t>    _waiting {0};            // Number of application threads waiting for a free record.
+        Mutex                  _mutex {};               // Protects _condition and _free_condition.
+        Condition              _condition {};           // Signaled when a message is enqueued while the logging thread is idle.
+        Condition              _free_condition {};      // Signaled when a record is freed while application threads are waiting.
+        volatile bool          _time_stamp {false};
+        volatile bool          _synchronous {false};
+        volatile bool          _terminated {false};
     };
 }
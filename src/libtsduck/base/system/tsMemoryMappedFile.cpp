@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsMemoryMappedFile.h"
+#include "tsSysUtils.h"
+
+#if defined(TS_UNIX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Map a file in memory.
+//----------------------------------------------------------------------------
+
+bool ts::MemoryMappedFile::open(const UString& filename, bool sequential, Report& report)
+{
+    close();
+
+#if defined(TS_WINDOWS)
+
+    ::HANDLE fh = ::CreateFileW(filename.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) {
+        report.error(u"error opening %s: %s", {filename, SysErrorCodeMessage()});
+        return false;
+    }
+    ::LARGE_INTEGER size;
+    void* base = nullptr;
+    if (::GetFileType(fh) != FILE_TYPE_DISK || !::GetFileSizeEx(fh, &size) || size.QuadPart <= 0 || uint64_t(size.QuadPart) > uint64_t(std::numeric_limits<size_t>::max())) {
+        report.error(u"%s is not a non-empty regular file", {filename});
+    }
+    else {
+        ::HANDLE mh = ::CreateFileMappingW(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mh != nullptr) {
+            base = ::MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+            // The view remains valid after closing the mapping handle.
+            ::CloseHandle(mh);
+        }
+        if (base == nullptr) {
+            report.error(u"error mapping %s: %s", {filename, SysErrorCodeMessage()});
+        }
+    }
+    ::CloseHandle(fh);
+    if (base == nullptr) {
+        return false;
+    }
+    _size = size_t(size.QuadPart);
+
+#else
+
+    const int fd = ::open(filename.toUTF8().c_str(), O_RDONLY);
+    if (fd < 0) {
+        report.error(u"error opening %s: %s", {filename, SysErrorCodeMessage()});
+        return false;
+    }
+    struct stat st;
+    void* base = MAP_FAILED;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || uint64_t(st.st_size) > uint64_t(std::numeric_limits<size_t>::max())) {
+        report.error(u"%s is not a non-empty regular file", {filename});
+    }
+    else {
+        base = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            report.error(u"error mapping %s: %s", {filename, SysErrorCodeMessage()});
+        }
+    }
+    // The mapping remains valid after closing the file descriptor.
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    _size = size_t(st.st_size);
+    if (sequential) {
+        ::madvise(base, _size, MADV_SEQUENTIAL);
+    }
+
+#endif
+
+    _base = reinterpret_cast<const uint8_t*>(base);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Unmap the file.
+//----------------------------------------------------------------------------
+
+void ts::MemoryMappedFile::close()
+{
+    if (_base != nullptr) {
+#if defined(TS_WINDOWS)
+        ::UnmapViewOfFile(_base);
+#else
+        ::munmap(const_cast<uint8_t*>(_base), _size);
+#endif
+        _base = nullptr;
+        _size = 0;
+    }
+}
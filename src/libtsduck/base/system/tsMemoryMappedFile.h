@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only memory-mapped file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsNullReport.h"
+
+namespace ts {
+    //!
+    //! Read-only mapping of a complete regular file in memory.
+    //! @ingroup system
+    //!
+    class TSDUCKDLL MemoryMappedFile
+    {
+        TS_NOCOPY(MemoryMappedFile);
+    public:
+        //!
+        //! Constructor.
+        //!
+        MemoryMappedFile() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~MemoryMappedFile();
+
+        //!
+        //! Map a file in memory.
+        //! Only non-empty regular files can be mapped. Pipes, devices or empty files cannot.
+        //! @param [in] filename Name of the file to map.
+        //! @param [in] sequential If true, the file is expected to be read sequentially
+        //! and the operating system is advised to read ahead.
+        //! @param [in,out] report Where to report errors. By default, errors are silently
+        //! ignored because a mapping failure is typically handled by reading the file
+        //! in a traditional way.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& filename, bool sequential = false, Report& report = NULLREP);
+
+        //!
+        //! Unmap the file.
+        //! All previously returned addresses become invalid.
+        //!
+        void close();
+
+        //!
+        //! Check if a file is mapped.
+        //! @return True if a file is mapped.
+        //!
+        bool isOpen() const { return _base != nullptr; }
+
+        //!
+        //! Get the base address of the mapped file.
+        //! @return The base address of the mapped file or a null pointer if no file is mapped.
+        //!
+        const uint8_t* data() const { return _base; }
+
+        //!
+        //! Get the size of the mapped file.
+        //! @return The size in bytes of the mapped file.
+        //!
+        size_t size() const { return _size; }
+
+    private:
+        const uint8_t* _base {nullptr};
+        size_t         _size {0};
+    };
+}
@@ -56,6 +56,11 @@ ts::Monotonic::~Monotonic()
 //----------------------------------------------------------------------------
 
 void ts::Monotonic::getSystemTime()
+{
+    _value = SystemTicks();
+}
+
+int64_t ts::Monotonic::SystemTicks()
 {
 #if defined(TS_WINDOWS)
 
@@ -65,19 +70,19 @@ void ts::Monotonic::getSystemTime()
         int64_t i;
     } result;
     ::GetSystemTimeAsFileTime(&result.ft);
-    _value = result.i;
+    return result.i;
 
 #elif defined(TS_MAC) || defined(TS_OPENBSD)
 
     // On OpenBSD and macOS, there is no clock_nanosleep. We use a relative nanosleep.
     // And nanosleep is always based on CLOCK_REALTIME.
-    _value = Time::UnixClockNanoSeconds(CLOCK_REALTIME);
+    return Time::UnixClockNanoSeconds(CLOCK_REALTIME);
 
 #elif defined(TS_UNIX)
 
     // Use clock_nanosleep. We can choose the clock.
     // The most appropriate one here is CLOCK_MONOTONIC.
-    _value = Time::UnixClockNanoSeconds(CLOCK_MONOTONIC);
+    return Time::UnixClockNanoSeconds(CLOCK_MONOTONIC);
 
 #else
     #error "Unimplemented operating system"
@@ -90,13 +95,41 @@ void ts::Monotonic::getSystemTime()
 //----------------------------------------------------------------------------
 
 void ts::Monotonic::wait()
+{
+    sleepUntil(_value);
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until the time of the monotonic clock with a better precision.
+//----------------------------------------------------------------------------
+
+void ts::Monotonic::preciseWait(const NanoSecond& spin) const
+{
+    // Sleep using the system timer until shortly before the due time.
+    const int64_t wakeup = _value - std::max<NanoSecond>(spin, 0) / NS_PER_TICK;
+    if (wakeup < _value && SystemTicks() < wakeup) {
+        sleepUntil(wakeup);
+    }
+
+    // Then actively poll the system clock.
+    while (SystemTicks() < _value) {
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Sleep until a given time in system ticks, using the system timer.
+//----------------------------------------------------------------------------
+
+void ts::Monotonic::sleepUntil(int64_t ticks) const
 {
 #if defined(TS_WINDOWS)
 
     // Windows implementation
 
     ::LARGE_INTEGER due_time;
-    due_time.QuadPart = _value;
+    due_time.QuadPart = ticks;
     if (::SetWaitableTimer(_handle, &due_time, 0, NULL, NULL, false) == 0) {
         throw MonotonicError(::GetLastError());
     }
@@ -111,7 +144,7 @@ void ts::Monotonic::wait()
 
     for (;;) {
         // Number of nanoseconds to wait for.
-        const NanoSecond nano = _value - Time::UnixClockNanoSeconds(CLOCK_REALTIME);
+        const NanoSecond nano = ticks - Time::UnixClockNanoSeconds(CLOCK_REALTIME);
 
         // Exit when due time is over.
         if (nano <= 0) {
@@ -134,8 +167,8 @@ void ts::Monotonic::wait()
 
     // Compute due time.
     ::timespec due;
-    due.tv_sec = time_t(_value / NanoSecPerSec);
-    due.tv_nsec = long(_value % NanoSecPerSec);
+    due.tv_sec = time_t(ticks / NanoSecPerSec);
+    due.tv_nsec = long(ticks % NanoSecPerSec);
 
     // Loop on clock_nanosleep, ignoring signals
     int status;
@@ -134,6 +134,18 @@ namespace ts {
         //!
         void wait();
 
+        //!
+        //! Wait until the time of the monotonic clock with a better precision than wait().
+        //! The system timer is used to sleep until shortly before the due time. Then,
+        //! the clock is actively polled until the due time. The precision is limited by
+        //! the resolution of the system clock, not the system timer. Use with care,
+        //! this method uses CPU during @a spin nanoseconds.
+        //! @param [in] spin Duration in nanoseconds before the due time where the clock
+        //! is actively polled. If zero or negative, the clock is polled during the whole
+        //! wait period.
+        //!
+        void preciseWait(const NanoSecond& spin) const;
+
         //!
         //! This static method requests a minimum resolution, in nano-seconds, for the timers.
         //! @param [in] precision Requested minimum resolution in nano-seconds.
@@ -146,6 +158,12 @@ namespace ts {
         // Monotonic clock value in system ticks
         int64_t _value {0};
 
+        // Get the current system time in system ticks.
+        static int64_t SystemTicks();
+
+        // Sleep until a given time in system ticks, using the system timer.
+        void sleepUntil(int64_t ticks) const;
+
 #if defined(TS_WINDOWS)
         // Timer handle
         ::HANDLE _handle {INVALID_HANDLE_VALUE};
@@ -10,6 +10,7 @@
 #include "tsSysUtils.h"
 #include "tsMemory.h"
 #include "tsCryptoAcceleration.h"
+#include "tsTSPacketAcceleration.h"
 
 #if defined(TS_LINUX)
     #include <sys/auxv.h>
@@ -23,6 +24,11 @@
     #include "tsSysCtl.h"
 #endif
 
+#if defined(TS_X86_64) && (defined(TS_GCC) || defined(TS_LLVM))
+    #include <cpuid.h>
+    #define TS_X86_CPUID 1
+#endif
+
 // Define singleton instance
 TS_DEFINE_SINGLETON(ts::SysInfo);
 
@@ -273,15 +279,37 @@ ts::SysInfo::SysInfo() :
     // Can be globally disabled using environment variables.
     //
     if (GetEnvironment(u"TS_NO_HARDWARE_ACCELERATION").empty()) {
+        #if defined(TS_X86_CPUID)
+            // Intel x86-64: get CPU features from the cpuid instruction.
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+                ecx = 0;
+            }
+            // Extended features, leaf 7, sub-leaf 0.
+            unsigned int eax7 = 0, ebx7 = 0, ecx7 = 0, edx7 = 0;
+            if (__get_cpuid_count(7, 0, &eax7, &ebx7, &ecx7, &edx7) == 0) {
+                ebx7 = 0;
+            }
+            // AVX registers can be used only when the OS saves them on context switch (XMM and YMM state in XCR0).
+            unsigned int xcr0 = 0;
+            if ((ecx & bit_OSXSAVE) != 0) {
+                unsigned int xcr0_high = 0;
+                asm("xgetbv" : "=a" (xcr0), "=d" (xcr0_high) : "c" (0));
+            }
+        #endif
         if (GetEnvironment(u"TS_NO_CRC32_INSTRUCTIONS").empty()) {
-            #if defined(TS_LINUX) && defined(HWCAP_CRC32)
+            #if defined(TS_X86_CPUID)
+                _crcInstructions = tsCRC32IsAccelerated && (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSE4_1) != 0;
+            #elif defined(TS_LINUX) && defined(HWCAP_CRC32)
                 _crcInstructions = tsCRC32IsAccelerated && (::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
             #elif defined(TS_MAC)
                 _crcInstructions = tsCRC32IsAccelerated && SysCtrlBool("hw.optional.armv8_crc32");
             #endif
         }
         if (GetEnvironment(u"TS_NO_AES_INSTRUCTIONS").empty()) {
-            #if defined(TS_LINUX) && defined(HWCAP_AES)
+            #if defined(TS_X86_CPUID)
+                _aesInstructions = tsAESIsAccelerated && (ecx & bit_AES) != 0;
+            #elif defined(TS_LINUX) && defined(HWCAP_AES)
                 _aesInstructions = tsAESIsAccelerated && (::getauxval(AT_HWCAP) & HWCAP_AES) != 0;
             #elif defined(TS_MAC)
                 _aesInstructions = tsAESIsAccelerated && SysCtrlBool("hw.optional.arm.FEAT_AES");
@@ -308,5 +336,10 @@ ts::SysInfo::SysInfo() :
                 _sha512Instructions = tsSHA512IsAccelerated && SysCtrlBool("hw.optional.arm.FEAT_SHA512");
             #endif
         }
+        if (GetEnvironment(u"TS_NO_SIMD_INSTRUCTIONS").empty()) {
+            #if defined(TS_X86_CPUID)
+                _simdInstructions = tsTSPacketIsAccelerated && (ecx & bit_AVX) != 0 && (ebx7 & bit_AVX2) != 0 && (xcr0 & 0x06) == 0x06;
+            #endif
+        }
     }
 }
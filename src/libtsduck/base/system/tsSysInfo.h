@@ -136,6 +136,12 @@ namespace ts {
         //!
         bool sha512Instructions() const { return _sha512Instructions; }
         //!
+        //! Check if the CPU supports the vector instructions which are used on arrays of TS packets.
+        //! On Intel x86-64, these are the AVX2 instructions.
+        //! @return True if the CPU supports the vector instructions for TS packets.
+        //!
+        bool simdInstructions() const { return _simdInstructions; }
+        //!
         //! Get the operating system version.
         //! @return The operating system version.
         //!
@@ -190,6 +196,7 @@ namespace ts {
         bool    _sha1Instructions {false};
         bool    _sha256Instructions {false};
         bool    _sha512Instructions {false};
+        bool    _simdInstructions {false};
         int     _systemMajorVersion {-1};
         UString _systemVersion {};
         UString _systemName {};
@@ -152,6 +152,19 @@ void ts::TextParser::rewind()
 }
 
 
+//----------------------------------------------------------------------------
+// Release the memory of all lines before the current one.
+//----------------------------------------------------------------------------
+
+void ts::TextParser::releaseConsumedLines()
+{
+    // Erasing elements in a list does not invalidate iterators to other elements.
+    if (_pos._lines == &_lines) {
+        _lines.erase(_lines.begin(), _pos._curLine);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Skip all whitespaces.
 //----------------------------------------------------------------------------
@@ -113,6 +113,15 @@ namespace ts {
         //!
         void rewind();
 
+        //!
+        //! Release the memory of all lines before the current one.
+        //! This is useful when a large document is parsed on the fly, when the parser never goes back.
+        //! This is not possible when the document was loaded from an external list of lines.
+        //! Previously saved positions before the current line become invalid.
+        //! After a rewind(), the document starts at the current line.
+        //!
+        void releaseConsumedLines();
+
         //!
         //! A class which describes a position in the document.
         //!
@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsFingerprintSet.h"
+#include "tsIntegerUtils.h"
+
+#if !defined(TS_CXX17)
+constexpr size_t ts::FingerprintSet::DEFAULT_MAX_SIZE;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor and configuration.
+//----------------------------------------------------------------------------
+
+ts::FingerprintSet::FingerprintSet(size_t max_size)
+{
+    setMaxSize(max_size);
+}
+
+void ts::FingerprintSet::setMaxSize(size_t max_size)
+{
+    clear();
+    _gen_size = std::max<size_t>(1, max_size / 2);
+    // Number of slots per table: a power of 2, at least twice the generation size (max load factor 0.5).
+    _bits = BitSize(2 * _gen_size - 1);
+}
+
+void ts::FingerprintSet::clear()
+{
+    for (auto& table : _tables) {
+        table.clear();
+        table.shrink_to_fit();
+    }
+    _count = 0;
+    _current = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Locate the slot of a fingerprint or the empty slot where it should be inserted.
+//----------------------------------------------------------------------------
+
+size_t ts::FingerprintSet::locate(const std::vector<uint64_t>& table, uint64_t fp) const
+{
+    // Fibonacci hashing: the fingerprint may not be uniformly distributed in its low-order bits.
+    const size_t mask = table.size() - 1;
+    size_t index = size_t((fp * 0x9E3779B97F4A7C15) >> (64 - _bits));
+    while (table[index] != 0 && table[index] != fp) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a fingerprint is present in the set.
+//----------------------------------------------------------------------------
+
+bool ts::FingerprintSet::contains(uint64_t fp) const
+{
+    if (fp == 0) {
+        fp = 1;
+    }
+    for (const auto& table : _tables) {
+        if (!table.empty() && table[locate(table, fp)] == fp) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a fingerprint in the set.
+//----------------------------------------------------------------------------
+
+bool ts::FingerprintSet::insert(uint64_t fp)
+{
+    if (fp == 0) {
+        fp = 1;
+    }
+
+    // Allocate the tables on first use.
+    if (_tables[_current].empty()) {
+        _tables[0].resize(size_t(1) << _bits, 0);
+        _tables[1].resize(size_t(1) << _bits, 0);
+    }
+
+    // Already in current generation, nothing to do.
+    std::vector<uint64_t>* table = &_tables[_current];
+    size_t index = locate(*table, fp);
+    if ((*table)[index] == fp) {
+        return false;
+    }
+
+    // If found in previous generation, it will be copied in the current one.
+    const std::vector<uint64_t>& previous(_tables[_current ^ 1]);
+    const bool found = previous[locate(previous, fp)] == fp;
+
+    // When the current generation is full, drop the previous one and start a new one.
+    if (_count >= _gen_size) {
+        _current ^= 1;
+        _count = 0;
+        table = &_tables[_current];
+        std::fill(table->begin(), table->end(), 0);
+        index = locate(*table, fp);
+    }
+
+    (*table)[index] = fp;
+    _count++;
+    return !found;
+}
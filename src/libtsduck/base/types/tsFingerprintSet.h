@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A bounded set of 64-bit fingerprints.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! A bounded set of 64-bit fingerprints with eviction of the oldest ones.
+    //! @ingroup cpp
+    //!
+    //! This class is typically used to detect already seen data in long-running
+    //! processing, using a hash or checksum of the data as fingerprint. Unlike
+    //! std::set or std::unordered_set, the memory is allocated once and does not
+    //! grow. When the maximum number of fingerprints is reached, the oldest ones
+    //! are forgotten.
+    //!
+    //! The fingerprints are stored in two generations of open addressing hash
+    //! tables with linear probing. New fingerprints are inserted in the current
+    //! generation. When it is full, the previous generation is dropped and the
+    //! current one becomes the previous one. A fingerprint which is found again
+    //! in the previous generation is copied into the current one. Therefore,
+    //! only fingerprints which are not seen during a complete generation are
+    //! forgotten.
+    //!
+    //! The value zero cannot be stored as a fingerprint. It is silently
+    //! replaced by the value 1.
+    //!
+    class TSDUCKDLL FingerprintSet
+    {
+    public:
+        //!
+        //! Default maximum number of fingerprints in the set.
+        //!
+        static constexpr size_t DEFAULT_MAX_SIZE = 1024 * 1024;
+
+        //!
+        //! Constructor.
+        //! The memory is allocated on the first insertion.
+        //! @param [in] max_size Maximum number of fingerprints in the set.
+        //! The allocated memory is about 16 bytes per fingerprint.
+        //!
+        explicit FingerprintSet(size_t max_size = DEFAULT_MAX_SIZE);
+
+        //!
+        //! Remove all fingerprints and deallocate the memory.
+        //!
+        void clear();
+
+        //!
+        //! Set a new maximum number of fingerprints.
+        //! All fingerprints are removed.
+        //! @param [in] max_size Maximum number of fingerprints in the set.
+        //!
+        void setMaxSize(size_t max_size);
+
+        //!
+        //! Get the maximum number of fingerprints.
+        //! @return The maximum number of fingerprints in the set.
+        //!
+        size_t maxSize() const { return 2 * _gen_size; }
+
+        //!
+        //! Check if a fingerprint is present in the set.
+        //! @param [in] fp The fingerprint to check.
+        //! @return True if @a fp is present in the set.
+        //!
+        bool contains(uint64_t fp) const;
+
+        //!
+        //! Insert a fingerprint in the set.
+        //! @param [in] fp The fingerprint to insert.
+        //! @return True if @a fp was inserted, false if it was already present.
+        //!
+        bool insert(uint64_t fp);
+
+    private:
+        size_t _gen_size = 0;   // Max number of fingerprints per generation.
+        size_t _bits = 0;       // Number of bits in a slot index.
+        size_t _count = 0;      // Number of fingerprints in current generation.
+        size_t _current = 0;    // Index of current generation in _tables.
+        std::vector<uint64_t> _tables[2] {};  // Hash tables, zero is an empty slot.
+
+        // Locate the slot of a fingerprint or the empty slot where it should be inserted.
+        size_t locate(const std::vector<uint64_t>& table, uint64_t fp) const;
+    };
+}
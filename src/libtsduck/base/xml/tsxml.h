@@ -48,6 +48,7 @@ namespace ts {
         class Document;
         class ModelDocument;
         class PatchDocument;
+        class StreamingDocument;
 
         //!
         //! Vector of constant elements.
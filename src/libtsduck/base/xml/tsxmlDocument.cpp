@@ -11,6 +11,9 @@
 #include "tsxmlDeclaration.h"
 #include "tsxmlComment.h"
 #include "tsxmlUnknown.h"
+#include "tsxmlText.h"
+#include "tsConfigurationCache.h"
+#include "tsMemory.h"
 #include "tsFileUtils.h"
 #include "tsFatal.h"
 
@@ -119,6 +122,11 @@ bool ts::xml::Document::load(const UString& fileName, bool search)
         return false;
     }
 
+    // Use the binary cache of the file when there is one.
+    if (search && !hasChildren() && loadCache(actualFileName)) {
+        return true;
+    }
+
     // Parse the document from the file.
     TextParser parser(report());
     report().debug(u"loading XML file %s", {actualFileName});
@@ -227,6 +235,212 @@ bool ts::xml::Document::save(const UString& fileName, size_t indent)
 }
 
 
+//----------------------------------------------------------------------------
+// Binary cache of an XML file.
+//
+// The document is serialized in preorder. Each node is serialized as:
+//   uint8  type (see below)
+//   uint8  flags (text nodes: bit 0 = CDATA, bit 1 = trimmable)
+//   uint32 line number
+//   string value (element name, text, etc.)
+// Elements add:
+//   uint32 attribute count
+//   attributes: string name, string value
+//   uint32 children count
+//   children nodes
+// The document itself is serialized as a children count and the children nodes.
+// Strings are serialized as a uint32 size followed by UTF-8 bytes.
+// All integers are little endian.
+//----------------------------------------------------------------------------
+
+namespace {
+    enum : uint8_t {
+        CACHE_ELEMENT     = 1,
+        CACHE_TEXT        = 2,
+        CACHE_COMMENT     = 3,
+        CACHE_DECLARATION = 4,
+        CACHE_UNKNOWN     = 5,
+    };
+
+    // Maximum nesting depth of XML elements in a cache.
+    constexpr size_t CACHE_MAX_DEPTH = 256;
+
+    void CacheAppendString(ts::ByteBlock& data, const ts::UString& str)
+    {
+        const size_t pos = data.size();
+        data.appendUInt32LE(0);
+        data.appendUTF8(str);
+        ts::PutUInt32LE(&data[pos], uint32_t(data.size() - pos - 4));
+    }
+
+    bool CacheGetUInt32(const uint8_t*& data, size_t& size, uint32_t& value)
+    {
+        if (size < 4) {
+            return false;
+        }
+        value = ts::GetUInt32LE(data);
+        data += 4;
+        size -= 4;
+        return true;
+    }
+
+    bool CacheGetString(const uint8_t*& data, size_t& size, ts::UString& str)
+    {
+        uint32_t len = 0;
+        if (!CacheGetUInt32(data, size, len) || size < len) {
+            return false;
+        }
+        str.assignFromUTF8(reinterpret_cast<const char*>(data), len);
+        data += len;
+        size -= len;
+        return true;
+    }
+}
+
+void ts::xml::Document::SerializeNode(ByteBlock& data, const Node* node)
+{
+    const Element* elem = dynamic_cast<const Element*>(node);
+    const Text* text = dynamic_cast<const Text*>(node);
+    if (elem != nullptr) {
+        data.appendUInt8(CACHE_ELEMENT);
+        data.appendUInt8(0);
+    }
+    else if (text != nullptr) {
+        data.appendUInt8(CACHE_TEXT);
+        data.appendUInt8((text->isCData() ? 0x01 : 0x00) | (text->isTrimmable() ? 0x02 : 0x00));
+    }
+    else if (dynamic_cast<const Comment*>(node) != nullptr) {
+        data.appendUInt8(CACHE_COMMENT);
+        data.appendUInt8(0);
+    }
+    else if (dynamic_cast<const Declaration*>(node) != nullptr) {
+        data.appendUInt8(CACHE_DECLARATION);
+        data.appendUInt8(0);
+    }
+    else {
+        data.appendUInt8(CACHE_UNKNOWN);
+        data.appendUInt8(0);
+    }
+    data.appendUInt32LE(uint32_t(node->lineNumber()));
+    CacheAppendString(data, node->value());
+
+    if (elem != nullptr) {
+        UStringList names;
+        elem->getAttributesNamesInModificationOrder(names);
+        data.appendUInt32LE(uint32_t(names.size()));
+        for (const auto& name : names) {
+            const Attribute& attr(elem->attribute(name, true));
+            CacheAppendString(data, attr.name());
+            CacheAppendString(data, attr.value());
+        }
+        SerializeChildren(data, elem);
+    }
+}
+
+void ts::xml::Document::SerializeChildren(ByteBlock& data, const Node* node)
+{
+    data.appendUInt32LE(uint32_t(node->childrenCount()));
+    for (const Node* child = node->firstChild(); child != nullptr; child = child->nextSibling()) {
+        SerializeNode(data, child);
+    }
+}
+
+bool ts::xml::Document::deserializeNode(Node* parent, const uint8_t*& data, size_t& size, size_t depth)
+{
+    if (size < 6 || depth > CACHE_MAX_DEPTH) {
+        return false;
+    }
+    const uint8_t type = data[0];
+    const uint8_t flags = data[1];
+    const size_t line = GetUInt32LE(data + 2);
+    data += 6;
+    size -= 6;
+
+    // Create the node with the same characteristics as the XML parser.
+    Node* node = nullptr;
+    Element* elem = nullptr;
+    switch (type) {
+        case CACHE_ELEMENT:
+            node = elem = new Element(report(), line);
+            break;
+        case CACHE_TEXT:
+            node = new Text(report(), line, (flags & 0x01) != 0, (flags & 0x02) != 0);
+            break;
+        case CACHE_COMMENT:
+            node = new Comment(report(), line);
+            break;
+        case CACHE_DECLARATION:
+            node = new Declaration(report(), line);
+            break;
+        case CACHE_UNKNOWN:
+            node = new Unknown(report(), line);
+            break;
+        default:
+            return false;
+    }
+    CheckNonNull(node);
+    node->reparent(parent);
+
+    UString value;
+    if (!CacheGetString(data, size, value)) {
+        return false;
+    }
+    node->setValue(value);
+
+    if (elem != nullptr) {
+        uint32_t count = 0;
+        if (!CacheGetUInt32(data, size, count)) {
+            return false;
+        }
+        UString name;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!CacheGetString(data, size, name) || !CacheGetString(data, size, value)) {
+                return false;
+            }
+            elem->setAttribute(name, value);
+        }
+        if (!CacheGetUInt32(data, size, count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!deserializeNode(elem, data, size, depth + 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ts::xml::Document::loadCache(const UString& fileName)
+{
+    ConfigurationCache cache;
+    if (!cache.open(fileName, ConfigurationCache::Kind::XML, report())) {
+        return false;
+    }
+    const uint8_t* data = cache.data();
+    size_t size = cache.size();
+    uint32_t count = 0;
+    bool ok = CacheGetUInt32(data, size, count);
+    for (uint32_t i = 0; ok && i < count; ++i) {
+        ok = deserializeNode(this, data, size, 0);
+    }
+    if (!ok || size != 0) {
+        report().debug(u"invalid cache content for %s", {fileName});
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool ts::xml::Document::saveCache(const UString& fileName) const
+{
+    ByteBlock data;
+    SerializeChildren(data, this);
+    report().verbose(u"creating cache of %s, %'d bytes", {fileName, data.size()});
+    return ConfigurationCache::Save(fileName, ConfigurationCache::Kind::XML, data, report());
+}
+
+
 //----------------------------------------------------------------------------
 // Convert the document to an XML string.
 //----------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 #include "tsxmlTweaks.h"
 #include "tsReport.h"
 #include "tsStringifyInterface.h"
+#include "tsByteBlock.h"
 
 namespace ts {
     namespace xml {
@@ -63,6 +64,10 @@ namespace ts {
             //! @return True on success, false on error.
             //! @see SearchConfigurationFile()
             //!
+            //! When @a search is true and a valid binary cache of the file is present
+            //! (see ts::ConfigurationCache), the document is loaded from the binary cache
+            //! instead of parsing the XML text.
+            //!
             bool load(const UString& fileName, bool search = true);
 
             //!
@@ -81,6 +86,15 @@ namespace ts {
             //!
             bool save(const UString& fileName, size_t indent = 2);
 
+            //!
+            //! Create the binary cache of an XML file.
+            //! The document shall have been loaded from that file, without modification.
+            //! @param [in] fileName Name of the XML file from which the document was loaded.
+            //! @return True on success, false on error.
+            //! @see ts::ConfigurationCache
+            //!
+            bool saveCache(const UString& fileName) const;
+
             //!
             //! Check if a "file name" is in fact inline XML content instead of a file name.
             //! @param [in] name A file name string.
@@ -145,6 +159,14 @@ namespace ts {
 
         private:
             Tweaks _tweaks {};  // Global XML tweaks for the document.
+
+            // Load the document from the binary cache of an XML file.
+            bool loadCache(const UString& fileName);
+
+            // Serialize / deserialize a node and its children in the binary cache.
+            static void SerializeNode(ByteBlock& data, const Node* node);
+            static void SerializeChildren(ByteBlock& data, const Node* node);
+            bool deserializeNode(Node* parent, const uint8_t*& data, size_t& size, size_t depth);
         };
     }
 }
@@ -874,6 +874,20 @@ void ts::xml::Element::printClose(TextFormatter& output, size_t levels) const
 
 bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
 {
+    // Parse the start tag, then all children, then the end tag.
+    bool closed = false;
+    return parseStartTag(parser, closed) && (closed || (parseChildren(parser) && parseEndTag(parser)));
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the start tag of the element, with all attributes.
+//----------------------------------------------------------------------------
+
+bool ts::xml::Element::parseStartTag(TextParser& parser, bool& closed)
+{
+    closed = false;
+
     // We just read the "<". Skip spaces and read the tag name.
     UString nodeName;
     parser.skipWhiteSpace();
@@ -900,6 +914,7 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
         }
         else if (parser.match(u"/>", true)) {
             // Found end of standalone tag, without children.
+            closed = true;
             return true;
         }
         else if (parser.parseXMLName(attrName)) {
@@ -950,16 +965,19 @@ bool ts::xml::Element::parseNode(TextParser& parser, const Node* parent)
     if (!ok) {
         UString ignored;
         parser.parseText(ignored, u">", true, false);
-        return false;
     }
+    return ok;
+}
 
-    // End of tag, swallow all children.
-    if (!parseChildren(parser)) {
-        return false;
-    }
 
+//----------------------------------------------------------------------------
+// Parse the end tag of the element, after all children.
+//----------------------------------------------------------------------------
+
+bool ts::xml::Element::parseEndTag(TextParser& parser)
+{
     // We now must be at "</tag>".
-    ok = parser.match(u"</", true);
+    bool ok = parser.match(u"</", true);
     if (ok) {
         UString endTag;
         ok = parser.skipWhiteSpace() && parser.parseXMLName(endTag) && parser.skipWhiteSpace() && endTag.similar(value());
@@ -858,9 +858,17 @@ namespace ts {
             virtual bool parseNode(TextParser& parser, const Node* parent) override;
 
         private:
+            friend class StreamingDocument;
             CaseSensitivity _attributeCase {CASE_INSENSITIVE}; // For attribute names.
             AttributeMap _attributes {};
 
+            // Parse the start tag of the element, after the "<", with all attributes.
+            // Set closed to true on a standalone tag "<.../>" which has no children.
+            bool parseStartTag(TextParser& parser, bool& closed);
+
+            // Parse the end tag of the element "</...>", after all children.
+            bool parseEndTag(TextParser& parser);
+
             // Compute the key in the attribute map.
             UString attributeKey(const UString& attributeName) const;
 
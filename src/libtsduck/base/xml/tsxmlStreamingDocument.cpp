@@ -0,0 +1,189 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlStreamingDocument.h"
+#include "tsxmlElement.h"
+#include "tsxmlDeclaration.h"
+#include "tsxmlComment.h"
+#include "tsxmlUnknown.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::StreamingDocument::StreamingDocument(Report& report) :
+    Document(report),
+    _parser(report)
+{
+}
+
+ts::xml::StreamingDocument::~StreamingDocument()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Open the document.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamingDocument::open(const UString& fileName)
+{
+    // Specific case of inline XML content, when the string is not the name of a file but directly an XML content.
+    if (IsInlineXML(fileName)) {
+        return openText(fileName);
+    }
+
+    // Specific case of the standard input.
+    if (fileName.empty() || fileName == u"-") {
+        return open(std::cin);
+    }
+
+    close();
+    report().debug(u"loading XML file %s", {fileName});
+    return _parser.loadFile(fileName) && parseProlog();
+}
+
+bool ts::xml::StreamingDocument::open(std::istream& strm)
+{
+    close();
+    return _parser.loadStream(strm) && parseProlog();
+}
+
+bool ts::xml::StreamingDocument::openText(const UString& text)
+{
+    close();
+    _parser.loadDocument(text);
+    return parseProlog();
+}
+
+
+//----------------------------------------------------------------------------
+// Close the document and release all resources.
+//----------------------------------------------------------------------------
+
+void ts::xml::StreamingDocument::close()
+{
+    _parser.clear();
+    _open_root = _valid = false;
+    clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the document up to the start tag of the root element.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamingDocument::parseProlog()
+{
+    // A document must contain optional declarations, followed by one single element (the root).
+    // Comments and unknown DTD are allowed before the root.
+    Node* node = nullptr;
+    while ((node = identifyNextNode(_parser)) != nullptr) {
+        Element* root = dynamic_cast<Element*>(node);
+        if (root != nullptr) {
+            // Parse the start tag of the root only, the children are parsed later, one by one.
+            bool closed = false;
+            if (!root->parseStartTag(_parser, closed)) {
+                delete root;
+                return false;
+            }
+            root->reparent(this);
+            _valid = true;
+            _open_root = !closed;
+            // On a standalone root element, the document is already complete.
+            return _open_root || parseEpilog();
+        }
+        else if (dynamic_cast<Declaration*>(node) == nullptr && dynamic_cast<Comment*>(node) == nullptr && dynamic_cast<Unknown*>(node) == nullptr) {
+            delete node;
+            break;
+        }
+        else if (node->parseNode(_parser, this)) {
+            node->reparent(this);
+        }
+        else {
+            delete node;
+            return false;
+        }
+    }
+    report().error(u"invalid XML document, no root element found");
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the document after the end tag of the root element.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamingDocument::parseEpilog()
+{
+    // Only comments are allowed after the root element.
+    Node* node = nullptr;
+    while ((node = identifyNextNode(_parser)) != nullptr) {
+        const bool ok = dynamic_cast<Comment*>(node) != nullptr && node->parseNode(_parser, this);
+        if (!ok) {
+            report().error(u"line %d: trailing %s, invalid XML document, need one single root element", {node->lineNumber(), node->typeName()});
+        }
+        delete node;
+        if (!ok) {
+            return _valid = false;
+        }
+    }
+
+    // We must have reached the end of document.
+    if (!_parser.eof()) {
+        report().error(u"line %d: trailing character sequence, invalid XML document", {_parser.lineNumber()});
+        return _valid = false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the next child element of the root element.
+//----------------------------------------------------------------------------
+
+ts::xml::Element* ts::xml::StreamingDocument::nextElement()
+{
+    Element* root = rootElement();
+    if (!_open_root || root == nullptr) {
+        return nullptr;
+    }
+
+    // Delete previous children and the text which was used to parse them.
+    Node* child = nullptr;
+    while ((child = root->firstChild()) != nullptr) {
+        // Deallocating the node forces the removal from the document through the destructor.
+        delete child;
+    }
+    _parser.releaseConsumedLines();
+
+    // Parse nodes until the next element. Comments and texts are ignored.
+    Node* node = nullptr;
+    while ((node = root->identifyNextNode(_parser)) != nullptr) {
+        if (!node->parseNode(_parser, root)) {
+            // Error, we expect the child's parser to have displayed the error message.
+            // There is no way to reliably resynchronize on the next element.
+            delete node;
+            _open_root = _valid = false;
+            return nullptr;
+        }
+        Element* elem = dynamic_cast<Element*>(node);
+        if (elem != nullptr) {
+            elem->reparent(root);
+            return elem;
+        }
+        delete node;
+    }
+
+    // No more children, we must be at the end tag of the root.
+    _open_root = false;
+    _valid = root->parseEndTag(_parser) && parseEpilog();
+    return nullptr;
+}
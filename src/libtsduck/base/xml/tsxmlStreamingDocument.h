@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  XML document which is parsed on the fly, one element at a time.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlDocument.h"
+#include "tsTextParser.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Representation of an XML document which is parsed on the fly, one element at a time.
+        //! @ingroup xml
+        //!
+        //! This is the input counterpart of RunningDocument. It is designed for large documents
+        //! which are made of a long list of independent elements under the root element, such
+        //! as section files or EPG files.
+        //!
+        //! When the document is open, the declarations and the start tag of the root element are
+        //! parsed. The root element is present in the document, with its attributes but without
+        //! children. Then, each call to nextElement() parses one complete child element of the
+        //! root and inserts it as the only child of the root. The previous child element is
+        //! deleted. The text of the input document is released as it is parsed.
+        //!
+        //! Comments and texts directly under the root element are ignored.
+        //!
+        class TSDUCKDLL StreamingDocument: public Document
+        {
+            TS_NOCOPY(StreamingDocument);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] report Where to report errors.
+            //!
+            explicit StreamingDocument(Report& report = NULLREP);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~StreamingDocument() override;
+
+            //!
+            //! Open an XML file and parse the document up to the start tag of the root element.
+            //! @param [in] fileName Name of the XML file to load.
+            //! If @a fileName is empty or "-", read the standard input.
+            //! If @a fileName starts with "<?xml", this is considered as "inline XML content".
+            //! @return True on success, false on error.
+            //!
+            bool open(const UString& fileName);
+
+            //!
+            //! Open an XML text stream and parse the document up to the start tag of the root element.
+            //! @param [in,out] strm A standard text stream in input mode.
+            //! @return True on success, false on error.
+            //!
+            bool open(std::istream& strm);
+
+            //!
+            //! Open an XML content and parse the document up to the start tag of the root element.
+            //! @param [in] text The XML document.
+            //! @return True on success, false on error.
+            //!
+            bool openText(const UString& text);
+
+            //!
+            //! Parse the next child element of the root element.
+            //! The previous child element, if any, is deleted.
+            //! @return Address of the next child element of the root or a null pointer at the end
+            //! of the document or on error. The returned element is owned by the document and is
+            //! valid until the next call to nextElement() or close().
+            //! @see isValid()
+            //!
+            Element* nextElement();
+
+            //!
+            //! Check if the document was correctly parsed so far.
+            //! After the last call to nextElement(), this indicates if the complete document was valid.
+            //! @return True if no error was found so far.
+            //!
+            bool isValid() const { return _valid; }
+
+            //!
+            //! Close the document and release all resources.
+            //!
+            void close();
+
+        private:
+            TextParser _parser;              // Parser of the document text.
+            bool       _open_root = false;   // The root element has more children to parse.
+            bool       _valid = false;       // No error so far.
+
+            // Parse the document from the loaded text, up to the start tag of the root element.
+            bool parseProlog();
+
+            // Parse the document after the end tag of the root element.
+            bool parseEpilog();
+        };
+    }
+}
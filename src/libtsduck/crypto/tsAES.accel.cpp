@@ -18,6 +18,7 @@
 
 #include "tsAES.h"
 #include "tsByteSwap.h"
+#include "tsMemory.h"
 #include "tsCryptoAcceleration.h"
 
 // Check if Arm-64 AES instructions can be used in asm() directives and intrinsics.
@@ -25,6 +26,11 @@
     #define TS_ARM_AES_INSTRUCTIONS 1
 #endif
 
+// Check if Intel AES-NI instructions can be used in intrinsics.
+#if defined(TS_X86_64) && defined(__AES__) && !defined(TS_NO_X86_AES_INSTRUCTIONS)
+    #define TS_X86_AES_INSTRUCTIONS 1
+#endif
+
 #if defined(TS_ARM_AES_INSTRUCTIONS)
 #include <arm_neon.h>
 class ts::AES::Acceleration
@@ -33,11 +39,19 @@ public:
     uint8x16_t eK[15];  // Scheduled encryption keys in SIMD register format.
     uint8x16_t dK[15];  // Scheduled decryption keys in SIMD register format.
 };
+#elif defined(TS_X86_AES_INSTRUCTIONS)
+#include <immintrin.h>
+class ts::AES::Acceleration
+{
+public:
+    __m128i eK[15];  // Scheduled encryption keys in SIMD register format.
+    __m128i dK[15];  // Scheduled decryption keys in SIMD register format.
+};
 #endif
 
 // "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
 extern const bool tsAESIsAccelerated =
-#if defined(TS_ARM_AES_INSTRUCTIONS)
+#if defined(TS_ARM_AES_INSTRUCTIONS) || defined(TS_X86_AES_INSTRUCTIONS)
     true;
 #else
     false;
@@ -53,7 +67,7 @@ TS_LLVM_NOWARNING(missing-noreturn)
 
 ts::AES::Acceleration* ts::AES::newAccel()
 {
-#if defined(TS_ARM_AES_INSTRUCTIONS)
+#if defined(TS_ARM_AES_INSTRUCTIONS) || defined(TS_X86_AES_INSTRUCTIONS)
     return new Acceleration;
 #else
     // Shall not be called.
@@ -64,7 +78,7 @@ ts::AES::Acceleration* ts::AES::newAccel()
 
 void ts::AES::deleteAccel(Acceleration* accel)
 {
-#if defined(TS_ARM_AES_INSTRUCTIONS)
+#if defined(TS_ARM_AES_INSTRUCTIONS) || defined(TS_X86_AES_INSTRUCTIONS)
     delete accel;
 #else
     // Shall not be called.
@@ -97,6 +111,20 @@ void ts::AES::setKeyAccel()
         accel.eK[i] = vld1q_u8(ek + 16 * i);
         accel.dK[i] = vld1q_u8(dk + 16 * i);
     }
+#elif defined(TS_X86_AES_INSTRUCTIONS)
+    // The scheduled keys are the same as used by AES-NI instructions, including the "equivalent
+    // inverse cipher" for decryption, but stored as big-endian 32-bit words. Serialize them in
+    // byte order before loading the SIMD registers. Keep the portable scheduled keys unmodified.
+    Acceleration& accel(*_accel);
+    uint8_t ek[16], dk[16];
+    for (int i = 0; i <= _nrounds; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            PutUInt32(ek + 4 * j, _eK[4 * i + j]);
+            PutUInt32(dk + 4 * j, _dK[4 * i + j]);
+        }
+        accel.eK[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ek));
+        accel.dK[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dk));
+    }
 #else
     // Shall not be called.
     assert(false);
@@ -141,6 +169,8 @@ void ts::AES::encryptAccel(const uint8_t* pt, uint8_t* ct)
         }
     }
     vst1q_u8(ct, blk);
+#elif defined(TS_X86_AES_INSTRUCTIONS)
+    encryptBlocksAccel(pt, ct, 1);
 #else
     // Shall not be called.
     assert(false);
@@ -185,6 +215,109 @@ void ts::AES::decryptAccel(const uint8_t* ct, uint8_t* pt)
         }
     }
     vst1q_u8(pt, blk);
+#elif defined(TS_X86_AES_INSTRUCTIONS)
+    decryptBlocksAccel(ct, pt, 1);
+#else
+    // Shall not be called.
+    assert(false);
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Accelerated encryption and decryption of several blocks in ECB mode.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_AES_INSTRUCTIONS)
+namespace {
+    // Number of blocks which are processed in parallel. The AES-NI instructions
+    // are pipelined, processing independent blocks hides their latency.
+    constexpr size_t PARALLEL_BLOCKS = 4;
+
+    // Cast helpers for unaligned load and store.
+    inline __m128i load(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void store(uint8_t* p, __m128i x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+}
+#endif
+
+void ts::AES::encryptBlocksAccel(const uint8_t* pt, uint8_t* ct, size_t count)
+{
+#if defined(TS_X86_AES_INSTRUCTIONS)
+    const __m128i* const k = _accel->eK;
+    const int nr = _nrounds;
+    while (count >= PARALLEL_BLOCKS) {
+        __m128i b0 = _mm_xor_si128(load(pt), k[0]);
+        __m128i b1 = _mm_xor_si128(load(pt + 16), k[0]);
+        __m128i b2 = _mm_xor_si128(load(pt + 32), k[0]);
+        __m128i b3 = _mm_xor_si128(load(pt + 48), k[0]);
+        for (int r = 1; r < nr; ++r) {
+            b0 = _mm_aesenc_si128(b0, k[r]);
+            b1 = _mm_aesenc_si128(b1, k[r]);
+            b2 = _mm_aesenc_si128(b2, k[r]);
+            b3 = _mm_aesenc_si128(b3, k[r]);
+        }
+        store(ct, _mm_aesenclast_si128(b0, k[nr]));
+        store(ct + 16, _mm_aesenclast_si128(b1, k[nr]));
+        store(ct + 32, _mm_aesenclast_si128(b2, k[nr]));
+        store(ct + 48, _mm_aesenclast_si128(b3, k[nr]));
+        pt += PARALLEL_BLOCKS * BLOCK_SIZE;
+        ct += PARALLEL_BLOCKS * BLOCK_SIZE;
+        count -= PARALLEL_BLOCKS;
+    }
+    for (; count > 0; --count, pt += BLOCK_SIZE, ct += BLOCK_SIZE) {
+        __m128i b = _mm_xor_si128(load(pt), k[0]);
+        for (int r = 1; r < nr; ++r) {
+            b = _mm_aesenc_si128(b, k[r]);
+        }
+        store(ct, _mm_aesenclast_si128(b, k[nr]));
+    }
+#elif defined(TS_ARM_AES_INSTRUCTIONS)
+    // One block at a time, the blocks can be encrypted in place.
+    for (; count > 0; --count, pt += BLOCK_SIZE, ct += BLOCK_SIZE) {
+        encryptAccel(pt, ct);
+    }
+#else
+    // Shall not be called.
+    assert(false);
+#endif
+}
+
+void ts::AES::decryptBlocksAccel(const uint8_t* ct, uint8_t* pt, size_t count)
+{
+#if defined(TS_X86_AES_INSTRUCTIONS)
+    const __m128i* const k = _accel->dK;
+    const int nr = _nrounds;
+    while (count >= PARALLEL_BLOCKS) {
+        __m128i b0 = _mm_xor_si128(load(ct), k[0]);
+        __m128i b1 = _mm_xor_si128(load(ct + 16), k[0]);
+        __m128i b2 = _mm_xor_si128(load(ct + 32), k[0]);
+        __m128i b3 = _mm_xor_si128(load(ct + 48), k[0]);
+        for (int r = 1; r < nr; ++r) {
+            b0 = _mm_aesdec_si128(b0, k[r]);
+            b1 = _mm_aesdec_si128(b1, k[r]);
+            b2 = _mm_aesdec_si128(b2, k[r]);
+            b3 = _mm_aesdec_si128(b3, k[r]);
+        }
+        store(pt, _mm_aesdeclast_si128(b0, k[nr]));
+        store(pt + 16, _mm_aesdeclast_si128(b1, k[nr]));
+        store(pt + 32, _mm_aesdeclast_si128(b2, k[nr]));
+        store(pt + 48, _mm_aesdeclast_si128(b3, k[nr]));
+        ct += PARALLEL_BLOCKS * BLOCK_SIZE;
+        pt += PARALLEL_BLOCKS * BLOCK_SIZE;
+        count -= PARALLEL_BLOCKS;
+    }
+    for (; count > 0; --count, ct += BLOCK_SIZE, pt += BLOCK_SIZE) {
+        __m128i b = _mm_xor_si128(load(ct), k[0]);
+        for (int r = 1; r < nr; ++r) {
+            b = _mm_aesdec_si128(b, k[r]);
+        }
+        store(pt, _mm_aesdeclast_si128(b, k[nr]));
+    }
+#elif defined(TS_ARM_AES_INSTRUCTIONS)
+    // One block at a time, the blocks can be decrypted in place.
+    for (; count > 0; --count, ct += BLOCK_SIZE, pt += BLOCK_SIZE) {
+        decryptAccel(ct, pt);
+    }
 #else
     // Shall not be called.
     assert(false);
@@ -998,3 +998,44 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
     }
     return true;
 }
+
+
+//----------------------------------------------------------------------------
+// Encryption and decryption of several blocks in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::AES::encryptBlocksImpl(const void* plain, void* cipher, size_t count)
+{
+    const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
+    uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
+
+    if (_accel_supported) {
+        // Accelerated instructions can process several blocks in parallel.
+        encryptBlocksAccel(pt, ct, count);
+    }
+    else {
+        // The portable implementation can encrypt in place.
+        for (; count > 0; --count, pt += BLOCK_SIZE, ct += BLOCK_SIZE) {
+            encryptImpl(pt, BLOCK_SIZE, ct, BLOCK_SIZE, nullptr);
+        }
+    }
+    return true;
+}
+
+bool ts::AES::decryptBlocksImpl(const void* cipher, void* plain, size_t count)
+{
+    const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
+    uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
+
+    if (_accel_supported) {
+        // Accelerated instructions can process several blocks in parallel.
+        decryptBlocksAccel(ct, pt, count);
+    }
+    else {
+        // The portable implementation can decrypt in place.
+        for (; count > 0; --count, ct += BLOCK_SIZE, pt += BLOCK_SIZE) {
+            decryptImpl(ct, BLOCK_SIZE, pt, BLOCK_SIZE, nullptr);
+        }
+    }
+    return true;
+}
@@ -47,7 +47,7 @@ bool ts::BlockCipher::setKey(const void* key, size_t key_length, size_t rounds)
 // Check if encryption or decryption is allowed. Increment counters.
 //----------------------------------------------------------------------------
 
-bool ts::BlockCipher::allowEncrypt()
+bool ts::BlockCipher::allowEncrypt(size_t count)
 {
     // Check that a key was successfully set.
     if (!_key_set) {
@@ -55,7 +55,7 @@ bool ts::BlockCipher::allowEncrypt()
     }
 
     // Check encryption limitations.
-    if (_key_encrypt_count >= _key_encrypt_max &&
+    if ((_key_encrypt_count >= _key_encrypt_max || count > _key_encrypt_max - _key_encrypt_count) &&
         (_alert == nullptr || _alert->handleBlockCipherAlert(*this, BlockCipherAlertInterface::ENCRYPTION_EXCEEDED)))
     {
         // Disallow encryption if no handler present or handler did not cancel the alert.
@@ -69,11 +69,11 @@ bool ts::BlockCipher::allowEncrypt()
     }
 
     // Encryption allowed.
-    _key_encrypt_count++;
+    _key_encrypt_count += count;
     return true;
 }
 
-bool ts::BlockCipher::allowDecrypt()
+bool ts::BlockCipher::allowDecrypt(size_t count)
 {
     // Check that a key was successfully set.
     if (!_key_set) {
@@ -81,7 +81,7 @@ bool ts::BlockCipher::allowDecrypt()
     }
 
     // Check decryption limitations.
-    if (_key_decrypt_count >= _key_decrypt_max &&
+    if ((_key_decrypt_count >= _key_decrypt_max || count > _key_decrypt_max - _key_decrypt_count) &&
         (_alert == nullptr || _alert->handleBlockCipherAlert(*this, BlockCipherAlertInterface::DECRYPTION_EXCEEDED)))
     {
         // Disallow decryption if no handler present or handler did not cancel the alert.
@@ -95,7 +95,7 @@ bool ts::BlockCipher::allowDecrypt()
     }
 
     // Decryption allowed.
-    _key_decrypt_count++;
+    _key_decrypt_count += count;
     return true;
 }
 
@@ -152,3 +152,47 @@ bool ts::BlockCipher::decryptInPlaceImpl(void* data, size_t data_length, size_t*
     const size_t plain_max_size = max_actual_length != nullptr ? *max_actual_length : data_length;
     return decryptImpl(cipher.data(), cipher.size(), data, plain_max_size, max_actual_length);
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt several contiguous blocks of data in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::encryptBlocks(const void* plain, void* cipher, size_t count)
+{
+    return count == 0 || (allowEncrypt(count) && encryptBlocksImpl(plain, cipher, count));
+}
+
+bool ts::BlockCipher::encryptBlocksImpl(const void* plain, void* cipher, size_t count)
+{
+    const size_t bsize = blockSize();
+    const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
+    uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
+    bool ok = true;
+    for (; ok && count > 0; --count, pt += bsize, ct += bsize) {
+        ok = pt == ct ? encryptInPlaceImpl(ct, bsize, nullptr) : encryptImpl(pt, bsize, ct, bsize, nullptr);
+    }
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several contiguous blocks of data in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::decryptBlocks(const void* cipher, void* plain, size_t count)
+{
+    return count == 0 || (allowDecrypt(count) && decryptBlocksImpl(cipher, plain, count));
+}
+
+bool ts::BlockCipher::decryptBlocksImpl(const void* cipher, void* plain, size_t count)
+{
+    const size_t bsize = blockSize();
+    const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
+    uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
+    bool ok = true;
+    for (; ok && count > 0; --count, ct += bsize, pt += bsize) {
+        ok = pt == ct ? decryptInPlaceImpl(pt, bsize, nullptr) : decryptImpl(ct, bsize, pt, bsize, nullptr);
+    }
+    return ok;
+}
@@ -168,6 +168,38 @@ namespace ts {
         //!
         bool decryptInPlace(void* data, size_t data_length, size_t* max_actual_length = nullptr);
 
+        //!
+        //! Encrypt several contiguous blocks of data in ECB mode.
+        //!
+        //! This method is meaningful for pure block ciphers such as AES or DES only.
+        //! Some implementations process several blocks in parallel, making this method
+        //! faster than encrypting the blocks one by one. Each block counts as one
+        //! encryption in the key usage limitation.
+        //!
+        //! @param [in] plain Address of plain text, @a count blocks of blockSize() bytes.
+        //! @param [out] cipher Address of buffer for cipher text, @a count blocks of blockSize() bytes.
+        //! Can be the same as @a plain (encryption in place) but the two areas must not partially overlap.
+        //! @param [in] count Number of blocks to encrypt.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBlocks(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several contiguous blocks of data in ECB mode.
+        //!
+        //! This method is meaningful for pure block ciphers such as AES or DES only.
+        //! Some implementations process several blocks in parallel, making this method
+        //! faster than decrypting the blocks one by one. Each block counts as one
+        //! decryption in the key usage limitation.
+        //!
+        //! @param [in] cipher Address of cipher text, @a count blocks of blockSize() bytes.
+        //! @param [out] plain Address of buffer for plain text, @a count blocks of blockSize() bytes.
+        //! Can be the same as @a cipher (decryption in place) but the two areas must not partially overlap.
+        //! @param [in] count Number of blocks to decrypt.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBlocks(const void* cipher, void* plain, size_t count);
+
         //!
         //! Get the number of times the current key was used for encryption.
         //! @return The number of times the current key was used for encryption.
@@ -293,6 +325,44 @@ namespace ts {
         //!
         virtual bool decryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length);
 
+        //!
+        //! Encrypt several contiguous blocks of data in ECB mode (implementation of algorithm-specific part).
+        //! The default implementation is to call encryptImpl() or encryptInPlaceImpl() on each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] plain Address of plain text, @a count blocks of blockSize() bytes.
+        //! @param [out] cipher Address of buffer for cipher text, same as @a plain or not overlapping.
+        //! @param [in] count Number of blocks to encrypt.
+        //! @return True on success, false on error.
+        //!
+        virtual bool encryptBlocksImpl(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several contiguous blocks of data in ECB mode (implementation of algorithm-specific part).
+        //! The default implementation is to call decryptImpl() or decryptInPlaceImpl() on each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] cipher Address of cipher text, @a count blocks of blockSize() bytes.
+        //! @param [out] plain Address of buffer for plain text, same as @a cipher or not overlapping.
+        //! @param [in] count Number of blocks to decrypt.
+        //! @return True on success, false on error.
+        //!
+        virtual bool decryptBlocksImpl(const void* cipher, void* plain, size_t count);
+
+        //!
+        //! Check if encryption of a number of messages is allowed by the key usage limitation.
+        //! This method is used by subclasses which provide their own multi-message entry points.
+        //! @param [in] count Number of messages to encrypt.
+        //! @return True if the encryption is allowed. In that case, the encryption counter is incremented.
+        //!
+        bool allowEncrypt(size_t count = 1);
+
+        //!
+        //! Check if decryption of a number of messages is allowed by the key usage limitation.
+        //! This method is used by subclasses which provide their own multi-message entry points.
+        //! @param [in] count Number of messages to decrypt.
+        //! @return True if the decryption is allowed. In that case, the decryption counter is incremented.
+        //!
+        bool allowDecrypt(size_t count = 1);
+
     private:
         bool      _key_set {false};                   // Current key successfully set.
         int       _cipher_id {0};                     // Cipher identity (from application).
@@ -302,9 +372,5 @@ namespace ts {
         size_t    _key_decrypt_max {UNLIMITED};       // Maximum number of times a key should be used for decryption.
         ByteBlock _current_key{};                     // Current unscheduled key.
         BlockCipherAlertInterface* _alert {nullptr};  // Alert handler.
-
-        // Check if encryption or decryption is allowed. Increment counters.
-        bool allowEncrypt();
-        bool allowDecrypt();
     };
 }
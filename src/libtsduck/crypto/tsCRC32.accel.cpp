@@ -22,9 +22,15 @@
     #define TS_ARM_CRC32_INSTRUCTIONS 1
 #endif
 
+// Check if Intel carry-less multiplication instructions can be used in intrinsics.
+#if defined(TS_X86_64) && defined(__PCLMUL__) && defined(__SSE4_1__) && !defined(TS_NO_X86_CRC32_INSTRUCTIONS)
+    #define TS_X86_CRC32_INSTRUCTIONS 1
+    #include <immintrin.h>
+#endif
+
 // "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
 extern const bool tsCRC32IsAccelerated =
-#if defined(TS_ARM_CRC32_INSTRUCTIONS)
+#if defined(TS_ARM_CRC32_INSTRUCTIONS) || defined(TS_X86_CRC32_INSTRUCTIONS)
     true;
 #else
     false;
@@ -45,6 +51,9 @@ uint32_t ts::CRC32::valueAccel() const
     uint32_t x;
     asm("rbit %w0, %w1" : "=r" (x) : "r" (_fcs));
     return x;
+#elif defined(TS_X86_CRC32_INSTRUCTIONS)
+    // With carry-less multiplication, the CRC32 register is kept in normal order.
+    return _fcs;
 #else
     // Shall not be called.
     assert(false);
@@ -88,6 +97,39 @@ namespace {
 #endif
 
 
+//----------------------------------------------------------------------------
+// Basic operations for the Intel carry-less multiplication instructions.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_CRC32_INSTRUCTIONS)
+namespace {
+
+    // See "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction",
+    // Intel white paper, 2009. The MPEG-2 CRC32 is not bit-reflected. Each block of
+    // 16 bytes is loaded in a 128-bit register in big-endian order so that the first
+    // bit of the block is the most significant coefficient of a 128-bit polynomial.
+    // The polynomial in an accumulator is "folded" over the next blocks: if A is the
+    // accumulator, made of two 64-bit halves H and L, then A.x^n = H.x^(n+64) + L.x^n
+    // and the two products are computed modulo P, the CRC32 generator polynomial,
+    // using pre-computed 32-bit constants x^(n+64) mod P and x^n mod P.
+    // The final reduction of the 128-bit accumulator is done using the portable
+    // implementation.
+
+    // Load 16 bytes from memory, in big-endian order, using a byte-reversal shuffle mask.
+    inline __m128i load128(const uint8_t* p, __m128i byteswap)
+    {
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), byteswap);
+    }
+
+    // Fold an accumulator using a pair of constants and add the next data block.
+    inline __m128i fold(__m128i acc, __m128i constants, __m128i data)
+    {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, constants, 0x11), _mm_clmulepi64_si128(acc, constants, 0x00)), data);
+    }
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Continue the computation of a data area, following a previous CRC32.
 //----------------------------------------------------------------------------
@@ -133,6 +175,61 @@ void ts::CRC32::addAccel(const void* data, size_t size)
     while (size--) {
         crcAdd8(_fcs, *cp8++);
     }
+#elif defined(TS_X86_CRC32_INSTRUCTIONS)
+    // Small areas are not worth the setup of the accumulators.
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    if (size < 32) {
+        addPortable(cp, size);
+        return;
+    }
+
+    // Folding constants over 4x128 bits: x^(4*128+64) mod P (high), x^(4*128) mod P (low).
+    // Folding constants over 128 bits: x^(128+64) mod P (high), x^128 mod P (low).
+    // These are local variables, not static ones, to make sure that no optional instruction
+    // is executed during the initialization of the library, on CPU's which don't support them.
+    const __m128i fold512 = _mm_set_epi64x(0x8833794C, 0xE6228B11);
+    const __m128i fold128 = _mm_set_epi64x(0xC5B9CD4C, 0xE8A45605);
+    const __m128i byteswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // The previous value of the CRC32 register is added to the first 32 bits of the data.
+    __m128i acc = _mm_xor_si128(load128(cp, byteswap), _mm_set_epi32(int(_fcs), 0, 0, 0));
+    cp += 16;
+    size -= 16;
+
+    if (size >= 112) {
+        // Use 4 independent accumulators over 64-byte chunks.
+        __m128i acc1 = load128(cp, byteswap);
+        __m128i acc2 = load128(cp + 16, byteswap);
+        __m128i acc3 = load128(cp + 32, byteswap);
+        cp += 48;
+        size -= 48;
+        while (size >= 64) {
+            acc  = fold(acc,  fold512, load128(cp, byteswap));
+            acc1 = fold(acc1, fold512, load128(cp + 16, byteswap));
+            acc2 = fold(acc2, fold512, load128(cp + 32, byteswap));
+            acc3 = fold(acc3, fold512, load128(cp + 48, byteswap));
+            cp += 64;
+            size -= 64;
+        }
+        // Merge the 4 accumulators into one.
+        acc = fold(acc, fold128, acc1);
+        acc = fold(acc, fold128, acc2);
+        acc = fold(acc, fold128, acc3);
+    }
+
+    // Fold the remaining 16-byte blocks.
+    while (size >= 16) {
+        acc = fold(acc, fold128, load128(cp, byteswap));
+        cp += 16;
+        size -= 16;
+    }
+
+    // Final reduction of the 128-bit accumulator, then add remaining bytes.
+    uint8_t last[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(last), _mm_shuffle_epi8(acc, byteswap));
+    _fcs = 0;
+    addPortable(last, sizeof(last));
+    addPortable(cp, size);
 #else
     // Shall not be called.
     assert(false);
@@ -127,10 +127,15 @@ void ts::CRC32::add(const void* data, size_t size)
         addAccel(data, size);
     }
     else {
-        // Portable implementation, using the pre-computed table.
-        const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
-        while (size-- > 0) {
-            _fcs = (_fcs << 8) ^ _fcstab_32[((_fcs >> 24) ^ (*cp++)) & 0xFF];
-        }
+        addPortable(data, size);
+    }
+}
+
+void ts::CRC32::addPortable(const void* data, size_t size)
+{
+    // Portable implementation, using the pre-computed table.
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    while (size-- > 0) {
+        _fcs = (_fcs << 8) ^ _fcstab_32[((_fcs >> 24) ^ (*cp++)) & 0xFF];
     }
 }
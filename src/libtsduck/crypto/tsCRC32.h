@@ -90,6 +90,9 @@ namespace ts {
         static volatile bool _accel_checked;
         static volatile bool _accel_supported;
 
+        // Portable version, using a pre-computed table.
+        void addPortable(const void* data, size_t size);
+
         // Accelerated versions, compiled in a separated module.
         uint32_t valueAccel() const;
         void addAccel(const void* data, size_t size);
@@ -67,9 +67,10 @@ namespace ts {
     private:
         size_t _counter_bits; // size in bits of the counter part.
 
-        // We need two work blocks.
+        // We need at least two work blocks.
         // The first one contains the "input block" or counter.
-        // The second one contains the "output block", the encrypted counter.
+        // The next ones contain the "output blocks", successive encrypted counters.
+        // Several output blocks are encrypted at once when the message is large enough.
         // This private method increments the counter block.
         bool incrementCounter();
     };
@@ -82,7 +83,7 @@ namespace ts {
 
 template<class CIPHER>
 ts::CTR<CIPHER>::CTR(size_t counter_bits) :
-    CipherChainingTemplate<CIPHER>(1, 1, 2),
+    CipherChainingTemplate<CIPHER>(1, 1, 9),
     _counter_bits(0)
 {
     setCounterBits(counter_bits);
@@ -173,27 +174,33 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     // work[0] = iv
     ::memcpy(this->work.data(), this->iv.data(), this->block_size);
 
-    // Loop on all blocks, including last truncated one.
+    // Number of output blocks in the work buffer.
+    const size_t max_blocks = this->work.size() / this->block_size - 1;
+    uint8_t* const out = this->work.data() + this->block_size;
 
+    // Loop on all groups of blocks, including last truncated one.
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
-
     while (plain_length > 0) {
-        // work[1] = encrypt(work[0])
-        if (!this->algo->encrypt(this->work.data(), this->block_size, this->work.data() + this->block_size, this->block_size)) {
+        // work[1..n] = successive values of work[0], work[0] += n
+        const size_t blocks = std::min(max_blocks, (plain_length + this->block_size - 1) / this->block_size);
+        for (size_t b = 0; b < blocks; ++b) {
+            ::memcpy(out + b * this->block_size, this->work.data(), this->block_size);
+            if (!incrementCounter()) {
+                return false;
+            }
+        }
+        // work[1..n] = encrypt(work[1..n])
+        if (!this->algo->encryptBlocks(out, out, blocks)) {
             return false;
         }
-        // This block size:
-        const size_t size = std::min(plain_length, this->block_size);
-        // cipher-text = plain-text XOR work[1]
+        // This group size:
+        const size_t size = std::min(plain_length, blocks * this->block_size);
+        // cipher-text = plain-text XOR work[1..n]
         for (size_t i = 0; i < size; ++i) {
-            ct[i] = this->work[this->block_size + i] ^ pt[i];
-        }
-        // work[0] += 1
-        if (!incrementCounter()) {
-            return false;
+            ct[i] = out[i] ^ pt[i];
         }
-        // advance one block
+        // advance n blocks
         ct += size;
         pt += size;
         plain_length -= size;
@@ -10,6 +10,11 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsMemory.h"
+
+#if defined(TS_X86_64)
+    #include <emmintrin.h>
+#endif
 
 // Operations on 64-bit areas.
 
@@ -580,6 +585,9 @@ bool ts::DVBCSA2::setKeyImpl(const void* key, size_t key_length, size_t rounds)
 
     // Block cipher key schedule
     _block.init(_key);
+    for (size_t i = 1; i <= 56; ++i) {
+        _batch_kk[i] = uint64_t(_block.roundKey(i) & 0xFF) * 0x0101010101010101;
+    }
 
     // Stream cipher initialization
     _stream.init(_key);
@@ -714,6 +722,560 @@ bool ts::DVBCSA2::decryptInPlaceImpl(void* addr, size_t size, size_t* max_actual
 }
 
 
+//----------------------------------------------------------------------------
+// Batch processing: bitsliced implementation of DVB-CSA2.
+//
+// In a batch, all packets use the same control word. The stream cipher is
+// "bitsliced": each bit of the stream cipher state is stored in a word where
+// bit N belongs to packet N. Each S-box lookup or register operation is then
+// applied to all packets at once using bitwise operations only. The block
+// cipher is "bytesliced": each byte of the block cipher state is stored in a
+// 64-bit word where byte N belongs to packet N, processing 8 packets at once.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_64)
+    const size_t ts::DVBCSA2::BATCH_LANES = 128;
+#else
+    const size_t ts::DVBCSA2::BATCH_LANES = 64;
+#endif
+
+namespace {
+
+    // Minimum number of packets to use the bitsliced stream cipher. Because all
+    // bits are processed in parallel, the cost of the bitsliced stream cipher is
+    // the same for one packet or 64 packets. Below this threshold, it is faster
+    // to process packets one by one.
+    constexpr size_t BATCH_MIN_LANES = 4;
+
+    // Portable bitslice word: 64 packets in parallel.
+    struct Word64
+    {
+        uint64_t v;
+        static constexpr size_t SLICES = 1;  // Number of 64-bit slices in the word.
+        static Word64 zero() { return Word64{0}; }
+        static Word64 ones() { return Word64{~uint64_t(0)}; }
+        static Word64 load(const uint64_t* s) { return Word64{s[0]}; }
+        void store(uint64_t* s) const { s[0] = v; }
+    };
+    inline Word64 operator^(Word64 a, Word64 b) { return Word64{a.v ^ b.v}; }
+    inline Word64 operator&(Word64 a, Word64 b) { return Word64{a.v & b.v}; }
+    inline Word64 operator|(Word64 a, Word64 b) { return Word64{a.v | b.v}; }
+
+#if defined(TS_X86_64)
+    // SSE2 bitslice word: 128 packets in parallel. SSE2 is always present on x86-64.
+    struct Word128
+    {
+        __m128i v;
+        static constexpr size_t SLICES = 2;
+        static Word128 zero() { return Word128{_mm_setzero_si128()}; }
+        static Word128 ones() { return Word128{_mm_set1_epi32(-1)}; }
+        static Word128 load(const uint64_t* s) { return Word128{_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))}; }
+        void store(uint64_t* s) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(s), v); }
+    };
+    inline Word128 operator^(Word128 a, Word128 b) { return Word128{_mm_xor_si128(a.v, b.v)}; }
+    inline Word128 operator&(Word128 a, Word128 b) { return Word128{_mm_and_si128(a.v, b.v)}; }
+    inline Word128 operator|(Word128 a, Word128 b) { return Word128{_mm_or_si128(a.v, b.v)}; }
+#endif
+
+    // Select b where sel is set, a elsewhere.
+    template <class W>
+    inline W Select(W sel, W a, W b)
+    {
+        return a ^ (sel & (a ^ b));
+    }
+
+    // Transpose a 8x8 bit matrix: bit c of byte r becomes bit r of byte c.
+    inline uint64_t TransposeBits(uint64_t x)
+    {
+        uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AA;
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCC;
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0;
+        return x ^ t ^ (t << 28);
+    }
+
+    // Transpose a 8x8 byte matrix: byte c of w[r] becomes byte r of w[c].
+    inline void TransposeBytes(uint64_t w[8])
+    {
+        for (size_t i = 0; i < 8; i += 2) {
+            const uint64_t t = ((w[i] >> 8) ^ w[i+1]) & 0x00FF00FF00FF00FF;
+            w[i+1] ^= t;
+            w[i] ^= t << 8;
+        }
+        for (size_t i = 0; i < 8; i += (i & 1) ? 3 : 1) {
+            const uint64_t t = ((w[i] >> 16) ^ w[i+2]) & 0x0000FFFF0000FFFF;
+            w[i+2] ^= t;
+            w[i] ^= t << 16;
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            const uint64_t t = ((w[i] >> 32) ^ w[i+4]) & 0x00000000FFFFFFFF;
+            w[i+4] ^= t;
+            w[i] ^= t << 32;
+        }
+    }
+
+    // Stream cipher S-boxes are evaluated on bitslice words using the algebraic normal form
+    // (ANF) of each output bit: a XOR of "monomials", each one being an AND of S-box inputs.
+    // In the ANF of an output bit, bit M is set when the AND of the inputs which are selected
+    // by the bits in M is part of the XOR. The ANF values are computed from sbox1 to sbox7.
+    // The evaluation is expanded at compile time using templates.
+
+    // Index of the least significant bit in a non-zero value.
+    constexpr size_t LowBit(uint32_t m)
+    {
+        return (m & 1) != 0 ? 0 : 1 + LowBit(m >> 1);
+    }
+
+    // AND of the S-box inputs which are selected by the bits in M.
+    template <class W, uint32_t M>
+    struct Monomial
+    {
+        static W eval(const W* x) { return Monomial<W, (M & (M - 1))>::eval(x) & x[LowBit(M)]; }
+    };
+
+    template <class W>
+    struct Monomial<W, 0>
+    {
+        static W eval(const W*) { return W::ones(); }
+    };
+
+    // Monomial M if PRESENT, zero otherwise.
+    template <class W, uint32_t M, bool PRESENT>
+    struct ANFTerm
+    {
+        static W eval(const W* x) { return Monomial<W, M>::eval(x); }
+    };
+
+    template <class W, uint32_t M>
+    struct ANFTerm<W, M, false>
+    {
+        static W eval(const W*) { return W::zero(); }
+    };
+
+    // XOR of the monomials 0 to M which are present in ANF.
+    template <class W, uint32_t ANF, uint32_t M = 31>
+    struct ANFSum
+    {
+        static W eval(const W* x) { return ANFTerm<W, M, ((ANF >> M) & 1) != 0>::eval(x) ^ ANFSum<W, ANF, M - 1>::eval(x); }
+    };
+
+    template <class W, uint32_t ANF>
+    struct ANFSum<W, ANF, 0>
+    {
+        static W eval(const W* x) { return ANFTerm<W, 0, (ANF & 1) != 0>::eval(x); }
+    };
+
+    // Evaluate a stream cipher S-box. The index in the S-box is x4..x0, the two output bits are o1,o0.
+    template <class W, uint32_t ANF0, uint32_t ANF1>
+    inline void SBox(W x4, W x3, W x2, W x1, W x0, W& o0, W& o1)
+    {
+        const W x[5] {x0, x1, x2, x3, x4};
+        o0 = ANFSum<W, ANF0>::eval(x);
+        o1 = ANFSum<W, ANF1>::eval(x);
+    }
+
+    // Bitsliced stream cipher. Same algorithm as DVBCSA2::StreamCipher, on bitslice words.
+    template <class W>
+    class StreamSlice
+    {
+    public:
+        // Initialize the state with the control word. All packets share the same initial state.
+        void init(const uint8_t* cw);
+
+        // Clock the stream cipher for one byte. In initialization mode, in[0..7] are bits 0..7
+        // of the input byte. Otherwise, in is null and out[0..7] receives bits 0..7 of the output.
+        void clockByte(const W* in, W* out);
+
+    private:
+        // Shift registers A and B are stored in a sliding window to avoid moving
+        // all nibbles on each clock. Register A[n] is _A[_pos+n-1], n = 1..10.
+        static constexpr size_t WINDOW = 32;
+        W _A[WINDOW + 10][4];
+        W _B[WINDOW + 10][4];
+        size_t _pos;
+        W _X[4], _Y[4], _Z[4], _D[4], _E[4], _F[4];
+        W _p, _q, _r;
+    };
+
+    template <class W>
+    void StreamSlice<W>::init(const uint8_t* cw)
+    {
+        _pos = WINDOW;
+        for (size_t n = 0; n < 10; ++n) {
+            // Load the 32 first bits of the key into A[1]..A[8] and the 32 last ones into B[1]..B[8].
+            const uint8_t ka = n < 8 ? uint8_t(cw[n / 2] >> (n % 2 == 0 ? 4 : 0)) : 0;
+            const uint8_t kb = n < 8 ? uint8_t(cw[4 + n / 2] >> (n % 2 == 0 ? 4 : 0)) : 0;
+            for (size_t k = 0; k < 4; ++k) {
+                _A[_pos + n][k] = (ka & (1 << k)) != 0 ? W::ones() : W::zero();
+                _B[_pos + n][k] = (kb & (1 << k)) != 0 ? W::ones() : W::zero();
+            }
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            _X[k] = _Y[k] = _Z[k] = _D[k] = _E[k] = _F[k] = W::zero();
+        }
+        _p = _q = _r = W::zero();
+    }
+
+    template <class W>
+    void StreamSlice<W>::clockByte(const W* in, W* out)
+    {
+        for (size_t j = 0; j < 4; ++j) {
+
+            // Move the sliding window of the shift registers when it reaches the start of the buffer.
+            if (_pos == 0) {
+                for (size_t n = 0; n < 10; ++n) {
+                    for (size_t k = 0; k < 4; ++k) {
+                        _A[WINDOW + n][k] = _A[n][k];
+                        _B[WINDOW + n][k] = _B[n][k];
+                    }
+                }
+                _pos = WINDOW;
+            }
+            const W (*A)[4] = _A + _pos - 1;
+            const W (*B)[4] = _B + _pos - 1;
+
+            // From A[1]..A[10], 35 bits are selected as inputs to 7 S-boxes.
+            W s1[2], s2[2], s3[2], s4[2], s5[2], s6[2], s7[2];
+            SBox<W, 0x35020B24, 0x5D59766F>(A[4][0], A[1][2], A[6][1], A[7][3], A[9][0], s1[0], s1[1]);
+            SBox<W, 0x29182835, 0x1E4001E7>(A[2][1], A[3][2], A[6][3], A[7][0], A[9][1], s2[0], s2[1]);
+            SBox<W, 0x0001012C, 0x52FD5FE7>(A[1][3], A[2][0], A[5][1], A[5][3], A[6][2], s3[0], s3[1]);
+            SBox<W, 0x5B861A1D, 0x5B87419B>(A[3][3], A[1][1], A[2][3], A[4][2], A[8][0], s4[0], s4[1]);
+            SBox<W, 0x0FF226B8, 0x66D66BEF>(A[5][2], A[4][3], A[6][0], A[8][1], A[9][2], s5[0], s5[1]);
+            SBox<W, 0x48C854D2, 0x02093824>(A[3][1], A[4][1], A[5][0], A[7][2], A[9][3], s6[0], s6[1]);
+            SBox<W, 0x0C0111DA, 0x48DA091E>(A[2][2], A[3][0], A[7][1], A[8][2], A[8][3], s7[0], s7[1]);
+
+            // Use 4x4 xor to produce extra nibble for T3.
+            const W extra_B[4] {
+                B[9][2] ^ B[6][3] ^ B[3][1] ^ B[8][0],
+                B[5][3] ^ B[8][2] ^ B[4][0] ^ B[5][1],
+                B[6][0] ^ B[8][1] ^ B[3][3] ^ B[4][2],
+                B[3][0] ^ B[6][1] ^ B[7][2] ^ B[9][3]
+            };
+
+            // T1 and T2, input nibbles are used during initialization only.
+            W next_A1[4], next_B1[4];
+            for (size_t k = 0; k < 4; ++k) {
+                next_A1[k] = A[10][k] ^ _X[k];
+                next_B1[k] = B[7][k] ^ B[10][k] ^ _Y[k];
+            }
+            if (in != nullptr) {
+                const W* in_A = in + (j % 2 == 0 ? 4 : 0);  // in1 (most significant nibble) on even clocks
+                const W* in_B = in + (j % 2 == 0 ? 0 : 4);  // in2 (least significant nibble) on even clocks
+                for (size_t k = 0; k < 4; ++k) {
+                    next_A1[k] = next_A1[k] ^ _D[k] ^ in_A[k];
+                    next_B1[k] = next_B1[k] ^ in_B[k];
+                }
+            }
+
+            // If p=1, rotate next_B1 left.
+            const W b3 = next_B1[3];
+            next_B1[3] = Select(_p, next_B1[3], next_B1[2]);
+            next_B1[2] = Select(_p, next_B1[2], next_B1[1]);
+            next_B1[1] = Select(_p, next_B1[1], next_B1[0]);
+            next_B1[0] = Select(_p, next_B1[0], b3);
+
+            // T3 and T4: D = E ^ Z ^ extra_B, F = Z + E + r if q=1, F = E if q=0, E = previous F.
+            W carry = _r;
+            for (size_t k = 0; k < 4; ++k) {
+                _D[k] = _E[k] ^ _Z[k] ^ extra_B[k];
+                const W sum = _Z[k] ^ _E[k] ^ carry;
+                carry = (_Z[k] & _E[k]) | (carry & (_Z[k] ^ _E[k]));
+                const W next_E = _F[k];
+                _F[k] = Select(_q, _E[k], sum);
+                _E[k] = next_E;
+            }
+            _r = Select(_q, _r, carry);
+
+            // Shift registers.
+            _pos--;
+            for (size_t k = 0; k < 4; ++k) {
+                _A[_pos][k] = next_A1[k];
+                _B[_pos][k] = next_B1[k];
+            }
+
+            // Outputs of the S-boxes.
+            _X[0] = s1[1]; _X[1] = s2[1]; _X[2] = s3[0]; _X[3] = s4[0];
+            _Y[0] = s3[1]; _Y[1] = s4[1]; _Y[2] = s5[0]; _Y[3] = s6[0];
+            _Z[0] = s5[1]; _Z[1] = s6[1]; _Z[2] = s1[0]; _Z[3] = s2[0];
+            _p = s7[1];
+            _q = s7[0];
+
+            // Two output bits are a function of the 4 bits of D.
+            if (out != nullptr) {
+                out[7 - 2 * j] = _D[2] ^ _D[3];
+                out[6 - 2 * j] = _D[0] ^ _D[1];
+            }
+        }
+    }
+
+    // Bytesliced block cipher, 8 packets in parallel. The S-box is applied on two bytes
+    // at once using a 16-bit table (128 kB) which is built on first use.
+    const uint16_t* BlockSBox16()
+    {
+        static const struct Table {
+            uint16_t data[65536] {};
+            Table()
+            {
+                for (size_t i = 0; i < 65536; ++i) {
+                    data[i] = uint16_t(block_sbox[i & 0xFF] | (block_sbox[i >> 8] << 8));
+                }
+            }
+        } table;
+        return table.data;
+    }
+
+    inline uint64_t BlockSBox8(const uint16_t* sbox16, uint64_t x)
+    {
+        return uint64_t(sbox16[x & 0xFFFF]) | (uint64_t(sbox16[(x >> 16) & 0xFFFF]) << 16) |
+               (uint64_t(sbox16[(x >> 32) & 0xFFFF]) << 32) | (uint64_t(sbox16[x >> 48]) << 48);
+    }
+
+    // Same as block_perm[] on each byte.
+    inline uint64_t BlockPerm8(uint64_t s)
+    {
+        return ((s & 0x2929292929292929) << 1) | ((s & 0x0202020202020202) << 6) | ((s & 0x0404040404040404) << 3) |
+               ((s & 0x1010101010101010) >> 2) | ((s & 0x4040404040404040) >> 6) | ((s & 0x8080808080808080) >> 4);
+    }
+
+    // Number of groups of 8 packets which are processed together by the block cipher.
+    // The groups are independent, they are interleaved for instruction-level parallelism.
+    constexpr size_t BLOCK_GROUPS = 4;
+    constexpr size_t BLOCK_LANES = 8 * BLOCK_GROUPS;
+
+    void BlockEncipher(const uint64_t* kk, uint64_t R[BLOCK_GROUPS][8])
+    {
+        const uint16_t* const sbox16 = BlockSBox16();
+        for (size_t i = 1; i <= 56; i++) {
+            for (size_t g = 0; g < BLOCK_GROUPS; ++g) {
+                uint64_t* const r = R[g];
+                const uint64_t sbox_out = BlockSBox8(sbox16, kk[i] ^ r[7]);
+                const uint64_t r1 = r[0];
+                r[0] = r[1];
+                r[1] = r[2] ^ r1;
+                r[2] = r[3] ^ r1;
+                r[3] = r[4] ^ r1;
+                r[4] = r[5];
+                r[5] = r[6] ^ BlockPerm8(sbox_out);
+                r[6] = r[7];
+                r[7] = r1 ^ sbox_out;
+            }
+        }
+    }
+
+    void BlockDecipher(const uint64_t* kk, uint64_t R[BLOCK_GROUPS][8])
+    {
+        const uint16_t* const sbox16 = BlockSBox16();
+        for (size_t i = 56; i > 0; i--) {
+            for (size_t g = 0; g < BLOCK_GROUPS; ++g) {
+                uint64_t* const r = R[g];
+                const uint64_t sbox_out = BlockSBox8(sbox16, kk[i] ^ r[6]);
+                const uint64_t r8 = r[7] ^ sbox_out;
+                r[7] = r[6];
+                r[6] = r[5] ^ BlockPerm8(sbox_out);
+                r[5] = r[4];
+                r[4] = r[3] ^ r8;
+                r[3] = r[2] ^ r8;
+                r[2] = r[1] ^ r8;
+                r[1] = r[0];
+                r[0] = r8;
+            }
+        }
+    }
+
+    // Apply the block cipher in reverse CBC mode on up to BLOCK_LANES packets.
+    void BlockChain(const uint64_t* kk, const ts::DVBCSA2::BatchEntry* batch, size_t count, bool encrypt)
+    {
+        size_t n[BLOCK_LANES];  // number of 8-byte blocks per packet
+        size_t max_n = 0;
+        for (size_t l = 0; l < BLOCK_LANES; ++l) {
+            n[l] = l < count ? batch[l].size / 8 : 0;
+            max_n = std::max(max_n, n[l]);
+        }
+        uint64_t w[BLOCK_GROUPS][8];
+        for (size_t b = 0; b < max_n; ++b) {
+            // Encryption: last block first, plain text is xor'ed with next cipher block before encryption.
+            // Decryption: first block first, deciphered block is xor'ed with next input block.
+            const size_t i = encrypt ? max_n - 1 - b : b;
+            for (size_t g = 0; g < BLOCK_GROUPS; ++g) {
+                for (size_t l = 0; l < 8; ++l) {
+                    const size_t lane = 8 * g + l;
+                    w[g][l] = 0;
+                    if (i < n[lane]) {
+                        w[g][l] = ts::GetUInt64LE(batch[lane].data + 8 * i);
+                        if (encrypt && i + 1 < n[lane]) {
+                            w[g][l] ^= ts::GetUInt64LE(batch[lane].data + 8 * i + 8);
+                        }
+                    }
+                }
+                TransposeBytes(w[g]);
+            }
+            if (encrypt) {
+                BlockEncipher(kk, w);
+            }
+            else {
+                BlockDecipher(kk, w);
+            }
+            for (size_t g = 0; g < BLOCK_GROUPS; ++g) {
+                TransposeBytes(w[g]);
+                for (size_t l = 0; l < 8; ++l) {
+                    const size_t lane = 8 * g + l;
+                    if (i < n[lane]) {
+                        if (!encrypt && i + 1 < n[lane]) {
+                            w[g][l] ^= ts::GetUInt64LE(batch[lane].data + 8 * i + 8);
+                        }
+                        ts::PutUInt64LE(batch[lane].data + 8 * i, w[g][l]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Apply the stream cipher on up to 64 * W::SLICES packets.
+    // The first 8 bytes initialize the stream cipher, the rest of the data is xor'ed with the key stream.
+    template <class W>
+    void StreamBatch(const uint8_t* cw, const ts::DVBCSA2::BatchEntry* batch, size_t count)
+    {
+        uint64_t slices[8][W::SLICES];
+        W bits[8];
+
+        // Transpose the first 8 bytes of all packets into the bitslice words of the stream cipher.
+        StreamSlice<W> stream;
+        stream.init(cw);
+        size_t max_size = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t s = 0; s < W::SLICES; ++s) {
+                for (size_t k = 0; k < 8; ++k) {
+                    slices[k][s] = 0;
+                }
+                for (size_t g = 0; g < 8; ++g) {
+                    uint64_t m = 0;
+                    for (size_t l = 0; l < 8; ++l) {
+                        const size_t lane = 64 * s + 8 * g + l;
+                        if (lane < count && batch[lane].size >= 8) {
+                            m |= uint64_t(batch[lane].data[i]) << (8 * l);
+                            max_size = std::max(max_size, batch[lane].size);
+                        }
+                    }
+                    m = TransposeBits(m);
+                    for (size_t k = 0; k < 8; ++k) {
+                        slices[k][s] |= ((m >> (8 * k)) & 0xFF) << (8 * g);
+                    }
+                }
+            }
+            for (size_t k = 0; k < 8; ++k) {
+                bits[k] = W::load(slices[k]);
+            }
+            stream.clockByte(bits, nullptr);
+        }
+
+        // Generate the key stream and xor it with the rest of the packets.
+        for (size_t i = 8; i < max_size; ++i) {
+            stream.clockByte(nullptr, bits);
+            for (size_t k = 0; k < 8; ++k) {
+                bits[k].store(slices[k]);
+            }
+            for (size_t s = 0; s < W::SLICES; ++s) {
+                for (size_t g = 0; g < 8 && 64 * s + 8 * g < count; ++g) {
+                    uint64_t m = 0;
+                    for (size_t k = 0; k < 8; ++k) {
+                        m |= ((slices[k][s] >> (8 * g)) & 0xFF) << (8 * k);
+                    }
+                    m = TransposeBits(m);
+                    for (size_t l = 0; l < 8; ++l) {
+                        const size_t lane = 64 * s + 8 * g + l;
+                        if (lane < count && i < batch[lane].size) {
+                            batch[lane].data[i] ^= uint8_t(m >> (8 * l));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt a batch of data areas.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Process up to 64 * W::SLICES data areas in parallel.
+    template <class W>
+    void ProcessSlice(const uint8_t* cw, const uint64_t* kk, const ts::DVBCSA2::BatchEntry* batch, size_t count, bool encrypt)
+    {
+        // Encryption: block cipher, then stream cipher. Decryption: the reverse.
+        if (!encrypt) {
+            StreamBatch<W>(cw, batch, count);
+        }
+        for (size_t l = 0; l < count; l += BLOCK_LANES) {
+            BlockChain(kk, batch + l, std::min(count - l, BLOCK_LANES), encrypt);
+        }
+        if (encrypt) {
+            StreamBatch<W>(cw, batch, count);
+        }
+    }
+}
+
+bool ts::DVBCSA2::encryptBatch(const BatchEntry* batch, size_t count)
+{
+    return processBatch(batch, count, true);
+}
+
+bool ts::DVBCSA2::decryptBatch(const BatchEntry* batch, size_t count)
+{
+    return processBatch(batch, count, false);
+}
+
+bool ts::DVBCSA2::processBatch(const BatchEntry* batch, size_t count, bool encrypt)
+{
+    // Filter invalid parameters.
+    if (count == 0) {
+        return true;
+    }
+    if (batch == nullptr || !_init) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (batch[i].data == nullptr || batch[i].size / 8 > MAX_NBLOCKS) {
+            return false;
+        }
+    }
+    if (!(encrypt ? allowEncrypt(count) : allowDecrypt(count))) {
+        return false;
+    }
+
+    while (count > 0) {
+        size_t lanes = std::min<size_t>(count, 64);
+#if defined(TS_X86_64)
+        if (count > 64) {
+            lanes = std::min<size_t>(count, 128);
+            ProcessSlice<Word128>(_key, _batch_kk, batch, lanes, encrypt);
+        }
+        else
+#endif
+        if (count >= BATCH_MIN_LANES) {
+            ProcessSlice<Word64>(_key, _batch_kk, batch, lanes, encrypt);
+        }
+        else {
+            // Not enough data areas to use the bitsliced implementation.
+            lanes = count;
+            for (size_t i = 0; i < count; ++i) {
+                if (encrypt) {
+                    encryptInPlaceImpl(batch[i].data, batch[i].size, nullptr);
+                }
+                else {
+                    decryptInPlaceImpl(batch[i].data, batch[i].size, nullptr);
+                }
+            }
+        }
+        batch += lanes;
+        count -= lanes;
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Wrappers for encrypt and decrypt.
 //----------------------------------------------------------------------------
@@ -67,6 +67,51 @@ namespace ts {
         //!
         static bool IsReducedCW(const uint8_t *cw);
 
+        //!
+        //! Description of one data area in a batch of data areas to encrypt or decrypt.
+        //! @see encryptBatch()
+        //! @see decryptBatch()
+        //!
+        struct BatchEntry
+        {
+            uint8_t* data;  //!< Address of the data area, typically the payload of a TS packet.
+            size_t   size;  //!< Size in bytes of the data area, up to 184 bytes.
+        };
+
+        //!
+        //! Encrypt a batch of data areas in place, typically the payloads of TS packets.
+        //!
+        //! All data areas are encrypted with the current control word. The result is the same
+        //! as calling encryptInPlace() on each data area. Large batches are processed using a
+        //! bitsliced implementation of DVB-CSA2 which encrypts up to BATCH_LANES data areas
+        //! in parallel. Each data area counts as one encryption in the key usage limitation.
+        //!
+        //! @param [in] batch Address of an array of @a count data areas.
+        //! @param [in] count Number of data areas in @a batch.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBatch(const BatchEntry* batch, size_t count);
+
+        //!
+        //! Decrypt a batch of data areas in place, typically the payloads of TS packets.
+        //!
+        //! All data areas are decrypted with the current control word. The result is the same
+        //! as calling decryptInPlace() on each data area. Large batches are processed using a
+        //! bitsliced implementation of DVB-CSA2 which decrypts up to BATCH_LANES data areas
+        //! in parallel. Each data area counts as one decryption in the key usage limitation.
+        //!
+        //! @param [in] batch Address of an array of @a count data areas.
+        //! @param [in] count Number of data areas in @a batch.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBatch(const BatchEntry* batch, size_t count);
+
+        //!
+        //! Maximum number of data areas which are processed in parallel by encryptBatch() and decryptBatch().
+        //! This is 128 on platforms with 128-bit SIMD instructions and 64 on other platforms.
+        //!
+        static const size_t BATCH_LANES;
+
         // Implementation of CipherChaining interface. Cannot set IV with DVB CSA.
         virtual bool setIV(const void*, size_t) override;
         virtual size_t minIVSize() const override;
@@ -102,6 +147,7 @@ namespace ts {
             void init(const uint8_t *cw);
             void encipher(const uint8_t *bd, uint8_t *ib);
             void decipher(const uint8_t *ib, uint8_t *bd);
+            int roundKey(size_t i) const { return _kk[i]; }
         };
 
         // Stream cipher data
@@ -130,5 +176,9 @@ namespace ts {
         uint8_t      _key[KEY_SIZE] {};
         BlockCipher  _block {};
         StreamCipher _stream {};
+        uint64_t     _batch_kk[57] {};  // Block cipher scheduled keys, each byte repeated 8 times, for batches.
+
+        // Encrypt or decrypt a batch, after checking the parameters.
+        bool processBatch(const BatchEntry* batch, size_t count, bool encrypt);
     };
 }
@@ -239,6 +239,24 @@ bool ts::DVS042<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, v
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
+    // When the plain text buffer is distinct from the cipher text, decrypt all complete
+    // blocks at once (some block ciphers process several blocks in parallel).
+    if (pt != ct && cipher_length >= this->block_size) {
+        if (!this->algo->decryptBlocks(ct, pt, cipher_length / this->block_size)) {
+            return false;
+        }
+        while (cipher_length >= this->block_size) {
+            // plain-text = previous-cipher XOR plain-text
+            for (size_t i = 0; i < this->block_size; ++i) {
+                pt[i] ^= previous[i];
+            }
+            previous = ct;
+            ct += this->block_size;
+            pt += this->block_size;
+            cipher_length -= this->block_size;
+        }
+    }
+
     while (cipher_length >= this->block_size) {
         // work = decrypt (cipher-text)
         if (!this->algo->decrypt(ct, this->block_size, this->work.data(), this->block_size)) {
@@ -83,7 +83,8 @@ ts::TSAnalyzer::TSAnalyzer(DuckContext& duck, const BitRate& bitrate_hint, BitRa
     _max_consecutive_suspects(1),
     _demux(_duck, this, this),
     _pes_demux(_duck, this),
-    _t2mi_demux(_duck, this)
+    _t2mi_demux(_duck, this),
+    _pid_index()
 {
     resetSectionDemux();
 }
@@ -147,6 +148,7 @@ void ts::TSAnalyzer::reset()
     _scrambled_services_cnt = 0;
     _tid_present.reset();
     _pids.clear();
+    _pid_index.fill(nullptr);
     _services.clear();
     _ts_bitrate_sum = 0;
     _ts_bitrate_cnt = 0;
@@ -426,7 +428,7 @@ ts::TSAnalyzer::ETIDContextPtr ts::TSAnalyzer::getETID(const Section& section)
 
 bool ts::TSAnalyzer::pidExists(PID pid) const
 {
-    return Contains(_pids, pid);
+    return pid < PID_MAX && _pid_index[pid] != nullptr;
 }
 
 
@@ -436,12 +438,17 @@ bool ts::TSAnalyzer::pidExists(PID pid) const
 
 ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& description)
 {
-    const PIDContextPtr p(_pids[pid]);
-    if (p.isNull()) {
-        // The PID was not yet used, map entry just created.
-        return _pids[pid] = new PIDContext(pid, description);
+    if (pid >= PID_MAX || _pid_index[pid] == nullptr) {
+        // The PID was not yet used, create a new entry.
+        const PIDContextPtr p(new PIDContext(pid, description));
+        _pids[pid] = p;
+        if (pid < PID_MAX) {
+            _pid_index[pid] = p.pointer();
+        }
+        return p;
     }
     else {
+        const PIDContextPtr p(_pids[pid]);
         // If the PID was marked as unreferenced, now use actual description.
         if (p->description == UNREFERENCED && description != UNREFERENCED) {
             p->description = description;
@@ -451,6 +458,18 @@ ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& des
 }
 
 
+//----------------------------------------------------------------------------
+//  Return a PID context, fast path for the per-packet processing.
+//----------------------------------------------------------------------------
+
+ts::TSAnalyzer::PIDContext* ts::TSAnalyzer::pidContext(PID pid)
+{
+    // The PID of a TS packet is always less than PID_MAX.
+    PIDContext* pc = _pid_index[pid];
+    return pc != nullptr ? pc : getPID(pid).pointer();
+}
+
+
 //----------------------------------------------------------------------------
 //  Return a service context. Allocate a new entry if service not found.
 //----------------------------------------------------------------------------
@@ -1547,7 +1566,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
     _t2mi_demux.feedPacket(pkt);
 
     // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
+    PIDContext* const ps = pidContext(pkt.getPID());
     ps->ts_pkt_cnt++;
 
     // Accumulate stat from packet
@@ -486,6 +486,9 @@ namespace ts {
         // Reset the section demux.
         void resetSectionDemux();
 
+        // Get a PID context, fast path for the per-packet processing, no safe pointer copy.
+        PIDContext* pidContext(PID pid);
+
         // Analyze the various PSI tables
         void analyzePAT(const PAT&);
         void analyzeCAT(const CAT&);
@@ -542,5 +545,11 @@ namespace ts {
         SectionDemux _demux;                     // PSI tables analysis
         PESDemux     _pes_demux;                 // Audio/video analysis
         T2MIDemux    _t2mi_demux;                // T2-MI analysis
+
+        // Direct index of PID contexts, by PID value. The PID contexts are owned by _pids,
+        // the index is used to avoid a map lookup and a safe pointer copy on each packet.
+        // The contexts themselves are not stored contiguously: they are individually
+        // allocated and shared through PIDContextPtr with subclasses and report code.
+        std::array<PIDContext*, PID_MAX> _pid_index;
     };
 }
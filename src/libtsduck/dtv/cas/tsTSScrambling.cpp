@@ -547,3 +547,114 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt several TS packets with the current parity and corresponding CW.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encrypt(TSPacket* const* pkt, size_t count)
+{
+    // Only DVB-CSA2 has a batch implementation, encrypt other algorithms packet by packet.
+    if (!useBatch()) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!encrypt(*pkt[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // If no current parity is set, start with even by default.
+    if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+        return false;
+    }
+    assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
+
+    // Collect the payloads to encrypt. Packets without payload are silently passed.
+    _batch.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (pkt[i]->isScrambled()) {
+            _report.error(u"try to scramble an already scrambled packet");
+            return false;
+        }
+        if (pkt[i]->hasPayload()) {
+            _batch.push_back({pkt[i]->getPayload(), pkt[i]->getPayloadSize()});
+        }
+    }
+
+    // Encrypt all payloads at once.
+    if (!_dvbcsa[_encrypt_scv & 1].encryptBatch(_batch.data(), _batch.size())) {
+        _report.error(u"packet encryption error using %s", {_dvbcsa[0].name()});
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (pkt[i]->hasPayload()) {
+            pkt[i]->setScrambling(_encrypt_scv);
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several TS packets with the CW corresponding to the parity in the packet.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::decrypt(TSPacket* const* pkt, size_t count)
+{
+    // Only DVB-CSA2 has a batch implementation, decrypt other algorithms packet by packet.
+    if (!useBatch()) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!decrypt(*pkt[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    _batch.clear();
+    _batch_pkts.clear();
+    for (size_t i = 0; i < count; ++i) {
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = pkt[i]->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+
+        // On parity change, decrypt the previous packets before switching to the new key.
+        if (scv != _decrypt_scv) {
+            if (!decryptCurrentBatch()) {
+                return false;
+            }
+            _decrypt_scv = scv;
+            // In case of fixed control word, use next key when the scrambling control changes.
+            if (hasFixedCW() && !setNextFixedCW(_decrypt_scv)) {
+                return false;
+            }
+        }
+        _batch.push_back({pkt[i]->getPayload(), pkt[i]->getPayloadSize()});
+        _batch_pkts.push_back(pkt[i]);
+    }
+    return decryptCurrentBatch();
+}
+
+bool ts::TSScrambling::decryptCurrentBatch()
+{
+    if (_batch.empty()) {
+        return true;
+    }
+    const bool ok = _dvbcsa[_decrypt_scv & 1].decryptBatch(_batch.data(), _batch.size());
+    if (ok) {
+        for (auto pkt : _batch_pkts) {
+            pkt->setScrambling(SC_CLEAR);
+        }
+    }
+    else {
+        _report.error(u"packet decryption error using %s", {_dvbcsa[0].name()});
+    }
+    _batch.clear();
+    _batch_pkts.clear();
+    return ok;
+}
@@ -191,6 +191,27 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt several TS packets with the current parity and corresponding CW.
+        //! The result is the same as calling encrypt() on each packet. With DVB-CSA2,
+        //! the packets are scrambled in parallel (see DVBCSA2::encryptBatch()).
+        //! @param [in,out] pkt Address of an array of @a count pointers to the packets to encrypt.
+        //! @param [in] count Number of packets to encrypt.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encrypt(TSPacket* const* pkt, size_t count);
+
+        //!
+        //! Decrypt several TS packets with the CW corresponding to the parity in each packet.
+        //! The result is the same as calling decrypt() on each packet. With DVB-CSA2, the
+        //! consecutive packets with the same parity are descrambled in parallel
+        //! (see DVBCSA2::decryptBatch()).
+        //! @param [in,out] pkt Address of an array of @a count pointers to the packets to decrypt.
+        //! @param [in] count Number of packets to decrypt.
+        //! @return True on success, false on error. A clear packet is not an error.
+        //!
+        bool decrypt(TSPacket* const* pkt, size_t count);
+
     private:
         // List of control words
         typedef std::list<ByteBlock> CWList;
@@ -210,10 +231,18 @@ namespace ts {
         CBC<AES>         _aescbc[2] {};
         CTR<AES>         _aesctr[2] {};
         CipherChaining*  _scrambler[2] {nullptr, nullptr};
+        std::vector<DVBCSA2::BatchEntry> _batch {};  // Payloads of the current DVB-CSA2 batch.
+        std::vector<TSPacket*> _batch_pkts {};        // Packets of the current DVB-CSA2 batch.
 
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Check if the current algorithm is DVB-CSA2, which can process batches of packets.
+        bool useBatch() const { return _scrambler[0] == &_dvbcsa[0]; }
+
+        // Decrypt the packets in the current DVB-CSA2 batch with the current decryption parity.
+        bool decryptCurrentBatch();
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
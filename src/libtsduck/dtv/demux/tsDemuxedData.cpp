@@ -87,7 +87,13 @@ void ts::DemuxedData::reload(const void* content, size_t content_size, PID sourc
 {
     _source_pid = source_pid;
     _first_pkt = _last_pkt = 0;
-    _data = new ByteBlock(content, content_size);
+    // Recycle the previous data block when it is not shared with another object.
+    if (!_data.isNull() && _data.count() == 1) {
+        _data->copy(content, content_size);
+    }
+    else {
+        _data = new ByteBlock(content, content_size);
+    }
 }
 
 void ts::DemuxedData::reload(const ByteBlock& content, PID source_pid)
@@ -14,6 +14,12 @@
 #include "tsReportFile.h"
 #include "tsEIT.h"
 
+#if !defined(TS_CXX17)
+constexpr size_t ts::SectionDemux::PID_PAGE_BITS;
+constexpr size_t ts::SectionDemux::PID_PAGE_SIZE;
+constexpr size_t ts::SectionDemux::PID_PAGE_COUNT;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Demux status information.
@@ -183,6 +189,55 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
 {
 }
 
+ts::SectionDemux::~SectionDemux()
+{
+    deleteAllPIDContexts();
+}
+
+
+//----------------------------------------------------------------------------
+// Management of the sparse table of PID contexts.
+//----------------------------------------------------------------------------
+
+ts::SectionDemux::PIDContext& ts::SectionDemux::getOrCreatePIDContext(PID pid)
+{
+    PIDContextPage*& page(_pids[pid >> PID_PAGE_BITS]);
+    if (page == nullptr) {
+        page = new PIDContextPage;
+        CheckNonNull(page);
+        page->fill(nullptr);
+    }
+    PIDContext*& pc((*page)[pid & (PID_PAGE_SIZE - 1)]);
+    if (pc == nullptr) {
+        pc = new PIDContext;
+        CheckNonNull(pc);
+    }
+    return *pc;
+}
+
+void ts::SectionDemux::deletePIDContext(PID pid)
+{
+    PIDContextPage* const page = _pids[pid >> PID_PAGE_BITS];
+    if (page != nullptr) {
+        PIDContext*& pc((*page)[pid & (PID_PAGE_SIZE - 1)]);
+        delete pc;
+        pc = nullptr;
+    }
+}
+
+void ts::SectionDemux::deleteAllPIDContexts()
+{
+    for (auto& page : _pids) {
+        if (page != nullptr) {
+            for (auto pc : *page) {
+                delete pc;
+            }
+            delete page;
+            page = nullptr;
+        }
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Reset the analysis context (partially built sections and tables).
@@ -191,13 +246,15 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
 void ts::SectionDemux::immediateReset()
 {
     SuperClass::immediateReset();
-    _pids.clear();
+    deleteAllPIDContexts();
 }
 
 void ts::SectionDemux::immediateResetPID(PID pid)
 {
     SuperClass::immediateResetPID(pid);
-    _pids.erase(pid);
+    if (pid < PID_MAX) {
+        deletePIDContext(pid);
+    }
 }
 
 
@@ -224,7 +281,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
     // Get PID and reference to the PID context.
     // The PID context is created if did not exist.
     const PID pid = pkt.getPID();
-    PIDContext& pc(_pids[pid]);
+    PIDContext& pc(getOrCreatePIDContext(pid));
 
     // If TS packet is scrambled, we cannot decode it and we loose synchronization
     // on this PID (usually, PID's carrying sections are not scrambled).
@@ -473,15 +530,32 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                 }
             }
 
-            // Create a new Section object if necessary (ie. if a section
-            // hendler is registered or if this is a new section).
+            // Create a new Section object if this is a new section to store in the TID context.
+            // When the section is only passed to the section handler, reuse a section object
+            // which is owned by the demux to avoid a memory allocation per section.
             SectionPtr sect_ptr;
+            Section* sect = nullptr;
 
-            if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number].isNull()))) {
+            if (section_ok && tc != nullptr && tc->sects[section_number].isNull()) {
                 sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
-                sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
-                sect_ptr->setLastTSPacketIndex(_packet_count);
-                if (!sect_ptr->isValid()) {
+                sect = sect_ptr.pointer();
+            }
+            else if (section_ok && _section_handler != nullptr) {
+                const Section* const old = tc == nullptr ? nullptr : tc->sects[section_number].pointer();
+                if (old != nullptr && section_length == old->size() && ::memcmp(ts_start, old->content(), section_length) == 0) {
+                    // Same content as the stored section: share its data, the CRC32 is already checked.
+                    _handler_section = *old;
+                }
+                else {
+                    _handler_section.reload(ts_start, section_length, pid, CRC32::CHECK);
+                }
+                sect = &_handler_section;
+            }
+
+            if (sect != nullptr) {
+                sect->setFirstTSPacketIndex(pusi_pkt_index);
+                sect->setLastTSPacketIndex(_packet_count);
+                if (!sect->isValid()) {
                     _duck.report().log(_ts_error_level, u"invalid section CRC, PID 0x%X (%<d), TID 0x%X (%<d), section %d, version %d, packet index %'d", {pid, tid, section_number, version, _packet_count});
                     _status.wrong_crc++;  // only possible error (hum?)
                     section_ok = false;
@@ -495,7 +569,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             try {
                 // If a handler is defined for sections, invoke it.
                 if (section_ok && _section_handler != nullptr) {
-                    _section_handler->handleSection(*this, *sect_ptr);
+                    _section_handler->handleSection(*this, *sect);
                 }
 
                 // Save the section in the TID context if this is a new one.
@@ -562,10 +636,14 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
 
 void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
 {
-    // Loop on all PID's.
-    for (auto& it1 : _pids) {
-        const PID pid = it1.first;
-        PIDContext& pc(it1.second);
+    // Loop on all PID's. Always check the existence of the PID context since
+    // a handler may reset the demux, deleting the contexts of all PID's.
+    for (PID pid = 0; pid < PID_MAX; ++pid) {
+        PIDContext* const ppc = getPIDContext(pid);
+        if (ppc == nullptr) {
+            continue;
+        }
+        PIDContext& pc(*ppc);
 
         // Mark that we are in the context of a table or section handler.
         // This is used to prevent the destruction of PID contexts during
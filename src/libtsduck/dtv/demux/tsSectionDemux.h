@@ -14,6 +14,7 @@
 #pragma once
 #include "tsAbstractDemux.h"
 #include "tsTablesPtr.h"
+#include "tsSection.h"
 #include "tsTableHandlerInterface.h"
 #include "tsSectionHandlerInterface.h"
 #include "tsInvalidSectionHandlerInterface.h"
@@ -50,6 +51,11 @@ namespace ts {
                               SectionHandlerInterface* section_handler = nullptr,
                               const PIDSet& pid_filter = NoPID);
 
+        //!
+        //! Destructor.
+        //!
+        virtual ~SectionDemux() override;
+
         // Inherited methods
         virtual void feedPacket(const TSPacket& pkt) override;
 
@@ -274,11 +280,37 @@ namespace ts {
         // If fill_eit is true, add missing sections in EIT.
         void fixAndFlush(bool pack, bool fill_eit);
 
+        // PID contexts are stored in a two-level sparse table, directly indexed by PID value.
+        // The first level is an array of pages of PID's. A page is an array of pointers to
+        // PID contexts. A page is allocated only when one of its PID's is used. Thus, getting
+        // the context of a PID is O(1), without tree walk and without allocation, once the
+        // PID context exists.
+        static constexpr size_t PID_PAGE_BITS = 8;
+        static constexpr size_t PID_PAGE_SIZE = size_t(1) << PID_PAGE_BITS;  // Number of PID's per page.
+        static constexpr size_t PID_PAGE_COUNT = PID_MAX / PID_PAGE_SIZE;    // Number of pages.
+        typedef std::array<PIDContext*, PID_PAGE_SIZE> PIDContextPage;
+        typedef std::array<PIDContextPage*, PID_PAGE_COUNT> PIDContextTable;
+
+        // Get the context of a PID, null if it does not exist.
+        PIDContext* getPIDContext(PID pid) const
+        {
+            const PIDContextPage* const page = _pids[pid >> PID_PAGE_BITS];
+            return page == nullptr ? nullptr : (*page)[pid & (PID_PAGE_SIZE - 1)];
+        }
+
+        // Get the context of a PID, create it if it does not exist.
+        PIDContext& getOrCreatePIDContext(PID pid);
+
+        // Delete the context of one PID or all PID's.
+        void deletePIDContext(PID pid);
+        void deleteAllPIDContexts();
+
         // Private members:
         TableHandlerInterface*          _table_handler {nullptr};
         SectionHandlerInterface*        _section_handler {nullptr};
         InvalidSectionHandlerInterface* _invalid_handler {nullptr};
-        std::map<PID,PIDContext>        _pids {};
+        PIDContextTable                 _pids {};
+        Section                         _handler_section {};  // Recycled section for the section handler only.
         Status _status {};
         bool   _get_current {true};
         bool   _get_next {false};
@@ -11,7 +11,7 @@
 #include "tsDescriptor.h"
 #include "tsDescriptorList.h"
 #include "tsPSIBuffer.h"
-#include "tsNames.h"
+#include "tsPSIRepository.h"
 
 
 //----------------------------------------------------------------------------
@@ -61,7 +61,7 @@ ts::EDID ts::AbstractDescriptor::edid(TID tid) const
     if (!isValid()) {
         return EDID();  // invalid value.
     }
-    else if (tid != TID_NULL && names::HasTableSpecificName(_tag, tid)) {
+    else if (tid != TID_NULL && PSIRepository::Instance()->hasTableSpecificName(_tag, tid)) {
         // Table-specific descriptor.
         return EDID::TableSpecific(_tag, tid);
     }
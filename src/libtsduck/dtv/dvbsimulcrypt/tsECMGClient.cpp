@@ -13,6 +13,7 @@
 const size_t ts::ECMGClient::RECEIVER_STACK_SIZE;
 const size_t ts::ECMGClient::RESPONSE_QUEUE_SIZE;
 const ts::MilliSecond ts::ECMGClient::RESPONSE_TIMEOUT;
+constexpr size_t ts::ECMGClient::LatencyStatistics::HISTOGRAM_SIZE;
 
 
 //----------------------------------------------------------------------------
@@ -59,11 +60,18 @@ bool ts::ECMGClient::abortConnection(const UString& message)
         _logger.report().error(message);
     }
 
-    GuardCondition lock(_mutex, _work_to_do);
-    _state = DISCONNECTED;
-    _connection.disconnect(_logger.report());
-    _connection.close(_logger.report());
-    lock.signal();
+    FailedRequests failed;
+    {
+        GuardCondition lock(_mutex, _work_to_do);
+        _state = DISCONNECTED;
+        _in_control = false;
+        _connection.disconnect(_logger.report());
+        _connection.close(_logger.report());
+        failPendingRequests(failed);
+        _streams.clear();
+        lock.signal();
+    }
+    NotifyFailedRequests(failed, message.empty() ? UString(u"ECMG connection aborted") : message);
 
     _logger.setReport(NullReport::Instance());
     return false;
@@ -80,6 +88,8 @@ bool ts::ECMGClient::connect(const ECMGClientArgs& args,
                              const AbortInterface* abort,
                              const tlv::Logger& logger)
 {
+    GuardMutex control(_control_mutex);
+
     // Initial state check
     {
         GuardMutex lock(_mutex);
@@ -95,6 +105,10 @@ bool ts::ECMGClient::connect(const ECMGClientArgs& args,
         }
         _abort = abort;
         _logger = logger;
+        _streams.clear();
+        _pending.clear();
+        _stats.reset();
+        _response_queue.clear();
     }
 
     // Perform TCP connection to ECMG server
@@ -119,82 +133,188 @@ bool ts::ECMGClient::connect(const ECMGClientArgs& args,
     {
         GuardCondition lock(_mutex, _work_to_do);
         _state = CONNECTING;
+        _in_control = true;
         lock.signal();
     }
 
     // Wait for a channel_status from the ECMG
     tlv::MessagePtr msg;
-    if (!_response_queue.dequeue(msg, RESPONSE_TIMEOUT)) {
-        return abortConnection(u"ECMG channel_setup response timeout");
-    }
-    if (msg->tag() != ecmgscs::Tags::channel_status) {
-        return abortConnection(u"unexpected response from ECMG (expected channel_status):\n" + msg->dump(4));
+    if (!waitResponse(msg, ecmgscs::Tags::channel_status, u"channel_setup")) {
+        return abortConnection();
     }
     ecmgscs::ChannelStatus* const csp = dynamic_cast<ecmgscs::ChannelStatus*>(msg.pointer());
     assert(csp != nullptr);
     channel_status = _channel_status = *csp;
 
-    // Send a stream_setup message to ECMG
-    ecmgscs::StreamSetup stream_setup(_protocol);
-    stream_setup.channel_id = args.ecm_channel_id;
-    stream_setup.stream_id = args.ecm_stream_id;
-    stream_setup.ECM_id = args.ecm_id;
-    stream_setup.nominal_CP_duration = uint16_t(args.cp_duration / 100); // unit is 1/10 second
-    if (!_connection.send(stream_setup, _logger)) {
+    // Open the first ECM stream.
+    _first_stream_id = args.ecm_stream_id;
+    if (!setupStream(args.ecm_stream_id, args.ecm_id, uint16_t(args.cp_duration / 100), stream_status)) { // unit is 1/10 second
         return abortConnection();
     }
 
-    // Wait for a stream_status from the ECMG
+    // ECM stream now established
+    {
+        GuardMutex lock(_mutex);
+        _state = CONNECTED;
+    }
+
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for a response to a control message.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::waitResponse(tlv::MessagePtr& msg, uint16_t expected_tag, const UChar* request)
+{
     if (!_response_queue.dequeue(msg, RESPONSE_TIMEOUT)) {
-        return abortConnection(u"ECMG stream_setup response timeout");
+        _logger.report().error(u"ECMG %s response timeout", {request});
+        return false;
+    }
+    else if (msg->tag() != expected_tag) {
+        _logger.report().error(u"unexpected response from ECMG to %s:\n%s", {request, msg->dump(4)});
+        return false;
     }
-    if (msg->tag() != ecmgscs::Tags::stream_status) {
-        return abortConnection(u"unexpected response from ECMG (expected stream_status):\n" + msg->dump(4));
+    else {
+        return true;
     }
-    ecmgscs::StreamStatus* const ssp = dynamic_cast<ecmgscs::StreamStatus*>(msg.pointer());
-    assert(ssp != nullptr);
-    stream_status = _stream_status = *ssp;
+}
 
-    // ECM stream now established
+
+//----------------------------------------------------------------------------
+// Send a stream_setup and wait for the response.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::setupStream(uint16_t stream_id, uint16_t ecm_id, uint16_t cp_duration, ecmgscs::StreamStatus& stream_status)
+{
     {
         GuardMutex lock(_mutex);
-        _state = CONNECTED;
+        if (_streams.count(stream_id) != 0) {
+            _logger.report().error(u"ECM stream id %d already open", {stream_id});
+            return false;
+        }
+        _in_control = true;
     }
 
-    return true;
+    // Send a stream_setup message to ECMG
+    ecmgscs::StreamSetup stream_setup(_protocol);
+    stream_setup.channel_id = _channel_status.channel_id;
+    stream_setup.stream_id = stream_id;
+    stream_setup.ECM_id = ecm_id;
+    stream_setup.nominal_CP_duration = cp_duration;
+
+    // Wait for a stream_status from the ECMG
+    tlv::MessagePtr msg;
+    const bool ok = _connection.send(stream_setup, _logger) && waitResponse(msg, ecmgscs::Tags::stream_status, u"stream_setup");
+
+    GuardMutex lock(_mutex);
+    _in_control = false;
+    if (ok) {
+        ecmgscs::StreamStatus* const ssp = dynamic_cast<ecmgscs::StreamStatus*>(msg.pointer());
+        assert(ssp != nullptr);
+        stream_status = *ssp;
+        _streams.insert(std::make_pair(stream_id, stream_status));
+    }
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Open an additional ECM stream on the channel.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::openStream(uint16_t stream_id, uint16_t ecm_id, uint16_t cp_duration, ecmgscs::StreamStatus& stream_status)
+{
+    GuardMutex control(_control_mutex);
+    if (_state != CONNECTED) {
+        _logger.report().error(u"ECMG client not connected");
+        return false;
+    }
+    return setupStream(stream_id, ecm_id, cp_duration, stream_status);
+}
+
+
+//----------------------------------------------------------------------------
+// Send a stream_close_request and wait for the response.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::closeStreamRequest(uint16_t stream_id)
+{
+    {
+        GuardMutex lock(_mutex);
+        if (_streams.count(stream_id) == 0) {
+            _logger.report().error(u"ECM stream id %d not open", {stream_id});
+            return false;
+        }
+        _in_control = true;
+    }
+
+    // Politely send a stream_close_request and wait for a stream_close_response
+    ecmgscs::StreamCloseRequest req(_protocol);
+    req.channel_id = _channel_status.channel_id;
+    req.stream_id = stream_id;
+    tlv::MessagePtr resp;
+    const bool ok = _connection.send(req, _logger) && waitResponse(resp, ecmgscs::Tags::stream_close_response, u"stream_close_request");
+
+    // Forget the stream and its pending requests, even on error.
+    FailedRequests failed;
+    {
+        GuardMutex lock(_mutex);
+        _in_control = false;
+        _streams.erase(stream_id);
+        failPendingRequests(failed, stream_id);
+    }
+    NotifyFailedRequests(failed, UString::Format(u"ECM stream id %d closed", {stream_id}));
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Close an ECM stream on the channel.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::closeStream(uint16_t stream_id)
+{
+    GuardMutex control(_control_mutex);
+    if (_state != CONNECTED) {
+        _logger.report().error(u"ECMG client not connected");
+        return false;
+    }
+    return closeStreamRequest(stream_id);
 }
 
 
 //----------------------------------------------------------------------------
-// Disconnect from remote ECMG. Close stream and channel.
+// Disconnect from remote ECMG. Close all streams and channel.
 //----------------------------------------------------------------------------
 
 bool ts::ECMGClient::disconnect()
 {
+    GuardMutex control(_control_mutex);
+
     // Mark disconnection in progress
     State previous_state;
+    std::vector<uint16_t> streams;
     {
         GuardMutex lock(_mutex);
         previous_state = _state;
         if (_state == CONNECTING || _state == CONNECTED) {
             _state = DISCONNECTING;
         }
+        for (const auto& it : _streams) {
+            streams.push_back(it.first);
+        }
     }
 
     // Disconnection sequence
     bool ok = previous_state == CONNECTED;
     if (ok) {
-        // Politely send a stream_close_request
-        ecmgscs::StreamCloseRequest req(_protocol);
-        req.channel_id = _stream_status.channel_id;
-        req.stream_id = _stream_status.stream_id;
-        tlv::MessagePtr resp;
-        // Politely send a stream_close_request
-        // and wait for a stream_close_response
-        ok = _connection.send(req, _logger) &&
-            _response_queue.dequeue(resp, RESPONSE_TIMEOUT) &&
-            resp->tag() == ecmgscs::Tags::stream_close_response;
-        // If we get a polite reply, send a channel_close
+        // Close all streams.
+        for (size_t i = 0; ok && i < streams.size(); ++i) {
+            ok = closeStreamRequest(streams[i]);
+        }
+        // If we get polite replies, send a channel_close
         if (ok) {
             ecmgscs::ChannelClose cc(_protocol);
             cc.channel_id = _channel_status.channel_id;
@@ -203,31 +323,87 @@ bool ts::ECMGClient::disconnect()
     }
 
     // TCP disconnection
-    GuardCondition lock(_mutex, _work_to_do);
-    if (previous_state == CONNECTING || previous_state == CONNECTED) {
-        _state = DISCONNECTED;
-        ok = _connection.disconnect(_logger.report()) && ok;
-        ok = _connection.close(_logger.report()) && ok;
-        lock.signal();
+    FailedRequests failed;
+    {
+        GuardCondition lock(_mutex, _work_to_do);
+        if (previous_state == CONNECTING || previous_state == CONNECTED) {
+            _state = DISCONNECTED;
+            _in_control = false;
+            ok = _connection.disconnect(_logger.report()) && ok;
+            ok = _connection.close(_logger.report()) && ok;
+            failPendingRequests(failed);
+            _streams.clear();
+            lock.signal();
+        }
     }
+    NotifyFailedRequests(failed, u"ECMG disconnected");
 
     return ok;
 }
 
 
 //----------------------------------------------------------------------------
-// Build a CW_provision message.
+// Complete all pending requests on error.
 //----------------------------------------------------------------------------
 
-void ts::ECMGClient::buildCWProvision(ecmgscs::CWProvision& msg,
-                                      uint16_t cp_number,
-                                      const ByteBlock& current_cw,
-                                      const ByteBlock& next_cw,
-                                      const ByteBlock& ac,
-                                      uint16_t cp_duration)
+void ts::ECMGClient::failPendingRequests(FailedRequests& failed, const Variable<uint16_t>& stream_id)
+{
+    for (auto it = _pending.begin(); it != _pending.end(); ) {
+        if (!stream_id.set() || (it->first >> 16) == stream_id.value()) {
+            SyncWaiter* const waiter = it->second.waiter;
+            if (waiter != nullptr) {
+                waiter->done = true;
+                waiter->success = false;
+                waiter->completed.signal();
+            }
+            if (it->second.handler != nullptr) {
+                FailedRequest req;
+                req.handler = it->second.handler;
+                req.stream_id = uint16_t(it->first >> 16);
+                req.cp_number = uint16_t(it->first & 0xFFFF);
+                failed.push_back(req);
+            }
+            it = _pending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void ts::ECMGClient::NotifyFailedRequests(const FailedRequests& failed, const UString& message)
+{
+    for (const auto& req : failed) {
+        req.handler->handleECMError(req.stream_id, req.cp_number, message);
+    }
+}
+
+ts::UString ts::ECMGClient::ErrorStatusMessage(const UChar* tag, const std::vector<uint16_t>& error_status)
 {
-    msg.channel_id = _stream_status.channel_id;
-    msg.stream_id = _stream_status.stream_id;
+    UStringList errors;
+    for (auto status : error_status) {
+        errors.push_back(ecmgscs::Errors::Name(status));
+    }
+    return UString::Format(u"ECMG returned %s: %s", {tag, UString::Join(errors)});
+}
+
+
+//----------------------------------------------------------------------------
+// Register a pending request and send the corresponding CW_provision message.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::sendCWProvision(uint16_t stream_id,
+                                     uint16_t cp_number,
+                                     const ByteBlock& current_cw,
+                                     const ByteBlock& next_cw,
+                                     const ByteBlock& ac,
+                                     uint16_t cp_duration,
+                                     const PendingRequest& request)
+{
+    // Build a CW_provision message
+    ecmgscs::CWProvision msg(_protocol);
+    msg.channel_id = _channel_status.channel_id;
+    msg.stream_id = stream_id;
     msg.CP_number = cp_number;
     msg.has_CW_encryption = false;
     msg.has_CP_duration = cp_duration != 0;
@@ -242,6 +418,38 @@ void ts::ECMGClient::buildCWProvision(ecmgscs::CWProvision& msg,
     if (!next_cw.empty()) {
         msg.CP_CW_combination.push_back(ecmgscs::CPCWCombination(cp_number + 1, next_cw));
     }
+
+    // Register the pending request.
+    const uint32_t key = RequestKey(stream_id, cp_number);
+    {
+        GuardMutex lock(_mutex);
+        if (_state != CONNECTED) {
+            _logger.report().error(u"ECMG client not connected");
+            return false;
+        }
+        if (_streams.count(stream_id) == 0) {
+            _logger.report().error(u"ECM stream id %d not open", {stream_id});
+            return false;
+        }
+        if (_pending.count(key) != 0) {
+            _logger.report().error(u"ECM request already pending for stream id %d, CP number %d", {stream_id, cp_number});
+            return false;
+        }
+        PendingRequest& req(_pending[key]);
+        req = request;
+        req.submitted.getSystemTime();
+        _stats.max_pending = std::max(_stats.max_pending, _pending.size());
+    }
+
+    // Send the CW_provision message, without waiting for previous responses.
+    const bool ok = _connection.send(msg, _logger);
+
+    // Clear pending request on error
+    if (!ok) {
+        GuardMutex lock(_mutex);
+        _pending.erase(key);
+    }
+    return ok;
 }
 
 
@@ -256,40 +464,42 @@ bool ts::ECMGClient::generateECM(uint16_t cp_number,
                                  uint16_t cp_duration,
                                  ecmgscs::ECMResponse& ecm_response)
 {
-    // Build a CW_provision message
-    ecmgscs::CWProvision msg(_protocol);
-    buildCWProvision(msg, cp_number, current_cw, next_cw, ac, cp_duration);
+    return generateECM(_first_stream_id, cp_number, current_cw, next_cw, ac, cp_duration, ecm_response);
+}
 
-    // Send the CW_provision message
-    if (!_connection.send(msg, _logger)) {
+bool ts::ECMGClient::generateECM(uint16_t stream_id,
+                                 uint16_t cp_number,
+                                 const ByteBlock& current_cw,
+                                 const ByteBlock& next_cw,
+                                 const ByteBlock& ac,
+                                 uint16_t cp_duration,
+                                 ecmgscs::ECMResponse& ecm_response)
+{
+    // The response is directly stored by the receiver thread, which signals the waiter.
+    SyncWaiter waiter(ecm_response);
+    PendingRequest request;
+    request.waiter = &waiter;
+    if (!sendCWProvision(stream_id, cp_number, current_cw, next_cw, ac, cp_duration, request)) {
         return false;
     }
 
-    // Compute ECM generation timeout (very conservative)
-    const MilliSecond timeout = std::max(RESPONSE_TIMEOUT, 2 * MilliSecond(_channel_status.max_comp_time));
-
-    // Wait for an ECM response from the ECMG
-    tlv::MessagePtr resp;
-    if (!_response_queue.dequeue(resp, timeout)) {
-        _logger.report().error(u"ECM generation timeout");
-        return false;
-    }
-    if (resp->tag() == ecmgscs::Tags::ECM_response) {
-        ecmgscs::ECMResponse* const ep = dynamic_cast <ecmgscs::ECMResponse*>(resp.pointer());
-        assert(ep != nullptr);
-        if (ep->CP_number == cp_number) {
-            // This is our ECM
-            ecm_response = *ep;
-            return true;
+    // Wait for the ECM response from the ECMG.
+    Monotonic deadline(true);
+    deadline += ecmTimeout() * NanoSecPerMilliSec;
+    GuardCondition lock(_mutex, waiter.completed);
+    while (!waiter.done) {
+        const NanoSecond remain = deadline - Monotonic(true);
+        if (remain <= 0 || !lock.waitCondition(std::max<MilliSecond>(1, remain / NanoSecPerMilliSec))) {
+            break;
         }
     }
 
-    // Unexpected response. Messages other than our ECM_response are channel_test
-    // and status_test. They are automatically handled in the reception thread.
-    // At this point, if we receive a message, this is an error or an truely
-    // unexpected message.
-    _logger.report().error(u"unexpected response to ECM request:\n%s", {resp->dump(4)});
-    return false;
+    // On timeout, the request is no longer pending. With the mutex held, the receiver thread cannot use the waiter.
+    if (!waiter.done) {
+        _pending.erase(RequestKey(stream_id, cp_number));
+        _logger.report().error(u"ECM generation timeout");
+    }
+    return waiter.success;
 }
 
 
@@ -304,26 +514,90 @@ bool ts::ECMGClient::submitECM(uint16_t cp_number,
                                uint16_t cp_duration,
                                ECMGClientHandlerInterface* ecm_handler)
 {
-    // Build a CW_provision message
-    ecmgscs::CWProvision msg(_protocol);
-    buildCWProvision(msg, cp_number, current_cw, next_cw, ac, cp_duration);
+    return submitECM(_first_stream_id, cp_number, current_cw, next_cw, ac, cp_duration, ecm_handler);
+}
 
-    // Register an asynchronous request
-    {
-        GuardMutex lock(_mutex);
-        _async_requests.insert(std::make_pair(cp_number, ecm_handler));
-    }
+bool ts::ECMGClient::submitECM(uint16_t stream_id,
+                               uint16_t cp_number,
+                               const ByteBlock& current_cw,
+                               const ByteBlock& next_cw,
+                               const ByteBlock& ac,
+                               uint16_t cp_duration,
+                               ECMGClientHandlerInterface* ecm_handler)
+{
+    PendingRequest request;
+    request.handler = ecm_handler;
+    return sendCWProvision(stream_id, cp_number, current_cw, next_cw, ac, cp_duration, request);
+}
 
-    // Send the CW_provision message
-    bool ok = _connection.send(msg, _logger);
 
-    // Clear asynchronous request on error
-    if (!ok) {
-        GuardMutex lock(_mutex);
-        _async_requests.erase(cp_number);
+//----------------------------------------------------------------------------
+// Get the timeout for ECM generation (very conservative).
+//----------------------------------------------------------------------------
+
+ts::MilliSecond ts::ECMGClient::ecmTimeout() const
+{
+    return std::max(RESPONSE_TIMEOUT, 2 * MilliSecond(_channel_status.max_comp_time));
+}
+
+
+//----------------------------------------------------------------------------
+// Latency statistics.
+//----------------------------------------------------------------------------
+
+void ts::ECMGClient::LatencyStatistics::reset()
+{
+    latency.reset();
+    histogram.fill(0);
+    max_pending = 0;
+}
+
+size_t ts::ECMGClient::LatencyStatistics::BinIndex(MicroSecond value)
+{
+    size_t index = 0;
+    for (MilliSecond ms = value / MicroSecPerMilliSec; ms > 0 && index < HISTOGRAM_SIZE - 1; ms >>= 1) {
+        index++;
     }
+    return index;
+}
 
-    return ok;
+void ts::ECMGClient::LatencyStatistics::feed(MicroSecond value)
+{
+    latency.feed(value);
+    histogram[BinIndex(value)]++;
+}
+
+ts::ECMGClient::LatencyStatistics ts::ECMGClient::latencyStatistics() const
+{
+    GuardMutex lock(_mutex);
+    return _stats;
+}
+
+void ts::ECMGClient::reportStatistics(Report& report, int level) const
+{
+    const LatencyStatistics stats(latencyStatistics());
+    report.log(level, u"ECMG: %'d ECM responses, max %'d pending requests", {stats.latency.count(), stats.max_pending});
+    if (stats.latency.count() > 0) {
+        report.log(level, u"ECMG: latency: min %'d us, mean %s us, std deviation %s us, max %'d us",
+                   {stats.latency.minimum(), stats.latency.meanString(), stats.latency.standardDeviationString(), stats.latency.maximum()});
+        UString line;
+        for (size_t i = 0; i < stats.histogram.size(); ++i) {
+            if (stats.histogram[i] > 0) {
+                if (i == 0) {
+                    line += u" <1 ms";
+                }
+                else if (i == stats.histogram.size() - 1) {
+                    line.format(u" >=%'d ms", {MilliSecond(1) << (i - 1)});
+                }
+                else {
+                    line.format(u" %'d-%'d ms", {MilliSecond(1) << (i - 1), MilliSecond(1) << i});
+                }
+                line.format(u": %'d,", {stats.histogram[i]});
+            }
+        }
+        line.removeSuffix(u",");
+        report.log(level, u"ECMG: latency histogram:%s", {line});
+    }
 }
 
 
@@ -367,42 +641,99 @@ void ts::ECMGClient::main()
                     break;
                 }
                 case ecmgscs::Tags::stream_test: {
-                    // Automatic reply to stream_test
-                    ok = _connection.send(_stream_status, _logger);
+                    // Automatic reply to stream_test with the status of the corresponding stream
+                    ecmgscs::StreamTest* const test = dynamic_cast<ecmgscs::StreamTest*>(msg.pointer());
+                    assert(test != nullptr);
+                    ecmgscs::StreamStatus status(_protocol);
+                    bool found = false;
+                    {
+                        GuardMutex lock(_mutex);
+                        const auto it = _streams.find(test->stream_id);
+                        found = it != _streams.end();
+                        if (found) {
+                            status = it->second;
+                        }
+                    }
+                    if (found) {
+                        ok = _connection.send(status, _logger);
+                    }
+                    else {
+                        ecmgscs::StreamError error(_protocol);
+                        error.channel_id = test->channel_id;
+                        error.stream_id = test->stream_id;
+                        error.error_status.push_back(ecmgscs::Errors::inv_stream_id);
+                        ok = _connection.send(error, _logger);
+                    }
                     break;
                 }
                 case ecmgscs::Tags::ECM_response: {
-                    // Check if this is an asynchronous ECM response
+                    // Find the corresponding pending request
                     ecmgscs::ECMResponse* const resp = dynamic_cast <ecmgscs::ECMResponse*>(msg.pointer());
                     assert(resp != nullptr);
                     ECMGClientHandlerInterface* handler = nullptr;
+                    bool found = false;
                     {
                         GuardMutex lock(_mutex);
-                        auto it = _async_requests.find(resp->CP_number);
-                        if (it != _async_requests.end()) {
-                            handler = it->second;
-                            _async_requests.erase(resp->CP_number);
+                        const auto it = _pending.find(RequestKey(resp->stream_id, resp->CP_number));
+                        found = it != _pending.end();
+                        if (found) {
+                            _stats.feed((Monotonic(true) - it->second.submitted) / NanoSecPerMicroSec);
+                            handler = it->second.handler;
+                            SyncWaiter* const waiter = it->second.waiter;
+                            if (waiter != nullptr) {
+                                // Synchronous request, the waiting thread is notified while holding the mutex.
+                                waiter->response = *resp;
+                                waiter->done = waiter->success = true;
+                                waiter->completed.signal();
+                            }
+                            _pending.erase(it);
                         }
                     }
-                    if (handler == nullptr) {
-                        // Not an asynchronous request -> enqueue response for application thread
-                        _response_queue.enqueue(msg);
-                    }
-                    else {
-                        // Pending request -> notify application
+                    if (handler != nullptr) {
+                        // Asynchronous request -> notify application
                         handler->handleECM(*resp);
                     }
+                    else if (!found) {
+                        _logger.report().debug(u"ignored unexpected ECM_response, stream id %d, CP number %d", {resp->stream_id, resp->CP_number});
+                    }
                     break;
                 }
                 default: {
-                    // Enqueue the message for application thread
-                    _response_queue.enqueue(msg);
+                    bool in_control = false;
+                    FailedRequests failed;
+                    UString error;
+                    {
+                        GuardMutex lock(_mutex);
+                        in_control = _in_control;
+                        if (!in_control && msg->tag() == ecmgscs::Tags::channel_error) {
+                            const ecmgscs::ChannelError* const err = dynamic_cast<const ecmgscs::ChannelError*>(msg.pointer());
+                            assert(err != nullptr);
+                            error = ErrorStatusMessage(u"channel_error", err->error_status);
+                            failPendingRequests(failed);
+                        }
+                        else if (!in_control && msg->tag() == ecmgscs::Tags::stream_error) {
+                            const ecmgscs::StreamError* const err = dynamic_cast<const ecmgscs::StreamError*>(msg.pointer());
+                            assert(err != nullptr);
+                            error = ErrorStatusMessage(u"stream_error", err->error_status);
+                            failPendingRequests(failed, err->stream_id);
+                        }
+                    }
+                    NotifyFailedRequests(failed, error);
+                    if (in_control) {
+                        // Enqueue the message for the application thread which waits for a response
+                        _response_queue.enqueue(msg);
+                    }
+                    else {
+                        // Unsollicited message, typically an error on a CW_provision
+                        _logger.report().error(u"unexpected message from ECMG:\n%s", {msg->dump(4)});
+                    }
                     break;
                 }
             }
         }
 
         // Error while receiving messages, most likely a disconnection
+        FailedRequests failed;
         {
             GuardMutex lock(_mutex);
             if (_state == DESTRUCTING) {
@@ -413,6 +744,8 @@ void ts::ECMGClient::main()
                 _connection.disconnect(NULLREP);
                 _connection.close(NULLREP);
             }
+            failPendingRequests(failed);
         }
+        NotifyFailedRequests(failed, u"ECMG connection lost");
     }
 }
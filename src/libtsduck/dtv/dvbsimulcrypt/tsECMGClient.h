@@ -19,6 +19,9 @@
 #include "tsECMGClientHandlerInterface.h"
 #include "tstlvConnection.h"
 #include "tsMessageQueue.h"
+#include "tsSingleDataStatistics.h"
+#include "tsMonotonic.h"
+#include "tsVariable.h"
 #include "tsCondition.h"
 #include "tsMutex.h"
 #include "tsThread.h"
@@ -30,6 +33,14 @@ namespace ts {
     //! Restriction: The target ECMG shall support only current or current/next control
     //! words in ECM, meaning CW_per_msg = 1 or 2 and lead_CW = 0 or 1.
     //!
+    //! One ECMGClient object manages one ECM channel, i.e. one TCP connection to the ECMG.
+    //! Several ECM streams can be multiplexed over the channel: the first one is opened by
+    //! connect(), additional ones by openStream(). ECM requests are pipelined: any number
+    //! of CW_provision messages can be sent on any stream without waiting for the previous
+    //! responses. The ECM_response messages are matched to the requests using their
+    //! ECM_stream_id and CP_number, in whatever order they are returned by the ECMG.
+    //! Using several channels simply means using several ECMGClient objects.
+    //!
     //! @see DVB standard ETSI TS 103.197 V1.4.1 for ECMG <=> SCS protocol.
     //! @ingroup mpeg
     //!
@@ -70,7 +81,7 @@ namespace ts {
                      const tlv::Logger& logger);
 
         //!
-        //! Synchronously generate an ECM.
+        //! Synchronously generate an ECM on the ECM stream which was opened by connect().
         //!
         //! @param [in] cp_number Current crypto-period number.
         //! @param [in] current_cw Control word for current crypto-period.
@@ -89,7 +100,7 @@ namespace ts {
                          ecmgscs::ECMResponse& response);
 
         //!
-        //! Asynchronously generate an ECM.
+        //! Asynchronously generate an ECM on the ECM stream which was opened by connect().
         //! Submit the ECM request and return immediately.
         //! The notification of the ECM generation or error is performed through the specified handler.
         //!
@@ -109,9 +120,129 @@ namespace ts {
                        uint16_t cp_duration,
                        ECMGClientHandlerInterface* handler);
 
+        //!
+        //! Synchronously generate an ECM on a given ECM stream.
+        //! Several threads can concurrently generate ECM's on the same client.
+        //!
+        //! @param [in] stream_id ECM_stream_id, as specified in connect() or openStream().
+        //! @param [in] cp_number Current crypto-period number.
+        //! @param [in] current_cw Control word for current crypto-period.
+        //! @param [in] next_cw Control word for next crypto-period.
+        //! If empty, the ECMG must work with CW_per_msg = 1.
+        //! @param [in] ac Access criteria, can be empty.
+        //! @param [in] cp_duration Crypto-period in 100 ms units, unspecified if zero.
+        //! @param [out] response Returned ECM.
+        //! @return True on success, false on error.
+        //!
+        bool generateECM(uint16_t stream_id,
+                         uint16_t cp_number,
+                         const ByteBlock& current_cw,
+                         const ByteBlock& next_cw,
+                         const ByteBlock& ac,
+                         uint16_t cp_duration,
+                         ecmgscs::ECMResponse& response);
+
+        //!
+        //! Asynchronously generate an ECM on a given ECM stream.
+        //! Submit the ECM request and return immediately.
+        //! The notification of the ECM generation or error is performed through the specified handler.
+        //!
+        //! @param [in] stream_id ECM_stream_id, as specified in connect() or openStream().
+        //! @param [in] cp_number Current crypto-period number.
+        //! @param [in] current_cw Control word for current crypto-period.
+        //! @param [in] next_cw Control word for next crypto-period.
+        //! If empty, the ECMG must work with CW_per_msg = 1.
+        //! @param [in] ac Access criteria, can be empty.
+        //! @param [in] cp_duration Crypto-period in 100 ms units, unspecified if zero.
+        //! @param [in] handler Object which will be notified of the returned ECM.
+        //! @return True on success, false on error.
+        //!
+        bool submitECM(uint16_t stream_id,
+                       uint16_t cp_number,
+                       const ByteBlock& current_cw,
+                       const ByteBlock& next_cw,
+                       const ByteBlock& ac,
+                       uint16_t cp_duration,
+                       ECMGClientHandlerInterface* handler);
+
+        //!
+        //! Open an additional ECM stream on the channel.
+        //! The client must be already connected.
+        //!
+        //! @param [in] stream_id ECM_stream_id of the new stream.
+        //! @param [in] ecm_id ECM_id of the new stream.
+        //! @param [in] cp_duration Nominal crypto-period duration in 100 ms units.
+        //! @param [out] stream_status Response to stream_setup.
+        //! @return True on success, false on error.
+        //!
+        bool openStream(uint16_t stream_id, uint16_t ecm_id, uint16_t cp_duration, ecmgscs::StreamStatus& stream_status);
+
+        //!
+        //! Close an ECM stream on the channel.
+        //! Pending ECM requests on this stream are dropped.
+        //! @param [in] stream_id ECM_stream_id of the stream to close.
+        //! @return True on success, false on error.
+        //!
+        bool closeStream(uint16_t stream_id);
+
+        //!
+        //! Get the timeout for ECM generation.
+        //! @return The maximum time, in milliseconds, to wait for an ECM_response.
+        //!
+        MilliSecond ecmTimeout() const;
+
+        //!
+        //! Statistics on the latency of ECM requests, from CW_provision to ECM_response.
+        //!
+        class TSDUCKDLL LatencyStatistics
+        {
+        public:
+            //!
+            //! Number of bins in the latency histogram.
+            //! Bin 0 counts latencies under 1 ms. Bin i counts latencies from 2^(i-1) to 2^i ms, excluded.
+            //! The last bin counts all latencies starting at 2^(HISTOGRAM_SIZE-2) ms.
+            //!
+            static constexpr size_t HISTOGRAM_SIZE = 14;
+
+            SingleDataStatistics<MicroSecond> latency {};        //!< Latency of completed ECM requests, in microseconds.
+            std::array<size_t, HISTOGRAM_SIZE> histogram {};     //!< Histogram of latencies, see HISTOGRAM_SIZE.
+            size_t                            max_pending = 0;   //!< Maximum number of simultaneously pending requests.
+
+            //!
+            //! Reset the statistics.
+            //!
+            void reset();
+
+            //!
+            //! Accumulate the latency of one ECM request.
+            //! @param [in] value Latency of the request, in microseconds.
+            //!
+            void feed(MicroSecond value);
+
+            //!
+            //! Get the index of the histogram bin for a given latency.
+            //! @param [in] value Latency of a request, in microseconds.
+            //! @return Index of the bin for @a value in @a histogram.
+            //!
+            static size_t BinIndex(MicroSecond value);
+        };
+
+        //!
+        //! Get a copy of the latency statistics of the ECM requests since connect().
+        //! @return A copy of the latency statistics.
+        //!
+        LatencyStatistics latencyStatistics() const;
+
+        //!
+        //! Report the latency statistics of the ECM requests since connect().
+        //! @param [in,out] report Where to report the statistics.
+        //! @param [in] level Severity level of the messages.
+        //!
+        void reportStatistics(Report& report, int level = Severity::Info) const;
+
         //!
         //! Disconnect from remote ECMG.
-        //! Close stream and channel.
+        //! Close all streams and channel.
         //! @return True on success, false on error.
         //!
         bool disconnect();
@@ -142,8 +273,34 @@ namespace ts {
         // Timeout for responses from ECMG (except ECM generation)
         static const MilliSecond RESPONSE_TIMEOUT = 5000;
 
-        // List of asynchronous ECM requests: key=cp_number, value=handler
-        typedef std::map <uint16_t, ECMGClientHandlerInterface*> AsyncRequests;
+        // Context of an application thread waiting for a synchronous ECM request.
+        class SyncWaiter
+        {
+            TS_NOBUILD_NOCOPY(SyncWaiter);
+        public:
+            SyncWaiter(ecmgscs::ECMResponse& resp) : response(resp) {}
+            ecmgscs::ECMResponse& response;         // Where to store the response.
+            Condition             completed {};     // Signaled when the request completes, successfully or not.
+            bool                  done = false;     // The request is completed.
+            bool                  success = false;  // The response was stored.
+        };
+
+        // Description of a pending ECM request.
+        // Asynchronous requests have a handler, synchronous requests have a waiter.
+        class PendingRequest
+        {
+        public:
+            ECMGClientHandlerInterface* handler = nullptr;  // Notification of asynchronous request.
+            SyncWaiter*                 waiter = nullptr;   // Synchronous request.
+            Monotonic                   submitted {};       // Submission time.
+        };
+
+        // Pending ECM requests, indexed by RequestKey(stream_id, cp_number).
+        typedef std::map<uint32_t, PendingRequest> PendingRequests;
+        static uint32_t RequestKey(uint16_t stream_id, uint16_t cp_number) { return (uint32_t(stream_id) << 16) | cp_number; }
+
+        // Status of open ECM streams, indexed by stream_id.
+        typedef std::map<uint16_t, ecmgscs::StreamStatus> StreamStatusMap;
 
         // Private members
         const ecmgscs::Protocol& _protocol;
@@ -152,19 +309,54 @@ namespace ts {
         tlv::Logger              _logger {};
         tlv::Connection <Mutex>  _connection {_protocol, true, 3}; // connection with ECMG server
         ecmgscs::ChannelStatus   _channel_status {_protocol};      // initial response to channel_setup
-        ecmgscs::StreamStatus    _stream_status {_protocol};       // initial response to stream_setup
-        Mutex                    _mutex {};          // exclusive access to protected fields
+        uint16_t                 _first_stream_id = 0;             // stream opened by connect()
+        Mutex                    _control_mutex {};  // serialize control operations using the response queue
+        mutable Mutex            _mutex {};          // exclusive access to protected fields
         Condition                _work_to_do {};     // notify receiver thread to do some work
-        AsyncRequests            _async_requests {};
+        StreamStatusMap          _streams {};        // responses to stream_setup of all open streams
+        PendingRequests          _pending {};        // pending ECM requests
+        LatencyStatistics        _stats {};          // ECM requests latency
+        bool                     _in_control = false; // a control operation waits for its response
         MessageQueue <tlv::Message, NullMutex> _response_queue {RESPONSE_QUEUE_SIZE};
 
-        // Build a CW_provision message.
-        void buildCWProvision(ecmgscs::CWProvision& msg,
-                              uint16_t cp_number,
-                              const ByteBlock& current_cw,
-                              const ByteBlock& next_cw,
-                              const ByteBlock& ac,
-                              uint16_t cp_duration);
+        // Send a stream_setup and wait for the response.
+        bool setupStream(uint16_t stream_id, uint16_t ecm_id, uint16_t cp_duration, ecmgscs::StreamStatus& stream_status);
+
+        // Send a stream_close_request and wait for the response.
+        bool closeStreamRequest(uint16_t stream_id);
+
+        // Wait for a response to a control message.
+        bool waitResponse(tlv::MessagePtr& msg, uint16_t expected_tag, const UChar* request);
+
+        // Register a pending request and send the corresponding CW_provision message.
+        bool sendCWProvision(uint16_t stream_id,
+                             uint16_t cp_number,
+                             const ByteBlock& current_cw,
+                             const ByteBlock& next_cw,
+                             const ByteBlock& ac,
+                             uint16_t cp_duration,
+                             const PendingRequest& request);
+
+        // Asynchronous request which failed, its handler is notified after releasing the mutex.
+        class FailedRequest
+        {
+        public:
+            ECMGClientHandlerInterface* handler = nullptr;
+            uint16_t                    stream_id = 0;
+            uint16_t                    cp_number = 0;
+        };
+        typedef std::list<FailedRequest> FailedRequests;
+
+        // Complete and remove all pending requests on error, all streams if stream_id is empty.
+        // Synchronous requests are immediately completed. Failed asynchronous requests are
+        // added in the list for notifyFailedRequests(). Must be called with the mutex held.
+        void failPendingRequests(FailedRequests& failed, const Variable<uint16_t>& stream_id = Variable<uint16_t>());
+
+        // Notify the handlers of failed asynchronous requests. Must be called without the mutex held.
+        static void NotifyFailedRequests(const FailedRequests& failed, const UString& message);
+
+        // Build an error message from the error_status of a channel_error or stream_error.
+        static UString ErrorStatusMessage(const UChar* tag, const std::vector<uint16_t>& error_status);
 
         // Receiver thread main code
         virtual void main() override;
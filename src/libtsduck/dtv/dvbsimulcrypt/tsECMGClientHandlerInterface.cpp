@@ -8,6 +8,9 @@
 
 #include "tsECMGClientHandlerInterface.h"
 
+// The default error handler does nothing.
+void ts::ECMGClientHandlerInterface::handleECMError(uint16_t, uint16_t, const UString&) {}
+
 ts::ECMGClientHandlerInterface::~ECMGClientHandlerInterface()
 {
 }
@@ -30,5 +30,17 @@ namespace ts {
         //! @param [in] response The response from the ECMG.
         //!
         virtual void handleECM(const ecmgscs::ECMResponse& response) = 0;
+
+        //!
+        //! This hook is invoked when an ECM request fails without response from the ECMG.
+        //! This happens on stream_error or channel_error from the ECMG, when the stream is
+        //! closed or when the ECMG is disconnected. The default implementation does nothing.
+        //! It is invoked in the context of an internal thread of the ECMG client object
+        //! or in the context of the application thread which closes the stream or the channel.
+        //! @param [in] stream_id ECM_stream_id of the failed request.
+        //! @param [in] cp_number CP_number of the failed request.
+        //! @param [in] message Description of the error.
+        //!
+        virtual void handleECMError(uint16_t stream_id, uint16_t cp_number, const UString& message);
     };
 }
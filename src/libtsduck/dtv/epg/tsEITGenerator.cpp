@@ -47,6 +47,8 @@ void ts::EITGenerator::reset()
     _actual_ts_id = 0;
     _actual_ts_id_set = false;
     _regenerate = false;
+    _update_time.clear();
+    _next_update.clear();
     _packet_index = 0;
     _max_bitrate = 0;
     _ts_bitrate = 0;
@@ -241,35 +243,31 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
             srv = &_services[service_id];
         }
 
+        // Check if an event with the same id already exists in the service.
+        const auto id_iter = srv->events.find(ev->event_id);
+        if (id_iter != srv->events.end()) {
+            if (id_iter->second->event_data == ev->event_data) {
+                // Duplicate event, ignore it.
+                continue;
+            }
+            // Modified event, remove the previous version.
+            _duck.report().log(2, u"replacing event id 0x%X (%<d), %s", {ev->event_id, service_id});
+            removeEvent(*srv, id_iter->second);
+        }
+
         // Locate or allocate the segment for that event. At this stage, we only create this
         // segment if necessary. This is the minimum to store an event. We do not try to create
         // empty intermediate segments. This will be done in regenerateSchedule().
-
-        const Time seg_start_time(EIT::SegmentStartTime(ev->start_time));
-        auto seg_iter = srv->segments.begin();
-        while (seg_iter != srv->segments.end() && (*seg_iter)->start_time < seg_start_time) {
-            ++seg_iter;
-        }
-        if (seg_iter == srv->segments.end() || (*seg_iter)->start_time != seg_start_time) {
-            // The segment does not exist, create it.
-            _duck.report().debug(u"creating EIT segment starting at %s for %s", {seg_start_time, service_id});
-            const ESegmentPtr seg(new ESegment(seg_start_time));
-            CheckNonNull(seg.pointer());
-            seg_iter = srv->segments.insert(seg_iter, seg);
-        }
-        ESegment& seg(**seg_iter);
+        ESegment& seg(getSegment(service_id, *srv, EIT::SegmentStartTime(ev->start_time)));
 
         // Insert the binary event in the list of events for that segment.
         auto ev_iter = seg.events.begin();
         while (ev_iter != seg.events.end() && (*ev_iter)->start_time < ev->start_time) {
             ++ev_iter;
         }
-        if (ev_iter != seg.events.end() && (*ev_iter)->event_id == ev->event_id && (*ev_iter)->event_data == ev->event_data) {
-            // Duplicate event, ignore it.
-            continue;
-        }
         _duck.report().log(2, u"loaded event id 0x%X (%<d), %s, starting %s", {ev->event_id, service_id, ev->start_time});
         seg.events.insert(ev_iter, ev);
+        srv->events[ev->event_id] = ev;
         ev_count++;
 
         // Mark all EIT schedule in this segment as to be regenerated.
@@ -279,12 +277,103 @@ bool ts::EITGenerator::loadEvents(const ServiceIdTriplet& service_id, const uint
     // If some events were added, it may be necessary to regenerate the EIT p/f in this service.
     if (ev_count > 0) {
         assert(srv != nullptr);
+        _next_update.clear();
         regeneratePresentFollowing(service_id, *srv, now);
     }
     return success;
 }
 
 
+//----------------------------------------------------------------------------
+// Delete one event from the EPG database.
+//----------------------------------------------------------------------------
+
+bool ts::EITGenerator::deleteEvent(const ServiceIdTriplet& service_id, uint16_t event_id)
+{
+    const auto srv_iter = _services.find(service_id);
+    if (srv_iter == _services.end()) {
+        return false;
+    }
+    EService& srv(srv_iter->second);
+    const auto id_iter = srv.events.find(event_id);
+    if (id_iter == srv.events.end()) {
+        return false;
+    }
+
+    _duck.report().log(2, u"deleting event id 0x%X (%<d), %s", {event_id, service_id});
+    removeEvent(srv, id_iter->second);
+    _next_update.clear();
+
+    // The deleted event may have been present or following.
+    regeneratePresentFollowing(service_id, srv, getCurrentTime());
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the segment of a service with the specified start time, create it if it does not exist.
+//----------------------------------------------------------------------------
+
+ts::EITGenerator::ESegment& ts::EITGenerator::getSegment(const ServiceIdTriplet& service_id, EService& srv, const Time& seg_start_time)
+{
+    auto seg_iter = srv.segments.begin();
+    while (seg_iter != srv.segments.end() && (*seg_iter)->start_time < seg_start_time) {
+        ++seg_iter;
+    }
+    if (seg_iter == srv.segments.end() || (*seg_iter)->start_time != seg_start_time) {
+        // The segment does not exist, create it.
+        _duck.report().debug(u"creating EIT segment starting at %s for %s", {seg_start_time, service_id});
+        const ESegmentPtr seg(new ESegment(seg_start_time));
+        CheckNonNull(seg.pointer());
+        seg_iter = srv.segments.insert(seg_iter, seg);
+    }
+    return **seg_iter;
+}
+
+
+//----------------------------------------------------------------------------
+// Remove an event from a service and mark its segment for regeneration.
+//----------------------------------------------------------------------------
+
+void ts::EITGenerator::removeEvent(EService& srv, const EventPtr& ev)
+{
+    // Keep a reference on the event, the parameter may point into the index.
+    const EventPtr event(ev);
+    const Time seg_start_time(EIT::SegmentStartTime(event->start_time));
+
+    for (auto& seg_iter : srv.segments) {
+        ESegment& seg(*seg_iter);
+        if (seg.start_time == seg_start_time) {
+            seg.events.remove(event);
+            _regenerate = srv.regenerate = seg.regenerate = true;
+            break;
+        }
+    }
+    srv.unindexEvent(event);
+}
+
+
+//----------------------------------------------------------------------------
+// EService: remove events from the index.
+//----------------------------------------------------------------------------
+
+void ts::EITGenerator::EService::unindexEvent(const EventPtr& ev)
+{
+    // Make sure that the indexed event is the same one, not a replacement.
+    const auto it = events.find(ev->event_id);
+    if (it != events.end() && it->second == ev) {
+        events.erase(it);
+    }
+}
+
+void ts::EITGenerator::EService::unindexEvents(const EventList& evs)
+{
+    for (const auto& ev : evs) {
+        unindexEvent(ev);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Load EPG data from an EIT section.
 //----------------------------------------------------------------------------
@@ -637,15 +726,21 @@ void ts::EITGenerator::markObsoleteSection(ESection& sec)
         // accumulate because the EIT bandwidth is not large enough and low-priority
         // EIT schedule never get a chance to get selected (and discarded when marked
         // as obsolete). Do some garbage collecting to avoid infinite accumulation.
-        if (_obsolete_count > 100) {
+        // The threshold is proportional to the number of queued sections to avoid
+        // repeated full scans when a large EPG is updated.
+        size_t queued_count = 0;
+        for (size_t index = 0; index < _injects.size(); ++index) {
+            queued_count += _injects[index].size();
+        }
+        if (_obsolete_count > std::max<size_t>(100, queued_count / 4)) {
             // Loop on all injection queues.
             for (size_t index = 0; index < _injects.size(); ++index) {
                 // Loop on all sections in the queue.
-                ESectionList& list(_injects[index]);
-                auto it = list.begin();
-                while (it != list.end()) {
-                    if ((*it)->obsolete) {
-                        it = list.erase(it);
+                ESectionQueue& queue(_injects[index]);
+                auto it = queue.begin();
+                while (it != queue.end()) {
+                    if (it->second->obsolete) {
+                        it = queue.erase(it);
                     }
                     else {
                         ++it;
@@ -662,32 +757,13 @@ void ts::EITGenerator::markObsoleteSection(ESection& sec)
 // Enqueue a section for injection.
 //----------------------------------------------------------------------------
 
-void ts::EITGenerator::enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool try_front)
+void ts::EITGenerator::enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject)
 {
     // Update section injection time.
     sec->next_inject = next_inject;
 
-    // Compute which injection queue to use.
-    ESectionList& list(_injects[size_t(_profile.sectionToProfile(*sec->section))]);
-
-    // Even start at from or back of the queue (possible optimization).
-    if (try_front) {
-        auto it = list.begin();
-        while (it != list.end() && (*it)->next_inject <= next_inject) {
-            ++it;
-        }
-        list.insert(it, sec);
-    }
-    else {
-        auto it = list.end();
-        while (it != list.begin() && (*--it)->next_inject > next_inject) {
-        }
-        if (it != list.end()) {
-            // it points to a section before sec, must insert after.
-            ++it;
-        }
-        list.insert(it, sec);
-    }
+    // Insert in the injection queue of the profile of the section, after all sections with the same injection time.
+    _injects[size_t(_profile.sectionToProfile(*sec->section))].insert(std::make_pair(next_inject, sec));
 }
 
 
@@ -770,7 +846,7 @@ bool ts::EITGenerator::regeneratePresentFollowingSection(const ServiceIdTriplet&
             sec->section->recomputeCRC();
         }
         // Place the section in the inject queue.
-        enqueueInjectSection(sec, inject_time, true);
+        enqueueInjectSection(sec, inject_time);
         // Section was modified.
         return true;
     }
@@ -849,6 +925,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
             // Remove initial segments before last midnight.
             while (!srv.segments.empty() && srv.segments.front()->start_time < last_midnight) {
                 markObsoleteSegment(*srv.segments.front());
+                srv.unindexEvents(srv.segments.front()->events);
                 srv.segments.pop_front();
             }
 
@@ -964,7 +1041,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                             // Sections are independently versioned, this one is complete.
                             sec->section->recomputeCRC();
                         }
-                        enqueueInjectSection(sec, getCurrentTime(), true);
+                        enqueueInjectSection(sec, getCurrentTime());
 
                         // Move to next section (if it exists).
                         ++sec_iter;
@@ -982,7 +1059,7 @@ void ts::EITGenerator::regenerateSchedule(const Time& now)
                         const ESectionPtr sec(new ESection(this, service_id, table_id, first_section_number, first_section_number));
                         CheckNonNull(sec.pointer());
                         seg.sections.push_back(sec);
-                        enqueueInjectSection(sec, getCurrentTime(), true);
+                        enqueueInjectSection(sec, getCurrentTime());
                     }
                 }
 
@@ -1095,9 +1172,18 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         return;
     }
 
+    // Nothing can change before the next known update time, unless the EPG was modified or the time moved backward.
+    if (_next_update != Time::Epoch && now >= _update_time && now < _next_update) {
+        return;
+    }
+
     // Reference time for EIT schedule.
     const Time last_midnight(now.thisDay());
 
+    // The end of the current segment is the latest next update time (this includes next midnight).
+    _update_time = now;
+    _next_update = EIT::SegmentStartTime(now) + EIT::SEGMENT_DURATION;
+
     // Loop on all services.
     for (auto& srv_iter : _services) {
 
@@ -1114,6 +1200,7 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         auto seg_iter = srv.segments.begin();
         while (seg_iter != srv.segments.end() && (*seg_iter)->start_time + EIT::SEGMENT_DURATION <= now) {
             ESegment& seg(**seg_iter);
+            srv.unindexEvents(seg.events);
             seg.events.clear();
             if (seg.sections.size() != 1 || seg.sections.front()->section->payloadSize() != EIT::EIT_PAYLOAD_FIXED_SIZE) {
                 // There are more than one section or the unique section contains events.
@@ -1126,6 +1213,7 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
         if (seg_iter != srv.segments.end()) {
             ESegment& seg(**seg_iter);
             while (!seg.events.empty() && seg.events.front()->end_time <= now) {
+                srv.unindexEvent(seg.events.front());
                 seg.events.pop_front();
                 // Regenerate the segment, unless we use the lazy update mode.
                 if (!(_options & EITOptions::LAZY_SCHED_UPDATE)) {
@@ -1134,8 +1222,19 @@ void ts::EITGenerator::updateForNewTime(const Time& now)
             }
         }
 
+        // The next update time for the service is the end of the first event in the current segment
+        // or the start of the first future event (the EIT p/f will change at that time).
+        for (auto it = seg_iter; it != srv.segments.end(); ++it) {
+            if (!(*it)->events.empty()) {
+                const Event& ev(*(*it)->events.front());
+                _next_update = std::min(_next_update, ev.start_time > now ? ev.start_time : ev.end_time);
+                break;
+            }
+        }
+
         // Discard events too far in the future.
         while (!srv.segments.empty() && srv.segments.back()->start_time >= last_midnight + EIT::TOTAL_DAYS * MilliSecPerDay) {
+            srv.unindexEvents(srv.segments.back()->events);
             srv.segments.pop_back();
         }
 
@@ -1167,32 +1266,23 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
 
     // Make sure no section for the last injected {tid,tidext} is scheduled for _section_gap milliseconds.
     if (_last_tid != TID_NULL) {
-        ESectionList& list(_injects[_last_index]);
+        ESectionQueue& queue(_injects[_last_index]);
         const Time next_inject = now + _section_gap;
         int gap_count = 0;
-        auto it = list.begin();
-        while (it != list.end() && (*it)->next_inject < next_inject) {
-            if ((*it)->section->tableId() != _last_tid || (*it)->section->tableIdExtension() != _last_tidext) {
+        auto it = queue.begin();
+        while (it != queue.end() && it->first < next_inject) {
+            if (it->second->section->tableId() != _last_tid || it->second->section->tableIdExtension() != _last_tidext) {
                 ++it;
             }
             else {
                 // We have a section with the same {tid,tidext}, need to reschedule it later.
-                const ESectionPtr next_sec = *it;
+                const ESectionPtr next_sec = it->second;
                 _duck.report().log(2, u"reschedule section %d at %s", {next_sec->section->sectionNumber(), next_inject});
-                it = list.erase(it);
-                // We can't call enqueueInjectSection() since we are currently walking through the same
-                // list and enqueueInjectSection() may change "it" iterator. Insert manually.
-                // Also reschedule each section "_section_gap" later than the previous one.
+                it = queue.erase(it);
+                // Reschedule each section "_section_gap" later than the previous one, before other sections
+                // with the same injection time. The new time is after the explored range, "it" remains valid.
                 next_sec->next_inject = next_inject + gap_count++ * _section_gap;
-                auto it1 = it;
-                while (it1 != list.end() && (*it1)->next_inject < next_sec->next_inject) {
-                    ++it1;
-                }
-                const bool same_place = it1 == it;
-                it1 = list.insert(it1, next_sec);
-                if (same_place) {
-                    it = it1;
-                }
+                queue.insert(queue.lower_bound(next_sec->next_inject), std::make_pair(next_sec->next_inject, next_sec));
             }
         }
         _last_tid = TID_NULL;
@@ -1203,11 +1293,11 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
 
         // Check if the first section in the queue is ready for injection.
         // Loop on obsolete events. Return on first injected event.
-        while (!_injects[index].empty() && _injects[index].front()->next_inject <= now) {
+        while (!_injects[index].empty() && _injects[index].begin()->first <= now) {
 
             // Remove the first section from the queue.
-            const ESectionPtr sec(_injects[index].front());
-            _injects[index].pop_front();
+            const ESectionPtr sec(_injects[index].begin()->second);
+            _injects[index].erase(_injects[index].begin());
 
             if (sec->obsolete) {
                 // This is an obsolete section, no longer in the base, drop it.
@@ -1220,7 +1310,7 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
                 sec->injected = true;
 
                 // Requeue next iteration of that section.
-                enqueueInjectSection(sec, now + _profile.repetitionSeconds(*sec->section) * MilliSecPerSec, false);
+                enqueueInjectSection(sec, now + _profile.repetitionSeconds(*sec->section) * MilliSecPerSec);
                 _duck.report().log(2, u"inject section TID 0x%X (%<d), service 0x%X (%<d), at %s, requeue for %s",
                                    {section->tableId(), section->tableIdExtension(), now, sec->next_inject});
                 _last_tid = section->tableId();
@@ -1350,7 +1440,7 @@ void ts::EITGenerator::dumpInternalState(int lev) const
             rep.log(lev, u"");
             rep.log(lev, u"- Injection queue #%d: %d sections", {index, _injects[index].size()});
             for (auto it = _injects[index].begin(); it != _injects[index].end(); ++it) {
-                dumpSection(lev, u"  - ", *it);
+                dumpSection(lev, u"  - ", it->second);
             }
         }
         rep.log(lev, u"");
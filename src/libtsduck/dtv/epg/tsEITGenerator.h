@@ -66,6 +66,11 @@ namespace ts {
     //! Events can also be individually loaded, outside EIT sections but using the same binary
     //! format as in EIT, from field @a event_id to end of descriptor list.
     //!
+    //! Events are indexed by event id in each service. Loading an event with the same event id
+    //! as an existing event in the same service replaces it. A single event can be removed using
+    //! EITGenerator::deleteEvent(). In all cases, only the EIT sections which contain modified
+    //! events are rebuilt.
+    //!
     //! Principle of operation
     //! ----------------------
     //! The EITGenerator object is continuously invoked for all packets in a TS. Packets from
@@ -263,6 +268,9 @@ namespace ts {
         //! If the clock is not yet defined, all events are stored and obsolete events will be discarded
         //! when the clock is defined for the first time.
         //!
+        //! An event with the same event id as an existing event in the same service replaces it.
+        //! Reloading an identical event has no effect.
+        //!
         //! @param [in] service Service id triplet for all events in the binary data.
         //! @param [in] data Address of binary events data. Each event is described using
         //! the same format as in an EIT section, from the @a event_id field to the end of the
@@ -303,6 +311,15 @@ namespace ts {
         //!
         bool loadEvents(const SectionFile& sections, bool get_actual_ts = false) { return loadEvents(sections.sections(), get_actual_ts); }
 
+        //!
+        //! Delete one event from the EPG database.
+        //! Only the EIT sections which contained the event are rebuilt.
+        //! @param [in] service Service id triplet of the event.
+        //! @param [in] event_id Event id of the event to delete.
+        //! @return True if the event was found and deleted, false if it was not found.
+        //!
+        bool deleteEvent(const ServiceIdTriplet& service, uint16_t event_id);
+
         //!
         //! Save all current EIT sections.
         //! If the current time is not set, the oldest event time in the EPG database is used.
@@ -349,6 +366,7 @@ namespace ts {
 
         typedef SafePtr<Event> EventPtr;
         typedef std::list<EventPtr> EventList;
+        typedef std::map<uint16_t, EventPtr> EventMap;    // index of events by event id
 
         // -----------------------------
         // Description of an EIT section
@@ -379,6 +397,7 @@ namespace ts {
 
         typedef SafePtr<ESection> ESectionPtr;
         typedef std::list<ESectionPtr> ESectionList;      // a list of EIT schedule sections
+        typedef std::multimap<Time, ESectionPtr> ESectionQueue;  // sections, indexed by next injection time
         typedef std::array<ESectionPtr, 2> ESectionPair;  // a pair of EIT p/f sections
 
         // ------------------------------------------------------------------
@@ -413,9 +432,14 @@ namespace ts {
             bool         regenerate {false};  // Some segments must be regenerated in the service.
             ESectionPair pf {};               // EIT p/f sections (0: present, 1: following).
             ESegmentList segments {};         // List of 3-hour segments (EPG events and EIT schedule sections).
+            EventMap     events {};           // Index of all events in all segments, by event id.
 
             // Constructor.
             EService() = default;
+
+            // Remove events from the index when they are removed from their segment.
+            void unindexEvent(const EventPtr& ev);
+            void unindexEvents(const EventList& evs);
         };
 
         // -------------------
@@ -430,12 +454,12 @@ namespace ts {
         // The injection lists are organized by repetition profile, in order of profile
         // priority (from EIT p/f actual to EID sched other/later). In each list, all
         // sections have the same profile and, consequently, the same repetition rate.
-        // The sections are sorted in order of next injection. When a section is ready
-        // to inject, it is passed to the packetizer and requeued at the end of the list
-        // for the next injection.
+        // The sections are indexed by next injection time, in order of insertion for the
+        // same time. When a section is ready to inject, it is passed to the packetizer
+        // and requeued for the next injection.
 
         typedef std::map<ServiceIdTriplet, EService> EServiceMap;
-        typedef std::array<ESectionList, EITRepetitionProfile::PROFILE_COUNT> ESectionListArray;
+        typedef std::array<ESectionQueue, EITRepetitionProfile::PROFILE_COUNT> ESectionQueueArray;
 
         // ---------------------------
         // EITGenerator private fields
@@ -446,6 +470,8 @@ namespace ts {
         uint16_t             _actual_ts_id {0};          // Actual transport stream id (to differentiate EIT actual and others).
         bool                 _actual_ts_id_set {false};  // Boolean: value in _actual_ts_id is valid.
         bool                 _regenerate {false};        // Some segments must be regenerated in some services.
+        Time                 _update_time {};            // Time of last update of the EIT database.
+        Time                 _next_update {};            // Time of next required update of the EIT database (Epoch if unknown).
         PacketCounter        _packet_index {0};          // Packet counter in the TS.
         BitRate              _max_bitrate {0};           // Max EIT bitrate.
         BitRate              _ts_bitrate {0};            // Declared TS bitrate.
@@ -458,7 +484,7 @@ namespace ts {
         SectionDemux         _demux;                     // Section demux for input stream, get PAT, TDT, TOT, EIT.
         Packetizer           _packetizer;                // Packetizer for generated EIT's.
         EServiceMap          _services {};               // Map of services -> segments -> events and sections.
-        ESectionListArray    _injects {};                // Arrays of sections for injection.
+        ESectionQueueArray   _injects {};                // Arrays of sections for injection.
         MilliSecond          _section_gap {30};          // Minimum gap between sections of the same tid/tidext, DVB specifies at least 25 ms.
         TID                  _last_tid {TID_NULL};       // TID of last injected section, or 0.
         uint16_t             _last_tidext {0};           // TIDEXT of last injected section.
@@ -472,8 +498,15 @@ namespace ts {
         // Update the EIT database according to the current time.
         // Obsolete events, sections and segments are discarded.
         // Segments which must be regenerated are marked as such (will be actually regenerated later, when used).
+        // Nothing is done before the next time where some event or segment may change.
         void updateForNewTime(const Time& now);
 
+        // Get the segment of a service with the specified start time, create it if it does not exist.
+        ESegment& getSegment(const ServiceIdTriplet& service_id, EService& srv, const Time& seg_start_time);
+
+        // Remove an event from a service and mark its segment for regeneration.
+        void removeEvent(EService& srv, const EventPtr& ev);
+
         // Regenerate, if necessary, EIT p/f in a service. Return true if section is modified.
         void regeneratePresentFollowing(const ServiceIdTriplet& service_id, EService& srv, const Time& now);
         bool regeneratePresentFollowingSection(const ServiceIdTriplet& service_id, ESectionPtr& sec, TID tid, bool section_number, const EventPtr& event, const Time&inject_time);
@@ -490,7 +523,7 @@ namespace ts {
         void markObsoleteSegment(ESegment& seg);
 
         // Enqueue a section for injection.
-        void enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject, bool try_front);
+        void enqueueInjectSection(const ESectionPtr& sec, const Time& next_inject);
 
         // Helper for dumpInternalState()
         void dumpSection(int level, const UString& margin, const ESectionPtr& section) const;
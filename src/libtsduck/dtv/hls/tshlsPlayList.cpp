@@ -549,12 +549,27 @@ bool ts::hls::PlayList::reload(bool strict, const WebRequestArgs args, ts::Repor
         return false;
     }
     assert(plNew._valid);
+
+    // Add new segments. Autosave if necessary, ignore errors.
+    if (merge(plNew, report)) {
+        autoSave(report);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Update a media playlist with a more recent version of the same playlist.
+//----------------------------------------------------------------------------
+
+bool ts::hls::PlayList::merge(PlayList& plNew, Report& report)
+{
     report.debug(u"playlist media sequence: old: %d/%s, new: %d/%d", {_mediaSequence, _segments.size(), plNew._mediaSequence, plNew._segments.size()});
 
     // If no new segment is present, nothing to do.
-    if (plNew._mediaSequence + plNew._segments.size() <= _mediaSequence + _segments.size()) {
+    if (!plNew._valid || plNew._mediaSequence + plNew._segments.size() <= _mediaSequence + _segments.size()) {
         report.debug(u"no new segment in playlist");
-        return true;
+        return false;
     }
 
     // Copy global characteristics.
@@ -579,10 +594,6 @@ bool ts::hls::PlayList::reload(bool strict, const WebRequestArgs args, ts::Repor
             _segments.push_back(plNew._segments[i]);
         }
     }
-
-    // Autosave if necessary, ignore errors.
-    autoSave(report);
-
     return true;
 }
 
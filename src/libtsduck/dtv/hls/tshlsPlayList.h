@@ -106,6 +106,17 @@ namespace ts {
             //!
             bool reload(bool strict = false, const WebRequestArgs args = WebRequestArgs(), Report& report = CERR);
 
+            //!
+            //! Update a media playlist with the content of a more recent version of the same playlist.
+            //! This is the second half of reload(), without download. It is useful when the new version
+            //! of the playlist is loaded in another object, for instance outside a critical section.
+            //! New segments are added. If a segment hole is found, all previous content is replaced.
+            //! @param [in,out] plNew The new version of the playlist. Its content is modified.
+            //! @param [in,out] report Where to report errors.
+            //! @return True if new segments were added, false if there is no new segment.
+            //!
+            bool merge(PlayList& plNew, Report& report = CERR);
+
             //!
             //! Set a directory name where all loaded files or URL are automatically saved.
             //! @param [in] dir A directory name.
@@ -0,0 +1,19 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Declare if bulk operations on TS packets are accelerated.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+// A global constant private boolean which is defined when the accelerated
+// module is compiled with accelerated instructions.
+extern const bool tsTSPacketIsAccelerated;
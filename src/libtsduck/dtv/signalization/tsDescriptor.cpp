@@ -12,7 +12,6 @@
 #include "tsAbstractTable.h"
 #include "tsPSIRepository.h"
 #include "tsxmlElement.h"
-#include "tsNames.h"
 
 
 //----------------------------------------------------------------------------
@@ -132,7 +131,7 @@ ts::EDID ts::Descriptor::edid(PDS pds, TID tid) const
         return EDID();  // invalid value.
     }
     const DID did = tag();
-    if (tid != TID_NULL && names::HasTableSpecificName(did, tid)) {
+    if (tid != TID_NULL && PSIRepository::Instance()->hasTableSpecificName(did, tid)) {
         // Table-specific descriptor.
         return EDID::TableSpecific(did, tid);
     }
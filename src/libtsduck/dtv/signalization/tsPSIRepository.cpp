@@ -10,6 +10,7 @@
 #include "tsDuckContext.h"
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
+#include "tsGuardMutex.h"
 #include "tsNames.h"
 
 TS_DEFINE_SINGLETON(ts::PSIRepository);
@@ -21,12 +22,21 @@ TS_DEFINE_SINGLETON(ts::PSIRepository);
 
 ts::PSIRepository::PSIRepository() :
     _tables(),
+    _tablesIndex(),
+    _tablesStandards(),
+    _tablesPIDs(),
+    _tablesWithPIDs(),
     _descriptors(),
+    _standardDescriptors(),
+    _tableSpecificTags(),
     _tableNames(),
     _descriptorNames(),
     _descriptorTablesIds(),
     _casIdDescriptorDisplays(),
-    _xmlModelFiles()
+    _xmlModelFiles(),
+    _namesMutex(),
+    _namesLoaded(),
+    _namesTags()
 {
 }
 
@@ -100,29 +110,31 @@ FUNCTION ts::PSIRepository::getTableFunction(TID tid, Standards standards, PID p
     FUNCTION fallbackFunc = nullptr;
     size_t fallbackCount = 0;
 
-    // Look for an exact match.
-    for (auto it = _tables.lower_bound(tid); it != _tables.end() && it->first == tid; ++it) {
+    // Look for an exact match in the contiguous range of descriptions for this table id.
+    for (size_t index = _tablesIndex[tid]; index < _tablesIndex[tid + 1]; ++index) {
+        const TableDescription& desc(_tables[index]);
+
         // Ignore entries for which the searched function is not present.
-        if (it->second.*member != nullptr) {
+        if (desc.*member != nullptr) {
 
             // If the table in a standard PID, this is an exact match.
-            if (it->second.hasPID(pid)) {
-                return it->second.*member;
+            if (desc.hasPID(pid)) {
+                return desc.*member;
             }
 
             // CAS match: either a CAS is specified and is in range, or no CAS specified and CAS-agnostic table (all CASID_NULL).
-            const bool casMatch = cas >= it->second.minCAS && cas <= it->second.maxCAS;
+            const bool casMatch = cas >= desc.minCAS && cas <= desc.maxCAS;
 
             // Standard match: at least one standard of the table is current, or standard-agnostic table (Standards::NONE).
-            const bool stdMatch = bool(standards & it->second.standards) || it->second.standards == Standards::NONE;
+            const bool stdMatch = bool(standards & desc.standards) || desc.standards == Standards::NONE;
 
             if (stdMatch && casMatch) {
                 // Found an exact match, no need to search further.
-                return it->second.*member;
+                return desc.*member;
             }
-            else if (it->second.minCAS == CASID_NULL) {
+            else if (desc.minCAS == CASID_NULL) {
                 // Not the right standard but a CAS-agnostic table, use as potential fallback.
-                fallbackFunc = it->second.*member;
+                fallbackFunc = desc.*member;
                 fallbackCount++;
             }
         }
@@ -140,22 +152,94 @@ FUNCTION ts::PSIRepository::getTableFunction(TID tid, Standards standards, PID p
 template <typename FUNCTION, typename std::enable_if<std::is_pointer<FUNCTION>::value>::type*>
 FUNCTION ts::PSIRepository::getDescriptorFunction(const EDID& edid, TID tid, FUNCTION DescriptorDescription::* member) const
 {
-    auto it(_descriptors.end());
-
-    if (edid.isStandard() && tid != TID_NULL) {
-        // For standard descriptors, first search a table-specific descriptor.
-        it = _descriptors.find(EDID::TableSpecific(edid.did(), tid));
-        // If not found and there is a table-specific name for the descriptor,
-        // do not fallback to non-table-specific function for this descriptor.
-        if (it == _descriptors.end() && (edid.isTableSpecific() || names::HasTableSpecificName(edid.did(), tid))) {
-            return nullptr;
+    if (edid.isStandard()) {
+        const DID did = edid.did();
+        if (tid != TID_NULL) {
+            // For standard descriptors, first search a table-specific descriptor.
+            if (_tableSpecificTags.test(did)) {
+                const auto it = _descriptors.find(EDID::TableSpecific(did, tid));
+                if (it != _descriptors.end()) {
+                    return it->second.*member;
+                }
+            }
+            // If not found and there is a table-specific name for the descriptor,
+            // do not fallback to non-table-specific function for this descriptor.
+            if (hasTableSpecificName(did, tid)) {
+                return nullptr;
+            }
         }
+        // Direct access to standard descriptors.
+        const DescriptorDescription* const desc = _standardDescriptors[did];
+        return desc != nullptr ? desc->*member : nullptr;
     }
-    if (it == _descriptors.end()) {
-        // If non-standard or no table-specific descriptor found, use direct lookup.
-        it = _descriptors.find(edid);
+    else {
+        // Non-standard descriptors, use direct lookup.
+        const auto it = _descriptors.find(edid);
+        return it != _descriptors.end() ? it->second.*member : nullptr;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a descriptor tag has a table-specific name in the names file.
+//----------------------------------------------------------------------------
+
+bool ts::PSIRepository::hasTableSpecificName(DID did, TID tid) const
+{
+    if (tid == TID_NULL || did >= 0x80) {
+        return false;
+    }
+
+    // Load all descriptor tags for this table id from the names file on first use.
+    if (!_namesLoaded[tid].load(std::memory_order_acquire)) {
+        GuardMutex lock(_namesMutex);
+        if (!_namesLoaded[tid].load(std::memory_order_relaxed)) {
+            for (DID tag = 0; tag < 0x80; ++tag) {
+                _namesTags[tid].set(tag, names::HasTableSpecificName(tag, tid));
+            }
+            _namesLoaded[tid].store(true, std::memory_order_release);
+        }
+    }
+    return _namesTags[tid].test(did);
+}
+
+
+//----------------------------------------------------------------------------
+// Add a table description for a table id.
+//----------------------------------------------------------------------------
+
+void ts::PSIRepository::addTable(TID tid, const TableDescription& desc)
+{
+    // Distinct definitions for the same table id accumulate, in registration order.
+    // Insert the description at the end of the range of this table id.
+    _tables.insert(_tables.begin() + _tablesIndex[tid + 1], desc);
+    for (size_t i = tid + 1; i < _tablesIndex.size(); ++i) {
+        _tablesIndex[i]++;
+    }
+
+    // Recompute the common subset of all standards for this table id.
+    Standards standards = Standards::NONE;
+    for (size_t index = _tablesIndex[tid]; index < _tablesIndex[tid + 1]; ++index) {
+        if (standards == Standards::NONE) {
+            // No standard found yet, use all standards from this definition.
+            standards = _tables[index].standards;
+        }
+        else {
+            // Some standards were already found, keep only the common subset.
+            standards &= _tables[index].standards;
+        }
+    }
+    _tablesStandards[tid] = standards;
+
+    // Register the standard PID's of the table. The first definition for a PID is used.
+    for (size_t i = 0; i < desc.pids.size() && desc.pids[i] != PID_NULL; ++i) {
+        const TablePID tpid(tid, desc.pids[i], desc.standards);
+        const auto it = std::lower_bound(_tablesPIDs.begin(), _tablesPIDs.end(), tpid);
+        if (it == _tablesPIDs.end() || it->tid != tid || it->pid != tpid.pid) {
+            _tablesPIDs.insert(it, tpid);
+            _tablesWithPIDs.set(tid);
+        }
     }
-    return it != _descriptors.end() ? it->second.*member : nullptr;
 }
 
 
@@ -203,9 +287,8 @@ ts::PSIRepository::RegisterTable::RegisterTable(TableFactory factory,
     desc.addPIDs(pids);
 
     // Store a copy of the table description for each table id.
-    // This is a multimap, distinct definitions for the same table id accumulate.
     for (auto it : tids) {
-        PSIRepository::Instance()->_tables.insert(std::make_pair(it, desc));
+        repo->addTable(it, desc);
     }
 }
 
@@ -233,7 +316,18 @@ ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DescriptorFactory fact
                                                           const UString& xmlNameLegacy)
 {
     registerXML(factory, edid, xmlName, xmlNameLegacy);
-    PSIRepository::Instance()->_descriptors.insert(std::make_pair(edid, DescriptorDescription(factory, displayFunction)));
+
+    // Only one description is used per extended descriptor id, the first one.
+    PSIRepository* const repo = PSIRepository::Instance();
+    const auto it = repo->_descriptors.insert(std::make_pair(edid, DescriptorDescription(factory, displayFunction))).first;
+
+    // Keep direct access to standard descriptors. Pointers to std::map elements remain valid.
+    if (edid.isStandard()) {
+        repo->_standardDescriptors[edid.did()] = &it->second;
+    }
+    else if (edid.isTableSpecific()) {
+        repo->_tableSpecificTags.set(edid.did());
+    }
 }
 
 void ts::PSIRepository::RegisterDescriptor::registerXML(DescriptorFactory factory, const EDID& edid, const UString& xmlName, const UString& xmlNameLegacy)
@@ -319,23 +413,16 @@ ts::DisplayCADescriptorFunction ts::PSIRepository::getCADescriptorDisplay(uint16
 
 ts::Standards ts::PSIRepository::getTableStandards(TID tid, PID pid) const
 {
-    // Accumulate the common subset of all standards for this table id.
-    Standards standards = Standards::NONE;
-    for (auto it = _tables.lower_bound(tid); it != _tables.end() && it->first == tid; ++it) {
-        if (it->second.hasPID(pid)) {
-            // We are in a standard PID for this table id, return the corresponding standards only.
-            return it->second.standards;
-        }
-        else if (standards == Standards::NONE) {
-            // No standard found yet, use all standards from first definition.
-            standards = it->second.standards;
-        }
-        else {
-            // Some standards were already found, keep only the common subset.
-            standards &= it->second.standards;
+    // If we are in a standard PID for this table id, return the corresponding standards only.
+    if (pid != PID_NULL && _tablesWithPIDs.test(tid)) {
+        const auto it = std::lower_bound(_tablesPIDs.begin(), _tablesPIDs.end(), TablePID(tid, pid));
+        if (it != _tablesPIDs.end() && it->tid == tid && it->pid == pid) {
+            return it->standards;
         }
     }
-    return standards;
+
+    // Otherwise, return the precomputed common subset of all standards for this table id.
+    return _tablesStandards[tid];
 }
 
 
@@ -392,12 +479,9 @@ ts::UString ts::PSIRepository::descriptorTables(const DuckContext& duck, const U
 void ts::PSIRepository::getRegisteredTableIds(std::vector<TID>& ids) const
 {
     ids.clear();
-    TID previous = TID_NULL;
-    for (const auto& it : _tables) {
-        // This is a multimap, the same key can be reused, use it once only.
-        if (it.first != previous) {
-            ids.push_back(it.first);
-            previous = it.first;
+    for (size_t tid = 0; tid < TID_MAX; ++tid) {
+        if (_tablesIndex[tid] < _tablesIndex[tid + 1]) {
+            ids.push_back(TID(tid));
         }
     }
 }
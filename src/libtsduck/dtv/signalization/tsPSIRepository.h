@@ -18,6 +18,7 @@
 #include "tsTablesPtr.h"
 #include "tsSingletonManager.h"
 #include "tsVersionInfo.h"
+#include "tsMutex.h"
 
 namespace ts {
 
@@ -35,6 +36,11 @@ namespace ts {
     //! single thread). Then, the singleton is only read during the execution of the
     //! application. So, no explicit synchronization is required.
     //!
+    //! Lookup performance: table ids and descriptor tags are 8-bit values. The repository
+    //! maintains, at registration time, flat arrays which are directly indexed by table id
+    //! or descriptor tag. Lookups by table id or standard descriptor tag, which are performed
+    //! for each section or descriptor, do not walk any tree.
+    //!
     //! @ingroup mpeg
     //!
     class TSDUCKDLL PSIRepository
@@ -87,6 +93,16 @@ namespace ts {
         //!
         DescriptorFactory getDescriptorFactory(const EDID& edid, TID tid = TID_NULL) const;
 
+        //!
+        //! Check if a descriptor tag has a table-specific meaning in a given table.
+        //! This is equivalent to names::HasTableSpecificName() but the result is cached
+        //! per table id and can be used for each descriptor in the packet processing path.
+        //! @param [in] did Descriptor tag.
+        //! @param [in] tid Table id of the table containing the descriptor.
+        //! @return True if the descriptor tag has a table-specific name for this table id.
+        //!
+        bool hasTableSpecificName(DID did, TID tid) const;
+
         //!
         //! Get the table factory for a given XML node name.
         //! @param [in] nodeName Name of XML node.
@@ -343,15 +359,45 @@ namespace ts {
             DescriptorDescription(DescriptorFactory fact = nullptr, DisplayDescriptorFunction disp = nullptr);
         };
 
+        // Standards of a table id in one of its standard PID's.
+        class TablePID
+        {
+        public:
+            TID       tid;        // Table id.
+            PID       pid;        // Standard PID for this table id.
+            Standards standards;  // Standards of the first registered description of this table id in this PID.
+
+            // Constructor.
+            TablePID(TID t = TID_NULL, PID p = PID_NULL, Standards s = Standards::NONE) : tid(t), pid(p), standards(s) {}
+
+            // Sort by table id, then PID.
+            bool operator<(const TablePID& other) const { return tid < other.tid || (tid == other.tid && pid < other.pid); }
+        };
+
         // PSIRepository instance private members.
-        std::multimap<TID, TableDescription>            _tables;                   // Description of all table ids, potential multiple entries per table idx
+        std::vector<TableDescription>                   _tables;                   // Description of all table ids, sorted by table id, potential multiple entries per table id.
+        std::array<size_t, TID_MAX + 1>                 _tablesIndex;              // Index in _tables of first description of each table id, last one is the end of _tables.
+        std::array<Standards, TID_MAX>                  _tablesStandards;          // Common subset of standards of all descriptions for each table id.
+        std::vector<TablePID>                           _tablesPIDs;               // Standards per table id in standard PID's, sorted by table id and PID.
+        std::bitset<TID_MAX>                            _tablesWithPIDs;           // Table ids with at least one standard PID.
         std::map<EDID, DescriptorDescription>           _descriptors;              // Description of all descriptors, by extended id.
+        std::array<const DescriptorDescription*, 0x100> _standardDescriptors;  // Direct access to standard descriptors in _descriptors, by descriptor tag.
+        std::bitset<0x100>                              _tableSpecificTags;    // Descriptor tags with at least one table-specific descriptor.
         std::map<UString, TableFactory>                 _tableNames;               // XML table name to table factory
         std::map<UString, DescriptorFactory>            _descriptorNames;          // XML descriptor name to descriptor factory
         std::multimap<UString, TID>                     _descriptorTablesIds;      // XML descriptor name to table id for table-specific descriptors
         std::map<uint16_t, DisplayCADescriptorFunction> _casIdDescriptorDisplays;  // CA_system_id to display function for CA_descriptor.
         UStringList                                     _xmlModelFiles;            // Additional XML model files for tables.
 
+        // Cache of table-specific names of descriptors from the names file, by table id, then descriptor tag (< 0x80).
+        // The names file is loaded on demand, a table id is loaded when first used, after registration.
+        mutable Mutex                                   _namesMutex;               // Protects the loading of _namesTags.
+        mutable std::array<std::atomic<bool>, TID_MAX>  _namesLoaded;              // Table ids for which _namesTags is loaded.
+        mutable std::array<std::bitset<0x80>, TID_MAX>  _namesTags;                // Descriptor tags with table-specific name, per table id.
+
+        // Add a table description for a table id.
+        void addTable(TID tid, const TableDescription& desc);
+
         // Common code to lookup a table function.
         template <typename FUNCTION, typename std::enable_if<std::is_pointer<FUNCTION>::value>::type* = nullptr>
         FUNCTION getTableFunction(TID tid, Standards standards, PID pid, uint16_t cas, FUNCTION TableDescription::* member) const;
@@ -328,6 +328,30 @@ ts::ByteBlock ts::Section::hash() const
 }
 
 
+//----------------------------------------------------------------------------
+// Get a 64-bit fingerprint of the section content.
+//----------------------------------------------------------------------------
+
+uint64_t ts::Section::fingerprint() const
+{
+    if (!isValid()) {
+        return 0;
+    }
+    const uint8_t* const data = content();
+    const size_t sec_size = size();
+    if (isLongSection()) {
+        // CRC32, section size, table id, table id extension, version, section number.
+        return (uint64_t(GetUInt32(data + sec_size - SECTION_CRC32_SIZE)) << 32) |
+               (uint64_t(sec_size & 0x0FFF) << 20) |
+               ((uint64_t(data[0]) ^ (uint64_t(GetUInt16(data + 3)) << 4) ^ (uint64_t(data[5]) << 12) ^ (uint64_t(data[6]) << 1)) & 0x000FFFFF);
+    }
+    else {
+        // Computed CRC32, section size, table id.
+        return (uint64_t(CRC32(data, sec_size).value()) << 32) | (uint64_t(sec_size & 0x0FFF) << 20) | data[0];
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of AbstractDefinedByStandards.
 //----------------------------------------------------------------------------
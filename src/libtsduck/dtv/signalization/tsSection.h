@@ -356,6 +356,18 @@ namespace ts {
         //!
         ByteBlock hash() const;
 
+        //!
+        //! Get a 64-bit fingerprint of the section content.
+        //! This is much faster than hash() but not collision-resistant. This is typically
+        //! used to detect duplicate sections. The fingerprint is built from the CRC32 of
+        //! the section, the section size and the main header fields. For long sections,
+        //! the CRC32 field in the section is used and is assumed to be correct (already
+        //! checked by the demux or recomputed). For short sections, a CRC32 of the content
+        //! is computed.
+        //! @return The section fingerprint or zero if the section is invalid.
+        //!
+        uint64_t fingerprint() const;
+
         //!
         //! Minimum number of TS packets required to transport the section.
         //! @return The minimum number of TS packets required to transport the section.
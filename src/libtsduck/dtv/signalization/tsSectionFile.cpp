@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsSectionFile.h"
+#include "tsTablesWriter.h"
 #include "tsSection.h"
 #include "tsAbstractTable.h"
 #include "tsBinaryTable.h"
@@ -15,7 +16,8 @@
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
 #include "tsxmlJSONConverter.h"
-#include "tsjsonNull.h"
+#include "tsxmlStreamingDocument.h"
+#include "tsjsonValue.h"
 #include "tsFileUtils.h"
 #include "tsEIT.h"
 
@@ -542,23 +544,23 @@ bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
 
 bool ts::SectionFile::loadXML(const UString& file_name)
 {
-    xml::Document doc(_report);
+    xml::StreamingDocument doc(_report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(file_name, false) && parseDocument(doc);
+    return doc.open(file_name) && parseStreamingDocument(doc);
 }
 
 bool ts::SectionFile::loadXML(std::istream& strm)
 {
-    xml::Document doc(_report);
+    xml::StreamingDocument doc(_report);
     doc.setTweaks(_xmlTweaks);
-    return doc.load(strm) && parseDocument(doc);
+    return doc.open(strm) && parseStreamingDocument(doc);
 }
 
 bool ts::SectionFile::parseXML(const UString& xml_content)
 {
-    xml::Document doc(_report);
+    xml::StreamingDocument doc(_report);
     doc.setTweaks(_xmlTweaks);
-    return doc.parse(xml_content) && parseDocument(doc);
+    return doc.openText(xml_content) && parseStreamingDocument(doc);
 }
 
 bool ts::SectionFile::parseDocument(const xml::Document& doc)
@@ -579,19 +581,42 @@ bool ts::SectionFile::parseDocument(const xml::Document& doc)
 
     // Analyze all tables in the document.
     for (const xml::Element* node = root == nullptr ? nullptr : root->firstChildElement(); node != nullptr; node = node->nextSiblingElement()) {
-        BinaryTablePtr bin(new BinaryTable);
-        CheckNonNull(bin.pointer());
-        if (bin->fromXML(_duck, node) && bin->isValid()) {
-            add(bin);
-        }
-        else {
-            doc.report().error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
-            success = false;
-        }
+        success = parseTable(node) && success;
     }
     return success;
 }
 
+bool ts::SectionFile::parseStreamingDocument(xml::StreamingDocument& doc)
+{
+    // Load the XML model for TSDuck files, if not already done.
+    // Then validate the root element, before any table is parsed.
+    if (!loadThisModel() || !_model.validate(doc)) {
+        return false;
+    }
+
+    // Analyze the tables one by one, as they are parsed. The XML representation of a table
+    // is deleted when the next one is parsed. Each table is validated according to the model.
+    bool success = true;
+    for (const xml::Element* node = doc.nextElement(); node != nullptr; node = doc.nextElement()) {
+        success = _model.validate(doc) && parseTable(node) && success;
+    }
+    return doc.isValid() && success;
+}
+
+bool ts::SectionFile::parseTable(const xml::Element* node)
+{
+    BinaryTablePtr bin(new BinaryTable);
+    CheckNonNull(bin.pointer());
+    if (bin->fromXML(_duck, node) && bin->isValid()) {
+        add(bin);
+        return true;
+    }
+    else {
+        _report.error(u"Error in table <%s> at line %d", {node->name(), node->lineNumber()});
+        return false;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Create XML file or text.
@@ -599,16 +624,15 @@ bool ts::SectionFile::parseDocument(const xml::Document& doc)
 
 bool ts::SectionFile::saveXML(const UString& file_name) const
 {
-    xml::Document doc(_report);
-    doc.setTweaks(_xmlTweaks);
-    return generateDocument(doc) && doc.save(file_name);
+    TablesWriter writer(_duck);
+    return writeDocument(writer, FileType::XML, file_name, std::cout);
 }
 
 ts::UString ts::SectionFile::toXML() const
 {
-    xml::Document doc(_report);
-    doc.setTweaks(_xmlTweaks);
-    return generateDocument(doc) ? doc.toString() : UString();
+    TablesWriter writer(_duck);
+    std::ostringstream strm;
+    return writeDocument(writer, FileType::XML, UString(), strm) ? UString::FromUTF8(strm.str()) : UString();
 }
 
 
@@ -657,61 +681,50 @@ bool ts::SectionFile::parseJSON(const UString& json_content)
 // Create JSON file or text.
 //----------------------------------------------------------------------------
 
-ts::json::ValuePtr ts::SectionFile::convertToJSON()
-{
-    xml::Document doc(_report);
-    doc.setTweaks(_xmlTweaks);
-
-    // Load the XML model, generate the initial XML document, convert XML into JSON.
-    if (loadThisModel() && generateDocument(doc)) {
-        return _model.convertToJSON(doc);
-    }
-    else {
-        return json::ValuePtr(new json::Null);
-    }
-}
-
 bool ts::SectionFile::saveJSON(const UString& file_name)
 {
-    const json::ValuePtr root(convertToJSON());
-    return !root->isNull() && root->save(file_name, 2, true, _report);
+    TablesWriter writer(_duck, &_model);
+    return loadThisModel() && writeDocument(writer, FileType::JSON, file_name, std::cout);
 }
 
 ts::UString ts::SectionFile::toJSON()
 {
-    const json::ValuePtr root(convertToJSON());
-    if (root->isNull()) {
+    TablesWriter writer(_duck, &_model);
+    std::ostringstream strm;
+    if (!loadThisModel() || !writeDocument(writer, FileType::JSON, UString(), strm)) {
         return UString();
     }
-    TextFormatter text(_report);
-    text.setString();
-    root->print(text);
-    return text.toString();
+    // A JSON text is returned without trailing end-of-line.
+    UString text(UString::FromUTF8(strm.str()));
+    while (!text.empty() && text.back() == LINE_FEED) {
+        text.pop_back();
+    }
+    return text;
 }
 
 
 //----------------------------------------------------------------------------
-// Generate an XML document.
+// Write all tables in an XML or JSON document, one by one.
 //----------------------------------------------------------------------------
 
-bool ts::SectionFile::generateDocument(xml::Document& doc) const
+bool ts::SectionFile::writeDocument(TablesWriter& writer, FileType type, const UString& file_name, std::ostream& strm) const
 {
-    // Initialize the document structure.
-    xml::Element* root = doc.initialize(u"tsduck");
-    if (root == nullptr) {
+    writer.setTweaks(_xmlTweaks);
+    if (!writer.open(type, file_name, strm)) {
         return false;
     }
 
-    // Format all tables.
+    // Format all tables. Invalid tables are ignored.
     for (auto& table : _tables) {
         if (!table.isNull()) {
-            table->toXML(_duck, root);
+            writer.write(*table);
         }
     }
+    writer.close();
 
     // Issue a warning if incomplete tables were not saved.
     if (!_orphanSections.empty()) {
-        doc.report().warning(u"%d orphan sections not saved in XML document (%d tables saved)", {_orphanSections.size(), _tables.size()});
+        _report.warning(u"%d orphan sections not saved in %s document (%d tables saved)", {_orphanSections.size(), type == FileType::JSON ? u"JSON" : u"XML", _tables.size()});
     }
 
     return true;
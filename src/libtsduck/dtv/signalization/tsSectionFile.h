@@ -25,6 +25,9 @@
 #include "tsTablesPtr.h"
 
 namespace ts {
+
+    class TablesWriter;
+
     //!
     //! A binary or XML file containing PSI/SI sections and tables.
     //! @ingroup mpeg
@@ -177,6 +180,7 @@ namespace ts {
         //!
         //! Load an XML file.
         //! The loaded tables are added to the content of this object.
+        //! The XML document is parsed one table at a time, the complete XML document is never built in memory.
         //! @param [in] file_name XML file name.
         //! If the file name starts with "<?xml", this is considered as "inline XML content".
         //! If the file name is empty or "-", the standard input is used.
@@ -231,6 +235,7 @@ namespace ts {
 
         //!
         //! Save an XML file.
+        //! The tables are serialized one by one, the complete XML document is never built in memory.
         //! @param [in] file_name XML file name.
         //! If the file name is empty or "-", the standard output is used.
         //! @return True on success, false on error.
@@ -239,6 +244,7 @@ namespace ts {
 
         //!
         //! Save a JSON file after automated XML-to-JSON conversion.
+        //! The tables are serialized and converted one by one, the complete XML document is never built in memory.
         //! @param [in] file_name JSON file name.
         //! If the file name is empty or "-", the standard output is used.
         //! @return True on success, false on error.
@@ -498,13 +504,16 @@ namespace ts {
         // Parse an XML document.
         bool parseDocument(const xml::Document& doc);
 
-        // Generate an XML document.
-        bool generateDocument(xml::Document& doc) const;
+        // Parse an XML document on the fly, one table at a time.
+        bool parseStreamingDocument(xml::StreamingDocument& doc);
+
+        // Parse one XML table and add it in the file.
+        bool parseTable(const xml::Element* node);
+
+        // Write all tables in an XML or JSON document, one by one.
+        bool writeDocument(TablesWriter& writer, FileType type, const UString& file_name, std::ostream& strm) const;
 
         // Check it a table can be formed using the last sections in _orphanSections.
         void collectLastTable();
-
-        // Generate a JSON document. Point to a JSON Null literal on error.
-        json::ValuePtr convertToJSON();
     };
 }
@@ -35,9 +35,9 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _report(_duck.report()),
     _demux(_duck),
     _cas_mapper(_duck),
-    _xml_doc(_report),
     _x2j_conv(_report),
-    _json_doc(_report),
+    _xml_writer(_duck),
+    _json_writer(_duck, &_x2j_conv),
     _sock(false, _report)
 {
     // Create an instance of each registered section filter.
@@ -173,9 +173,9 @@ void ts::TablesLogger::defineArgs(Args& args)
     args.option(u"no-deep-duplicate");
     args.help(u"no-deep-duplicate",
               u"Do not report identical sections in the same PID, even when non-consecutive. "
-              u"A hash of each section is kept for each PID and later identical sections are not reported.\n"
-              u"Warning: This option accumulates memory for hash values of all sections since the beginning. "
-              u"Do not use that option for commands running too long or the process may crash with insufficient memory.");
+              u"A fingerprint of each section is kept for each PID and later identical sections are not reported. "
+              u"The memory for fingerprints is bounded. When more than one million distinct sections are found, "
+              u"the sections which were not seen for the longest time may be reported again.");
 
     args.option(u"no-duplicate");
     args.help(u"no-duplicate",
@@ -367,11 +367,11 @@ bool ts::TablesLogger::open()
     _packet_count = 0;
     _demux.reset();
     _cas_mapper.reset();
-    _xml_doc.clear();
-    _json_doc.close();
+    _xml_writer.close();
+    _json_writer.close();
     _short_sections.clear();
     _last_sections.clear();
-    _deep_hashes.clear();
+    _deep_fingerprints.clear();
     _sections_once.clear();
 
     if (_bin_file.is_open()) {
@@ -411,28 +411,23 @@ bool ts::TablesLogger::open()
         return false;
     }
 
-    // Set XML options in document and converter.
-    _xml_doc.setTweaks(_xml_tweaks);
+    // Set XML options in writers and converter.
     _x2j_conv.setTweaks(_xml_tweaks);
+    _xml_writer.setTweaks(_xml_tweaks);
+    _xml_writer.setXMLOptions(_xml_options);
+    _json_writer.setTweaks(_xml_tweaks);
+    _json_writer.setXMLOptions(_xml_options);
 
     // Open/create the XML output.
-    if (_use_xml && !_rewrite_xml && _xml_doc.open(u"tsduck", u"", _xml_destination, std::cout) == nullptr) {
+    if (_use_xml && !_rewrite_xml && !_xml_writer.open(SectionFile::FileType::XML, _xml_destination, std::cout)) {
         _abort = true;
         return false;
     }
 
     // Open/create the JSON output.
-    if (_use_json && !_rewrite_json) {
-        json::ValuePtr root;
-        if (_xml_tweaks.x2jIncludeRoot) {
-            root = new json::Object;
-            root->add(u"#name", u"tsduck");
-            root->add(u"#nodes", json::ValuePtr(new json::Array));
-        }
-        if (!_json_doc.open(root, _json_destination, std::cout)) {
-            _abort = true;
-            return false;
-        }
+    if (_use_json && !_rewrite_json && !_json_writer.open(SectionFile::FileType::JSON, _json_destination, std::cout)) {
+        _abort = true;
+        return false;
     }
 
     // Open/create the binary output.
@@ -476,8 +471,8 @@ void ts::TablesLogger::close()
         }
 
         // Close files and documents.
-        _xml_doc.close();
-        _json_doc.close();
+        _xml_writer.close();
+        _json_writer.close();
         if (_bin_file.is_open()) {
             _bin_file.close();
         }
@@ -509,18 +504,18 @@ void ts::TablesLogger::feedPacket(const TSPacket& pkt)
 // Detect and track duplicate section by PID.
 //----------------------------------------------------------------------------
 
-bool ts::TablesLogger::isDuplicate(PID pid, const Section& section, std::map<PID,ByteBlock> TablesLogger::* tracker)
+bool ts::TablesLogger::isDuplicate(PID pid, const Section& section, std::map<PID,uint64_t> TablesLogger::* tracker)
 {
-    // Get a SHA-1 for the section.
-    const ByteBlock hash(section.hash());
-    ByteBlock& last((this->*tracker)[pid]);
-    if (last.empty() || last != hash) {
-        // Not the same section, keep the hash for next time.
-        last = hash;
+    // Get a fingerprint for the section.
+    const uint64_t fp = section.fingerprint();
+    uint64_t& last((this->*tracker)[pid]);
+    if (last == 0 || last != fp) {
+        // Not the same section, keep the fingerprint for next time.
+        last = fp;
         return false;
     }
     else {
-        // Same section (same hash) as previously.
+        // Same section (same fingerprint) as previously.
         return true;
     }
 }
@@ -532,18 +527,9 @@ bool ts::TablesLogger::isDuplicate(PID pid, const Section& section, std::map<PID
 
 bool ts::TablesLogger::isDeepDuplicate(PID pid, const Section& section)
 {
-    // Get a SHA-1 for the section.
-    const ByteBlock hash(section.hash());
-    auto& set(_deep_hashes[pid]);
-    if (set.find(hash) == set.end()) {
-        // Section not yet found on that PID, keep the hash for next time.
-        set.insert(hash);
-        return false;
-    }
-    else {
-        // Section already found.
-        return true;
-    }
+    // Get a fingerprint for the section. Mix the PID in the CRC32 part to track all PID's in the same set.
+    // Inserting the fingerprint returns false if it was already present.
+    return !_deep_fingerprints.insert(section.fingerprint() ^ (uint64_t(pid) << 32));
 }
 
 
@@ -600,37 +586,20 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         postDisplay();
     }
 
-    // Save table in XML format.
-    if (_use_xml) {
+    // Save table in XML format. In case of rewrite, create a new document each time.
+    // Otherwise, just add the table in the running document.
+    if (_use_xml && (!_rewrite_xml || _xml_writer.open(SectionFile::FileType::XML, _xml_destination, std::cout))) {
+        _xml_writer.write(table);
         if (_rewrite_xml) {
-            // Build and save a new document each time.
-            xml::Document doc(_report);
-            doc.initialize(u"tsduck");
-            table.toXML(_duck, doc.rootElement(), _xml_options);
-            doc.save(_xml_destination, 2);
-        }
-        else {
-            // Just add the table in the running doc.
-            // Convert the table into an XML structure, print and delete the XML table.
-            table.toXML(_duck, _xml_doc.rootElement(), _xml_options);
-            _xml_doc.flush();
+            _xml_writer.close();
         }
     }
 
-    // Save table in JSON format.
-    if (_use_json) {
-        // First, build an XML document with the table.
-        xml::Document doc(_report);
-        doc.initialize(u"tsduck");
-        table.toXML(_duck, doc.rootElement(), _xml_options);
+    // Save table in JSON format, same principle.
+    if (_use_json && (!_rewrite_json || _json_writer.open(SectionFile::FileType::JSON, _json_destination, std::cout))) {
+        _json_writer.write(table);
         if (_rewrite_json) {
-            // Convert to JSON and save a new document each time.
-            _x2j_conv.convertToJSON(doc)->save(_json_destination, 2, true, _report);
-        }
-        else {
-            // Convert to JSON. Force "tsduck" root to appear so that the path to the first table is always the same.
-            // Query the first (and only) converted table and add it to the running document.
-            _json_doc.add(_x2j_conv.convertToJSON(doc, true)->query(u"#nodes[0]"));
+            _json_writer.close();
         }
     }
 
@@ -739,7 +708,7 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
 
     // Ignore duplicate sections.
     if (_no_duplicate && isDuplicate(pid, sect, &TablesLogger::_last_sections)) {
-        // Same section (same hash) as previously, ignore it.
+        // Same section (same fingerprint) as previously, ignore it.
         return;
     }
     if (_no_deep_duplicate && isDeepDuplicate(pid, sect)) {
@@ -20,10 +20,10 @@
 #include "tsUDPSocket.h"
 #include "tsCASMapper.h"
 #include "tsxmlTweaks.h"
-#include "tsxmlRunningDocument.h"
 #include "tsxmlJSONConverter.h"
-#include "tsjsonRunningDocument.h"
+#include "tsTablesWriter.h"
 #include "tsDuckProtocol.h"
+#include "tsFingerprintSet.h"
 
 namespace ts {
     //!
@@ -211,14 +211,14 @@ namespace ts {
         PacketCounter            _packet_count = 0;
         SectionDemux             _demux;
         CASMapper                _cas_mapper;
-        xml::RunningDocument     _xml_doc;                   // XML document, built on-the-fly.
         xml::JSONConverter       _x2j_conv;                  // XML-to-JSON converter.
-        json::RunningDocument    _json_doc;                  // JSON document, built on-the-fly.
+        TablesWriter             _xml_writer;                // XML document, built on-the-fly.
+        TablesWriter             _json_writer;               // JSON document, built on-the-fly.
         std::ofstream            _bin_file {};               // Binary output file.
         UDPSocket                _sock;                      // Output socket.
-        std::map<PID,ByteBlock>  _short_sections {};         // Tracking duplicate short sections by PID with a section hash.
-        std::map<PID,ByteBlock>  _last_sections {};          // Tracking duplicate sections by PID with a section hash (with --all-sections).
-        std::map<PID,std::set<ByteBlock>> _deep_hashes {};   // Tracking of deep duplicate sections.
+        std::map<PID,uint64_t>   _short_sections {};         // Tracking duplicate short sections by PID with a section fingerprint.
+        std::map<PID,uint64_t>   _last_sections {};          // Tracking duplicate sections by PID with a section fingerprint (with --all-sections).
+        FingerprintSet           _deep_fingerprints {};      // Tracking of deep duplicate sections, fingerprints include the PID.
         std::set<uint64_t>       _sections_once {};          // Tracking sets of PID/TID/TDIext/secnum/version with --all-once.
         TablesLoggerFilterVector _section_filters {};        // All registered section filters.
         duck::Protocol           _duck_protocol {};          // To generate UDP messages.
@@ -249,7 +249,7 @@ namespace ts {
         void logInvalid(const DemuxedData&, const UString&);
 
         // Detect and track duplicate section by PID.
-        bool isDuplicate(PID pid, const Section& section, std::map<PID,ByteBlock> TablesLogger::* tracker);
+        bool isDuplicate(PID pid, const Section& section, std::map<PID,uint64_t> TablesLogger::* tracker);
         bool isDeepDuplicate(PID pid, const Section& section);
     };
 
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTablesWriter.h"
+#include "tsDuckContext.h"
+#include "tsjsonArray.h"
+#include "tsjsonObject.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::TablesWriter::TablesWriter(DuckContext& duck, const xml::JSONConverter* model) :
+    _duck(duck),
+    _report(duck.report()),
+    _ext_model(model),
+    _own_model(_report),
+    _xml_doc(_report),
+    _json_doc(_report)
+{
+}
+
+ts::TablesWriter::~TablesWriter()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the XML model to use for JSON conversion.
+//----------------------------------------------------------------------------
+
+const ts::xml::JSONConverter* ts::TablesWriter::model()
+{
+    if (_ext_model != nullptr) {
+        return _ext_model;
+    }
+    else if (_own_model.hasChildren() || SectionFile::LoadModel(_own_model, true)) {
+        return &_own_model;
+    }
+    else {
+        return nullptr;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Open the output document.
+//----------------------------------------------------------------------------
+
+bool ts::TablesWriter::open(SectionFile::FileType type, const UString& file_name, std::ostream& strm)
+{
+    // Cleanup previous state.
+    close();
+
+    if (type == SectionFile::FileType::XML) {
+        _xml_doc.setTweaks(_tweaks);
+        if (_xml_doc.open(u"tsduck", u"", file_name, strm) == nullptr) {
+            return false;
+        }
+        _xml_empty = true;
+        _xml_file_name = file_name;
+        _xml_strm = &strm;
+    }
+    else if (type == SectionFile::FileType::JSON) {
+        if (model() == nullptr) {
+            return false;
+        }
+        _own_model.setTweaks(_tweaks);
+        // The root of the JSON document is either an array of tables or the object for the XML root.
+        json::ValuePtr root;
+        if (_tweaks.x2jIncludeRoot) {
+            root = new json::Object;
+            root->add(u"#name", u"tsduck");
+            root->add(u"#nodes", json::ValuePtr(new json::Array));
+        }
+        if (!_json_doc.open(root, file_name, strm)) {
+            return false;
+        }
+    }
+    else {
+        _report.error(u"invalid output document type, must be XML or JSON");
+        return false;
+    }
+
+    _type = type;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Write a table in the output document.
+//----------------------------------------------------------------------------
+
+bool ts::TablesWriter::write(const BinaryTable& table)
+{
+    if (_type == SectionFile::FileType::XML) {
+        // Build the XML representation of the table directly in the running document.
+        // It is printed and deleted in flush().
+        const bool ok = table.toXML(_duck, _xml_doc.rootElement(), _xml_options) != nullptr;
+        _xml_doc.flush();
+        _xml_empty = false;
+        return ok;
+    }
+    else if (_type == SectionFile::FileType::JSON) {
+        // Build a transient XML document containing the table only, convert it and print it.
+        xml::Document doc(_report);
+        doc.setTweaks(_tweaks);
+        if (doc.initialize(u"tsduck") == nullptr || table.toXML(_duck, doc.rootElement(), _xml_options) == nullptr) {
+            return false;
+        }
+        _json_doc.add(model()->convertToJSON(doc, true)->query(u"#nodes[0]"));
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Close the output document.
+//----------------------------------------------------------------------------
+
+void ts::TablesWriter::close()
+{
+    // A running XML document is printed with the first table only. Without table, print an empty document.
+    const bool print_empty = _type == SectionFile::FileType::XML && _xml_empty;
+    _xml_doc.close();
+    if (print_empty) {
+        TextFormatter text(_report);
+        if (_xml_file_name.empty() || _xml_file_name == u"-") {
+            text.setStream(*_xml_strm);
+        }
+        else {
+            text.setFile(_xml_file_name);
+        }
+        xml::Document doc(_report);
+        doc.setTweaks(_tweaks);
+        if (text.isOpen() && doc.initialize(u"tsduck") != nullptr) {
+            doc.print(text);
+        }
+        text.close();
+    }
+    _json_doc.close();
+    _type = SectionFile::FileType::UNSPECIFIED;
+}
@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Write tables one by one in an XML or JSON document.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsSectionFile.h"
+#include "tsBinaryTable.h"
+#include "tsxmlTweaks.h"
+#include "tsxmlRunningDocument.h"
+#include "tsxmlJSONConverter.h"
+#include "tsjsonRunningDocument.h"
+
+namespace ts {
+    //!
+    //! Write tables one by one in an XML or JSON document.
+    //! @ingroup mpeg
+    //!
+    //! The output document is produced on the fly. Each table is converted and printed
+    //! as soon as it is written. The memory footprint is limited to the representation
+    //! of one table, regardless of the number of tables in the document.
+    //!
+    //! This is not a DOM-less serializer. Tables and descriptors only know how to serialize
+    //! themselves into an XML element. Each table is therefore built as a transient XML DOM
+    //! which is printed and deleted. With JSON output, this transient DOM is additionally
+    //! converted into a transient JSON value, using the XML model of the tables.
+    //!
+    //! The output is identical to the serialization of a complete XML document containing
+    //! all tables or its automated XML-to-JSON conversion, as produced by SectionFile.
+    //!
+    class TSDUCKDLL TablesWriter
+    {
+        TS_NOBUILD_NOCOPY(TablesWriter);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in,out] duck TSDuck execution context. The reference is kept inside this object.
+        //! @param [in] model Optional XML model for tables, already loaded, to use for JSON output.
+        //! When null, the XML model is loaded by this object when a JSON document is opened.
+        //! When not null, the referenced object must remain valid as long as this object.
+        //!
+        explicit TablesWriter(DuckContext& duck, const xml::JSONConverter* model = nullptr);
+
+        //!
+        //! Destructor.
+        //!
+        ~TablesWriter();
+
+        //!
+        //! Set new formatting tweaks for XML and JSON documents.
+        //! Must be called before open().
+        //! @param [in] tweaks XML tweaks.
+        //!
+        void setTweaks(const xml::Tweaks& tweaks) { _tweaks = tweaks; }
+
+        //!
+        //! Set new options to convert tables to XML.
+        //! @param [in] options Conversion options.
+        //!
+        void setXMLOptions(const BinaryTable::XMLOptions& options) { _xml_options = options; }
+
+        //!
+        //! Open the output document.
+        //! @param [in] type Type of document, must be either SectionFile::FileType::XML or SectionFile::FileType::JSON.
+        //! @param [in] file_name Output file name to create. When empty or "-", @a strm is used for output.
+        //! @param [in,out] strm The default output text stream when @a file_name is empty or "-".
+        //! The referenced stream object must remain valid until close() is called.
+        //! @return True on success, false on error.
+        //!
+        bool open(SectionFile::FileType type, const UString& file_name = UString(), std::ostream& strm = std::cout);
+
+        //!
+        //! Check if the output document is open.
+        //! @return True if the output document is open.
+        //!
+        bool isOpen() const { return _type != SectionFile::FileType::UNSPECIFIED; }
+
+        //!
+        //! Write a table in the output document.
+        //! @param [in] table The table to write.
+        //! @return True on success, false on error.
+        //!
+        bool write(const BinaryTable& table);
+
+        //!
+        //! Close the output document.
+        //! An XML document without table is printed as an empty root element.
+        //!
+        void close();
+
+    private:
+        DuckContext&              _duck;
+        Report&                   _report;
+        const xml::JSONConverter* _ext_model;       // External XML model, if any.
+        xml::JSONConverter        _own_model;       // XML model, loaded by this object.
+        xml::Tweaks               _tweaks {};       // XML formatting tweaks.
+        BinaryTable::XMLOptions   _xml_options {};  // XML conversion options.
+        SectionFile::FileType     _type {SectionFile::FileType::UNSPECIFIED};
+        xml::RunningDocument      _xml_doc;         // XML document, built on-the-fly.
+        bool                      _xml_empty {true};      // No table was written in the XML document.
+        UString                   _xml_file_name {};      // Output XML file name.
+        std::ostream*             _xml_strm {nullptr};    // Default output stream for XML document.
+        json::RunningDocument     _json_doc;        // JSON document, built on-the-fly.
+
+        // Get the XML model to use for JSON conversion, null if cannot be loaded.
+        const xml::JSONConverter* model();
+    };
+}
@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsDatagramPacer.h"
+
+#if !defined(TS_CXX17)
+constexpr ts::NanoSecond ts::DatagramPacer::DEFAULT_SPIN;
+constexpr ts::NanoSecond ts::DatagramPacer::MAX_GAP;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Re-initialize the state and the statistics.
+//----------------------------------------------------------------------------
+
+void ts::DatagramPacer::reset()
+{
+    _pid = _user_pid;
+    _pkt_count = 0;
+    _synced = false;
+    _base_ts = 0;
+    _last_ts = _prev_ts = _datagram_ts = INVALID_PCR;
+    _last_ts_pkt = _prev_ts_pkt = 0;
+    _scheduled = _unscheduled = _late = _resync = 0;
+    _jitter.reset();
+}
+
+
+//----------------------------------------------------------------------------
+// Duration of a number of packets in PCR units, INVALID_PCR if unknown.
+//----------------------------------------------------------------------------
+
+uint64_t ts::DatagramPacer::duration(PacketCounter packets, const BitRate& bitrate) const
+{
+    if (_prev_ts != INVALID_PCR && _last_ts_pkt > _prev_ts_pkt) {
+        // Use the rate between the last two time stamps, more accurate than the average bitrate.
+        return (packets * (_last_ts - _prev_ts)) / (_last_ts_pkt - _prev_ts_pkt);
+    }
+    else if (bitrate > 0) {
+        return ((packets * PKT_SIZE_BITS * uint64_t(SYSTEM_CLOCK_FREQ)) / bitrate).toInt();
+    }
+    else {
+        return INVALID_PCR;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Store a new time stamp reference.
+//----------------------------------------------------------------------------
+
+void ts::DatagramPacer::setReference(uint64_t ts, PacketCounter index)
+{
+    if (_last_ts != INVALID_PCR && ts >= _last_ts && index > _last_ts_pkt) {
+        _prev_ts = _last_ts;
+        _prev_ts_pkt = _last_ts_pkt;
+    }
+    else if (_last_ts == INVALID_PCR || index != _last_ts_pkt) {
+        // First time stamp or time stamps going backward (wrap-down or discontinuity).
+        _prev_ts = INVALID_PCR;
+    }
+    _last_ts = ts;
+    _last_ts_pkt = index;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the time stamp of the first packet in a datagram.
+//----------------------------------------------------------------------------
+
+uint64_t ts::DatagramPacer::getTimeStamp(const TSPacket* packets, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate)
+{
+    // Look for the first time stamp in the datagram.
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t ts = INVALID_PCR;
+        if (_use_timestamps) {
+            if (metadata != nullptr && metadata[i].hasInputTimeStamp()) {
+                ts = metadata[i].getInputTimeStamp();
+            }
+        }
+        else if (packets[i].hasPCR()) {
+            const PID pid = packets[i].getPID();
+            if (_pid == PID_NULL) {
+                _pid = pid;
+            }
+            if (pid == _pid) {
+                ts = packets[i].getPCR();
+            }
+        }
+        if (ts != INVALID_PCR) {
+            setReference(ts, _pkt_count + i);
+            if (i == 0) {
+                return ts;
+            }
+            // Compute the theoretical time stamp of the first packet in the datagram.
+            const uint64_t offset = duration(i, bitrate);
+            return offset == INVALID_PCR || offset > ts ? ts : ts - offset;
+        }
+    }
+
+    // No time stamp in the datagram, extrapolate from the last one.
+    if (_last_ts != INVALID_PCR) {
+        const uint64_t offset = duration(_pkt_count - _last_ts_pkt, bitrate);
+        if (offset != INVALID_PCR) {
+            return _last_ts + offset;
+        }
+    }
+    else if (bitrate > 0) {
+        // No time stamp was ever found, start a virtual time line based on the bitrate.
+        setReference(0, _pkt_count);
+        return 0;
+    }
+    return INVALID_PCR;
+}
+
+
+//----------------------------------------------------------------------------
+// Compute the due time of the next datagram.
+//----------------------------------------------------------------------------
+
+bool ts::DatagramPacer::dueTime(const TSPacket* packets, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate, Monotonic& due)
+{
+    const uint64_t ts = getTimeStamp(packets, metadata, count, bitrate);
+    _pkt_count += count;
+
+    if (ts == INVALID_PCR) {
+        _unscheduled++;
+        return false;
+    }
+
+    const Monotonic now(true);
+    const bool discontinuity = _datagram_ts != INVALID_PCR &&
+        (ts < _datagram_ts || (NanoSecPerMicroSec * (ts - _datagram_ts)) / (SYSTEM_CLOCK_FREQ / MicroSecPerSec) > MAX_GAP);
+    _datagram_ts = ts;
+
+    if (_synced && !discontinuity && ts >= _base_ts) {
+        due = _base_clock;
+        due += (NanoSecPerMicroSec * (ts - _base_ts)) / (SYSTEM_CLOCK_FREQ / MicroSecPerSec);
+        if (now - due <= MAX_GAP) {
+            _scheduled++;
+            return true;
+        }
+    }
+
+    // Initial synchronization or resynchronization after a discontinuity or an input stall.
+    // The time stamp of this datagram becomes the reference at the current time.
+    if (_synced) {
+        _resync++;
+    }
+    _synced = true;
+    _base_ts = ts;
+    _base_clock = now;
+    due = now;
+    _scheduled++;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until the due time of a datagram and update the statistics.
+//----------------------------------------------------------------------------
+
+void ts::DatagramPacer::wait(const Monotonic& due)
+{
+    Monotonic now(true);
+    if (now >= due) {
+        // The datagram was not ready before its due time. It is considered as late
+        // when it is beyond the precision of the active polling.
+        if (now - due > _spin) {
+            _late++;
+        }
+        return;
+    }
+
+    // Hybrid sleep until due time, then measure the actual wake-up delay.
+    due.preciseWait(_spin);
+    now.getSystemTime();
+    _jitter.feed(double(now - due) / double(NanoSecPerMicroSec));
+}
+
+
+//----------------------------------------------------------------------------
+// Report the statistics on the pacing precision.
+//----------------------------------------------------------------------------
+
+void ts::DatagramPacer::reportStatistics(Report& report, int level) const
+{
+    report.log(level, u"pacing: %'d datagrams scheduled, %'d unscheduled, %'d late, %'d resynchronizations",
+               {_scheduled, _unscheduled, _late, _resync});
+    if (_jitter.count() > 0) {
+        report.log(level, u"pacing: wake-up delay after due time: mean %s us, std deviation %s us, max %.2f us",
+                   {_jitter.meanString(), _jitter.standardDeviationString(), _jitter.maximum()});
+    }
+}
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Schedule the transmission of datagrams containing TS packets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+#include "tsMonotonic.h"
+#include "tsSingleDataStatistics.h"
+
+namespace ts {
+    //!
+    //! Schedule the transmission of datagrams containing TS packets.
+    //! @ingroup mpeg
+    //! @see PCRRegulator
+    //!
+    //! The transmission time of each datagram is computed from the time stamp of its first
+    //! TS packet. This time stamp is either the PCR of a reference PID or the input time
+    //! stamp of the packet. Between two time stamps, the time of each packet is interpolated.
+    //! Datagrams are then sent at their due time with a sub-millisecond precision using
+    //! a hybrid sleep (system timer followed by active polling of the clock).
+    //!
+    //! Statistics on the achieved precision are collected and can be reported.
+    //!
+    class TSDUCKDLL DatagramPacer
+    {
+        TS_NOCOPY(DatagramPacer);
+    public:
+        //!
+        //! Constructor.
+        //!
+        DatagramPacer() = default;
+
+        //!
+        //! Default duration before the due time where the clock is actively polled, in nanoseconds.
+        //!
+        static constexpr NanoSecond DEFAULT_SPIN = 200 * NanoSecPerMicroSec;
+
+        //!
+        //! Maximum gap in time stamps between two datagrams or maximum lateness of a datagram.
+        //! Beyond this value, the stream is considered as discontinuous and the pacing is resynchronized.
+        //!
+        static constexpr NanoSecond MAX_GAP = NanoSecPerSec;
+
+        //!
+        //! Set the duration before the due time where the clock is actively polled.
+        //! @param [in] spin Duration in nanoseconds.
+        //!
+        void setSpin(NanoSecond spin) { _spin = spin; }
+
+        //!
+        //! Set the PCR reference PID.
+        //! @param [in] pid Reference PID. If PID_NULL, use the first PID containing PCR's.
+        //!
+        void setReferencePID(PID pid) { _user_pid = pid; }
+
+        //!
+        //! Use input time stamps of packets instead of PCR's.
+        //! @param [in] on If true, use input time stamps from packet metadata.
+        //!
+        void setUseTimeStamps(bool on) { _use_timestamps = on; }
+
+        //!
+        //! Re-initialize the state and the statistics.
+        //!
+        void reset();
+
+        //!
+        //! Compute the due time of the next datagram.
+        //! Must be called once per datagram, in sequence.
+        //! @param [in] packets Address of the first TS packet in the datagram.
+        //! @param [in] metadata Address of the metadata of the first TS packet. Can be null.
+        //! @param [in] count Number of TS packets in the datagram.
+        //! @param [in] bitrate Current bitrate, used to interpolate time stamps when necessary. Ignored if zero.
+        //! @param [out] due Due time of the datagram.
+        //! @return True if @a due is valid, false if the datagram cannot be scheduled and shall be sent immediately.
+        //!
+        bool dueTime(const TSPacket* packets, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate, Monotonic& due);
+
+        //!
+        //! Wait until the due time of a datagram and update the statistics.
+        //! @param [in] due Due time, as returned by dueTime().
+        //!
+        void wait(const Monotonic& due);
+
+        //!
+        //! Report the statistics on the pacing precision.
+        //! @param [in,out] report Where to report the statistics.
+        //! @param [in] level Severity level of the message.
+        //!
+        void reportStatistics(Report& report, int level = Severity::Info) const;
+
+    private:
+        // Configuration.
+        NanoSecond     _spin {DEFAULT_SPIN};         // Active polling duration before due time.
+        PID            _user_pid {PID_NULL};         // User-specified reference PID.
+        bool           _use_timestamps {false};      // Use input time stamps instead of PCR's.
+
+        // Time references.
+        PID            _pid {PID_NULL};              // Current reference PID.
+        PacketCounter  _pkt_count {0};               // Index of first packet in next datagram.
+        bool           _synced {false};              // The clock base is set.
+        uint64_t       _base_ts {0};                 // Time stamp at clock base, in PCR units.
+        Monotonic      _base_clock {};               // System time at clock base.
+        uint64_t       _last_ts {INVALID_PCR};       // Last time stamp, in PCR units.
+        PacketCounter  _last_ts_pkt {0};             // Index of packet with last time stamp.
+        uint64_t       _prev_ts {INVALID_PCR};       // Previous time stamp.
+        PacketCounter  _prev_ts_pkt {0};             // Index of packet with previous time stamp.
+        uint64_t       _datagram_ts {INVALID_PCR};   // Time stamp of last datagram.
+
+        // Statistics.
+        PacketCounter  _scheduled {0};               // Number of scheduled datagrams.
+        PacketCounter  _unscheduled {0};             // Number of datagrams without due time.
+        PacketCounter  _late {0};                    // Number of datagrams which were ready after their due time.
+        PacketCounter  _resync {0};                  // Number of resynchronizations.
+        SingleDataStatistics<double> _jitter {};     // Wake-up delays after due time, in microseconds.
+
+        // Get the time stamp of the first packet in a datagram, INVALID_PCR if unknown.
+        uint64_t getTimeStamp(const TSPacket* packets, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate);
+
+        // Store a new time stamp reference.
+        void setReference(uint64_t ts, PacketCounter index);
+
+        // Duration of a number of packets in PCR units, INVALID_PCR if unknown.
+        uint64_t duration(PacketCounter packets, const BitRate& bitrate) const;
+    };
+}
@@ -10,6 +10,12 @@
 #include "tsMemory.h"
 #include "tsUString.h"
 
+#if !defined(TS_CXX17)
+constexpr size_t ts::PCRAnalyzer::PCR_RING_SIZE;
+constexpr size_t ts::PCRAnalyzer::PCR_RING_MASK;
+constexpr uint16_t ts::PCRAnalyzer::NO_PID_INDEX;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor and destructor.
@@ -19,7 +25,7 @@ ts::PCRAnalyzer::PCRAnalyzer(size_t min_pid, size_t min_pcr) :
     _min_pid(std::max<size_t>(1, min_pid)),
     _min_pcr(std::max<size_t>(1, min_pcr))
 {
-    TS_ZERO(_pid);
+    _pid_index.fill(NO_PID_INDEX);
 }
 
 ts::PCRAnalyzer::~PCRAnalyzer()
@@ -77,14 +83,9 @@ void ts::PCRAnalyzer::reset()
     _inst_ts_bitrate_188 = 0;
     _inst_ts_bitrate_204 = 0;
 
-    for (size_t i = 0; i < PID_MAX; ++i) {
-        if (_pid[i] != nullptr) {
-            delete _pid[i];
-            _pid[i] = nullptr;
-        }
-    }
-
-    _packet_pcr_index_map.clear();
+    _pids.clear();
+    _pid_index.fill(NO_PID_INDEX);
+    _pcr_first = _pcr_count = 0;
 }
 
 
@@ -119,12 +120,34 @@ void ts::PCRAnalyzer::processDiscontinuity()
     _discontinuities++;
 
     // All collected PCR's become invalid since at least one packet is missing.
-    for (size_t i = 0; i < PID_MAX; ++i) {
-        if (_pid[i] != nullptr) {
-            _pid[i]->last_pcr_value = INVALID_PCR;
+    for (auto& pa : _pids) {
+        pa.last_pcr_value = INVALID_PCR;
+    }
+    _pcr_first = _pcr_count = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Drop PCR/DTS values which are older than one second from the ring buffer.
+//----------------------------------------------------------------------------
+
+void ts::PCRAnalyzer::purgePCRRing(uint64_t pcr_dts)
+{
+    // Note that the ring buffer covers PCR/DTS packets across all PIDs. As long as the
+    // clocks used to generate the PCR/DTS values for different programs are the same,
+    // there should be no issue. But if the PCR/DTS values across the programs are wildly
+    // different, then the following approach won't work. Because the values are kept
+    // in packet order, wrapping up at the maximum PCR/DTS value is not an issue.
+    while (_pcr_count > 0) {
+        const uint64_t diff_values = pcrDistance(_pcr_ring[_pcr_first].pcr_dts, pcr_dts);
+        // A distance of more than half the PCR range means that the oldest value is slightly
+        // in the future of the current one (PID's with slightly different clocks), keep it.
+        if (diff_values <= SYSTEM_CLOCK_FREQ || diff_values > PCR_SCALE / 2) {
+            break;
         }
+        _pcr_first = (_pcr_first + 1) & PCR_RING_MASK;
+        _pcr_count--;
     }
-    _packet_pcr_index_map.clear();
 }
 
 
@@ -161,14 +184,16 @@ ts::BitRate ts::PCRAnalyzer::instantaneousBitrate204() const
 
 ts::BitRate ts::PCRAnalyzer::bitrate188(PID pid) const
 {
-    return (pid >= PID_MAX || _ts_bitrate_cnt == 0 || _ts_pkt_cnt == 0 || _pid[pid] == nullptr) ? 0 :
-        BitRate((_ts_bitrate_188 * _pid[pid]->ts_pkt_cnt) / (_ts_bitrate_cnt * _ts_pkt_cnt));
+    const PIDAnalysis* const pa = pidAnalysis(pid);
+    return (_ts_bitrate_cnt == 0 || _ts_pkt_cnt == 0 || pa == nullptr) ? 0 :
+        BitRate((_ts_bitrate_188 * pa->ts_pkt_cnt) / (_ts_bitrate_cnt * _ts_pkt_cnt));
 }
 
 ts::BitRate ts::PCRAnalyzer::bitrate204(PID pid) const
 {
-    return (pid >= PID_MAX || _ts_bitrate_cnt == 0 || _ts_pkt_cnt == 0 || _pid[pid] == nullptr) ? 0 :
-        BitRate((_ts_bitrate_204 * _pid[pid]->ts_pkt_cnt) / (_ts_bitrate_cnt * _ts_pkt_cnt));
+    const PIDAnalysis* const pa = pidAnalysis(pid);
+    return (_ts_bitrate_cnt == 0 || _ts_pkt_cnt == 0 || pa == nullptr) ? 0 :
+        BitRate((_ts_bitrate_204 * pa->ts_pkt_cnt) / (_ts_bitrate_cnt * _ts_pkt_cnt));
 }
 
 
@@ -178,7 +203,8 @@ ts::BitRate ts::PCRAnalyzer::bitrate204(PID pid) const
 
 ts::PacketCounter ts::PCRAnalyzer::packetCount(PID pid) const
 {
-    return (pid >= PID_MAX || _pid[pid] == nullptr) ? 0 : _pid[pid]->ts_pkt_cnt;
+    const PIDAnalysis* const pa = pidAnalysis(pid);
+    return pa == nullptr ? 0 : pa->ts_pkt_cnt;
 }
 
 
@@ -220,10 +246,11 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
     const PID pid = pkt.getPID();
     assert(pid < PID_MAX);
 
-    PIDAnalysis* ps = _pid[pid];
-    if (ps == nullptr) {
-        ps = _pid[pid] = new PIDAnalysis;
+    if (_pid_index[pid] == NO_PID_INDEX) {
+        _pid_index[pid] = uint16_t(_pids.size());
+        _pids.emplace_back();
     }
+    PIDAnalysis* const ps = &_pids[_pid_index[pid]];
 
     // Count one more packet in the PID
     ps->ts_pkt_cnt++;
@@ -285,23 +312,8 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
             BitRate ts_bitrate_204 = diff_values == 0 ? 0 :
                 BitRate((_ts_pkt_cnt - ps->last_pcr_packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
 
-            // Clear out values older than 1 second from _packet_pcr_index_map.
-            // Note that this is a map that covers PCR/DTS packets across all PIDs
-            // as long as the clocks used to generate the PCR/DTS values for different
-            // programs is the same clock, there should be no issue, but if the PCR/DTS values
-            // across the two programs are wildly different, then the following approach won't work.
-            while (!_packet_pcr_index_map.empty()) {
-                const uint64_t earliestPCR_DTS = _packet_pcr_index_map.begin()->first;
-                diff_values = _use_dts ?
-                    DiffPTS(earliestPCR_DTS, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(earliestPCR_DTS, pcr_dts);
-                if (diff_values > SYSTEM_CLOCK_FREQ) {
-                    _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
-                }
-                else {
-                    break;
-                }
-            }
+            // Clear out values older than 1 second.
+            purgePCRRing(pcr_dts);
 
             // Per-PID statistics:
             ps->ts_bitrate_188 += ts_bitrate_188;
@@ -319,14 +331,15 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
 
             // Transport stream instantaneous statistics.
             // For instantaneous bit rates, these are the actual bit rates, and it doesn't use the "count" approach.
-            if (!_packet_pcr_index_map.empty()) {
-                diff_values = _use_dts ?
-                    DiffPTS(_packet_pcr_index_map.begin()->first, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(_packet_pcr_index_map.begin()->first, pcr_dts);
-                _inst_ts_bitrate_188 = diff_values == 0 ? 0 :
-                    BitRate((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / diff_values;
-                _inst_ts_bitrate_204 = diff_values == 0 ? 0 :
-                    BitRate((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
+            if (_pcr_count > 0) {
+                const PCRPoint& oldest(_pcr_ring[_pcr_first]);
+                diff_values = pcrDistance(oldest.pcr_dts, pcr_dts);
+                if (diff_values <= PCR_SCALE / 2) {
+                    _inst_ts_bitrate_188 = diff_values == 0 ? 0 :
+                        BitRate((_ts_pkt_cnt - oldest.packet) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / diff_values;
+                    _inst_ts_bitrate_204 = diff_values == 0 ? 0 :
+                        BitRate((_ts_pkt_cnt - oldest.packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
+                }
             }
 
             // Check if we got enough values for this PID
@@ -341,14 +354,15 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
             ps->last_pcr_value = pcr_dts;
             ps->last_pcr_packet = _ts_pkt_cnt;
 
-            // Also add PCR (or DTS)/packet index combo to map for use in instantaneous bit rate calculations.
-            _packet_pcr_index_map[pcr_dts] = _ts_pkt_cnt;
-
-            // Make sure that some crazy TS does not accumulate thousands of PCR values in the same second range.
-            while (_packet_pcr_index_map.size() > FOOLPROOF_MAP_LIMIT) {
-                // Erase older entries.
-                _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
+            // Also add PCR (or DTS)/packet index combo to the ring buffer for use in instantaneous bit rate calculations.
+            // When the ring buffer is full, drop the oldest entry.
+            if (_pcr_count == PCR_RING_SIZE) {
+                _pcr_first = (_pcr_first + 1) & PCR_RING_MASK;
+                _pcr_count--;
             }
+            PCRPoint& last(_pcr_ring[(_pcr_first + _pcr_count++) & PCR_RING_MASK]);
+            last.pcr_dts = pcr_dts;
+            last.packet = _ts_pkt_cnt;
         }
     }
 
@@ -178,6 +178,15 @@ namespace ts {
         // Process a discontinuity in the transport stream
         void processDiscontinuity();
 
+        // Distance in PCR units from first to last PCR (or DTS), modulo the PCR range.
+        uint64_t pcrDistance(uint64_t first, uint64_t last) const
+        {
+            return _use_dts ? DiffPTS(first, last) * SYSTEM_CLOCK_SUBFACTOR : DiffPCR(first, last);
+        }
+
+        // Drop PCR/DTS values which are older than one second from the ring buffer.
+        void purgePCRRing(uint64_t pcr_dts);
+
         // Analysis of one PID
         struct PIDAnalysis
         {
@@ -190,6 +199,20 @@ namespace ts {
             uint64_t ts_bitrate_cnt {0};   // Count of computed TS bitrates
         };
 
+        // One PCR (or DTS) value with the index of its packet in the TS.
+        struct PCRPoint
+        {
+            uint64_t pcr_dts {0};          // PCR or DTS value
+            uint64_t packet {0};           // Index of packet containing the PCR/DTS in the TS
+        };
+
+        // The PCR/DTS values of the last second, across the entire TS, are kept in a ring buffer, in packet order.
+        // The size is a power of 2 to avoid a division. Make sure that some crazy TS does not accumulate thousands
+        // of PCR values in the same second range: when the ring buffer is full, the oldest value is dropped.
+        static constexpr size_t PCR_RING_SIZE = 1024;
+        static constexpr size_t PCR_RING_MASK = PCR_RING_SIZE - 1;
+        static constexpr uint16_t NO_PID_INDEX = 0xFFFF;
+
         // Private members:
         bool     _use_dts {false};         // Use DTS instead of PCR
         bool     _ignore_errors {false};   // Ignore TS errors such as discontinuities.
@@ -205,8 +228,16 @@ namespace ts {
         size_t   _completed_pids {0};      // Number of PIDs with enough PCRs
         size_t   _pcr_pids {0};            // Number of PIDs with PCRs
         size_t   _discontinuities {0};     // Number of discontinuities
-        PIDAnalysis* _pid[PID_MAX] {};     // Per-PID stats
-        std::map<uint64_t, uint64_t> _packet_pcr_index_map {}; // Map of PCR/DTS to packet index across entire TS
-        static constexpr size_t FOOLPROOF_MAP_LIMIT = 1000;    // Max number of entries in the PCR map
+        size_t   _pcr_first {0};           // Index of oldest PCR/DTS in _pcr_ring
+        size_t   _pcr_count {0};           // Number of PCR/DTS in _pcr_ring
+        std::vector<PIDAnalysis> _pids {}; // Per-PID stats, in order of appearance of the PID's
+        std::array<uint16_t, PID_MAX> _pid_index {};      // Index in _pids by PID, NO_PID_INDEX if none
+        std::array<PCRPoint, PCR_RING_SIZE> _pcr_ring {}; // Ring buffer of last PCR/DTS values, oldest first
+
+        // Get the analysis of a PID, null if not yet created.
+        const PIDAnalysis* pidAnalysis(PID pid) const
+        {
+            return pid < PID_MAX && _pid_index[pid] != NO_PID_INDEX ? &_pids[_pid_index[pid]] : nullptr;
+        }
     };
 }
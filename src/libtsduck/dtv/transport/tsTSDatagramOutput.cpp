@@ -11,6 +11,7 @@
 #include "tsIPProtocols.h"
 #include "tsDuckContext.h"
 #include "tsArgs.h"
+#include "tsTime.h"
 
 #if !defined(TS_CXX17)
 constexpr size_t ts::TSDatagramOutput::DEFAULT_PACKET_BURST;
@@ -36,6 +37,9 @@ ts::TSDatagramOutput::TSDatagramOutput(TSDatagramOutputOptions flags, TSDatagram
     _rtp_user_ssrc(0),
     _pcr_user_pid(PID_NULL),
     _rs204_format(false),
+    _pacing(false),
+    _pacing_timestamps(false),
+    _pacing_spin(DatagramPacer::DEFAULT_SPIN),
     _destination(),
     _local_addr(),
     _local_port(IPv4SocketAddress::AnyPort),
@@ -44,6 +48,8 @@ ts::TSDatagramOutput::TSDatagramOutput(TSDatagramOutputOptions flags, TSDatagram
     _mc_loopback(true),
     _force_mc_local(false),
     _send_bufsize(0),
+    _send_batch(UDPSocket::DEFAULT_BATCH_SIZE),
+    _use_txtime(false),
     _is_open(false),
     _rtp_sequence(0),
     _rtp_ssrc(0),
@@ -55,7 +61,14 @@ ts::TSDatagramOutput::TSDatagramOutput(TSDatagramOutputOptions flags, TSDatagram
     _pkt_count(0),
     _out_count(0),
     _out_buffer(),
-    _sock()
+    _out_mdata(),
+    _sock(),
+    _batch_slot(0),
+    _batch_buffer(),
+    _batch_msgs(),
+    _batch_count(0),
+    _pacer(),
+    _txtime(-1)
 {
 }
 
@@ -92,11 +105,6 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"With --rtp, specify the payload type. "
                   u"By default, use " + UString::Decimal(RTP_PT_MP2T) + u", the standard RTP type for MPEG2-TS.");
 
-        args.option(u"pcr-pid", 0, Args::PIDVAL);
-        args.help(u"pcr-pid",
-                  u"With --rtp, specify the PID containing the PCR's which are used as reference for RTP timestamps. "
-                  u"By default, use the first PID containing PCR's.");
-
         args.option(u"start-sequence-number", 0, Args::UINT16);
         args.help(u"start-sequence-number",
                   u"With --rtp, specify the initial sequence number. "
@@ -108,6 +116,38 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"By default, use a random value. Do not modify unless there is a good reason to do so.");
     }
 
+    // The following options are defined only when pacing is allowed.
+    if ((_flags & TSDatagramOutputOptions::ALLOW_PACING) != TSDatagramOutputOptions::NONE) {
+        args.option(u"pacing");
+        args.help(u"pacing",
+                  u"Send each datagram at the time of its first TS packet, instead of sending the datagrams as soon as "
+                  u"the packets are available. The time of each packet is computed from the PCR's of a reference PID "
+                  u"(see --pcr-pid) or from the input timestamps (see --pacing-timestamps). Between two time references, "
+                  u"the time of the packets is interpolated. This option smoothes the output of bursty inputs. "
+                  u"Statistics on the achieved pacing precision are reported at the end of the session.");
+
+        args.option(u"pacing-spin", 0, Args::UNSIGNED);
+        args.help(u"pacing-spin", u"microseconds",
+                  u"With --pacing, specify the duration before the due time of each datagram where the clock is actively polled, "
+                  u"after sleeping with the system timer. A larger value improves the precision when the system timer is "
+                  u"imprecise but uses more CPU. The default is " +
+                  UString::Decimal(DatagramPacer::DEFAULT_SPIN / NanoSecPerMicroSec) + u" microseconds.");
+
+        args.option(u"pacing-timestamps");
+        args.help(u"pacing-timestamps",
+                  u"With --pacing, use the input timestamps of the packets as time reference, instead of PCR's. "
+                  u"This is useful to reproduce the timing of a stream which was received from the network. "
+                  u"Implies --pacing.");
+    }
+
+    // The PCR PID is used with RTP or pacing.
+    if ((_flags & (TSDatagramOutputOptions::ALLOW_RTP | TSDatagramOutputOptions::ALLOW_PACING)) != TSDatagramOutputOptions::NONE) {
+        args.option(u"pcr-pid", 0, Args::PIDVAL);
+        args.help(u"pcr-pid",
+                  u"With --rtp or --pacing, specify the PID containing the PCR's which are used as time reference. "
+                  u"By default, use the first PID containing PCR's.");
+    }
+
     // The following options are defined only when raw UDP is allowed.
     if (_raw_udp) {
         args.option(u"", 0, Args::STRING, 1, 1);
@@ -153,11 +193,29 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"Use 204-byte format for TS packets in UDP datagrams. "
                   u"Each TS packet is followed by a zeroed placeholder for a 16-byte Reed-Solomon trailer.");
 
+        args.option(u"send-batch", 0, Args::POSITIVE);
+        args.help(u"send-batch", u"count",
+                  u"Specify the maximum number of UDP datagrams to send at once. "
+                  u"When supported by the operating system (Linux), the datagrams which are built "
+                  u"from the same chunk of TS packets are sent using one single system call, up to that number. "
+                  u"The default is " + UString::Decimal(UDPSocket::DEFAULT_BATCH_SIZE) + u". "
+                  u"Use 1 to send datagrams one by one.");
+
         args.option(u"tos", 's', Args::INTEGER, 0, 1, 1, 255);
         args.help(u"tos",
                   u"Specifies the TOS (Type-Of-Service) socket option. Setting this value "
                   u"may depend on the user's privilege or operating system configuration.");
 
+        if ((_flags & TSDatagramOutputOptions::ALLOW_PACING) != TSDatagramOutputOptions::NONE) {
+            args.option(u"txtime");
+            args.help(u"txtime",
+                      u"With --pacing, let the kernel transmit each datagram at its due time (socket option SO_TXTIME). "
+                      u"The datagrams are passed to the kernel shortly before their due time. "
+                      u"The network interface shall use a queuing discipline which supports it, typically 'fq' or 'etf'. "
+                      u"Otherwise, the datagrams are sent when passed to the kernel. "
+                      u"Implies --pacing. This option is available on Linux only.");
+        }
+
         args.option(u"ttl", 't', Args::INTEGER, 0, 1, 1, 255);
         args.help(u"ttl",
                   u"Specifies the TTL (Time-To-Live) socket option. The actual option "
@@ -186,6 +244,21 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         args.getIntValue(_rtp_start_sequence, u"start-sequence-number");
         _rtp_fixed_ssrc = args.present(u"ssrc-identifier");
         args.getIntValue(_rtp_user_ssrc, u"ssrc-identifier");
+    }
+
+    if ((_flags & TSDatagramOutputOptions::ALLOW_PACING) != TSDatagramOutputOptions::NONE) {
+        _pacing_timestamps = args.present(u"pacing-timestamps");
+        _use_txtime = _raw_udp && args.present(u"txtime");
+        _pacing = _pacing_timestamps || _use_txtime || args.present(u"pacing");
+        args.getIntValue(_pacing_spin, u"pacing-spin", DatagramPacer::DEFAULT_SPIN / NanoSecPerMicroSec);
+        _pacing_spin *= NanoSecPerMicroSec;
+        if (_use_txtime && !UDPSocket::TransmitTimeSupported()) {
+            args.error(u"--txtime is not supported on this system");
+            success = false;
+        }
+    }
+
+    if ((_flags & (TSDatagramOutputOptions::ALLOW_RTP | TSDatagramOutputOptions::ALLOW_PACING)) != TSDatagramOutputOptions::NONE) {
         args.getIntValue(_pcr_user_pid, u"pcr-pid", PID_NULL);
     }
 
@@ -198,6 +271,7 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         args.getIntValue(_ttl, u"ttl", 0);
         args.getIntValue(_tos, u"tos", -1);
         args.getIntValue(_send_bufsize, u"buffer-size", 0);
+        args.getIntValue(_send_batch, u"send-batch", UDPSocket::DEFAULT_BATCH_SIZE);
         _mc_loopback = !args.present(u"disable-multicast-loop");
         _force_mc_local = args.present(u"force-local-multicast-outgoing");
         _rs204_format = args.present(u"rs204");
@@ -221,6 +295,7 @@ bool ts::TSDatagramOutput::open(Report& report)
     // The output buffer is empty.
     if (_enforce_burst) {
         _out_buffer.resize(_pkt_burst);
+        _out_mdata.resize(_pkt_burst);
         _out_count = 0;
     }
 
@@ -257,11 +332,24 @@ bool ts::TSDatagramOutput::open(Report& report)
             (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr, report)) ||
             (_send_bufsize > 0 && !_sock.setSendBufferSize(_send_bufsize, report)) ||
             (_tos >= 0 && !_sock.setTOS(_tos, report)) ||
-            (_ttl > 0 && !_sock.setTTL(_ttl, report)))
+            (_ttl > 0 && !_sock.setTTL(_ttl, report)) ||
+            (_use_txtime && !_sock.enableTransmitTime(report)))
         {
             _sock.close(report);
             return false;
         }
+
+        // Prepare the buffer of datagrams to send at once.
+        // With --pacing, the datagrams are sent one by one at their due time.
+        _batch_count = 0;
+        if (_send_batch > 1 && !_pacing) {
+            _batch_slot = RTP_HEADER_SIZE + _pkt_burst * PKT_RS_SIZE;
+            _batch_buffer.resize(_send_batch * _batch_slot);
+            _batch_msgs.resize(_send_batch);
+            for (size_t i = 0; i < _send_batch; ++i) {
+                _batch_msgs[i].data = _batch_buffer.data() + i * _batch_slot;
+            }
+        }
     }
 
     // Other states.
@@ -271,6 +359,15 @@ bool ts::TSDatagramOutput::open(Report& report)
     _last_rtp_pcr_pkt = 0;
     _rtp_pcr_offset = 0;
     _pkt_count = 0;
+    _txtime = -1;
+
+    // Initialize pacing.
+    if (_pacing) {
+        _pacer.setReferencePID(_pcr_user_pid);
+        _pacer.setUseTimeStamps(_pacing_timestamps);
+        _pacer.setSpin(_pacing_spin);
+        _pacer.reset();
+    }
 
     _is_open = true;
     return true;
@@ -287,12 +384,16 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, Report& report)
     if (_is_open) {
         // Flush incomplete datagram, if any.
         if (_out_count > 0) {
-            success = sendPackets(_out_buffer.data(), _out_count, bitrate, report);
+            success = sendPackets(_out_buffer.data(), _out_mdata.data(), _out_count, bitrate, report);
             _out_count = 0;
         }
         if (_raw_udp) {
+            success = flushBatch(report) && success;
             _sock.close(report);
         }
+        if (_pacing) {
+            _pacer.reportStatistics(report);
+        }
         _is_open = false;
     }
     return success;
@@ -303,7 +404,7 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, Report& report)
 // Send TS packets.
 //----------------------------------------------------------------------------
 
-bool ts::TSDatagramOutput::send(const TSPacket* pkt, size_t packet_count, const BitRate& bitrate, Report& report)
+bool ts::TSDatagramOutput::send(const TSPacket* pkt, const TSPacketMetadata* mdata, size_t packet_count, const BitRate& bitrate, Report& report)
 {
     if (!_is_open) {
         report.error(u"TSDatagramOutput is not open");
@@ -323,13 +424,20 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, size_t packet_count, const
         // Copy as many packets as possible in output buffer.
         const size_t count = std::min(packet_count, _pkt_burst - _out_count);
         TSPacket::Copy(&_out_buffer[_out_count], pkt, count);
+        if (mdata != nullptr) {
+            TSPacketMetadata::Copy(&_out_mdata[_out_count], mdata, count);
+            mdata += count;
+        }
+        else {
+            TSPacketMetadata::Reset(&_out_mdata[_out_count], count);
+        }
         pkt += count;
         packet_count -= count;
         _out_count += count;
 
         // Send the output buffer when full.
         if (_out_count == _pkt_burst) {
-            if (!sendPackets(_out_buffer.data(), _out_count, bitrate, report)) {
+            if (!sendPackets(_out_buffer.data(), _out_mdata.data(), _out_count, bitrate, report)) {
                 return false;
             }
             _out_count = 0;
@@ -339,10 +447,13 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, size_t packet_count, const
     // Send subsequent packets from the global buffer.
     while (packet_count >= min_burst) {
         size_t count = std::min(packet_count, _pkt_burst);
-        if (!sendPackets(pkt, count, bitrate, report)) {
+        if (!sendPackets(pkt, mdata, count, bitrate, report)) {
             return false;
         }
         pkt += count;
+        if (mdata != nullptr) {
+            mdata += count;
+        }
         packet_count -= count;
     }
 
@@ -352,9 +463,17 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, size_t packet_count, const
         assert(_out_count == 0);
         assert(packet_count < _pkt_burst);
         TSPacket::Copy(_out_buffer.data(), pkt, packet_count);
+        if (mdata != nullptr) {
+            TSPacketMetadata::Copy(_out_mdata.data(), mdata, packet_count);
+        }
+        else {
+            TSPacketMetadata::Reset(_out_mdata.data(), packet_count);
+        }
         _out_count = packet_count;
     }
-    return true;
+
+    // Send all datagrams which were built from this chunk of packets.
+    return flushBatch(report);
 }
 
 
@@ -362,10 +481,15 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, size_t packet_count, const
 // Send contiguous packets in one single datagram.
 //----------------------------------------------------------------------------
 
-bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count, const BitRate& bitrate, Report& report)
+bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetadata* mdata, size_t packet_count, const BitRate& bitrate, Report& report)
 {
     bool status = true;
 
+    // With --pacing, wait for the due time of the datagram.
+    if (_pacing) {
+        pace(pkt, mdata, packet_count, bitrate);
+    }
+
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
         // We cannot use the wall clock time because the plugin is likely to burst its output.
@@ -484,11 +608,40 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count,
 
     // Count packets datagram per datagram.
     _pkt_count += packet_count;
+    _txtime = -1;
 
     return status;
 }
 
 
+//----------------------------------------------------------------------------
+// With --pacing, wait for the due time of the next datagram.
+//----------------------------------------------------------------------------
+
+void ts::TSDatagramOutput::pace(const TSPacket* pkt, const TSPacketMetadata* mdata, size_t packet_count, const BitRate& bitrate)
+{
+    Monotonic due;
+    if (!_pacer.dueTime(pkt, mdata, packet_count, bitrate, due)) {
+        // No time reference yet, send immediately.
+        return;
+    }
+
+#if defined(TS_LINUX)
+    if (_use_txtime) {
+        // Pass the datagram to the kernel shortly before its due time, with its transmission time.
+        // The Monotonic class uses CLOCK_MONOTONIC on Linux, like SO_TXTIME.
+        Monotonic handover(due);
+        handover -= _pacing_spin;
+        _pacer.wait(handover);
+        _txtime = Time::UnixClockNanoSeconds(CLOCK_MONOTONIC) + (due - Monotonic(true));
+        return;
+    }
+#endif
+
+    _pacer.wait(due);
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of TSDatagramOutputHandlerInterface.
 // The object is its own handler in case of raw UDP output.
@@ -496,5 +649,31 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, size_t packet_count,
 
 bool ts::TSDatagramOutput::sendDatagram(const void* address, size_t size, Report& report)
 {
-    return _sock.send(address, size, report);
+    // With --txtime, the datagram is transmitted by the kernel at its due time.
+    if (_txtime >= 0) {
+        return _sock.sendAt(address, size, _txtime, report);
+    }
+
+    // Without batch, send the datagram immediately.
+    if (_send_batch <= 1 || _pacing || size > _batch_slot) {
+        return flushBatch(report) && _sock.send(address, size, report);
+    }
+
+    // Copy the datagram in the batch, send the batch when full.
+    UDPSocket::Message& msg(_batch_msgs[_batch_count++]);
+    msg.size = size;
+    ::memcpy(msg.data, address, size);
+    return _batch_count < _send_batch || flushBatch(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Send all datagrams which are waiting in the raw UDP batch.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::flushBatch(Report& report)
+{
+    const size_t count = _batch_count;
+    _batch_count = 0;
+    return count == 0 || _sock.send(_batch_msgs.data(), count, report);
 }
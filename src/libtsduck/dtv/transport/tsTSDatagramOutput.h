@@ -14,6 +14,8 @@
 #pragma once
 #include "tsTSDatagramOutputHandlerInterface.h"
 #include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+#include "tsDatagramPacer.h"
 #include "tsUDPSocket.h"
 #include "tsEnumUtils.h"
 
@@ -26,6 +28,7 @@ namespace ts {
         NONE         = 0x0000,  //!< No option.
         ALLOW_RTP    = 0x0001,  //!< Allow RTP options to build an RTP datagram.
         ALWAYS_BURST = 0x0002,  //!< Do not define option --enforce-burst, always enforce burst.
+        ALLOW_PACING = 0x0004,  //!< Allow pacing options to send datagrams at the time of their packets.
     };
 }
 TS_ENABLE_BITMASK_OPERATORS(ts::TSDatagramOutputOptions);
@@ -104,7 +107,23 @@ namespace ts {
         //! @param [in,out] report Where to report errors.
         //! @return True on success, false on error.
         //!
-        bool send(const TSPacket* packets, size_t packet_count, const BitRate& bitrate, Report& report);
+        bool send(const TSPacket* packets, size_t packet_count, const BitRate& bitrate, Report& report)
+        {
+            return send(packets, nullptr, packet_count, bitrate, report);
+        }
+
+        //!
+        //! Send TS packets with their metadata.
+        //! Some of them can be buffered and sent later.
+        //! @param [in] packets Address of first packet.
+        //! @param [in] metadata Address of first packet metadata. Can be null. The input time
+        //! stamps of the packets are used for pacing with option --pacing-timestamps.
+        //! @param [in] packet_count Number of packets to send.
+        //! @param [in] bitrate Current bitrate to compute timestamps. Ignored if zero.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool send(const TSPacket* packets, const TSPacketMetadata* metadata, size_t packet_count, const BitRate& bitrate, Report& report);
 
     private:
         // Configuration and command line options.
@@ -123,6 +142,9 @@ namespace ts {
         uint32_t          _rtp_user_ssrc;      // RTP user-specified SSRC id
         PID               _pcr_user_pid;       // User-specified PCR PID.
         bool              _rs204_format;       // Use 204-byte format with Reed Solomon placeholder.
+        bool              _pacing;             // Send datagrams at the time of their packets.
+        bool              _pacing_timestamps;  // Pacing uses input timestamps instead of PCR's.
+        NanoSecond        _pacing_spin;        // Active polling duration before the due time of a datagram.
 
         // Command line options for raw UDP.
         IPv4SocketAddress _destination;        // Destination address/port.
@@ -133,6 +155,8 @@ namespace ts {
         bool              _mc_loopback;        // Multicast loopback option
         bool              _force_mc_local;     // Force multicast outgoing local interface
         size_t            _send_bufsize;       // Socket send buffer size.
+        size_t            _send_batch;         // Max number of datagrams to send at once.
+        bool              _use_txtime;         // Use scheduled transmission times (SO_TXTIME).
 
         // Working data.
         bool              _is_open;            // Currently in progress
@@ -146,13 +170,26 @@ namespace ts {
         PacketCounter     _pkt_count;          // Total packet counter for output packets
         size_t            _out_count;          // Number of packets in _out_buffer
         TSPacketVector    _out_buffer;         // Buffered packets for output with --enforce-burst
+        TSPacketMetadataVector _out_mdata;     // Metadata of buffered packets
         UDPSocket         _sock;               // Outgoing socket for raw UDP
+        size_t            _batch_slot;         // Size of one datagram slot in _batch_buffer
+        ByteBlock         _batch_buffer;       // Datagrams waiting to be sent at once on raw UDP
+        std::vector<UDPSocket::Message> _batch_msgs; // Description of datagrams in _batch_buffer
+        size_t            _batch_count;        // Number of datagrams in _batch_buffer
+        DatagramPacer     _pacer;              // Compute due times of datagrams with --pacing
+        NanoSecond        _txtime;             // Transmission time of next datagram with --txtime, negative if none
 
         // Implementation of TSDatagramOutputHandlerInterface.
         // The object is its own handler in case of raw UDP output.
         virtual bool sendDatagram(const void* address, size_t size, Report& report) override;
 
         // Send contiguous packets in one single datagram.
-        bool sendPackets(const TSPacket* packet, size_t count, const BitRate& bitrate, Report& report);
+        bool sendPackets(const TSPacket* packet, const TSPacketMetadata* mdata, size_t count, const BitRate& bitrate, Report& report);
+
+        // With --pacing, wait for the due time of the next datagram.
+        void pace(const TSPacket* packet, const TSPacketMetadata* mdata, size_t count, const BitRate& bitrate);
+
+        // Send all datagrams which are waiting in the raw UDP batch.
+        bool flushBatch(Report& report);
     };
 }
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Implementation of bulk operations on TS packets using vector instructions,
+// when available. This module is compiled with special options to use optional
+// instructions for the target architecture. It may fail when these instructions
+// are not implemented in the current CPU. Consequently, this module shall not be
+// called when these instructions are not implemented.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacket.h"
+#include "tsTSPacketAcceleration.h"
+
+// Check if Intel AVX2 instructions can be used in intrinsics.
+#if defined(TS_X86_64) && (defined(TS_GCC) || defined(TS_LLVM)) && defined(__AVX2__) && !defined(TS_NO_X86_AVX2_INSTRUCTIONS)
+    #define TS_X86_AVX2_INSTRUCTIONS 1
+    #include <immintrin.h>
+#endif
+
+// "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
+extern const bool tsTSPacketIsAccelerated =
+#if defined(TS_X86_AVX2_INSTRUCTIONS)
+    true;
+#else
+    false;
+#endif
+
+// Don't complain about assert(false) when acceleration is not implemented.
+TS_LLVM_NOWARNING(missing-noreturn)
+
+#if defined(TS_X86_AVX2_INSTRUCTIONS)
+namespace {
+
+    // Number of packets which are processed at a time, one per 32-bit lane.
+    constexpr size_t LANES = 8;
+
+    // Load the first 4 bytes of 8 consecutive packets, as little-endian 32-bit values.
+    // In each lane, the sync byte is in bits 0-7, the rest of the header in bits 8-31.
+    inline __m256i LoadHeaders(const ts::TSPacket* packets)
+    {
+        constexpr int size = int(ts::PKT_SIZE);
+        const __m256i offsets = _mm256_setr_epi32(0, size, 2 * size, 3 * size, 4 * size, 5 * size, 6 * size, 7 * size);
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(packets->b), offsets, 1);
+    }
+
+    // Store 8 lanes of 32-bit values, all less than 256, as 8 bytes.
+    inline void StoreBytes(uint8_t* dest, __m256i values)
+    {
+        // The packing instructions operate on each 128-bit half: the 4 bytes of each half end up in its first 32 bits.
+        values = _mm256_packus_epi32(values, values);
+        values = _mm256_packus_epi16(values, values);
+        const uint32_t low = uint32_t(_mm256_cvtsi256_si32(values));
+        const uint32_t high = uint32_t(_mm256_extract_epi32(values, 4));
+        ::memcpy(dest, &low, 4);
+        ::memcpy(dest + 4, &high, 4);
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Check the sync byte of contiguous TS packets.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacket::FindInvalidSyncAccel(const TSPacket* packets, size_t count)
+{
+#if defined(TS_X86_AVX2_INSTRUCTIONS)
+
+    const __m256i sync_mask = _mm256_set1_epi32(0xFF);
+    const __m256i sync_byte = _mm256_set1_epi32(SYNC_BYTE);
+    size_t index = 0;
+    for (; index + LANES <= count; index += LANES) {
+        const __m256i sync = _mm256_and_si256(LoadHeaders(packets + index), sync_mask);
+        const int valid = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sync, sync_byte)));
+        if (valid != 0xFF) {
+            // Stop on the first packet with an invalid sync byte.
+            return index + size_t(__builtin_ctz(uint32_t(~valid)));
+        }
+    }
+    return index;
+
+#else
+    // Shall not be called.
+    assert(false);
+    return 0;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Extract the main header fields of contiguous TS packets.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacket::ExtractHeadersAccel(const TSPacket* packets, size_t count, PID* pids, uint8_t* cc, uint8_t* pusi, uint8_t* scrambling)
+{
+#if defined(TS_X86_AVX2_INSTRUCTIONS)
+
+    // Bit layout of the little-endian 32-bit header: PID in bits 8-12 (MSB) and 16-23 (LSB),
+    // PUSI in bit 14, continuity counter in bits 24-27, scrambling control in bits 30-31.
+    const __m256i pid_high_mask = _mm256_set1_epi32(0x1F00);
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i cc_mask = _mm256_set1_epi32(0x0F);
+    const __m256i bit_mask = _mm256_set1_epi32(0x01);
+
+    size_t index = 0;
+    for (; index + LANES <= count; index += LANES) {
+        const __m256i headers = LoadHeaders(packets + index);
+        if (pids != nullptr) {
+            __m256i pid = _mm256_or_si256(_mm256_and_si256(headers, pid_high_mask), _mm256_and_si256(_mm256_srli_epi32(headers, 16), byte_mask));
+            // Pack to 16 bits. Each 128-bit half is packed in its first 64 bits, then gather the two 64-bit parts.
+            pid = _mm256_permute4x64_epi64(_mm256_packus_epi32(pid, pid), 0x08);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pids + index), _mm256_castsi256_si128(pid));
+        }
+        if (cc != nullptr) {
+            StoreBytes(cc + index, _mm256_and_si256(_mm256_srli_epi32(headers, 24), cc_mask));
+        }
+        if (pusi != nullptr) {
+            StoreBytes(pusi + index, _mm256_and_si256(_mm256_srli_epi32(headers, 14), bit_mask));
+        }
+        if (scrambling != nullptr) {
+            StoreBytes(scrambling + index, _mm256_srli_epi32(headers, 30));
+        }
+    }
+    return index;
+
+#else
+    // Shall not be called.
+    assert(false);
+    return 0;
+#endif
+}
@@ -846,6 +846,39 @@ namespace ts {
         //!
         static bool Locate(const uint8_t* buffer, size_t buffer_size, size_t& start_index, size_t& packet_count);
 
+        //!
+        //! Check the sync byte of contiguous TS packets.
+        //! This is the bulk equivalent of hasValidSync() on each packet. When supported
+        //! by the CPU, vector instructions are used to check several packets at a time.
+        //! @param [in] packets Address of the first contiguous TS packet.
+        //! @param [in] count Number of TS packets to check.
+        //! @return Index of the first packet with an invalid sync byte or @a count if all packets are valid.
+        //!
+        static size_t FindInvalidSync(const TSPacket* packets, size_t count);
+
+        //!
+        //! Extract the main header fields of contiguous TS packets into compact arrays.
+        //! This is the bulk equivalent of getPID(), getCC(), getPUSI() and getScrambling()
+        //! on each packet. When supported by the CPU, vector instructions are used to process
+        //! several packets at a time. Each output array is optional and ignored when null.
+        //! @param [in] packets Address of the first contiguous TS packet.
+        //! @param [in] count Number of TS packets to process.
+        //! @param [out] pids Receives the @a count PID values.
+        //! @param [out] cc Receives the @a count continuity counters.
+        //! @param [out] pusi Receives the @a count "payload unit start indicator" as 0 or 1.
+        //! @param [out] scrambling Receives the @a count "transport scrambling control" values.
+        //!
+        static void ExtractHeaders(const TSPacket* packets, size_t count, PID* pids, uint8_t* cc = nullptr, uint8_t* pusi = nullptr, uint8_t* scrambling = nullptr);
+
+        //!
+        //! Count packets per PID in contiguous TS packets.
+        //! @param [in] packets Address of the first contiguous TS packet.
+        //! @param [in] count Number of TS packets to process.
+        //! @param [in,out] counters An array of PID_MAX packet counters, indexed by PID.
+        //! The counter of the PID of each packet is incremented. Counters are not reset first.
+        //!
+        static void CountPIDs(const TSPacket* packets, size_t count, PacketCounter* counters);
+
         //!
         //! Sanity check routine.
         //! Ensure that the TSPacket structure can
@@ -856,6 +889,17 @@ namespace ts {
         static void SanityCheck();
 
     private:
+        // Runtime check once if accelerated instructions are supported on this CPU.
+        static volatile bool _accel_checked;
+        static volatile bool _accel_supported;
+        static bool AccelSupported();
+
+        // Accelerated versions of bulk operations, compiled in a separated module.
+        // Only process an initial part of the packets, return the index where the
+        // caller shall continue with the portable code.
+        static size_t FindInvalidSyncAccel(const TSPacket* packets, size_t count);
+        static size_t ExtractHeadersAccel(const TSPacket* packets, size_t count, PID* pids, uint8_t* cc, uint8_t* pusi, uint8_t* scrambling);
+
         // These private methods compute the offset of PCR, OPCR, etc.
         // Return 0 if there is none.
         size_t PCROffset() const;
@@ -19,6 +19,7 @@ constexpr size_t ts::MuxerArgs::MIN_BUFFERED_PACKETS;
 constexpr size_t ts::MuxerArgs::DEFAULT_LOSSY_INPUT_PACKETS;
 constexpr ts::MilliSecond ts::MuxerArgs::DEFAULT_RESTART_DELAY;
 constexpr ts::MicroSecond ts::MuxerArgs::DEFAULT_CADENCE;
+constexpr ts::MicroSecond ts::MuxerArgs::DEFAULT_MIN_CADENCE;
 constexpr ts::BitRate::int_t ts::MuxerArgs::MIN_PSI_BITRATE;
 constexpr ts::BitRate::int_t ts::MuxerArgs::DEFAULT_PSI_BITRATE;
 #endif
@@ -45,6 +46,7 @@ ts::MuxerArgs::MuxerArgs() :
     inputRestartDelay(DEFAULT_RESTART_DELAY),
     outputRestartDelay(DEFAULT_RESTART_DELAY),
     cadence(DEFAULT_CADENCE),
+    minCadence(DEFAULT_MIN_CADENCE),
     inBufferPackets(DEFAULT_BUFFERED_PACKETS),
     outBufferPackets(DEFAULT_BUFFERED_PACKETS),
     maxInputPackets(DEFAULT_MAX_INPUT_PACKETS),
@@ -78,6 +80,8 @@ void ts::MuxerArgs::enforceDefaults()
     maxInputPackets = std::min(std::max(maxInputPackets, MIN_INPUT_PACKETS), inBufferPackets / 2);
     maxOutputPackets = std::max(maxOutputPackets, MIN_OUTPUT_PACKETS);
     lossyReclaim = std::min(std::max<size_t>(1, lossyReclaim), inBufferPackets);
+    cadence = std::max<MicroSecond>(1, cadence);
+    minCadence = std::min(std::max<MicroSecond>(1, minCadence), cadence);
     patBitRate = patBitRate.max(MIN_PSI_BITRATE);
     catBitRate = catBitRate.max(MIN_PSI_BITRATE);
     nitBitRate = nitBitRate.max(MIN_PSI_BITRATE);
@@ -107,7 +111,10 @@ void ts::MuxerArgs::defineArgs(Args& args)
 
     args.option(u"cadence", 0, Args::POSITIVE);
     args.help(u"cadence", u"microseconds",
-              u"Specify the internal polling cadence in microseconds. "
+              u"Specify the maximum interval between two muxing iterations in microseconds. "
+              u"The multiplexer wakes up when new input packets are available or when the next "
+              u"output packet is due. When all inputs are idle, it wakes up at least at this interval "
+              u"to insert PSI/SI and null packets. "
               u"The default is " + UString::Decimal(DEFAULT_CADENCE) + u" microseconds.");
 
     args.option<BitRate>(u"cat-bitrate", 0, 0, 0, MIN_PSI_BITRATE);
@@ -141,6 +148,13 @@ void ts::MuxerArgs::defineArgs(Args& args)
               u"Specify the maximum number of TS packets to write at a time. "
               u"The default is " + UString::Decimal(DEFAULT_MAX_OUTPUT_PACKETS) + u" packets.");
 
+    args.option(u"min-cadence", 0, Args::POSITIVE);
+    args.help(u"min-cadence", u"microseconds",
+              u"Specify the minimum interval between two muxing iterations in microseconds. "
+              u"This limits the CPU load when input packets arrive in small bursts. "
+              u"A lower value reduces the latency between input and output. "
+              u"The default is " + UString::Decimal(DEFAULT_MIN_CADENCE) + u" microseconds.");
+
     args.option(u"nit", 0, TableScopeEnum);
     args.help(u"nit", u"type",
               u"Specify which type of NIT shall be merged in the output stream. The default is \"actual\".");
@@ -208,6 +222,7 @@ bool ts::MuxerArgs::loadArgs(DuckContext& duck, Args& args)
     args.getValue(outputBitRate, u"bitrate");
     args.getIntValue(inputRestartDelay, u"restart-delay", DEFAULT_RESTART_DELAY);
     args.getIntValue(cadence, u"cadence", DEFAULT_CADENCE);
+    args.getIntValue(minCadence, u"min-cadence", DEFAULT_MIN_CADENCE);
     outputRestartDelay = inputRestartDelay;
     args.getIntValue(inBufferPackets, u"buffer-packets", DEFAULT_BUFFERED_PACKETS);
     args.getIntValue(maxInputPackets, u"max-input-packets", DEFAULT_MAX_INPUT_PACKETS);
@@ -41,7 +41,8 @@ namespace ts {
         bool                   ignoreConflicts;    //!< Ignore PID or service conflicts (inconsistent stream).
         MilliSecond            inputRestartDelay;  //!< When an input start fails, retry after that delay.
         MilliSecond            outputRestartDelay; //!< When the output start fails, retry after that delay.
-        MicroSecond            cadence;            //!< Internal polling cadence in microseconds.
+        MicroSecond            cadence;            //!< Maximum interval between two muxing iterations in microseconds, when inputs are idle.
+        MicroSecond            minCadence;         //!< Minimum interval between two muxing iterations in microseconds.
         size_t                 inBufferPackets;    //!< Input buffer size in packets.
         size_t                 outBufferPackets;   //!< Output buffer size in packets (default: N x inBufferPackets).
         size_t                 maxInputPackets;    //!< Maximum input packets to read at a time.
@@ -63,6 +64,7 @@ namespace ts {
         static constexpr size_t DEFAULT_LOSSY_INPUT_PACKETS = 16;     //!< Default number of oldest input packets to drop with lossy input.
         static constexpr MilliSecond DEFAULT_RESTART_DELAY = 2000;    //!< Default input and output restart delay.
         static constexpr MicroSecond DEFAULT_CADENCE = 10000;         //!< Default cadence in microseconds.
+        static constexpr MicroSecond DEFAULT_MIN_CADENCE = 500;       //!< Default minimum cadence in microseconds.
         static constexpr BitRate::int_t MIN_PSI_BITRATE = 100;        //!< Minimum bitrate for global PSI/SI PID's.
         static constexpr BitRate::int_t DEFAULT_PSI_BITRATE = 15000;  //!< Default bitrate for global PSI/SI PID's.
 
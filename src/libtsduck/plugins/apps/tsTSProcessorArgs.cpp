@@ -13,6 +13,7 @@
 #if !defined(TS_CXX17)
 constexpr size_t ts::TSProcessorArgs::DEFAULT_BUFFER_SIZE;
 constexpr size_t ts::TSProcessorArgs::MIN_BUFFER_SIZE;
+constexpr size_t ts::TSProcessorArgs::DEFAULT_SYNC_SPIN;
 #endif
 
 #define DEF_BITRATE_INTERVAL               5  // seconds
@@ -52,6 +53,8 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     control_reuse(false),
     control_sources(),
     control_timeout(DEF_CONTROL_TIMEOUT),
+    sync_mode(SyncMode::MUTEX),
+    sync_spin(DEFAULT_SYNC_SPIN),
     duck_args(),
     input(),
     plugins(),
@@ -202,6 +205,25 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"are enforced. The explicit values 'no', 'false', 'off' are used to enforce "
               u"the offline defaults and the explicit values 'yes', 'true', 'on' are used "
               u"to enforce the real-time defaults.");
+
+    args.option(u"sync-mode", 0, Enumeration({
+        {u"mutex",     int(SyncMode::MUTEX)},
+        {u"lock-free", int(SyncMode::LOCKFREE)},
+    }));
+    args.help(u"sync-mode", u"name",
+              u"Specify how the plugin threads synchronize their access to the global packet buffer. "
+              u"With \"mutex\", all plugins share one global mutex, each handoff of packets between "
+              u"two plugins locks it. With \"lock-free\", each pair of adjacent plugins communicates "
+              u"through atomic packet counters in the circular buffer. A plugin waiting for packets "
+              u"first polls for a short while and then blocks on a condition which is private to that "
+              u"pair of plugins. The lock-free mode reduces the contention when many plugins are used "
+              u"at high bitrates. The default is \"mutex\".");
+
+    args.option(u"sync-spin", 0, Args::UNSIGNED);
+    args.help(u"sync-spin", u"count",
+              u"With --sync-mode lock-free, specify the number of polling iterations of a plugin "
+              u"waiting for packets before blocking. Zero means always block immediately. "
+              u"The default is " + UString::Decimal(DEFAULT_SYNC_SPIN) + u".");
 }
 
 
@@ -229,6 +251,8 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(control_port, u"control-port", 0);
     args.getIntValue(control_timeout, u"control-timeout", DEF_CONTROL_TIMEOUT);
     control_reuse = args.present(u"control-reuse-port");
+    args.getIntValue(sync_mode, u"sync-mode", SyncMode::MUTEX);
+    args.getIntValue(sync_spin, u"sync-spin", DEFAULT_SYNC_SPIN);
 
     // Convert MB in MiB for buffer size for compatibility with original versions.
     ts_buffer_size = size_t((uint64_t(ts_buffer_size) * 1024 * 1024) / 1000000);
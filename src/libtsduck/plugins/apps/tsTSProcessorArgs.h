@@ -27,6 +27,14 @@ namespace ts {
     class TSDUCKDLL TSProcessorArgs
     {
     public:
+        //!
+        //! Synchronization mode between plugin executors in the global packet buffer.
+        //!
+        enum class SyncMode {
+            MUTEX,     //!< All plugin executors synchronize through one global mutex (default).
+            LOCKFREE,  //!< Adjacent plugin executors synchronize through atomic counters, spin-then-block waiting.
+        };
+
         UString           app_name;         //!< Application name, for help messages.
         bool              ignore_jt;        //!< Ignore "joint termination" options in plugins.
         bool              log_plugin_index; //!< Log plugin index with plugin name.
@@ -50,6 +58,8 @@ namespace ts {
         bool              control_reuse;    //!< Set the 'reuse port' socket option on the control TCP server port.
         IPv4AddressVector control_sources;  //!< Remote IP addresses which are allowed to send control commands.
         MilliSecond       control_timeout;  //!< Reception timeout in milliseconds for control commands.
+        SyncMode          sync_mode;        //!< Synchronization mode between plugin executors.
+        size_t            sync_spin;        //!< In lock-free mode, number of polling iterations before blocking.
         DuckContext::SavedArgs duck_args;   //!< Default TSDuck context options for all plugins. Each plugin can override them in its context.
         PluginOptions          input;       //!< Input plugin description.
         PluginOptionsVector    plugins;     //!< Packet processor plugins descriptions.
@@ -57,6 +67,7 @@ namespace ts {
 
         static constexpr size_t DEFAULT_BUFFER_SIZE = 16 * 1000000;  //!< Default size in bytes of global TS buffer.
         static constexpr size_t MIN_BUFFER_SIZE = 18800;             //!< Minimum size in bytes of global TS buffer.
+        static constexpr size_t DEFAULT_SYNC_SPIN = 200;             //!< Default number of polling iterations before blocking in lock-free mode.
 
         //!
         //! Constructor.
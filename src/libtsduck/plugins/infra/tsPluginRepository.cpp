@@ -11,9 +11,12 @@
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
 #include "tsFileUtils.h"
+#include "tsMemoryMappedFile.h"
 
 TS_DEFINE_SINGLETON(ts::PluginRepository);
 
+const ts::UChar* const ts::PluginRepository::INDEX_FILE_NAME = u"tsduck.plugins.index";
+
 // Options for --list-processor.
 const ts::Enumeration ts::PluginRepository::ListProcessorEnum({
     {u"all",          ts::PluginRepository::LIST_ALL},
@@ -34,7 +37,12 @@ ts::PluginRepository::PluginRepository() :
     _sharedLibraryAllowed(true),
     _inputPlugins(),
     _processorPlugins(),
-    _outputPlugins()
+    _outputPlugins(),
+    _indexLoaded(false),
+    _inputIndex(),
+    _processorIndex(),
+    _outputIndex(),
+    _indexedLibraries()
 {
 }
 
@@ -108,7 +116,17 @@ FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UStri
     // Search plugin in current cache.
     auto it = plugin_map.find(plugin_name);
 
-    // Load a shared library if not found and allowed.
+    // If not found, load the shared library which is described in an index, if any.
+    if (it == plugin_map.end() && _sharedLibraryAllowed) {
+        const UString library(SearchIndex(plugin_type, plugin_name));
+        if (!library.empty()) {
+            SharedLibrary shlib(library, SharedLibraryFlags::PERMANENT, report);
+            CERR.debug(u"loaded indexed plugin file \"%s\", status: %s", {library, shlib.isLoaded()});
+            it = plugin_map.find(plugin_name);
+        }
+    }
+
+    // Search a shared library if still not found and allowed.
     if (it == plugin_map.end() && _sharedLibraryAllowed) {
         // Load shareable library. Use name resolution. Use permanent mapping to keep
         // the shareable image in memory after returning from this function. Also make
@@ -203,11 +221,178 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+// Search a plugin in the index files of all plugin directories.
+//----------------------------------------------------------------------------
+
+ts::UString ts::PluginRepository::SearchIndex(const UString& type, const UString& name)
+{
+    // Same search rules as plugins. The first directory which describes the plugin wins.
+    UStringList dirs;
+    ApplicationSharedLibrary::GetSearchPath(dirs, TS_PLUGINS_PATH);
+
+    // Look for a line starting with "type:name:" directly in the mapped file, without parsing the index.
+    const std::string pattern('\n' + type.toUTF8() + ':' + name.toUTF8() + ':');
+    for (const auto& dir : dirs) {
+        MemoryMappedFile file;
+        if (file.open(dir + PathSeparator + INDEX_FILE_NAME)) {
+            const char* const begin = reinterpret_cast<const char*>(file.data());
+            const char* const end = begin + file.size();
+            const char* lib = nullptr;
+            if (size_t(end - begin) >= pattern.size() - 1 && std::equal(pattern.begin() + 1, pattern.end(), begin)) {
+                // Found on the first line, not preceded by a new line.
+                lib = begin + pattern.size() - 1;
+            }
+            else {
+                const char* const line = std::search(begin, end, pattern.begin(), pattern.end());
+                if (line != end) {
+                    lib = line + pattern.size();
+                }
+            }
+            if (lib != nullptr) {
+                const char* const lib_end = std::find(lib, end, ':');
+                if (lib_end != end && lib_end > lib) {
+                    return dir + PathSeparator + UString::FromUTF8(lib, lib_end - lib);
+                }
+            }
+        }
+    }
+    return UString();
+}
+
+
+//----------------------------------------------------------------------------
+// Load the index files of all plugin directories.
+//----------------------------------------------------------------------------
+
+void ts::PluginRepository::loadIndex()
+{
+    if (_indexLoaded) {
+        return;
+    }
+    _indexLoaded = true;
+
+    // Same search rules as plugins. The first directory which describes a plugin wins.
+    UStringList dirs;
+    ApplicationSharedLibrary::GetSearchPath(dirs, TS_PLUGINS_PATH);
+
+    for (const auto& dir : dirs) {
+        // The index is read through a memory mapping, avoiding the setup of a C++ stream.
+        const UString file_name(dir + PathSeparator + INDEX_FILE_NAME);
+        MemoryMappedFile file;
+        if (!file.open(file_name)) {
+            continue;
+        }
+        CERR.debug(u"loading plugin index \"%s\"", {file_name});
+        UStringVector lines;
+        UString::FromUTF8(reinterpret_cast<const char*>(file.data()), file.size()).split(lines, u'\n', true, true);
+        for (const auto& line : lines) {
+            if (line.startWith(u"#")) {
+                continue;
+            }
+            // Syntax: type:name:library:description, the description may contain colons.
+            UStringVector fields;
+            line.split(fields, u':', false);
+            IndexMap* index = nullptr;
+            if (fields.size() >= 4) {
+                if (fields[0] == u"input") {
+                    index = &_inputIndex;
+                }
+                else if (fields[0] == u"processor") {
+                    index = &_processorIndex;
+                }
+                else if (fields[0] == u"output") {
+                    index = &_outputIndex;
+                }
+            }
+            const UString library(index == nullptr ? UString() : dir + PathSeparator + fields[2]);
+            if (index == nullptr || fields[1].empty() || fields[2].empty()) {
+                CERR.debug(u"invalid line in plugin index \"%s\": %s", {file_name, line});
+            }
+            else if (index->find(fields[1]) == index->end() && FileExists(library)) {
+                IndexEntry& entry((*index)[fields[1]]);
+                entry.library = library;
+                entry.description = line.substr(fields[0].size() + fields[1].size() + fields[2].size() + 3);
+                entry.description.trim();
+                _indexedLibraries.insert(library);
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Create the index file of all plugins in a directory.
+//----------------------------------------------------------------------------
+
+bool ts::PluginRepository::createIndex(const UString& directory, Report& report)
+{
+    // Get list of shared library files in the directory.
+    UStringVector files;
+    ExpandWildcard(files, directory + PathSeparator + u"tsplugin_*" TS_SHARED_LIB_SUFFIX);
+    std::sort(files.begin(), files.end());
+
+    // A minimal TSP, used to build temporary plugins.
+    ReportTSP tsp(report);
+
+    UStringList lines;
+    lines.push_back(u"# TSDuck plugin index, generated file, do not modify.");
+    lines.push_back(u"# Syntax: type:name:library:description");
+
+    for (const auto& file : files) {
+        // Load the library and check which plugins were registered.
+        const UStringList inputs(inputNames());
+        const UStringList processors(processorNames());
+        const UStringList outputs(outputNames());
+        SharedLibrary shlib(file, SharedLibraryFlags::PERMANENT, report);
+        if (!shlib.isLoaded()) {
+            report.error(u"error loading %s: %s", {file, shlib.errorMessage()});
+            return false;
+        }
+        const UString library(BaseName(file));
+        for (const auto& it : _inputPlugins) {
+            if (std::find(inputs.begin(), inputs.end(), it.first) == inputs.end()) {
+                Plugin* p = it.second(&tsp);
+                lines.push_back(UString::Format(u"input:%s:%s:%s", {it.first, library, p->getDescription()}));
+                delete p;
+            }
+        }
+        for (const auto& it : _processorPlugins) {
+            if (std::find(processors.begin(), processors.end(), it.first) == processors.end()) {
+                Plugin* p = it.second(&tsp);
+                lines.push_back(UString::Format(u"processor:%s:%s:%s", {it.first, library, p->getDescription()}));
+                delete p;
+            }
+        }
+        for (const auto& it : _outputPlugins) {
+            if (std::find(outputs.begin(), outputs.end(), it.first) == outputs.end()) {
+                Plugin* p = it.second(&tsp);
+                lines.push_back(UString::Format(u"output:%s:%s:%s", {it.first, library, p->getDescription()}));
+                delete p;
+            }
+        }
+    }
+
+    const UString index_file(directory + PathSeparator + INDEX_FILE_NAME);
+    report.verbose(u"creating %s, %d plugins", {index_file, lines.size() - 2});
+    if (!UString::Save(lines, index_file)) {
+        report.error(u"error creating %s", {index_file});
+        return false;
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Load all available tsp processors.
 //----------------------------------------------------------------------------
 
 void ts::PluginRepository::loadAllPlugins(Report& report)
+{
+    loadSharedLibraries(false, report);
+}
+
+void ts::PluginRepository::loadSharedLibraries(bool skip_indexed, Report& report)
 {
     // Do nothing if loading dynamic libraries is disallowed.
     if (!_sharedLibraryAllowed) {
@@ -220,6 +405,10 @@ void ts::PluginRepository::loadAllPlugins(Report& report)
 
     // Load all plugins, let them register their plugins.
     for (size_t i = 0; i < files.size(); ++i) {
+        if (skip_indexed && _indexedLibraries.find(files[i]) != _indexedLibraries.end()) {
+            // Already described in an index, no need to load it.
+            continue;
+        }
         // Permanent load.
         SharedLibrary shlib(files[i], SharedLibraryFlags::PERMANENT, report);
         CERR.debug(u"loaded plugin file \"%s\", status: %s", {files[i], shlib.isLoaded()});
@@ -231,49 +420,71 @@ void ts::PluginRepository::loadAllPlugins(Report& report)
 // List all tsp processors.
 //----------------------------------------------------------------------------
 
+template<typename FACTORY>
+void ts::PluginRepository::GetDescriptions(DescriptionMap& descriptions, const std::map<UString,FACTORY>& plugins, const IndexMap* index, TSP* tsp)
+{
+    // Plugins which are described in an index but not loaded.
+    if (index != nullptr) {
+        for (const auto& it : *index) {
+            descriptions[it.first] = it.second.description;
+        }
+    }
+
+    // Registered plugins, build temporary plugins to get their description.
+    for (const auto& it : plugins) {
+        Plugin* p = it.second(tsp);
+        descriptions[it.first] = p->getDescription();
+        delete p;
+    }
+}
+
 ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int flags)
 {
     // Output text, use some preservation.
     UString out;
     out.reserve(5000);
 
-    // Load all shareable plugins first.
-    if (loadAll) {
-        loadAllPlugins(report);
+    // Load all shareable plugins first. Plugins which are described in an index are not loaded.
+    const bool useIndex = loadAll && _sharedLibraryAllowed;
+    if (useIndex) {
+        loadIndex();
+        loadSharedLibraries(true, report);
+    }
+
+    // A minimal TSP, used to build temporary plugins.
+    ReportTSP tsp(report);
+
+    // Get descriptions of all plugins.
+    DescriptionMap inputs;
+    DescriptionMap outputs;
+    DescriptionMap processors;
+    if ((flags & LIST_INPUT) != 0) {
+        GetDescriptions(inputs, _inputPlugins, useIndex ? &_inputIndex : nullptr, &tsp);
+    }
+    if ((flags & LIST_OUTPUT) != 0) {
+        GetDescriptions(outputs, _outputPlugins, useIndex ? &_outputIndex : nullptr, &tsp);
+    }
+    if ((flags & LIST_PACKET) != 0) {
+        GetDescriptions(processors, _processorPlugins, useIndex ? &_processorIndex : nullptr, &tsp);
     }
 
     // Compute max name width of all plugins.
     size_t name_width = 0;
     if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
-        if ((flags & LIST_INPUT) != 0) {
-            for (const auto& it : _inputPlugins) {
-                name_width = std::max(name_width, it.first.width());
-            }
-        }
-        if ((flags & LIST_PACKET) != 0) {
-            for (const auto& it : _processorPlugins) {
-                name_width = std::max(name_width, it.first.width());
-            }
-        }
-        if ((flags & LIST_OUTPUT) != 0) {
-            for (const auto& it : _outputPlugins) {
+        for (const auto* map : {&inputs, &outputs, &processors}) {
+            for (const auto& it : *map) {
                 name_width = std::max(name_width, it.first.width());
             }
         }
     }
 
-    // A minimal TSP, used to build temporary plugins.
-    ReportTSP tsp(report);
-
     // List capabilities.
     if ((flags & LIST_INPUT) != 0) {
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp input plugins:\n\n";
         }
-        for (const auto& it : _inputPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : inputs) {
+            ListOnePlugin(out, it.first, it.second, name_width, flags);
         }
     }
 
@@ -281,10 +492,8 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp output plugins:\n\n";
         }
-        for (const auto& it : _outputPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : outputs) {
+            ListOnePlugin(out, it.first, it.second, name_width, flags);
         }
     }
 
@@ -292,10 +501,8 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp packet processor plugins:\n\n";
         }
-        for (const auto& it : _processorPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : processors) {
+            ListOnePlugin(out, it.first, it.second, name_width, flags);
         }
     }
 
@@ -307,7 +514,7 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
 // List one plugin.
 //----------------------------------------------------------------------------
 
-void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags)
+void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, const UString& description, size_t name_width, int flags)
 {
     if ((flags & LIST_NAMES) != 0) {
         out += name;
@@ -316,14 +523,14 @@ void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plug
     else if ((flags & LIST_COMPACT) != 0) {
         out += name;
         out += u":";
-        out += plugin->getDescription();
+        out += description;
         out += u"\n";
     }
     else {
         out += u"  ";
         out += name.toJustifiedLeft(name_width + 1, u'.', false, 1);
         out += u" ";
-        out += plugin->getDescription();
+        out += description;
         out += u"\n";
     }
 }
@@ -26,6 +26,18 @@ namespace ts {
     //!
     //! This class is a singleton. Use static Instance() method to access the single instance.
     //!
+    //! Plugins which are not statically linked are loaded from shared libraries on demand.
+    //! To avoid searching and loading all shared libraries, each directory of plugins may
+    //! contain an index file, named INDEX_FILE_NAME, which is generated at build time.
+    //! Each line of this text file describes one plugin, using the syntax
+    //! "type:name:library:description" where @e type is one of "input", "output" or
+    //! "processor" and @e library is the file name of the shared library in the same
+    //! directory. Empty lines and lines starting with '#' are ignored.
+    //!
+    //! When a plugin is not registered, the indexes are searched first and only the
+    //! corresponding shared library is loaded. Plugins which are not described in
+    //! an index (third-party plugins for instance) are searched as usual.
+    //!
     class TSDUCKDLL PluginRepository
     {
         TS_DECLARE_SINGLETON(PluginRepository);
@@ -179,6 +191,22 @@ namespace ts {
         //!
         UString listPlugins(bool loadAll, Report& report, int flags = LIST_ALL);
 
+        //!
+        //! Name of the index file of plugins in a directory of plugins.
+        //!
+        static const UChar* const INDEX_FILE_NAME;
+
+        //!
+        //! Create the index file of all plugins in a directory.
+        //! All shared libraries of plugins in the directory are loaded.
+        //! This function is typically used at build time. The index file is created
+        //! in the same directory, with name INDEX_FILE_NAME.
+        //! @param [in] directory Directory of plugins.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool createIndex(const UString& directory, Report& report);
+
         //!
         //! A class to register plugins.
         //!
@@ -216,16 +244,44 @@ namespace ts {
         typedef std::map<UString, ProcessorPluginFactory> ProcessorMap;
         typedef std::map<UString, OutputPluginFactory>    OutputMap;
 
+        // Description of a plugin in an index file.
+        class IndexEntry
+        {
+        public:
+            UString library {};      // Full path of shared library.
+            UString description {};  // Plugin description.
+        };
+        typedef std::map<UString, IndexEntry> IndexMap;
+        typedef std::map<UString, UString> DescriptionMap;
+
         bool         _sharedLibraryAllowed;
         InputMap     _inputPlugins;
         ProcessorMap _processorPlugins;
         OutputMap    _outputPlugins;
+        bool         _indexLoaded;
+        IndexMap     _inputIndex;
+        IndexMap     _processorIndex;
+        IndexMap     _outputIndex;
+        std::set<UString> _indexedLibraries;  // Full paths of all shared libraries in indexes.
 
         template<typename FACTORY>
         FACTORY getFactory(const UString& name, const UString& type, const std::map<UString,FACTORY>&, Report&);
 
+        // Search a plugin in the index files of all plugin directories, return the full path of its shared library.
+        static UString SearchIndex(const UString& type, const UString& name);
+
+        // Load the complete index files of all plugin directories, if not already done.
+        void loadIndex();
+
+        // Load shared libraries of plugins, optionally skip libraries which are described in an index.
+        void loadSharedLibraries(bool skip_indexed, Report& report);
+
+        // Get the descriptions of plugins, from the index and registered plugins.
+        template<typename FACTORY>
+        static void GetDescriptions(DescriptionMap& descriptions, const std::map<UString,FACTORY>& plugins, const IndexMap* index, TSP* tsp);
+
         // List one plugin.
-        static void ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags);
+        static void ListOnePlugin(UString& out, const UString& name, const UString& description, size_t name_width, int flags);
     };
 }
 
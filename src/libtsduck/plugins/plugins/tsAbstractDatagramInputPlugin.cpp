@@ -24,8 +24,8 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
                                                              bool real_time) :
     InputPlugin(tsp_, description, syntax),
     _real_time(real_time),
-    _inbuf(std::max(buffer_size, 7 * PKT_SIZE)),
-    _mdata(_inbuf.size() / PKT_SIZE)
+    _buffer_size(std::max(buffer_size, 7 * PKT_SIZE)),
+    _mdata(_buffer_size / PKT_SIZE)
 {
     if (_real_time) {
         option(u"display-interval", 'd', POSITIVE);
@@ -99,6 +99,10 @@ bool ts::AbstractDatagramInputPlugin::getOptions()
 bool ts::AbstractDatagramInputPlugin::start()
 {
     // Initialize working data.
+    _inbuf.resize(_buffer_size * _max_datagrams);
+    _dgram_sizes.resize(_max_datagrams);
+    _dgram_timestamps.resize(_max_datagrams);
+    _dgram_count = _dgram_next = 0;
     _inbuf_count = _inbuf_next = _mdata_next = 0;
     _start = _start_0 = _start_1 = _next_display = Time::Epoch;
     _packets = _packets_0 = _packets_1 = 0;
@@ -131,6 +135,17 @@ ts::BitRateConfidence ts::AbstractDatagramInputPlugin::getBitrateConfidence()
 }
 
 
+//----------------------------------------------------------------------------
+// Receive a batch of datagram messages, default implementation.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDatagramInputPlugin::receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_sizes, MicroSecond* timestamps)
+{
+    timestamps[0] = -1;
+    return max_count > 0 && receiveDatagram(buffer, buffer_size, ret_sizes[0], timestamps[0]) ? 1 : 0;
+}
+
+
 //----------------------------------------------------------------------------
 // Input method
 //----------------------------------------------------------------------------
@@ -146,21 +161,33 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
     // Loop until we get some TS packets.
     while (_inbuf_count == 0) {
 
-        // Wait for a datagram message
-        size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp)) {
-            return 0;
+        // When all previously received datagrams are processed, wait for new datagram messages.
+        if (_dgram_next >= _dgram_count) {
+            _dgram_next = 0;
+            _dgram_count = receiveDatagrams(_inbuf.data(), _buffer_size, _max_datagrams, _dgram_sizes.data(), _dgram_timestamps.data());
+            if (_dgram_count == 0) {
+                return 0;
+            }
         }
 
+        // Process next datagram.
+        const size_t dgram_index = _dgram_next++;
+        const uint8_t* const dgram = _inbuf.data() + dgram_index * _buffer_size;
+        const size_t insize = _dgram_sizes[dgram_index];
+        timestamp = _dgram_timestamps[dgram_index];
+
         // Look for TS packets in the UDP message.
-        new_packets = TSPacket::Locate(_inbuf.data(), insize, _inbuf_next, _inbuf_count);
+        new_packets = TSPacket::Locate(dgram, insize, _inbuf_next, _inbuf_count);
 
         if (new_packets) {
 
             // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
             // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
-            const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (_inbuf[1] & 0x7F) == RTP_PT_MP2T;
-            const uint32_t rtp_timestamp = rtp ? GetUInt32(_inbuf.data() + 4) : 0;
+            const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (dgram[1] & 0x7F) == RTP_PT_MP2T;
+            const uint32_t rtp_timestamp = rtp ? GetUInt32(dgram + 4) : 0;
+
+            // Make the index of the first TS packet relative to the complete input buffer.
+            _inbuf_next += dgram_index * _buffer_size;
 
             // Use RTP time stamp if there is one and RTP is the preferred choice.
             bool use_rtp = false;
@@ -70,6 +70,30 @@ namespace ts {
         //!
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) = 0;
 
+        //!
+        //! Receive a batch of datagram messages.
+        //! The default implementation receives one single datagram using receiveDatagram().
+        //! Subclasses may override it to receive several datagrams in one system call.
+        //! The method shall wait for at least one datagram but should not wait for more.
+        //! @param [out] buffer Address of the buffer for the received messages.
+        //! The datagram at index @a i is stored at address @a buffer + @a i * @a buffer_size.
+        //! @param [in] buffer_size Size in bytes of the reception buffer for one datagram.
+        //! @param [in] max_count Maximum number of datagrams to receive.
+        //! @param [out] ret_sizes Array of @a max_count elements receiving the sizes of the datagrams.
+        //! @param [out] timestamps Array of @a max_count elements receiving the receive timestamps
+        //! of the datagrams in micro-seconds or -1 if not available.
+        //! @return Number of received datagrams, zero on error.
+        //! @see setDatagramBatchSize()
+        //!
+        virtual size_t receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_sizes, MicroSecond* timestamps);
+
+        //!
+        //! Set the maximum number of datagrams to receive at once using receiveDatagrams().
+        //! Must be called before start(). The default is one.
+        //! @param [in] count Maximum number of datagrams to receive at once.
+        //!
+        void setDatagramBatchSize(size_t count) { _max_datagrams = std::max<size_t>(1, count); }
+
     private:
         // Order of priority for input timestamps. SYSTEM means lower layer from subclass (UDP, SRT, etc).
         enum TimePriority {RTP_SYSTEM_TSP, SYSTEM_RTP_TSP, RTP_TSP, SYSTEM_TSP, TSP_ONLY};
@@ -90,10 +114,16 @@ namespace ts {
         PacketCounter _packets_0 {0};       // Number of received packets since _start_0
         Time          _start_1 {};          // Start of previous bitrate evaluation period
         PacketCounter _packets_1 {0};       // Number of received packets since _start_1
+        size_t        _buffer_size {0};     // Size of one datagram buffer.
+        size_t        _max_datagrams {1};   // Maximum number of datagrams to receive at once.
+        size_t        _dgram_count {0};     // Number of datagrams in _inbuf.
+        size_t        _dgram_next {0};      // Index of next datagram to analyze in _inbuf.
         size_t        _inbuf_count {0};     // Number of remaining TS packets in inbuf
         size_t        _inbuf_next {0};      // Byte index in _inbuf of next TS packet to return
         size_t        _mdata_next {0};      // Index in _mdata of next TS packet metadata to return
-        ByteBlock     _inbuf {};            // Input buffer
-        TSPacketMetadataVector _mdata {};   // Metadata for packets in _inbuf
+        ByteBlock     _inbuf {};            // Input buffer, contains up to _max_datagrams datagrams
+        TSPacketMetadataVector _mdata {};   // Metadata for packets in current datagram
+        std::vector<size_t>      _dgram_sizes {};       // Sizes of datagrams in _inbuf.
+        std::vector<MicroSecond> _dgram_timestamps {};  // Receive timestamps of datagrams in _inbuf.
     };
 }
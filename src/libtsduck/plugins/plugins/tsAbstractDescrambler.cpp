@@ -457,7 +457,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return !_pids.test(pid) || decrypt(_scrambling, pkt) ? TSP_OK : TSP_END;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -479,7 +479,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return decrypt(_scrambling, pkt) ? TSP_OK : TSP_END;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
@@ -509,6 +509,11 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     if ((scv == SC_EVEN_KEY && pecm->new_cw_even) || (scv == SC_ODD_KEY && pecm->new_cw_odd)) {
 
         // A new CW was deciphered.
+        // Packets which were received before must be descrambled using the previous CW.
+        if (!flushPending()) {
+            return TSP_END;
+        }
+
         // In asynchronous mode, the CW are accessed under mutex protection.
         if (!_synchronous) {
             _mutex.acquire();
@@ -532,5 +537,64 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     }
 
     // Descramble the packet payload.
-    return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+    return decrypt(pecm->scrambling, pkt) ? TSP_OK : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::usePacketBatch()
+{
+    return true;
+}
+
+void ts::AbstractDescrambler::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Non-virtual calls to the packet processing method, descrambling is deferred until end of batch.
+    _in_batch = true;
+    size_t i = 0;
+    while (i < count) {
+        status[i] = AbstractDescrambler::processPacket(pkt[i], pkt_data[i]);
+        if (status[i++] == TSP_END) {
+            break;
+        }
+    }
+    _in_batch = false;
+    if (!flushPending() && i > 0) {
+        status[i - 1] = TSP_END;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Descramble a packet, immediately or deferred in batch mode.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::decrypt(TSScrambling& scrambling, TSPacket& pkt)
+{
+    if (_in_batch) {
+        _pending.push_back(std::make_pair(&scrambling, &pkt));
+        return true;
+    }
+    else {
+        return scrambling.decrypt(pkt);
+    }
+}
+
+bool ts::AbstractDescrambler::flushPending()
+{
+    // Descramble sequences of consecutive packets using the same descrambler, preserving the order of packets.
+    bool ok = true;
+    for (size_t first = 0; ok && first < _pending.size(); ) {
+        TSScrambling* const scrambling = _pending[first].first;
+        _pending_pkts.clear();
+        while (first < _pending.size() && _pending[first].first == scrambling) {
+            _pending_pkts.push_back(_pending[first++].second);
+        }
+        ok = scrambling->decrypt(_pending_pkts.data(), _pending_pkts.size());
+    }
+    _pending.clear();
+    return ok;
 }
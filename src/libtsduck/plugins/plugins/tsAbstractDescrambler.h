@@ -41,6 +41,10 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        // In batch mode, the scrambled packets are descrambled all at once at end of batch.
+        // A concrete descrambler which overrides processPacket() shall override usePacketBatch() to return false.
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     protected:
         //!
@@ -238,6 +242,12 @@ namespace ts {
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
+        // Descramble a packet now or, in batch mode, at end of batch or before next CW change.
+        bool decrypt(TSScrambling& scrambling, TSPacket& pkt);
+
+        // Descramble all pending packets of the current batch.
+        bool flushPending();
+
         // Abstract descrambler private data.
         bool               _use_service {false};  // Descramble a service (ie. not a specific list of PID's).
         bool               _need_ecm {false};     // We need to get control words from ECM's.
@@ -254,6 +264,9 @@ namespace ts {
         Mutex              _mutex {};             // Exclusive access to protected areas
         Condition          _ecm_to_do {};         // Notify thread to process ECM.
         ECMThread          _ecm_thread;           // Thread which deciphers ECM's.
+        bool               _in_batch {false};     // Currently processing a batch of packets.
+        std::vector<std::pair<TSScrambling*, TSPacket*>> _pending {}; // Packets to descramble at end of batch.
+        std::vector<TSPacket*> _pending_pkts {};  // Consecutive pending packets using the same descrambler.
         // -- start of protected area --
         bool               _stop_thread {false};  // Terminate ECM processing thread
         // -- end of protected area --
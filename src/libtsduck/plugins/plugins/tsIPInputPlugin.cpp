@@ -26,6 +26,14 @@ ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
 {
     // Add UDP receiver common options.
     _sock.defineArgs(*this, true, true, false);
+
+    option(u"receive-batch", 0, POSITIVE);
+    help(u"receive-batch", u"count",
+         u"Specify the maximum number of UDP datagrams to receive at once. "
+         u"When supported by the operating system (Linux), all datagrams which are already "
+         u"available in the socket are received using one single system call, up to that number. "
+         u"The default is " + UString::Decimal(UDPSocket::DEFAULT_BATCH_SIZE) + u". "
+         u"Use 1 to receive datagrams one by one.");
 }
 
 
@@ -36,6 +44,7 @@ ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
 bool ts::IPInputPlugin::getOptions()
 {
     // Get command line arguments for superclass and socket.
+    setDatagramBatchSize(intValue<size_t>(u"receive-batch", UDPSocket::DEFAULT_BATCH_SIZE));
     return AbstractDatagramInputPlugin::getOptions() && _sock.loadArgs(duck, *this);
 }
 
@@ -97,3 +106,26 @@ bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, siz
     IPv4SocketAddress destination;
     return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *tsp, &timestamp);
 }
+
+size_t ts::IPInputPlugin::receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_sizes, MicroSecond* timestamps)
+{
+    // Describe all message buffers, once and for all.
+    if (_msgs.size() != max_count || (max_count > 0 && _msgs[0].data != buffer)) {
+        _msgs.resize(max_count);
+        for (size_t i = 0; i < max_count; ++i) {
+            _msgs[i].data = buffer + i * buffer_size;
+            _msgs[i].max_size = buffer_size;
+        }
+    }
+
+    // Receive a batch of messages.
+    size_t count = 0;
+    if (!_sock.receive(_msgs.data(), max_count, count, tsp, *tsp)) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ret_sizes[i] = _msgs[i].size;
+        timestamps[i] = _msgs[i].timestamp;
+    }
+    return count;
+}
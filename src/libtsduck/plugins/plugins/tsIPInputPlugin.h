@@ -40,8 +40,10 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) override;
+        virtual size_t receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_sizes, MicroSecond* timestamps) override;
 
     private:
-        UDPReceiver _sock; // Incoming socket with associated command line options.
+        UDPReceiver _sock;       // Incoming socket with associated command line options.
+        std::vector<UDPSocket::Message> _msgs {};  // Description of messages for batch reception.
     };
 }
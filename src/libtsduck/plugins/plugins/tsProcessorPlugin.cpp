@@ -57,6 +57,29 @@ ts::ProcessorPlugin::Status ts::ProcessorPlugin::processPacket(TSPacket& pkt, TS
     return TSP_OK;
 }
 
+bool ts::ProcessorPlugin::usePacketBatch()
+{
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Default implementation of packet batch processing interface.
+//----------------------------------------------------------------------------
+
+void ts::ProcessorPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // The default implementation calls processPacket() for each packet.
+    // A plugin which returns true in usePacketBatch() without overriding
+    // processPacketBatch() still works, with one virtual call per packet.
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processPacket(pkt[i], pkt_data[i]);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Default implementations of packet window processing interface.
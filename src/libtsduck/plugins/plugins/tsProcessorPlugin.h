@@ -72,6 +72,16 @@ namespace ts {
     //! sizes is larger than the size of the global buffer, the stream processing can enter a deadlock and
     //! stops. The global @c tsp command shall be carefully tuned to avoid that.
     //!
+    //! There is a third intermediate way, the "packet batch method". The plugin processes arrays of
+    //! contiguous packets in one call, without the latency of the "packet window method". To trigger
+    //! this type of processing, the plugin class shall override ProcessorPlugin::usePacketBatch() to
+    //! return true and ProcessorPlugin::processPacketBatch(). This method is preferred for simple plugins
+    //! which apply per-packet or per-PID decisions. Instead of one virtual call per packet, the
+    //! decisions are applied in a tight loop over the batch. Previously dropped packets and packets
+    //! which are excluded by -\-only-label options are never part of a batch. The batch method
+    //! cannot be mixed with the window method: if getPacketWindowSize() returns a non-zero value,
+    //! the window method is used.
+    //!
     class TSDUCKDLL ProcessorPlugin : public Plugin
     {
         TS_NOBUILD_NOCOPY(ProcessorPlugin);
@@ -117,6 +127,43 @@ namespace ts {
         //!
         virtual Status processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
 
+        //!
+        //! Check if the plugin prefers the "packet batch" processing method.
+        //!
+        //! This method shall be overriden by plugins which implement processPacketBatch().
+        //! This method is called once by the application after start() but before processing any packet.
+        //!
+        //! @return True if TS packets shall be processed by batches using processPacketBatch().
+        //! If this method is not overriden, the default implementation returns false and TS packets
+        //! are processed one by one using processPacket().
+        //!
+        virtual bool usePacketBatch();
+
+        //!
+        //! Packet batch processing interface.
+        //!
+        //! The main application invokes processPacketBatch() to let the plugin process an array
+        //! of contiguous TS packets in one call. The plugin shall set one processing status per
+        //! packet, with the same meaning as the status which is returned by processPacket().
+        //!
+        //! When the plugin sets the status TSP_END for one packet, the processing is terminated
+        //! after that packet. The plugin should return immediately. The status of subsequent
+        //! packets is ignored.
+        //!
+        //! During the execution of processPacketBatch(), tsp->pluginPackets() returns the number of
+        //! packets which were processed by the plugin before the first packet in the batch. The index of
+        //! the packet @a i in the batch is consequently <code>tsp->pluginPackets() + i</code>.
+        //!
+        //! The default implementation calls processPacket() for each packet.
+        //!
+        //! @param [in,out] pkt Address of an array of @a count TS packets to process.
+        //! @param [in,out] pkt_data Address of an array of @a count TS packet metadata.
+        //! @param [out] status Address of an array of @a count packet processing status.
+        //! All status are initially set to TSP_OK by the application.
+        //! @param [in] count Number of packets in the batch.
+        //!
+        virtual void processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count);
+
         //!
         //! Packet window processing interface.
         //!
@@ -20,7 +20,7 @@ TS_REGISTER_OUTPUT_PLUGIN(u"srt", ts::SRTOutputPlugin);
 
 ts::SRTOutputPlugin::SRTOutputPlugin(TSP* tsp_) :
     OutputPlugin(tsp_, u"Send TS packets using Secure Reliable Transport (SRT)", u"[options] [address:port]"),
-    _datagram(TSDatagramOutputOptions::NONE, this)
+    _datagram(TSDatagramOutputOptions::ALLOW_PACING, this)
 {
     _datagram.defineArgs(*this);
     _sock.defineArgs(*this);
@@ -101,7 +101,7 @@ bool ts::SRTOutputPlugin::stop()
 
 bool ts::SRTOutputPlugin::send(const TSPacket* packets, const TSPacketMetadata* metadata, size_t packet_count)
 {
-    return _datagram.send(packets, packet_count, tsp->bitrate(), *tsp);
+    return _datagram.send(packets, metadata, packet_count, tsp->bitrate(), *tsp);
 }
 
 
@@ -9,12 +9,75 @@
 #include "tshlsInputPlugin.h"
 #include "tsPluginRepository.h"
 #include "tsFileUtils.h"
+#include "tsGuardMutex.h"
+#include "tsGuardCondition.h"
+#include "tsThread.h"
 
 #if !defined(TS_UNIX) || !defined(TS_NO_CURL)
 TS_REGISTER_INPUT_PLUGIN(u"hls", ts::hls::InputPlugin);
 #endif
 
 
+//----------------------------------------------------------------------------
+// Background threads in prefetch mode.
+//----------------------------------------------------------------------------
+
+// Thread which downloads media segments, one at a time, in playlist order.
+class ts::hls::InputPlugin::FetchThread: public Thread
+{
+    TS_NOBUILD_NOCOPY(FetchThread);
+public:
+    FetchThread(InputPlugin& plugin);
+    virtual ~FetchThread() override;
+
+    Condition  wakeup {};  // Signaled when the state of the plugin changes.
+    WebRequest request;    // Current download, can be aborted from another thread.
+
+private:
+    InputPlugin& _plugin;
+    UString      _cookiesFile;  // Private cookie jar, concurrent curl handles must not write the same file.
+    virtual void main() override;
+};
+
+// Thread which reloads the media playlist when it is close to exhaustion.
+class ts::hls::InputPlugin::RefreshThread: public Thread
+{
+    TS_NOBUILD_NOCOPY(RefreshThread);
+public:
+    RefreshThread(InputPlugin& plugin) : Thread(), _plugin(plugin) {}
+    virtual ~RefreshThread() override { waitForTermination(); }
+
+    Condition wakeup {};  // Signaled when the state of the plugin changes.
+
+private:
+    InputPlugin& _plugin;
+    virtual void main() override;
+};
+
+// Constructed before the threads are started: the shared cookies file is not written at that time.
+ts::hls::InputPlugin::FetchThread::FetchThread(InputPlugin& plugin) :
+    Thread(),
+    request(*plugin.tsp),
+    _plugin(plugin),
+    _cookiesFile(TempFile(u".cookies"))
+{
+    // Start with the cookies from the playlists (authentication tokens for instance).
+    // The shared cookies file is only read here, it remains owned by the playlist requests.
+    ByteBlock cookies;
+    if (FileExists(_plugin.webArgs.cookiesFile) && cookies.loadFromFile(_plugin.webArgs.cookiesFile, std::numeric_limits<size_t>::max(), _plugin.tsp)) {
+        cookies.saveToFile(_cookiesFile, _plugin.tsp);
+    }
+}
+
+ts::hls::InputPlugin::FetchThread::~FetchThread()
+{
+    waitForTermination();
+    if (FileExists(_cookiesFile)) {
+        DeleteFile(_cookiesFile, *_plugin.tsp);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Input constructor
 //----------------------------------------------------------------------------
@@ -101,6 +164,16 @@ ts::hls::InputPlugin::InputPlugin(TSP* tsp_) :
          u"When the URL is a master playlist, select a content the resolution of which has a "
          u"lower height than the specified maximum.");
 
+    option(u"prefetch", 0, INTEGER, 0, 1, 0, 32);
+    help(u"prefetch", u"count",
+         u"Number of media segments which are concurrently downloaded in advance. "
+         u"The segments are downloaded in background threads and passed in order to the next plugin. "
+         u"The playlist is also reloaded in the background. "
+         u"This is useful when the download time of each segment is long compared to its duration "
+         u"because of the network latency. "
+         u"By default, the segments are downloaded one after the other, "
+         u"while being passed to the next plugin.");
+
     option(u"save-files", 0, DIRECTORY);
     help(u"save-files",
          u"Specify a directory where all downloaded files, media segments and playlists, are saved "
@@ -129,6 +202,16 @@ ts::hls::InputPlugin::InputPlugin(TSP* tsp_) :
 }
 
 
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::hls::InputPlugin::~InputPlugin()
+{
+    stopPrefetch();
+}
+
+
 //----------------------------------------------------------------------------
 // Simple virtual methods.
 //----------------------------------------------------------------------------
@@ -155,6 +238,7 @@ bool ts::hls::InputPlugin::getOptions()
     getIntValue(_minHeight, u"min-height");
     getIntValue(_maxHeight, u"max-height");
     getIntValue(_startSegment, u"start-segment");
+    getIntValue(_prefetch, u"prefetch", 0);
     _lowestRate = present(u"lowest-bitrate");
     _highestRate = present(u"highest-bitrate");
     _lowestRes = present(u"lowest-resolution");
@@ -207,6 +291,7 @@ bool ts::hls::InputPlugin::getOptions()
     }
 
     // Automatically save media segments and playlists.
+    _saveDirectory = saveDirectory;
     setAutoSaveDirectory(saveDirectory);
     _playlist.setAutoSaveDirectory(saveDirectory);
 
@@ -351,8 +436,8 @@ bool ts::hls::InputPlugin::start()
 
     _segmentCount = 0;
 
-    // Invoke superclass.
-    return AbstractHTTPInputPlugin::start();
+    // Invoke superclass in sequential mode, start the background threads in prefetch mode.
+    return _prefetch == 0 ? AbstractHTTPInputPlugin::start() : startPrefetch();
 }
 
 
@@ -362,7 +447,8 @@ bool ts::hls::InputPlugin::start()
 
 bool ts::hls::InputPlugin::stop()
 {
-    // Invoke superclass first.
+    // Terminate background threads, if any, and invoke superclass.
+    stopPrefetch();
     const bool stopped = AbstractHTTPInputPlugin::stop();
 
     // Then delete the cookie file. Must be done after complete stop to avoid recreation.
@@ -370,6 +456,294 @@ bool ts::hls::InputPlugin::stop()
 }
 
 
+//----------------------------------------------------------------------------
+// Abort the input operation currently in progress.
+//----------------------------------------------------------------------------
+
+bool ts::hls::InputPlugin::abortInput()
+{
+    abortPrefetch();
+    return AbstractHTTPInputPlugin::abortInput();
+}
+
+
+//----------------------------------------------------------------------------
+// Input method.
+//----------------------------------------------------------------------------
+
+size_t ts::hls::InputPlugin::receive(TSPacket* buffer, TSPacketMetadata* metadata, size_t maxPackets)
+{
+    // In sequential mode, the superclass streams the segments one by one.
+    if (_prefetch == 0) {
+        return AbstractHTTPInputPlugin::receive(buffer, metadata, maxPackets);
+    }
+
+    GuardCondition lock(_mutex, _fetched);
+    for (;;) {
+        // Wait for the completion of the next media segment, in playlist order.
+        while (!_terminate && (_downloads.empty() ? !_completed : !_downloads.front().done)) {
+            lock.waitCondition();
+        }
+        if (_terminate) {
+            return 0;
+        }
+        if (_downloads.empty()) {
+            tsp->verbose(u"HLS playlist completed");
+            return 0;
+        }
+
+        // Like in sequential mode, failing to open a segment terminates the session.
+        // A segment which was partially downloaded is passed as is.
+        Download& dl(_downloads.front());
+        if (!dl.success && dl.data.empty()) {
+            _terminate = true;
+            notifyAll();
+            return 0;
+        }
+
+        // Return as many packets as possible from the segment.
+        const size_t count = std::min(maxPackets, (dl.data.size() - dl.offset) / PKT_SIZE);
+        if (count > 0) {
+            ::memcpy(buffer, dl.data.data() + dl.offset, count * PKT_SIZE);
+            dl.offset += count * PKT_SIZE;
+        }
+
+        // When the segment is exhausted, free its slot for the next download.
+        // A trailing partial packet, if any, is dropped, as in sequential mode.
+        if (dl.data.size() - dl.offset < PKT_SIZE) {
+            _downloads.pop_front();
+            notifyAll();
+        }
+        if (count > 0) {
+            return count;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Start, abort, stop background threads in prefetch mode.
+//----------------------------------------------------------------------------
+
+bool ts::hls::InputPlugin::startPrefetch()
+{
+    _terminate = _completed = false;
+    _downloads.clear();
+    _fetchers.clear();
+    for (size_t i = 0; i < _prefetch; ++i) {
+        _fetchers.push_back(FetchThreadPtr(new FetchThread(*this)));
+    }
+    _refresher = new RefreshThread(*this);
+
+    bool success = _refresher->start();
+    for (auto& fetcher : _fetchers) {
+        success = success && fetcher->start();
+    }
+    if (!success) {
+        tsp->error(u"error starting HLS download threads");
+        stopPrefetch();
+    }
+    return success;
+}
+
+void ts::hls::InputPlugin::abortPrefetch()
+{
+    // Request the termination of all threads and interrupt the downloads in progress.
+    GuardMutex lock(_mutex);
+    _terminate = true;
+    for (auto& fetcher : _fetchers) {
+        fetcher->request.abort();
+    }
+    notifyAll();
+}
+
+void ts::hls::InputPlugin::stopPrefetch()
+{
+    abortPrefetch();
+
+    // Move the threads out of the plugin under the mutex: the other threads and abortInput() walk them in notifyAll().
+    std::vector<FetchThreadPtr> fetchers;
+    RefreshThreadPtr refresher;
+    {
+        GuardMutex lock(_mutex);
+        fetchers.swap(_fetchers);
+        refresher = _refresher;
+        _refresher.clear();
+    }
+
+    // The destructors of the threads wait for their termination, outside the mutex.
+    // A playlist reload in progress is not interruptible, it ends on its own Web timeout.
+    refresher.clear();
+    fetchers.clear();
+    _downloads.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Notify all background threads and the input thread of a state change.
+//----------------------------------------------------------------------------
+
+void ts::hls::InputPlugin::notifyAll()
+{
+    // Each waiting thread has its own condition because a condition awakes only one thread.
+    _fetched.signal();
+    for (auto& fetcher : _fetchers) {
+        fetcher->wakeup.signal();
+    }
+    if (!_refresher.isNull()) {
+        _refresher->wakeup.signal();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if no more segment shall be downloaded.
+//----------------------------------------------------------------------------
+
+void ts::hls::InputPlugin::checkCompleted()
+{
+    if (!_completed &&
+        // reached maximum number of segments
+        ((_maxSegmentCount > 0 && _segmentCount >= _maxSegmentCount) ||
+         // no more segment in a playlist which cannot be reloaded
+         (_playlist.segmentCount() == 0 && !_playlist.isUpdatable()) ||
+         // user interruption
+         tsp->aborting()))
+    {
+        _completed = true;
+        notifyAll();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Download thread in prefetch mode.
+//----------------------------------------------------------------------------
+
+void ts::hls::InputPlugin::FetchThread::main()
+{
+    Report& report(*_plugin.tsp);
+    report.debug(u"HLS download thread started");
+
+    request.setArgs(_plugin.webArgs);
+    request.setAutoRedirect(true);
+    request.enableCookies(_cookiesFile);
+
+    for (;;) {
+        Download* dl = nullptr;
+        UString url;
+
+        // Wait until a new media segment can be downloaded.
+        {
+            GuardCondition lock(_plugin._mutex, wakeup);
+            while (!_plugin._terminate && !_plugin._completed && (_plugin._downloads.size() >= _plugin._prefetch || _plugin._playlist.segmentCount() == 0)) {
+                lock.waitCondition();
+            }
+            if (_plugin._terminate || _plugin._completed) {
+                break;
+            }
+
+            // Remove first segment from the playlist and queue its download, in playlist order.
+            hls::MediaSegment seg;
+            _plugin._playlist.popFirstSegment(seg);
+            _plugin._segmentCount++;
+            url = seg.urlString();
+            _plugin._downloads.emplace_back();
+            dl = &_plugin._downloads.back();
+            dl->url = url;
+
+            // Fewer segments remain in the playlist, the playlist may need to be reloaded.
+            _plugin.checkCompleted();
+            _plugin.notifyAll();
+        }
+
+        // Download the segment outside the critical section.
+        report.debug(u"downloading segment %s", {url});
+        ByteBlock data;
+        const bool success = request.downloadBinaryContent(url, data);
+        report.verbose(u"downloaded %s, %'d bytes", {request.finalURL(), data.size()});
+
+        // Auto-save the segment when necessary. Display errors but do not fail, this is just auto save.
+        const UString name(BaseName(URL(request.finalURL()).getPath()));
+        if (!data.empty() && !_plugin._saveDirectory.empty() && !name.empty()) {
+            report.verbose(u"saving input TS to %s", {_plugin._saveDirectory + PathSeparator + name});
+            data.saveToFile(_plugin._saveDirectory + PathSeparator + name, &report);
+        }
+
+        // Pass the segment content to the input thread.
+        GuardMutex lock(_plugin._mutex);
+        dl->data.swap(data);
+        dl->done = true;
+        dl->success = success;
+        _plugin._fetched.signal();
+    }
+
+    report.debug(u"HLS download thread terminated");
+}
+
+
+//----------------------------------------------------------------------------
+// Playlist reload thread in prefetch mode.
+//----------------------------------------------------------------------------
+
+void ts::hls::InputPlugin::RefreshThread::main()
+{
+    Report& report(*_plugin.tsp);
+    report.debug(u"HLS playlist reload thread started");
+
+    bool retried = false;
+    PlayList playlist;
+
+    for (;;) {
+        // Wait until there is only one or zero remaining segment in an updatable playlist.
+        {
+            GuardCondition lock(_plugin._mutex, wakeup);
+            while (!_plugin._terminate && !_plugin._completed && (!_plugin._playlist.isUpdatable() || _plugin._playlist.segmentCount() >= 2)) {
+                lock.waitCondition();
+            }
+            if (_plugin._terminate || _plugin._completed) {
+                break;
+            }
+            playlist = _plugin._playlist;
+        }
+
+        // Reload a copy of the playlist outside the critical section. The download threads
+        // continue to pop segments from the playlist in the meantime.
+        const bool reloaded = playlist.reload(false, _plugin.webArgs, report);
+
+        // Add the new segments to the playlist, unless the plugin was stopped during the reload.
+        GuardCondition lock(_plugin._mutex, wakeup);
+        if (_plugin._terminate || _plugin._completed) {
+            break;
+        }
+        else if (reloaded && _plugin._playlist.merge(playlist, report)) {
+            retried = false;
+            _plugin.checkCompleted();
+            _plugin.notifyAll();
+        }
+        else if (_plugin._playlist.segmentCount() == 0 && ((retried && !reloaded) || Time::CurrentUTC() > _plugin._playlist.terminationUTC())) {
+            // End of playlist if we cannot find new segments. Like in sequential mode, the first
+            // reload error is ignored but we stop on reload error when retrying.
+            _plugin._completed = true;
+            _plugin.notifyAll();
+        }
+        else {
+            // If there is no new segment, this means that we have read all segments before the server could
+            // produce new segments. For live streams, this is possible because new segments can be produced
+            // as late as the estimated end time of the previous playlist. So, we retry at regular intervals,
+            // half the target duration of a segment, with a minimum of 2 seconds.
+            retried = _plugin._playlist.segmentCount() == 0;
+            const Time limit(Time::CurrentUTC() + std::max<MilliSecond>(2000, (MilliSecPerSec * _plugin._playlist.targetDuration()) / 2));
+            for (Time now(Time::CurrentUTC()); !_plugin._terminate && !_plugin._completed && now < limit; now = Time::CurrentUTC()) {
+                lock.waitCondition(limit - now);
+            }
+        }
+    }
+
+    report.debug(u"HLS playlist reload thread terminated");
+}
+
+
 //----------------------------------------------------------------------------
 // Called by AbstractHTTPInputPlugin to open an URL.
 //----------------------------------------------------------------------------
@@ -408,6 +782,10 @@ bool ts::hls::InputPlugin::openURL(WebRequest& request)
         // End of playlist if we cannot find new segments.
         completed = _playlist.segmentCount() == 0;
     }
+    else if (!completed && _playlist.segmentCount() == 0) {
+        // All segments were played in a playlist which cannot be reloaded.
+        completed = true;
+    }
 
     if (completed) {
         tsp->verbose(u"HLS playlist completed");
@@ -15,6 +15,10 @@
 #include "tsAbstractHTTPInputPlugin.h"
 #include "tshlsPlayList.h"
 #include "tsURL.h"
+#include "tsByteBlock.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsSafePtr.h"
 
 namespace ts {
     namespace hls {
@@ -25,6 +29,11 @@ namespace ts {
         //! The input plugin can read HLS playlists and media segments from local
         //! files or receive them in real time using HTTP or HTTPS.
         //!
+        //! By default, media segments are downloaded one after the other and streamed
+        //! to the next plugin while being downloaded. With option --prefetch, several
+        //! media segments are concurrently downloaded in background threads and passed
+        //! in order to the next plugin. The playlist is also reloaded in the background.
+        //!
         class TSDUCKDLL InputPlugin: public AbstractHTTPInputPlugin
         {
             TS_NOBUILD_NOCOPY(InputPlugin);
@@ -35,11 +44,18 @@ namespace ts {
             //!
             InputPlugin(TSP* tsp);
 
+            //!
+            //! Destructor.
+            //!
+            virtual ~InputPlugin() override;
+
             // Implementation of plugin API
             virtual bool getOptions() override;
             virtual bool start() override;
             virtual bool stop() override;
+            virtual bool abortInput() override;
             virtual bool isRealTime() override;
+            virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
 
         protected:
             // Implementation of AbstractHTTPInputPlugin
@@ -66,10 +82,49 @@ namespace ts {
             UString  _altName {};
             UString  _altGroupId {};
             UString  _altLanguage {};
+            size_t   _prefetch {0};
+            UString  _saveDirectory {};
 
             // Working data:
             size_t   _segmentCount {0};
             PlayList _playlist {};
+
+            // Background threads, in prefetch mode.
+            class FetchThread;
+            class RefreshThread;
+            typedef SafePtr<FetchThread> FetchThreadPtr;
+            typedef SafePtr<RefreshThread> RefreshThreadPtr;
+
+            // Description of a media segment download, in prefetch mode.
+            class Download
+            {
+            public:
+                UString   url {};          // Media segment URL.
+                ByteBlock data {};         // Downloaded content.
+                size_t    offset {0};      // Offset of next packet to pass to tsp.
+                bool      done {false};    // Download is completed.
+                bool      success {false}; // Download was successful.
+            };
+
+            // Working data in prefetch mode. All fields, including _playlist and _segmentCount, are protected by _mutex.
+            Mutex                       _mutex {};
+            Condition                   _fetched {};          // Signaled when a download completes or the state changes.
+            bool                        _terminate {false};   // Stop all background threads.
+            bool                        _completed {false};   // No more segment to download.
+            std::list<Download>         _downloads {};        // Downloads in progress or not yet passed to tsp, in playlist order.
+            std::vector<FetchThreadPtr> _fetchers {};         // Segment download threads.
+            RefreshThreadPtr            _refresher {};        // Playlist reload thread.
+
+            // Start, abort, stop background threads in prefetch mode.
+            bool startPrefetch();
+            void abortPrefetch();
+            void stopPrefetch();
+
+            // Notify all background threads and the input thread of a state change. Must be called with _mutex held.
+            void notifyAll();
+
+            // Check if no more segment shall be downloaded. Must be called with _mutex held.
+            void checkCompleted();
         };
     }
 }
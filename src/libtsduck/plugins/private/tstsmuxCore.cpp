@@ -7,8 +7,9 @@
 //----------------------------------------------------------------------------
 
 #include "tstsmuxCore.h"
-#include "tsMonotonic.h"
 #include "tsFatal.h"
+#include "tsGuardCondition.h"
+#include "tsSysUtils.h"
 #include "tsAlgorithm.h"
 #include "tsBinaryTable.h"
 #include "tsCADescriptor.h"
@@ -16,6 +17,10 @@
 #include "tsTOT.h"
 #include "tsEIT.h"
 
+#if !defined(TS_CXX17)
+constexpr ts::PacketCounter ts::tsmux::Core::NONE;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor and destructor.
@@ -45,7 +50,17 @@ ts::tsmux::Core::Core(const MuxerArgs& opt, const PluginEventHandlerRegistry& ha
     _max_eits(128), // hard-coded for now
     _eits(),
     _pid_origin(),
-    _service_origin()
+    _service_origin(),
+    _wakeup_mutex(),
+    _wakeup_cond(),
+    _wakeup_signaled(false),
+    _now(),
+    _iterations(0),
+    _input_wakeups(0),
+    _input_polls(0),
+    _null_packets(0),
+    _wakeup_delay(),
+    _latency()
 {
     // Preset common default options.
     _duck.restoreArgs(_opt.duckArgs);
@@ -143,9 +158,11 @@ void ts::tsmux::Core::stop()
         _inputs[i]->terminate();
     }
 
-    // Stop our internal thread. We only set the terminate flag, actual termination
-    // will occur at the next muxing iteration.
+    // Stop our internal thread. We only set the terminate flag and wake up the thread,
+    // actual termination will occur at the next muxing iteration.
+    GuardCondition lock(_wakeup_mutex, _wakeup_cond);
     _terminate = true;
+    lock.signal();
 }
 
 
@@ -215,12 +232,18 @@ void ts::tsmux::Core::main()
     PacketCounter next_nit_packet = 0;
     PacketCounter next_sdt_packet = 0;
 
-    // Insertion is cadenced using a monotonic clock.
+    // Insertion is scheduled using a monotonic clock. Output packet N is due at start + N * packet duration.
     const Monotonic start(true);
-    Monotonic clock(start);
+    _now = start;
+
+    // The unit of Monotonic operations is the nanosecond, the command line options are in microseconds.
+    const NanoSecond max_wait = _opt.cadence * NanoSecPerMicroSec;
+    const NanoSecond min_wait = _opt.minCadence * NanoSecPerMicroSec;
 
-    // The unit of Monotonic operations is the nanosecond, the command line option is in microseconds.
-    const NanoSecond cadence = _opt.cadence * NanoSecPerMicroSec;
+    // Reset statistics.
+    _iterations = _input_wakeups = _input_polls = _null_packets = 0;
+    _wakeup_delay.reset();
+    _latency.reset();
 
     // Keep track of terminated input plugins.
     _terminated_inputs.clear();
@@ -234,19 +257,19 @@ void ts::tsmux::Core::main()
     TSPacket pkt;
     TSPacketMetadata pkt_data;
 
-    // Loop until we are instructed to stop. Each iteration is a muxing period at the defined cadence.
+    // Loop until we are instructed to stop. Each iteration sends all packets which are due at the current time.
+    // Then, the thread sleeps until the next deadline or until an input thread signals new packets.
     while (!_terminate) {
 
-        // End of next time interval.
-        clock += cadence;
+        _iterations++;
 
-        // Number of packets which should have been sent by the end of the time interval.
-        const PacketCounter expected_packets = (((clock - start) * _bitrate) / (NanoSecPerSec * PKT_SIZE_BITS)).toInt();
+        // Number of packets which should have been sent at this time.
+        const PacketCounter expected_packets = (((_now - start) * _bitrate) / (NanoSecPerSec * PKT_SIZE_BITS)).toInt();
 
-        // Number of packets to send by the end of the time interval.
+        // Number of packets to send now.
         PacketCounter packet_count = expected_packets < _output_packets ? 0 : expected_packets - _output_packets;
 
-        // Loop on packets to send during this time interval.
+        // Loop on packets to send now.
         while (!_terminate && packet_count > 0) {
 
             pkt_data.reset();
@@ -280,6 +303,7 @@ void ts::tsmux::Core::main()
                 // Nothing is available, insert a null packet.
                 pkt = NullPacket;
                 pkt_data.setNullified(true);
+                _null_packets++;
             }
 
             // Output that packet.
@@ -293,12 +317,29 @@ void ts::tsmux::Core::main()
             }
         }
 
-        // Wait until next muxing period.
+        // Compute the next deadline.
         if (!_terminate) {
-            clock.wait();
+            // Index of the next output packet which can be filled from an input plugin.
+            const PacketCounter slot = nextInputSlot();
+            // When all inputs are idle, wait for input packets, at most the maximum cadence.
+            Monotonic due(_now);
+            due += max_wait;
+            if (slot != NONE) {
+                // Some input packets are waiting, wake up when their output slot is due.
+                // Packet N is sent when the expected number of packets exceeds N.
+                Monotonic slot_time(start);
+                slot_time += (((slot + 1) * PKT_SIZE_BITS * NanoSecPerSec) / _bitrate).toInt() + 1;
+                Monotonic min_due(_now);
+                min_due += min_wait;
+                due = std::min(due, std::max(slot_time, min_due));
+            }
+            waitUntil(due, slot == NONE);
         }
     }
 
+    // Report scheduling statistics.
+    reportStatistics();
+
     // Make sure all plugins, input and output, terminates.
     // It termination was externally triggerd, all plugins are already terminating.
     // But if all inputs have naturally terminated, we must terminate the output thread.
@@ -317,9 +358,15 @@ bool ts::tsmux::Core::getInputPacket(size_t& input_index, TSPacket& pkt, TSPacke
 {
     bool success = false;
     size_t plugin_count = 0;
+    Monotonic received;
     do {
         // Try to get a packet from current plugin.
-        success = _inputs[input_index]->getPacket(pkt, pkt_data);
+        success = _inputs[input_index]->getPacket(pkt, pkt_data, received);
+
+        // Measure the latency between the input reception and the output.
+        if (success) {
+            _latency.feed(double(Monotonic(true) - received) / double(NanoSecPerMicroSec));
+        }
 
         // Keep track of terminated input plugins.
         if (!success && _inputs[input_index]->isTerminated()) {
@@ -338,6 +385,82 @@ bool ts::tsmux::Core::getInputPacket(size_t& input_index, TSPacket& pkt, TSPacke
 }
 
 
+//----------------------------------------------------------------------------
+// Index of the next output packet which can be filled from an input plugin.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::tsmux::Core::nextInputSlot() const
+{
+    PacketCounter slot = NONE;
+    for (const auto& input : _inputs) {
+        slot = std::min(slot, input->nextSlot());
+    }
+    return slot;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until a deadline or until an input thread signals new packets.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::Core::waitUntil(const Monotonic& due, bool wake_on_input)
+{
+    bool signaled = false;
+    {
+        // Wait on the condition, with its millisecond granularity, until shortly before the deadline.
+        GuardCondition lock(_wakeup_mutex, _wakeup_cond);
+        for (;;) {
+            signaled = wake_on_input && _wakeup_signaled;
+            if (signaled || _terminate) {
+                break;
+            }
+            const NanoSecond remain = due - Monotonic(true);
+            if (remain < 2 * NanoSecPerMilliSec) {
+                break;
+            }
+            lock.waitCondition(remain / NanoSecPerMilliSec - 1);
+        }
+        _wakeup_signaled = false;
+    }
+
+    if (signaled) {
+        _input_wakeups++;
+    }
+    else if (!_terminate) {
+        // Complete the wait with the system timer and measure the wake-up delay.
+        Monotonic wakeup(due);
+        wakeup.wait();
+        _now.getSystemTime();
+        _wakeup_delay.feed(double(_now - due) / double(NanoSecPerMicroSec));
+        return;
+    }
+    _now.getSystemTime();
+}
+
+
+//----------------------------------------------------------------------------
+// Report scheduling statistics.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::Core::reportStatistics()
+{
+    if (_log.verbose()) {
+        ProcessMetrics metrics;
+        GetProcessMetrics(metrics);
+        _log.verbose(u"core: %'d output packets, %'d null packets, %'d muxing iterations, %'d woken up by input, %'d input buffer accesses, process CPU time: %'d ms",
+                     {_output_packets, _null_packets, _iterations, _input_wakeups, _input_polls, metrics.cpu_time});
+        if (_wakeup_delay.count() > 0) {
+            _log.verbose(u"core: wake-up delay after deadline: mean %s us, std deviation %s us, max %.2f us",
+                         {_wakeup_delay.meanString(), _wakeup_delay.standardDeviationString(), _wakeup_delay.maximum()});
+        }
+        if (_latency.count() > 0) {
+            _log.verbose(u"core: input to output latency: mean %s us, std deviation %s us, max %.2f us",
+                         {_latency.meanString(), _latency.standardDeviationString(), _latency.maximum()});
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Try to extract a UTC time from a TDT or TOT in one TS packet.
 //----------------------------------------------------------------------------
@@ -422,6 +545,7 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
     _next_insertion(0),
     _next_packet(),
     _next_metadata(),
+    _next_received(),
     _pid_clocks()
 {
     // Filter all global PSI/SI for merging in output PSI.
@@ -444,6 +568,29 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
 
     // The NIT is valid only when waiting to be merged.
     _nit.invalidate();
+
+    // The input thread wakes up the core when new packets are available.
+    _input.setNotification(&_core._wakeup_mutex, &_core._wakeup_cond, &_core._wakeup_signaled);
+}
+
+
+//----------------------------------------------------------------------------
+// Index of the next output packet which can be filled from this input.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::tsmux::Core::Input::nextSlot() const
+{
+    if (_next_insertion > 0) {
+        // A delayed packet is waiting for its insertion point, based on PID clocks.
+        return _next_insertion;
+    }
+    else if (!_terminated && _input.available()) {
+        // Packets (or termination) are available, the next output packet can use them.
+        return _core._output_packets;
+    }
+    else {
+        return NONE;
+    }
 }
 
 
@@ -451,7 +598,7 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
 // Get one input packet. Return false when none is immediately available.
 //----------------------------------------------------------------------------
 
-bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, Monotonic& received)
 {
     // If there is a waiting packet, either return that packet or nothing.
     if (_next_insertion > 0) {
@@ -461,6 +608,7 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
             _next_insertion = 0;
             pkt = _next_packet;
             pkt_data = _next_metadata;
+            received = _next_received;
             adjustPCR(pkt);
             return true;
         }
@@ -470,9 +618,15 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
         }
     }
 
+    // Do not lock the input buffer when it is known to be empty.
+    if (!_terminated && !_input.available()) {
+        return false;
+    }
+
     // Get one packet from the input executor thread, non-blocking.
+    _core._input_polls++;
     size_t ret_count = 0;
-    _terminated = _terminated || !_input.getPackets(&pkt, &pkt_data, 1, ret_count, false);
+    _terminated = _terminated || !_input.getPackets(&pkt, &pkt_data, 1, ret_count, false, &received);
     if (_terminated || ret_count == 0) {
         return false;
     }
@@ -521,6 +675,7 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
                         _next_insertion = target_packet;
                         _next_packet = pkt;
                         _next_metadata = pkt_data;
+                        _next_received = received;
                         return false;
                     }
                 }
@@ -17,6 +17,8 @@
 #include "tstsmuxInputExecutor.h"
 #include "tstsmuxOutputExecutor.h"
 #include "tsTime.h"
+#include "tsMonotonic.h"
+#include "tsSingleDataStatistics.h"
 #include "tsSectionDemux.h"
 #include "tsCyclingPacketizer.h"
 #include "tsPCRMerger.h"
@@ -113,6 +115,20 @@ namespace ts {
             std::map<PID,Origin>      _pid_origin;      // Map of PID's to original input stream.
             std::map<uint16_t,Origin> _service_origin;  // Map of service ids to original input stream.
 
+            // Event-driven scheduling: the input threads signal new packets, the core waits until the next deadline.
+            Mutex               _wakeup_mutex;      // Protects _wakeup_signaled.
+            Condition           _wakeup_cond;       // Signaled by input threads when packets are available.
+            bool                _wakeup_signaled;   // Wake-up condition was signaled.
+            Monotonic           _now;               // Time of current muxing iteration.
+
+            // Scheduling statistics.
+            PacketCounter       _iterations;        // Number of muxing iterations.
+            PacketCounter       _input_wakeups;     // Number of iterations which were triggered by an input thread.
+            PacketCounter       _input_polls;       // Number of accesses to input buffers.
+            PacketCounter       _null_packets;      // Number of inserted null packets.
+            SingleDataStatistics<double> _wakeup_delay;  // Delay after deadline on timed wake-up, in microseconds.
+            SingleDataStatistics<double> _latency;       // Time from input reception to output, in microseconds.
+
             // Implementation of Thread.
             virtual void main() override;
 
@@ -120,6 +136,16 @@ namespace ts {
             // Update the plugin index. Return false if all input plugins were tried without success.
             bool getInputPacket(size_t& input_index, TSPacket& pkt, TSPacketMetadata& pkt_data);
 
+            // Index of the next output packet which can be filled from an input plugin, NONE if all inputs are idle.
+            static constexpr PacketCounter NONE = std::numeric_limits<PacketCounter>::max();
+            PacketCounter nextInputSlot() const;
+
+            // Wait until a deadline or, when wake_on_input is true, until an input thread signals new packets.
+            void waitUntil(const Monotonic& due, bool wake_on_input);
+
+            // Report scheduling statistics.
+            void reportStatistics();
+
             // Try to extract a UTC time from a TDT or TOT in one TS packet.
             bool getUTC(Time& utc, const TSPacket& pkt);
 
@@ -156,8 +182,11 @@ namespace ts {
                 // Wait for the executor thread to terminate.
                 void waitForTermination() { _input.waitForTermination(); }
 
-                // Get one input packet. Return false when none is immediately available.
-                bool getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
+                // Get one input packet and its reception time. Return false when none is immediately available.
+                bool getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, Monotonic& received);
+
+                // Index of the next output packet which can be filled from this input, NONE if idle.
+                PacketCounter nextSlot() const;
 
             private:
                 Core&            _core;           // Reference to the parent Core.
@@ -173,6 +202,7 @@ namespace ts {
                 PacketCounter    _next_insertion; // Insertion point of next packet.
                 TSPacket         _next_packet;    // Next packet to insert if already received but not yet inserted.
                 TSPacketMetadata _next_metadata;  // Associated metadata.
+                Monotonic        _next_received;  // Reception time of next packet.
                 std::map<PID,PIDClock> _pid_clocks;  // Output clock of each input PID.
 
                 // Adjust the PCR of a packet before insertion.
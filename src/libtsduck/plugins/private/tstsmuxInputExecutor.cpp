@@ -19,7 +19,8 @@ ts::tsmux::InputExecutor::InputExecutor(const MuxerArgs& opt, const PluginEventH
     // Input threads have a high priority to be always ready to load incoming packets in the buffer.
     PluginExecutor(opt, handlers, PluginType::INPUT, opt.inputs[index], ThreadAttributes().setPriority(ThreadAttributes::GetHighPriority()), log),
     _input(dynamic_cast<InputPlugin*>(PluginThread::plugin())),
-    _pluginIndex(index)
+    _pluginIndex(index),
+    _received(_buffer_size)
 {
     // Make sure that the input plugins display their index.
     setLogName(UString::Format(u"%s[%d]", {pluginName(), _pluginIndex}));
@@ -52,6 +53,31 @@ void ts::tsmux::InputExecutor::terminate()
 
     // Then abort input in progress if there is one to avoid blocking.
     _input->abortInput();
+
+    // The core shall no longer wait for this input.
+    _available = true;
+    notify();
+}
+
+
+//----------------------------------------------------------------------------
+// Set the notification of the multiplexer core.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::InputExecutor::setNotification(Mutex* mutex, Condition* condition, bool* signaled)
+{
+    _notify_mutex = mutex;
+    _notify_condition = condition;
+    _notify_signaled = signaled;
+}
+
+void ts::tsmux::InputExecutor::notify()
+{
+    if (_notify_mutex != nullptr && _notify_condition != nullptr && _notify_signaled != nullptr) {
+        GuardCondition lock(*_notify_mutex, *_notify_condition);
+        *_notify_signaled = true;
+        lock.signal();
+    }
 }
 
 
@@ -59,7 +85,7 @@ void ts::tsmux::InputExecutor::terminate()
 // Copy packets from the input buffer.
 //----------------------------------------------------------------------------
 
-bool ts::tsmux::InputExecutor::getPackets(TSPacket* pkt, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool blocking)
+bool ts::tsmux::InputExecutor::getPackets(TSPacket* pkt, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool blocking, Monotonic* received)
 {
     // In blocking mode, loop until there is some packet in the buffer.
     GuardCondition lock(_mutex, _got_packets);
@@ -83,8 +109,12 @@ bool ts::tsmux::InputExecutor::getPackets(TSPacket* pkt, TSPacketMetadata* mdata
     if (ret_count > 0) {
         TSPacket::Copy(pkt, &_packets[_packets_first], ret_count);
         TSPacketMetadata::Copy(mdata, &_metadata[_packets_first], ret_count);
+        if (received != nullptr) {
+            std::copy(_received.begin() + _packets_first, _received.begin() + _packets_first + ret_count, received);
+        }
         _packets_first = (_packets_first + ret_count) % _buffer_size;
         _packets_count -= ret_count;
+        _available = _packets_count > 0 || _terminate;
 
         // Signal that there are some free space.
         // The mutex was initially locked for the _got_packets condition because we needed to wait
@@ -130,11 +160,18 @@ void ts::tsmux::InputExecutor::main()
         if (!_terminate) {
             count = _input->receive(&_packets[first], &_metadata[first], std::min(count, _opt.maxInputPackets));
             if (count > 0) {
-                // Packets successfully received.
-                GuardCondition lock(_mutex, _got_packets);
-                _packets_count += count;
-                // Signal that there are some new packets in the buffer.
-                lock.signal();
+                // Packets successfully received. One reception time per chunk is precise enough.
+                const Monotonic now(true);
+                std::fill(_received.begin() + first, _received.begin() + first + count, now);
+                {
+                    GuardCondition lock(_mutex, _got_packets);
+                    _packets_count += count;
+                    _available = true;
+                    // Signal that there are some new packets in the buffer.
+                    lock.signal();
+                }
+                // Wake up the core outside the buffer lock.
+                notify();
             }
             else if (_opt.inputOnce) {
                 // Terminates when the input plugin terminates or fails.
@@ -153,5 +190,7 @@ void ts::tsmux::InputExecutor::main()
 
     // Stop the plugin.
     _input->stop();
+    _available = true;
+    notify();
     debug(u"input thread terminated");
 }
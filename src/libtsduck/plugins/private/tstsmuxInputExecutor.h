@@ -15,6 +15,7 @@
 #include "tstsmuxPluginExecutor.h"
 #include "tsMuxerArgs.h"
 #include "tsInputPlugin.h"
+#include "tsMonotonic.h"
 
 namespace ts {
     namespace tsmux {
@@ -48,9 +49,27 @@ namespace ts {
             //! @param [out] ret_count Returned number of actual packets.
             //! @param [in] blocking If true, block until at least one packet is available.
             //! If false, immediately return with @a ret_count being zero if no packet is available.
+            //! @param [out] received Optional address of a buffer of @a max_count reception times.
             //! @return True on success, false if the output is terminated on error.
             //!
-            bool getPackets(TSPacket* pkt, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool blocking);
+            bool getPackets(TSPacket* pkt, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool blocking, Monotonic* received = nullptr);
+
+            //!
+            //! Check if packets are available in the input buffer or if the input is terminated.
+            //! In both cases, the next call to getPackets() will not block.
+            //! This method does not lock the buffer and can be called at high frequency.
+            //! @return True if a call to getPackets() is useful.
+            //!
+            bool available() const { return _available; }
+
+            //!
+            //! Set the notification of the multiplexer core when packets are available or the input is terminated.
+            //! Must be called before starting the executor thread.
+            //! @param [in] mutex Mutex which protects @a signaled.
+            //! @param [in] condition Condition to signal, associated with @a mutex.
+            //! @param [in,out] signaled Flag which is set under the protection of @a mutex before signaling @a condition.
+            //!
+            void setNotification(Mutex* mutex, Condition* condition, bool* signaled);
 
             // Implementation of TSP.
             virtual size_t pluginIndex() const override;
@@ -59,8 +78,16 @@ namespace ts {
             virtual void terminate() override;
 
         private:
-            InputPlugin* _input;         // Plugin API.
-            const size_t _pluginIndex;   // Index of this input plugin.
+            InputPlugin*      _input;             // Plugin API.
+            const size_t      _pluginIndex;       // Index of this input plugin.
+            std::vector<Monotonic> _received;     // Reception time of each packet in the circular buffer.
+            std::atomic<bool> _available {false}; // Packets are available in the buffer or the input is terminated.
+            Mutex*            _notify_mutex {nullptr};      // Mutex to notify the core.
+            Condition*        _notify_condition {nullptr};  // Condition to notify the core.
+            bool*             _notify_signaled {nullptr};   // Notification flag, protected by _notify_mutex.
+
+            // Notify the core that packets are available or the input is terminated.
+            void notify();
 
             // Implementation of Thread.
             virtual void main() override;
@@ -37,8 +37,16 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
     _bitrate(0),
     _br_confidence(BitRateConfidence::LOW),
     _restart(false),
-    _restart_data()
+    _restart_data(),
+    _lockfree(options.sync_mode == TSProcessorArgs::SyncMode::LOCKFREE),
+    _work_mutex(),
+    _sleeping(false),
+    _br_lock(),
+    _wait_count(0),
+    _block_count(0)
 {
+    _br_lock.clear();
+
     // Preset common default options.
     if (plugin() != nullptr) {
         plugin()->resetContext(options.duck_args);
@@ -48,6 +56,14 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
 ts::tsp::PluginExecutor::~PluginExecutor()
 {
     waitForTermination();
+
+    // Report synchronization statistics, useful to compare the synchronization modes.
+    if (_lockfree) {
+        debug(u"lock-free synchronization: %'d waits for packets, %'d blocked", {_wait_count, _block_count});
+    }
+    else {
+        debug(u"mutex synchronization: %'d waits for packets", {_wait_count});
+    }
 }
 
 
@@ -81,7 +97,26 @@ void ts::tsp::PluginExecutor::setAbort()
 {
     GuardMutex lock(_global_mutex);
     _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.signal();
+    ringPrevious<PluginExecutor>()->wakeUp(true);
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up this plugin executor when something new happened.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::wakeUp(bool force)
+{
+    if (!_lockfree) {
+        // The caller holds the global mutex.
+        _to_do.signal();
+    }
+    else if (force || _sleeping.load()) {
+        // The waiting thread checks its condition and waits on _to_do while holding _work_mutex.
+        // Acquiring the mutex here guarantees that the signal cannot be lost.
+        GuardMutex lock(_work_mutex);
+        _to_do.signal();
+    }
 }
 
 
@@ -116,6 +151,7 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
     _pkt_first = pkt_first;
     _pkt_cnt = pkt_cnt;
     _input_end = input_end;
+    _sleeping = false;
     _tsp_aborting = aborted;
     _bitrate = bitrate;
     _br_confidence = br_confidence;
@@ -134,6 +170,10 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
 
+    if (_lockfree) {
+        return passPacketsLockFree(count, bitrate, br_confidence, input_end, aborted);
+    }
+
     // We access data under the protection of the global mutex.
     GuardMutex lock(_global_mutex);
 
@@ -141,18 +181,18 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     _pkt_first = (_pkt_first + count) % _buffer->count();
     _pkt_cnt -= count;
 
-    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
-    PluginExecutor* next = ringNext<PluginExecutor>();
-    next->_pkt_cnt += count;
-
     // Propagate bitrate and end of input flag to next processor.
+    PluginExecutor* next = ringNext<PluginExecutor>();
     next->_bitrate = bitrate;
     next->_br_confidence = br_confidence;
     next->_input_end = next->_input_end || input_end;
 
+    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
+    next->_pkt_cnt += count;
+
     // Wake the next processor when there is some new input data or end of input.
     if (count > 0 || input_end) {
-        next->_to_do.signal();
+        next->wakeUp(true);
     }
 
     // Force to abort our processor when the next one is aborting. Already done in waitWork() but force immediately.
@@ -164,7 +204,55 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     // Wake the previous processor when we abort (propagate abort conditions backward).
     if (aborted) {
         _tsp_aborting = true; // volatile bool in TSP superclass
-        ringPrevious<PluginExecutor>()->_to_do.signal();
+        ringPrevious<PluginExecutor>()->wakeUp(true);
+    }
+
+    // Return false when the current processor shall stop.
+    return !input_end && !aborted;
+}
+
+
+//----------------------------------------------------------------------------
+// Lock-free version of passPackets().
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted)
+{
+    // Update our buffer. Only this thread modifies _pkt_first. The previous processor concurrently
+    // increments _pkt_cnt, which is why we subtract instead of assigning a new value.
+    _pkt_first = (_pkt_first + count) % _buffer->count();
+    _pkt_cnt -= count;
+
+    PluginExecutor* next = ringNext<PluginExecutor>();
+
+    // Propagate bitrate to next processor, before publishing the new packets.
+    while (next->_br_lock.test_and_set(std::memory_order_acquire)) {
+    }
+    next->_bitrate = bitrate;
+    next->_br_confidence = br_confidence;
+    next->_br_lock.clear(std::memory_order_release);
+
+    // Publish the new packets, then the end of input. The next processor reads these two
+    // fields in reverse order: when it sees the end of input, it also sees all packets.
+    next->_pkt_cnt += count;
+    if (input_end) {
+        next->_input_end = true;
+    }
+
+    // Wake the next processor when there is some new input data or end of input, if it is blocked.
+    if (count > 0 || input_end) {
+        next->wakeUp(false);
+    }
+
+    // Force to abort our processor when the next one is aborting (see passPackets()).
+    if (plugin()->type() != PluginType::OUTPUT) {
+        aborted = aborted || next->_tsp_aborting;
+    }
+
+    // Wake the previous processor when we abort (propagate abort conditions backward).
+    if (aborted) {
+        _tsp_aborting = true; // volatile bool in TSP superclass
+        ringPrevious<PluginExecutor>()->wakeUp(true);
     }
 
     // Return false when the current processor shall stop.
@@ -188,12 +276,21 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         min_pkt_cnt = _buffer->count();
     }
 
+    if (_lockfree) {
+        waitWorkLockFree(min_pkt_cnt, pkt_first, pkt_cnt, bitrate, br_confidence, input_end, aborted, timeout);
+        return;
+    }
+
     // We access data under the protection of the global mutex.
     GuardCondition lock(_global_mutex, _to_do);
 
     PluginExecutor* next = ringNext<PluginExecutor>();
     timeout = false;
 
+    if (_pkt_cnt < min_pkt_cnt && !_input_end && !next->_tsp_aborting) {
+        _wait_count++;
+    }
+
     // Loop until enough packets are available (or some error condition).
     while (_pkt_cnt < min_pkt_cnt && !_input_end && !timeout && !next->_tsp_aborting) {
         // If packet area for this processor is empty, wait for some packet.
@@ -212,7 +309,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     }
     else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
         // Return up to the wrap-up point. This will satisfy the requested minimum.
-        pkt_cnt = std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+        pkt_cnt = std::min(_pkt_cnt.load(), _buffer->count() - _pkt_first);
     }
     else {
         // The requested minimum does not fit into a contiguous area.
@@ -234,6 +331,73 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
 }
 
 
+//----------------------------------------------------------------------------
+// Lock-free version of waitWork().
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                               BitRate& bitrate, BitRateConfidence& br_confidence,
+                                               bool& input_end, bool& aborted, bool &timeout)
+{
+    PluginExecutor* next = ringNext<PluginExecutor>();
+    timeout = false;
+
+    if (!workAvailable(min_pkt_cnt)) {
+        _wait_count++;
+
+        // First, poll for a short while. Most of the time, the previous processor
+        // passes packets soon enough and we avoid a costly system call.
+        for (size_t spin = 0; spin < _options.sync_spin && !workAvailable(min_pkt_cnt); ++spin) {
+            Thread::Yield();
+        }
+
+        // Then block on our private condition. The _sleeping flag is set before checking the condition
+        // for the last time and the previous processor checks it after publishing new packets. So,
+        // either we see the new packets or the previous processor sees we are sleeping and signals us.
+        if (!workAvailable(min_pkt_cnt)) {
+            GuardCondition lock(_work_mutex, _to_do);
+            _sleeping = true;
+            while (!workAvailable(min_pkt_cnt) && !timeout) {
+                _block_count++;
+                timeout = !lock.waitCondition(_tsp_timeout) && !plugin()->handlePacketTimeout();
+            }
+            _sleeping = false;
+        }
+    }
+
+    // Read the end of input before the number of packets (see passPacketsLockFree()).
+    const bool end = _input_end.load();
+    const size_t available = _pkt_cnt.load();
+
+    // The number of returned packets is limited up to the wrap-up point of the circular buffer (see waitWork()).
+    if (timeout) {
+        pkt_cnt = 0;
+    }
+    else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
+        pkt_cnt = std::min(available, _buffer->count() - _pkt_first);
+    }
+    else {
+        pkt_cnt = available;
+    }
+
+    pkt_first = _pkt_first;
+    input_end = end && pkt_cnt == available;
+
+    // Get the bitrate from the previous processor.
+    while (_br_lock.test_and_set(std::memory_order_acquire)) {
+    }
+    bitrate = _bitrate;
+    br_confidence = _br_confidence;
+    _br_lock.clear(std::memory_order_release);
+
+    // Force to abort our processor when the next one is aborting (see waitWork()).
+    aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
+
+    log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+        {min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout});
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
@@ -268,7 +432,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
     // Acquire the global mutex to modify global data.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     {
-        GuardCondition lock1(_global_mutex, _to_do);
+        GuardMutex lock1(_global_mutex);
 
         // If there was a previous pending restart operation, cancel it.
         if (!_restart_data.isNull()) {
@@ -284,7 +448,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
         _restart = true;
 
         // Signal the plugin thread that there is something to do.
-        lock1.signal();
+        wakeUp(true);
     }
 
     // Now wait for the restart operation to complete.
@@ -301,6 +465,10 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
 
 bool ts::tsp::PluginExecutor::pendingRestart()
 {
+    // Fast path without locking the global mutex, restarts are rare.
+    if (!_restart) {
+        return false;
+    }
     GuardMutex lock(_global_mutex);
     return _restart && !_restart_data.isNull();
 }
@@ -312,6 +480,12 @@ bool ts::tsp::PluginExecutor::pendingRestart()
 
 bool ts::tsp::PluginExecutor::processPendingRestart(bool& restarted)
 {
+    // Fast path without locking the global mutex, restarts are rare.
+    if (!_restart) {
+        restarted = false;
+        return true;
+    }
+
     // Run under the protection of the global mutex.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     GuardMutex lock1(_global_mutex);
@@ -21,6 +21,7 @@
 #include "tsCondition.h"
 #include "tsMutex.h"
 #include "tsThread.h"
+#include <atomic>
 
 namespace ts {
     namespace tsp {
@@ -40,6 +41,8 @@ namespace ts {
             //! @param [in] pl_options Command line options for this plugin.
             //! @param [in] attributes Creation attributes for the thread executing this plugin.
             //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
+            //! In lock-free synchronization mode (see TSProcessorArgs::sync_mode), the global mutex
+            //! is no longer used to pass packets from one plugin executor to the next one.
             //! @param [in,out] report Where to report logs.
             //!
             PluginExecutor(const TSProcessorArgs& options,
@@ -207,14 +210,43 @@ namespace ts {
             // The following private data must be accessed exclusively under the protection of the global mutex.
             // Implementation details: see the file src/docs/developing-plugins.dox.
             // [*] After initialization, these fields are read/written only in passPackets() and waitWork().
-            Condition         _to_do;          // Notify processor to do something.
-            size_t            _pkt_first;      // Starting index of packets area [*]
-            size_t            _pkt_cnt;        // Size of packets area [*]
-            bool              _input_end;      // No more packet after current ones [*]
-            BitRate           _bitrate;        // Input bitrate (set by previous plugin) [*]
-            BitRateConfidence _br_confidence;  // Input bitrate confidence (set by previous plugin) [*]
-            bool              _restart;        // Restart the plugin asap using _restart_data
-            RestartDataPtr    _restart_data;   // How to restart the plugin
+            // [L] In lock-free mode, these fields are not protected by the global mutex. _pkt_cnt is incremented
+            //     by the previous plugin executor and decremented by this one. _input_end is set by the previous
+            //     plugin executor. _bitrate and _br_confidence are protected by the _br_lock spin lock.
+            Condition           _to_do;          // Notify processor to do something.
+            size_t              _pkt_first;      // Starting index of packets area [*]
+            std::atomic<size_t> _pkt_cnt;        // Size of packets area [*] [L]
+            std::atomic<bool>   _input_end;      // No more packet after current ones [*] [L]
+            BitRate             _bitrate;        // Input bitrate (set by previous plugin) [*] [L]
+            BitRateConfidence   _br_confidence;  // Input bitrate confidence (set by previous plugin) [*] [L]
+            std::atomic<bool>   _restart;        // Restart the plugin asap using _restart_data
+            RestartDataPtr      _restart_data;   // How to restart the plugin
+
+            // Lock-free synchronization mode: the global mutex is replaced by per-edge synchronization
+            // between this plugin executor and the previous one.
+            const bool          _lockfree;       // Use lock-free synchronization mode.
+            Mutex               _work_mutex;     // Protect _to_do when this executor blocks, in lock-free mode.
+            std::atomic<bool>   _sleeping;       // This executor is blocked (or about to be blocked) on _to_do.
+            std::atomic_flag    _br_lock;        // Spin lock for _bitrate and _br_confidence in lock-free mode.
+            PacketCounter       _wait_count;     // Number of calls to waitWork() which had to wait for packets.
+            PacketCounter       _block_count;    // Number of times the thread was actually blocked, in lock-free mode.
+
+            // Wake up this plugin executor (from another thread) when something new happened.
+            // In mutex mode, must be called with the global mutex held.
+            // In lock-free mode, if 'force' is false, do nothing when the executor is not blocked.
+            void wakeUp(bool force);
+
+            // Lock-free versions of passPackets() and waitWork().
+            bool passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted);
+            void waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                  BitRate& bitrate, BitRateConfidence& br_confidence,
+                                  bool& input_end, bool& aborted, bool &timeout);
+
+            // Check if waitWork() can return, in lock-free mode.
+            bool workAvailable(size_t min_pkt_cnt) const
+            {
+                return _input_end.load() || _pkt_cnt.load() >= min_pkt_cnt || ringNext<PluginExecutor>()->_tsp_aborting;
+            }
 
             // Description of a restart operation.
             class RestartData
@@ -68,8 +68,11 @@ void ts::tsp::ProcessorExecutor::main()
         window_size = _processor->getPacketWindowSize();
     }
 
-    // Perform the complete packet processing in individual-packet or packet-window mode.
-    if (window_size == 0) {
+    // Perform the complete packet processing in individual-packet, packet-batch or packet-window mode.
+    if (window_size == 0 && _processor->usePacketBatch()) {
+        processPacketBatches();
+    }
+    else if (window_size == 0) {
         processIndividualPackets();
     }
     else {
@@ -239,6 +242,166 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
 }
 
 
+//----------------------------------------------------------------------------
+// Process packets using packet batches.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::processPacketBatches()
+{
+    // Maximum number of packets in a batch: never more than between two flushes.
+    const size_t batch_max = std::max<size_t>(1, std::min(_options.max_flush_pkt, _buffer->count()));
+    debug(u"packet processing by batches of up to %'d packets", {batch_max});
+
+    std::vector<ProcessorPlugin::Status> batch_status(batch_max);
+    std::vector<bool> batch_was_null(batch_max);
+
+    TSPacketLabelSet only_labels(_processor->getOnlyLabelOption());
+    PacketCounter passed_packets = 0;
+    PacketCounter dropped_packets = 0;
+    PacketCounter nullified_packets = 0;
+    BitRate output_bitrate = _tsp_bitrate;
+    BitRateConfidence br_confidence = _tsp_bitrate_confidence;
+    bool bitrate_never_modified = true;
+    bool input_end = false;
+    bool aborted = false;
+    bool restarted = false;
+
+    do {
+        // Wait for packets to process
+        size_t pkt_first = 0;
+        size_t pkt_cnt = 0;
+        bool timeout = false;
+        waitWork(1, pkt_first, pkt_cnt, _tsp_bitrate, _tsp_bitrate_confidence, input_end, aborted, timeout);
+
+        // If bitrate was never modified by the plugin, always copy the input bitrate as output bitrate.
+        if (bitrate_never_modified) {
+            output_bitrate = _tsp_bitrate;
+            br_confidence = _tsp_bitrate_confidence;
+        }
+
+        // Process restart requests.
+        if (!processPendingRestart(restarted)) {
+            timeout = true; // restart error
+        }
+        else if (restarted) {
+            // Plugin was restarted, need to recheck --only-label
+            only_labels = _processor->getOnlyLabelOption();
+        }
+
+        // Same termination conditions as processIndividualPackets().
+        if (timeout || (aborted && !input_end)) {
+            passPackets(0, output_bitrate, br_confidence, true, true);
+            break;
+        }
+        if (pkt_cnt == 0 && input_end) {
+            passPackets(0, output_bitrate, br_confidence, true, false);
+            break;
+        }
+
+        // Now process the packets.
+        size_t pkt_done = 0;
+        size_t pkt_flush = 0;
+
+        while (pkt_done < pkt_cnt && !aborted) {
+
+            TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
+            TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
+
+            // Build a batch with the longest sequence of contiguous packets to submit to the plugin.
+            const size_t max_count = std::min(pkt_cnt - pkt_done, batch_max);
+            size_t batch_count = 0;
+            if (!_suspended) {
+                while (batch_count < max_count && pkt[batch_count].b[0] != 0 && (only_labels.none() || pkt_data[batch_count].hasAnyLabel(only_labels))) {
+                    batch_was_null[batch_count] = pkt[batch_count].getPID() == PID_NULL;
+                    batch_status[batch_count] = ProcessorPlugin::TSP_OK;
+                    pkt_data[batch_count].setFlush(false);
+                    pkt_data[batch_count].setBitrateChanged(false);
+                    batch_count++;
+                }
+            }
+
+            // Apply the processing routine to the batch.
+            if (batch_count > 0) {
+                _processor->processPacketBatch(pkt, pkt_data, batch_status.data(), batch_count);
+            }
+
+            // Post-process the packets of the batch or the first packet which cannot be part of a batch.
+            const size_t count = std::max<size_t>(batch_count, 1);
+            for (size_t i = 0; i < count && !aborted; ++i) {
+
+                bool got_new_bitrate = false;
+                pkt_done++;
+                pkt_flush++;
+
+                if (batch_count == 0) {
+                    // The packet was previously dropped, or the plugin is suspended, or the packet does not
+                    // have any required label. Pass the packet without submitting it to the plugin.
+                    addNonPluginPackets(1);
+                    if (pkt->b[0] != 0) {
+                        pkt_data->setFlush(false);
+                        pkt_data->setBitrateChanged(false);
+                        passed_packets++;
+                    }
+                }
+                else {
+                    addPluginPackets(1);
+                    switch (batch_status[i]) {
+                        case ProcessorPlugin::TSP_OK:
+                            passed_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_NULL:
+                            pkt[i] = NullPacket;
+                            break;
+                        case ProcessorPlugin::TSP_DROP:
+                            pkt[i].b[0] = 0;
+                            dropped_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_END:
+                            debug(u"plugin requests termination");
+                            input_end = aborted = true;
+                            pkt_done--;
+                            pkt_flush--;
+                            pkt_cnt = pkt_done;
+                            break;
+                        default:
+                            error(u"invalid packet processing status %d", {batch_status[i]});
+                            break;
+                    }
+                    // After TSP_END, the loop exits and subsequent packets in the batch are ignored.
+                    if (!aborted) {
+                        // Detect if the packet was nullified by the plugin.
+                        if (!batch_was_null[i] && pkt[i].getPID() == PID_NULL) {
+                            pkt_data[i].setNullified(true);
+                            nullified_packets++;
+                        }
+                        // If the packet processor has signaled a new bitrate, get it.
+                        if (pkt_data[i].getBitrateChanged()) {
+                            const BitRate new_bitrate = _processor->getBitrate();
+                            if (new_bitrate != 0) {
+                                bitrate_never_modified = false;
+                                got_new_bitrate = new_bitrate != output_bitrate;
+                                output_bitrate = new_bitrate;
+                                br_confidence = _processor->getBitrateConfidence();
+                            }
+                        }
+                    }
+                }
+
+                // Periodic flush, same conditions as processIndividualPackets().
+                if (pkt_data[i].getFlush() || got_new_bitrate || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt)) {
+                    aborted = !passPackets(pkt_flush, output_bitrate, br_confidence, pkt_done == pkt_cnt && input_end, aborted);
+                    pkt_flush = 0;
+                }
+            }
+        }
+
+    } while (!input_end && !aborted);
+
+    debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
+          {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
+}
+
+
 //----------------------------------------------------------------------------
 // Process packets using packet windows.
 //----------------------------------------------------------------------------
@@ -57,8 +57,9 @@ namespace ts {
             // Inherited from Thread
             virtual void main() override;
 
-            // Process packets one by one or using packet windows.
+            // Process packets one by one, using packet batches or using packet windows.
             void processIndividualPackets();
+            void processPacketBatches();
             void processPacketWindows(size_t window_size);
         };
     }
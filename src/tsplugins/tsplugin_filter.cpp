@@ -32,6 +32,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Packet intervals and list of them.
@@ -85,6 +87,7 @@ namespace ts {
         TSPacketLabelSet   _reset_perm_labels;  // Labels to reset on all packets after getting one packet
 
         // Working data:
+        bool               _pid_only;           // Filter on explicit PID values only, no other criteria.
         PacketCounter      _filtered_packets;   // Number of filtered packets
         PIDSet             _stream_id_pid;      // PID values selected from stream ids
         std::set<uint16_t> _all_service_ids;    // All service ids to filter, after service name resolution
@@ -92,6 +95,12 @@ namespace ts {
 
         // Implementation of SignalizationHandlerInterface
         virtual void handleService(uint16_t ts_id, const Service& service, const PMT& pmt, bool removed) override;
+
+        // Filter one packet with its index in the stream.
+        Status filterPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index);
+
+        // Apply labels and return the status of a packet, after filtering.
+        Status selectPacket(TSPacketMetadata& pkt_data, bool ok);
     };
 }
 
@@ -148,6 +157,7 @@ ts::FilterPlugin::FilterPlugin(TSP* tsp_) :
     _reset_labels(),
     _set_perm_labels(),
     _reset_perm_labels(),
+    _pid_only(false),
     _filtered_packets(0),
     _stream_id_pid(),
     _all_service_ids(),
@@ -474,6 +484,16 @@ bool ts::FilterPlugin::getOptions()
     // If we look for service names, we also need to be notified of changes in service list.
     _demux.setHandler(_service_names.empty() ? nullptr : this);
 
+    // Check if the filter is based on explicit PID values only (most common usage). In that
+    // case, the packet content does not need to be analyzed and a fast path can be used.
+    _pid_only =
+        !_need_demux && _labels.none() && _stream_ids.empty() && _pattern.empty() && _ranges.empty() &&
+        !_with_payload && !_with_af && !_with_pes && !_with_pcr && !_with_splice && !_unit_start &&
+        !_nullified && !_input_stuffing && !_valid && _scrambling_ctrl < 0 &&
+        _splice < -128 && _min_splice < -128 && _max_splice < -128 &&
+        _min_payload < 0 && _max_payload < 0 && _min_af < 0 && _max_af < 0 &&
+        _after_packets == 0 && _every_packets == 0;
+
     return true;
 }
 
@@ -508,6 +528,48 @@ bool ts::FilterPlugin::stop()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return filterPacket(pkt, pkt_data, tsp->pluginPackets());
+}
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::FilterPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::FilterPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    if (_pid_only) {
+        // Fast path: filter on PID values only. Extract PID values by blocks, then filter.
+        constexpr size_t BLOCK_SIZE = 256;
+        PID pids[BLOCK_SIZE];
+        for (size_t start = 0; start < count; start += BLOCK_SIZE) {
+            const size_t block = std::min(count - start, BLOCK_SIZE);
+            TSPacket::ExtractHeaders(pkt + start, block, pids);
+            for (size_t i = 0; i < block; ++i) {
+                status[start + i] = selectPacket(pkt_data[start + i], _explicit_pid[pids[i]] != _negate);
+            }
+        }
+    }
+    else {
+        const PacketCounter index = tsp->pluginPackets();
+        for (size_t i = 0; i < count; ++i) {
+            status[i] = filterPacket(pkt[i], pkt_data[i], index + i);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Filter one packet with its index in the stream.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::FilterPlugin::filterPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter packetIndex)
 {
     const PID pid = pkt.getPID();
 
@@ -517,7 +579,6 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
     }
 
     // Pass initial packets without filtering.
-    const PacketCounter packetIndex = tsp->pluginPackets();
     if (packetIndex < _after_packets) {
         return TSP_OK;
     }
@@ -560,7 +621,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
         (int(pkt.getPayloadSize()) <= _max_payload) ||
         (_min_af >= 0 && int(pkt.getAFSize()) >= _min_af) ||
         (int(pkt.getAFSize()) <= _max_af) ||
-        (_every_packets > 0 && (tsp->pluginPackets() - _after_packets) % _every_packets == 0) ||
+        (_every_packets > 0 && (packetIndex - _after_packets) % _every_packets == 0) ||
         (_with_pes && pkt.startPES());
 
     // Search binary patterns in packets.
@@ -582,10 +643,16 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
     }
 
     // Reverse selection criteria with --negate.
-    if (_negate) {
-        ok = !ok;
-    }
+    return selectPacket(pkt_data, ok != _negate);
+}
+
 
+//----------------------------------------------------------------------------
+// Apply labels and return the status of a packet, after filtering.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::FilterPlugin::selectPacket(TSPacketMetadata& pkt_data, bool ok)
+{
     // Set/reset labels on filtered packets.
     if (ok) {
         _filtered_packets++;
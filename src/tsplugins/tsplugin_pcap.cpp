@@ -192,12 +192,14 @@ bool ts::PcapInputPlugin::start()
             if (ok) {
                 _pcap_tcp.setBidirectionalFilter(_source, _destination);
                 _pcap_tcp.setReportAddressesFilterSeverity(Severity::Verbose);
+                _pcap_tcp.setZeroCopy(true);
             }
         }
         else {
             ok = _pcap_udp.open(_file_name, *tsp);
             if (ok) {
                 _pcap_udp.setProtocolFilterUDP();
+                _pcap_udp.setZeroCopy(true);
             }
         }
     }
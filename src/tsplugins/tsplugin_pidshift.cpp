@@ -33,6 +33,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Command line options:
@@ -46,6 +48,9 @@ namespace ts {
         bool            _pass_all;       // Pass all packets after an error.
         PacketCounter   _init_packets;   // Count packets in PID's to shift during initial evaluation phase.
         TimeShiftBuffer _buffer;         // The timeshift buffer logic.
+
+        // Process one packet during the initial evaluation phase, with its index in the stream.
+        Status evaluate(PID pid, PacketCounter index);
     };
 }
 
@@ -194,56 +199,98 @@ ts::ProcessorPlugin::Status ts::PIDShiftPlugin::processPacket(TSPacket& pkt, TSP
 
     // If the buffer is not yet open, we are in the initial evaluation phase.
     if (!_buffer.isOpen()) {
+        const Status status = evaluate(pid, tsp->pluginPackets());
+        if (_pass_all || !_buffer.isOpen()) {
+            return status;
+        }
+    }
+
+    // No longer in evaluation phase, shift packets.
+    if (_pids.test(pid) && !_buffer.shift(pkt, pkt_data, *tsp)) {
+        _pass_all = true;
+        return _ignore_errors ? TSP_OK : TSP_END;
+    }
+    return TSP_OK;
+}
 
-        // Count packets in the PID's to shift.
-        if (_pids.test(pid)) {
-            _init_packets++;
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::PIDShiftPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::PIDShiftPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    size_t i = 0;
+
+    // Initial evaluation phase, packet per packet.
+    while (i < count && !_pass_all && !_buffer.isOpen()) {
+        status[i] = evaluate(pkt[i].getPID(), tsp->pluginPackets() + i);
+        if (_pass_all || !_buffer.isOpen()) {
+            ++i;
         }
+    }
 
-        // Evaluate the duration from the beginning of the TS (zero if bitrate is unknown).
-        const BitRate ts_bitrate = tsp->bitrate();
-        const PacketCounter ts_packets = tsp->pluginPackets() + 1;
-        const MilliSecond ms = PacketInterval(ts_bitrate, ts_packets);
-
-        if (ms >= _eval_ms) {
-            // The evaluation phase is completed.
-            // Global bitrate of the selected PID's = ts_bitrate * _init_packet / ts_packets
-            // Compute the amount of packets to shift in the selected PID's:
-            const PacketCounter count = ((ts_bitrate * _init_packets * _shift_ms) / (ts_packets * MilliSecPerSec * PKT_SIZE_BITS)).toInt();
-
-            tsp->debug(u"TS bitrate: %'d b/s, TS packets: %'d, selected: %'d, duration: %'d ms, shift: %'d packets", {ts_bitrate, ts_packets, _init_packets, ms, count});
-
-            // We can do that only if we have seen some packets from them.
-            if (count < TimeShiftBuffer::MIN_TOTAL_PACKETS) {
-                tsp->error(u"not enough packets from selected PID's during evaluation phase, cannot compute the shift buffer size");
-                _pass_all = true;
-                return _ignore_errors ? TSP_OK : TSP_END;
-            }
-
-            tsp->verbose(u"setting shift buffer size to %'d packets", {count});
-            _buffer.setTotalPackets(size_t(count));
-
-            // Open the shift buffer.
-            if (!_buffer.open(*tsp)) {
-                _pass_all = true;
-                return _ignore_errors ? TSP_OK : TSP_END;
-            }
+    // Steady state: shift packets from selected PID's, pass all others.
+    for (; i < count && !_pass_all; ++i) {
+        if (_pids.test(pkt[i].getPID()) && !_buffer.shift(pkt[i], pkt_data[i], *tsp)) {
+            _pass_all = true;
+            status[i] = _ignore_errors ? TSP_OK : TSP_END;
         }
-        else if (ts_packets > MAX_EVAL_PACKETS && ts_bitrate == 0) {
-            tsp->error(u"bitrate still unknown after %'d packets, cannot compute the shift buffer size", {ts_packets});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Process one packet during the initial evaluation phase.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::PIDShiftPlugin::evaluate(PID pid, PacketCounter index)
+{
+    // Count packets in the PID's to shift.
+    if (_pids.test(pid)) {
+        _init_packets++;
+    }
+
+    // Evaluate the duration from the beginning of the TS (zero if bitrate is unknown).
+    const BitRate ts_bitrate = tsp->bitrate();
+    const PacketCounter ts_packets = index + 1;
+    const MilliSecond ms = PacketInterval(ts_bitrate, ts_packets);
+
+    if (ms >= _eval_ms) {
+        // The evaluation phase is completed.
+        // Global bitrate of the selected PID's = ts_bitrate * _init_packet / ts_packets
+        // Compute the amount of packets to shift in the selected PID's:
+        const PacketCounter count = ((ts_bitrate * _init_packets * _shift_ms) / (ts_packets * MilliSecPerSec * PKT_SIZE_BITS)).toInt();
+
+        tsp->debug(u"TS bitrate: %'d b/s, TS packets: %'d, selected: %'d, duration: %'d ms, shift: %'d packets", {ts_bitrate, ts_packets, _init_packets, ms, count});
+
+        // We can do that only if we have seen some packets from them.
+        if (count < TimeShiftBuffer::MIN_TOTAL_PACKETS) {
+            tsp->error(u"not enough packets from selected PID's during evaluation phase, cannot compute the shift buffer size");
             _pass_all = true;
             return _ignore_errors ? TSP_OK : TSP_END;
         }
-        else {
-            // Still in evaluation phase, pass all packets.
-            return TSP_OK;
+
+        tsp->verbose(u"setting shift buffer size to %'d packets", {count});
+        _buffer.setTotalPackets(size_t(count));
+
+        // Open the shift buffer.
+        if (!_buffer.open(*tsp)) {
+            _pass_all = true;
+            return _ignore_errors ? TSP_OK : TSP_END;
         }
     }
-
-    // No longer in evaluation phase, shift packets.
-    if (_pids.test(pid) && !_buffer.shift(pkt, pkt_data, *tsp)) {
+    else if (ts_packets > MAX_EVAL_PACKETS && ts_bitrate == 0) {
+        tsp->error(u"bitrate still unknown after %'d packets, cannot compute the shift buffer size", {ts_packets});
         _pass_all = true;
         return _ignore_errors ? TSP_OK : TSP_END;
     }
+
+    // Still in evaluation phase (pass the packet) or the buffer is now open (shift the packet).
     return TSP_OK;
 }
@@ -36,6 +36,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         typedef SafePtr<CyclingPacketizer, NullMutex> CyclingPacketizerPtr;
@@ -45,6 +47,7 @@ namespace ts {
         bool          _pmt_ready;       // All PMT PID's are known
         SectionDemux  _demux;           // Section demux
         PacketizerMap _pzer;            // Packetizer for sections
+        PID           _remap[PID_MAX];  // Flat copy of _pidMap, indexed by input PID
 
         // Invoked by the demux when a complete table is available.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
@@ -72,7 +75,8 @@ ts::RemapPlugin::RemapPlugin(TSP* tsp_) :
     _update_psi(false),
     _pmt_ready(false),
     _demux(duck, this),
-    _pzer()
+    _pzer(),
+    _remap()
 {
     option(u"no-psi", 'n');
     help(u"no-psi",
@@ -117,6 +121,14 @@ bool ts::RemapPlugin::start()
     // Do not care about PMT if no need to update PSI
     _pmt_ready = !_update_psi;
 
+    // Build the direct remapping table.
+    for (PID pid = 0; pid < PID_MAX; ++pid) {
+        _remap[pid] = pid;
+    }
+    for (const auto& it : _pidMap) {
+        _remap[it.first] = it.second;
+    }
+
     tsp->verbose(u"%d PID's remapped", {_pidMap.size()});
     return true;
 }
@@ -128,8 +140,7 @@ bool ts::RemapPlugin::start()
 
 ts::PID ts::RemapPlugin::remap(PID pid)
 {
-    const auto it = _pidMap.find(pid);
-    return it == _pidMap.end() ? pid : it->second;
+    return pid < PID_MAX ? _remap[pid] : pid;
 }
 
 
@@ -273,3 +284,43 @@ ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPack
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::RemapPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::RemapPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    if (_update_psi) {
+        // Non-virtual calls to the packet processing method, in a loop which the compiler can inline.
+        for (size_t i = 0; i < count; ++i) {
+            status[i] = RemapPlugin::processPacket(pkt[i], pkt_data[i]);
+            if (status[i] == TSP_END) {
+                break;
+            }
+        }
+    }
+    else {
+        // Fast path: remap packets using the direct remapping table only.
+        for (size_t i = 0; i < count; ++i) {
+            const PID pid = pkt[i].getPID();
+            const PID new_pid = _remap[pid];
+            if (pid != new_pid) {
+                pkt[i].setPID(new_pid);
+                pkt_data[i].setLabels(_setLabels);
+                pkt_data[i].clearLabels(_resetLabels);
+            }
+            else if (!_unchecked && _newPIDs.test(pid)) {
+                tsp->error(u"PID conflict: PID %d (0x%X) present both in input and remap", {pid, pid});
+                status[i] = TSP_END;
+                break;
+            }
+        }
+    }
+}
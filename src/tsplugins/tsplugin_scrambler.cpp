@@ -19,6 +19,7 @@
 #include "tsOneShotPacketizer.h"
 #include "tsECMGClient.h"
 #include "tsECMGClientArgs.h"
+#include "tsGuardCondition.h"
 #include "tsBetterSystemRandomGenerator.h"
 #include "tsCADescriptor.h"
 #include "tsScramblingDescriptor.h"
@@ -50,6 +51,12 @@
 // In asynchronous mode, there is enough time to generate ECM(N+1) while
 // cp(N) is finishing.
 //
+// In synchronous mode, ECM(N+1) is also requested as soon as cp(N+1) is
+// generated and the ECMG computes it while the packets of cp(N) are processed.
+// But the packet processing waits for ECM(N+1) at the point where it becomes
+// necessary, instead of entering degraded mode. This way, ECM requests are
+// pipelined and we do not wait a full ECMG round trip at each crypto-period.
+//
 // The transition points in the TS are:
 // - CW change (start a new crypto-period)
 // - ECM change (start broadcasting a new ECM, can be before or after
@@ -83,6 +90,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Description of a crypto-period.
@@ -108,6 +117,10 @@ namespace ts {
             // Check if ECM generation is complete (useful in asynchronous mode)
             bool ecmReady() const { return _ecm_ok; }
 
+            // Wait for the completion of the ECM generation (useful in synchronous mode).
+            // Return false on error or timeout.
+            bool waitECM();
+
             // Get next ECM packet in ECM cycle (or null packet if ECM not ready).
             void getNextECMPacket(TSPacket&);
 
@@ -118,6 +131,9 @@ namespace ts {
             ScramblerPlugin* _plugin {nullptr};  // Reference to scrambler plugin
             uint16_t         _cp_number {0};     // Crypto-period number
             volatile bool    _ecm_ok {false};    // _ecm field is valid
+            bool             _ecm_done {false};  // ECM generation completed, successfully or not
+            Mutex            _mutex {};          // Protect _ecm_done
+            Condition        _ecm_completed {};  // Signaled when _ecm_done is set
             TSPacketVector   _ecm {};            // Packetized ECM
             size_t           _ecm_pkt_index {};  // Next ECM packet to insert in TS
             ByteBlock        _cw_current {};
@@ -127,12 +143,17 @@ namespace ts {
             void generateCW(ByteBlock& cw);
 
             // Generate the ECM for a crypto-period.
-            // With --synchronous, the ECM is directly generated. Otherwise,
-            // the ECM will be set later, notified through private handleECM.
+            // The ECM will be set later, notified through private handleECM.
             void generateECM();
 
+            // Process an ECM response.
+            void setECM(const ecmgscs::ECMResponse&);
+
             // Invoked when an ECM is available, maybe in the context of an external thread.
             virtual void handleECM(const ecmgscs::ECMResponse&) override;
+
+            // Invoked when the ECM request failed, maybe in the context of an external thread.
+            virtual void handleECMError(uint16_t stream_id, uint16_t cp_number, const UString& message) override;
         };
 
         // ScramblerPlugin parameters, remain constant after start()
@@ -180,6 +201,11 @@ namespace ts {
         size_t            _current_ecm {0};             // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling;                  // Scrambler
         CyclingPacketizer _pzer_pmt;                    // Packetizer for modified PMT
+        bool              _in_batch {false};            // Currently processing a batch of packets
+        std::vector<TSPacket*> _pending {};             // Packets to scramble at end of batch or before CW change
+
+        // Scramble all pending packets of the current batch with the current CW.
+        bool flushPending();
 
         // Initialize ECM and CP scheduling.
         void initializeScheduling();
@@ -304,7 +330,9 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
     option(u"synchronous");
     help(u"synchronous",
          u"Specify to synchronously generate the ECM's. By default, in real-time "
-         u"mode, the packet processing continues while generating ECM's. This option "
+         u"mode, the packet processing continues while generating ECM's. With this "
+         u"option, ECM's are still requested in advance but the packet processing "
+         u"waits for an ECM when it is needed and not yet available. This option "
          u"is always on in offline mode.");
 
     // ECMG and scrambling options.
@@ -430,6 +458,9 @@ bool ts::ScramblerPlugin::start()
                 return false;
             }
             _cp[1].initNext(_cp[0]);
+            if (_synchronous_ecmg && !_cp[0].waitECM()) {
+                return false;
+            }
         }
     }
 
@@ -457,6 +488,7 @@ bool ts::ScramblerPlugin::stop()
 {
     // Disconnect from ECMG
     if (_ecmg.isConnected()) {
+        _ecmg.reportStatistics(*tsp, Severity::Verbose);
         _ecmg.disconnect();
     }
 
@@ -610,6 +642,11 @@ bool ts::ScramblerPlugin::inDegradedMode()
         // Next ECM ready, no need to enter degraded mode.
         return false;
     }
+    else if (_synchronous_ecmg) {
+        // In synchronous mode, wait for the next ECM instead of entering degraded mode.
+        // On error, the plugin is aborted and there is no transition.
+        return !nextECM().waitECM();
+    }
     else {
         // Entering degraded mode
         tsp->warning(u"Next ECM not ready, entering degraded mode");
@@ -666,6 +703,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // Packets which were received before the transition must use the previous CW.
+    if (!flushPending()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -834,8 +876,11 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
         _partial_clear = _partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
+    // Scramble the packet payload. In batch mode, defer scrambling until end of batch or next CW change.
+    if (_in_batch) {
+        _pending.push_back(&pkt);
+    }
+    else if (!_scrambling.encrypt(pkt)) {
         return TSP_END;
     }
     _scrambled_count++;
@@ -844,6 +889,41 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::ScramblerPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Non-virtual calls to the packet processing method. The packets to scramble
+    // are collected and scrambled all at once, using the batch DVB-CSA2 engine.
+    _in_batch = true;
+    size_t i = 0;
+    while (i < count) {
+        status[i] = ScramblerPlugin::processPacket(pkt[i], pkt_data[i]);
+        if (status[i++] == TSP_END) {
+            break;
+        }
+    }
+    _in_batch = false;
+    if (!flushPending() && i > 0) {
+        status[i - 1] = TSP_END;
+    }
+}
+
+bool ts::ScramblerPlugin::flushPending()
+{
+    const bool ok = _pending.empty() || _scrambling.encrypt(_pending.data(), _pending.size());
+    _pending.clear();
+    return ok;
+}
+
+
 //----------------------------------------------------------------------------
 // Initialize first crypto period.
 //----------------------------------------------------------------------------
@@ -898,6 +978,10 @@ void ts::ScramblerPlugin::CryptoPeriod::generateCW(ByteBlock& cw)
 
 bool ts::ScramblerPlugin::CryptoPeriod::initScramblerKey() const
 {
+    if (!_plugin->flushPending()) {
+        return false;
+    }
+
     _plugin->debug(u"starting crypto-period %'d at packet %'d", {_cp_number, _plugin->_packet_count});
 
     // Change the parity of the scrambled packets.
@@ -913,38 +997,41 @@ bool ts::ScramblerPlugin::CryptoPeriod::initScramblerKey() const
 
 void ts::ScramblerPlugin::CryptoPeriod::generateECM()
 {
-    _ecm_ok = false;
+    {
+        GuardMutex lock(_mutex);
+        _ecm_ok = _ecm_done = false;
+    }
 
-    if (_plugin->_synchronous_ecmg) {
-        // Synchronous ECM generation
-        ecmgscs::ECMResponse response(_plugin->_ecmgscs);
-        if (!_plugin->_ecmg.generateECM(_cp_number,
-                                        _cw_current,
-                                        _cw_next,
-                                        _plugin->_ecmg_args.access_criteria,
-                                        uint16_t(_plugin->_ecmg_args.cp_duration / 100),
-                                        response))
-        {
-            // Error, message already reported
-            _plugin->_abort = true;
-        }
-        else {
-            handleECM(response);
-        }
+    // The ECM request is always asynchronous, even in synchronous mode. The ECMG computes
+    // the ECM in parallel with the packet processing. In synchronous mode, we will wait
+    // for the ECM only when it is actually needed.
+    if (!_plugin->_ecmg.submitECM(_cp_number,
+                                  _cw_current,
+                                  _cw_next,
+                                  _plugin->_ecmg_args.access_criteria,
+                                  uint16_t(_plugin->_ecmg_args.cp_duration / 100),
+                                  this))
+    {
+        // Error, message already reported
+        _plugin->_abort = true;
     }
-    else {
-        // Asynchronous ECM generation
-        if (!_plugin->_ecmg.submitECM(_cp_number,
-                                      _cw_current,
-                                      _cw_next,
-                                      _plugin->_ecmg_args.access_criteria,
-                                      uint16_t(_plugin->_ecmg_args.cp_duration / 100),
-                                      this))
-        {
-            // Error, message already reported
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for the completion of the ECM generation.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::CryptoPeriod::waitECM()
+{
+    GuardCondition lock(_mutex, _ecm_completed);
+    while (!_ecm_done && !_plugin->_abort) {
+        if (!lock.waitCondition(_plugin->_ecmg.ecmTimeout())) {
+            _plugin->tsp->error(u"ECM generation timeout for crypto-period %d", {_cp_number});
             _plugin->_abort = true;
         }
     }
+    return _ecm_ok;
 }
 
 
@@ -953,6 +1040,37 @@ void ts::ScramblerPlugin::CryptoPeriod::generateECM()
 //----------------------------------------------------------------------------
 
 void ts::ScramblerPlugin::CryptoPeriod::handleECM(const ecmgscs::ECMResponse& response)
+{
+    setECM(response);
+
+    // Notify a thread which waits for the ECM, successful or not.
+    GuardCondition lock(_mutex, _ecm_completed);
+    _ecm_done = true;
+    lock.signal();
+}
+
+void ts::ScramblerPlugin::CryptoPeriod::handleECMError(uint16_t, uint16_t, const UString& message)
+{
+    // Errors are expected when the ECMG is disconnected at the end of the processing.
+    if (_plugin->_ecmg.isConnected()) {
+        _plugin->tsp->error(u"ECM generation failed for crypto-period %d: %s", {_cp_number, message});
+    }
+    else {
+        _plugin->tsp->debug(u"ECM generation failed for crypto-period %d: %s", {_cp_number, message});
+    }
+
+    // In synchronous mode, there is no degraded mode, the plugin is aborted.
+    if (_plugin->_synchronous_ecmg) {
+        _plugin->_abort = true;
+    }
+
+    // Notify a thread which waits for the ECM, the ECM is not valid.
+    GuardCondition lock(_mutex, _ecm_completed);
+    _ecm_done = true;
+    lock.signal();
+}
+
+void ts::ScramblerPlugin::CryptoPeriod::setECM(const ecmgscs::ECMResponse& response)
 {
     if (_plugin->_channel_status.section_TSpkt_flag == 0) {
         // ECMG returns ECM in section format
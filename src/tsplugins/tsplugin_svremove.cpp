@@ -39,6 +39,8 @@ namespace ts {
         SVRemovePlugin(TSP*);
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         bool              _abort;          // Error (service not found, etc)
@@ -595,3 +597,29 @@ ts::ProcessorPlugin::Status ts::SVRemovePlugin::processPacket(TSPacket& pkt, TSP
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::SVRemovePlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::SVRemovePlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // In transparent mode, all packets are passed (all status are initially TSP_OK).
+    if (_transparent) {
+        return;
+    }
+
+    // Non-virtual calls to the packet processing method, in a loop which the compiler can inline.
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = SVRemovePlugin::processPacket(pkt[i], pkt_data[i]);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
@@ -38,6 +38,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Each service to keep is described by one structure.
@@ -897,3 +899,24 @@ ts::ProcessorPlugin::Status ts::ZapPlugin::processPacket(TSPacket& pkt, TSPacket
             return TSP_END;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::ZapPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::ZapPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Non-virtual calls to the packet processing method, in a loop which the compiler can inline.
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = ZapPlugin::processPacket(pkt[i], pkt_data[i]);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
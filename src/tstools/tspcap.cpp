@@ -353,6 +353,9 @@ bool FileAnalysis::analyze(std::ostream& out)
         return false;
     }
 
+    // Each packet is completely processed before reading the next one, no need to copy them.
+    _file.setZeroCopy(true);
+
     // Set packet filters.
     _file.setProtocolFilter(_opt.protocols);
     _file.setSourceFilter(_opt.source_filter);
@@ -553,6 +556,7 @@ bool UDPSimulCryptDump::dump(std::ostream& out)
     if (!_file.loadArgs(_opt.duck, _opt) || !_file.open(_opt.input_file, _opt)) {
         return false;
     }
+    _file.setZeroCopy(true);
 
     // Set packet filters.
     _file.setProtocolFilterUDP();
@@ -598,6 +602,7 @@ bool TCPSimulCryptDump::dump(std::ostream& out)
     if (!_file.loadArgs(_opt.duck, _opt) || !_file.open(_opt.input_file, _opt)) {
         return false;
     }
+    _file.setZeroCopy(true);
 
     // Set packet filters.
     _file.setBidirectionalFilter(_opt.source_filter, _opt.dest_filter);
@@ -681,6 +686,7 @@ bool TCPSessionDump::dump(std::ostream& out)
     if (!_file.loadArgs(_opt.duck, _opt) || !_file.open(_opt.input_file, _opt)) {
         return false;
     }
+    _file.setZeroCopy(true);
 
     // Set packet filters.
     _file.setBidirectionalFilter(_opt.source_filter, _opt.dest_filter);
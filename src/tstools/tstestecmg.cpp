@@ -24,6 +24,7 @@
 #include "tsGuardMutex.h"
 #include "tsCondition.h"
 #include "tsGuardCondition.h"
+#include "tsTime.h"
 #include <atomic>
 TS_MAIN(MainCode);
 
@@ -26,9 +26,11 @@ public:
     virtual void afterTest() override;
 
     void testCRC();
+    void testLargeData();
 
     TSUNIT_TEST_BEGIN(CRC32Test);
     TSUNIT_TEST(testCRC);
+    TSUNIT_TEST(testLargeData);
     TSUNIT_TEST_END();
 };
 
@@ -183,3 +185,44 @@ void CRC32Test::testCRC()
 
     bench.report(u"CRC32Test::testCRC");
 }
+
+void CRC32Test::testLargeData()
+{
+    // Pseudo-random data, larger than any section.
+    std::vector<uint8_t> data(65536);
+    uint32_t seed = 0x12345678;
+    for (auto& b : data) {
+        seed = seed * 1103515245 + 12345;
+        b = uint8_t(seed >> 16);
+    }
+
+    // Reference value, one byte at a time, never accelerated by large blocks.
+    ts::CRC32 ref;
+    for (auto b : data) {
+        ref.add(&b, 1);
+    }
+
+    // All sizes and alignments around the thresholds of the accelerated implementation.
+    for (size_t size = 0; size < 600; ++size) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            ts::CRC32 bytes;
+            for (size_t i = 0; i < size; ++i) {
+                bytes.add(&data[offset + i], 1);
+            }
+            ts::CRC32 block(&data[offset], size);
+            TSUNIT_EQUAL(bytes.value(), block.value());
+        }
+    }
+
+    // Complete data, repeated for benchmarking.
+    utest::TSUnitBenchmark bench(u"TSUNIT_CRC32_ITERATIONS");
+    ts::CRC32 c;
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        c.reset();
+        c.add(data.data(), data.size());
+    }
+    bench.stop();
+    TSUNIT_EQUAL(ref.value(), c.value());
+    bench.report(u"CRC32Test::testLargeData");
+}
@@ -58,6 +58,7 @@ public:
 
     void testAES();
     void testAES_ECB();
+    void testAES_Blocks();
     void testAES_CBC();
     void testAES_CTR();
     void testAES_CTS1();
@@ -69,6 +70,7 @@ public:
     void testTDES();
     void testTDES_CBC();
     void testDVBCSA2();
+    void testDVBCSA2_Batch();
     void testDVBCISSA();
     void testIDSA();
     void testSCTE52_2003();
@@ -80,6 +82,7 @@ public:
     TSUNIT_TEST_BEGIN(CryptoTest);
     TSUNIT_TEST(testAES);
     TSUNIT_TEST(testAES_ECB);
+    TSUNIT_TEST(testAES_Blocks);
     TSUNIT_TEST(testAES_CBC);
     TSUNIT_TEST(testAES_CTR);
     TSUNIT_TEST(testAES_CTS1);
@@ -91,6 +94,7 @@ public:
     TSUNIT_TEST(testTDES);
     TSUNIT_TEST(testTDES_CBC);
     TSUNIT_TEST(testDVBCSA2);
+    TSUNIT_TEST(testDVBCSA2_Batch);
     TSUNIT_TEST(testDVBCISSA);
     TSUNIT_TEST(testIDSA);
     TSUNIT_TEST(testSCTE52_2003);
@@ -375,6 +379,63 @@ void CryptoTest::testAES_ECB()
     bench.report(u"CryptoTest::testAES_ECB");
 }
 
+void CryptoTest::testAES_Blocks()
+{
+    // Multi-block encryption and decryption must be identical to block by block.
+    // Use an odd number of blocks to test the processing of remaining blocks.
+    static const size_t block_count = 1023;
+    utest::TSUnitBenchmark bench(u"TSUNIT_AES_BLOCKS_ITERATIONS");
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock plain(block_count * ts::AES::BLOCK_SIZE);
+    ts::ByteBlock cipher(plain.size());
+    ts::ByteBlock ref(plain.size());
+    TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+
+    for (size_t key_size = ts::AES::MIN_KEY_SIZE; key_size <= ts::AES::MAX_KEY_SIZE; key_size += 8) {
+        ts::AES aes;
+        ts::ByteBlock key(key_size);
+        TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+        TSUNIT_ASSERT(aes.setKey(key.data(), key.size()));
+
+        for (size_t i = 0; i < block_count; ++i) {
+            TSUNIT_ASSERT(aes.encrypt(&plain[i * ts::AES::BLOCK_SIZE], ts::AES::BLOCK_SIZE, &ref[i * ts::AES::BLOCK_SIZE], ts::AES::BLOCK_SIZE));
+        }
+        TSUNIT_EQUAL(block_count, aes.encryptionCount());
+
+        bench.start();
+        for (size_t iter = 0; iter < bench.iterations; ++iter) {
+            TSUNIT_ASSERT(aes.encryptBlocks(plain.data(), cipher.data(), block_count));
+        }
+        bench.stop();
+        TSUNIT_ASSERT(cipher == ref);
+        TSUNIT_EQUAL(block_count * (1 + bench.iterations), aes.encryptionCount());
+
+        bench.start();
+        for (size_t iter = 0; iter < bench.iterations; ++iter) {
+            TSUNIT_ASSERT(aes.decryptBlocks(ref.data(), cipher.data(), block_count));
+        }
+        bench.stop();
+        TSUNIT_ASSERT(cipher == plain);
+
+        // In place.
+        TSUNIT_ASSERT(aes.encryptBlocks(cipher.data(), cipher.data(), block_count));
+        TSUNIT_ASSERT(cipher == ref);
+        TSUNIT_ASSERT(aes.decryptBlocks(cipher.data(), cipher.data(), block_count));
+        TSUNIT_ASSERT(cipher == plain);
+    }
+
+    // Key usage limitation applies to each block.
+    ts::AES aes;
+    TSUNIT_ASSERT(aes.setKey(plain.data(), ts::AES::MIN_KEY_SIZE));
+    aes.setEncryptionMax(10);
+    TSUNIT_ASSERT(aes.encryptBlocks(plain.data(), cipher.data(), 6));
+    TSUNIT_ASSERT(!aes.encryptBlocks(plain.data(), cipher.data(), 6));
+    TSUNIT_ASSERT(aes.encryptBlocks(plain.data(), cipher.data(), 4));
+    TSUNIT_ASSERT(!aes.encryptBlocks(plain.data(), cipher.data(), 1));
+
+    bench.report(u"CryptoTest::testAES_Blocks");
+}
+
 void CryptoTest::testAES_CBC()
 {
     utest::TSUnitBenchmark bench(u"TSUNIT_AES_CBC_ITERATIONS");
@@ -532,6 +593,85 @@ void CryptoTest::testDVBCSA2()
     bench.report(u"CryptoTest::testDVBCSA2");
 }
 
+void CryptoTest::testDVBCSA2_Batch()
+{
+    // Batch encryption and decryption must be identical to packet by packet, with any mix of
+    // payload sizes, including payloads which are too short to be scrambled. Use a number of
+    // packets which is not a multiple of the number of parallel lanes.
+    static const size_t pkt_count = 300;
+    utest::TSUnitBenchmark bench(u"TSUNIT_DVBCSA2_BATCH_ITERATIONS");
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock plain(pkt_count * ts::PKT_MAX_PAYLOAD_SIZE);
+    ts::ByteBlock data(plain.size());
+    ts::ByteBlock ref(plain.size());
+    ts::ByteBlock key(ts::DVBCSA2::KEY_SIZE);
+    TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+    TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+
+    ts::DVBCSA2 csa;
+    TSUNIT_ASSERT(csa.setKey(key.data(), key.size()));
+
+    // Payloads are at the end of 184-byte areas, as in TS packets with adaptation fields.
+    std::vector<ts::DVBCSA2::BatchEntry> batch(pkt_count);
+    ref = plain;
+    for (size_t i = 0; i < pkt_count; ++i) {
+        const size_t size = i < 100 ? ts::PKT_MAX_PAYLOAD_SIZE : (i * 37) % (ts::PKT_MAX_PAYLOAD_SIZE + 1);
+        const size_t offset = (i + 1) * ts::PKT_MAX_PAYLOAD_SIZE - size;
+        batch[i].data = &data[offset];
+        batch[i].size = size;
+        TSUNIT_ASSERT(csa.encryptInPlace(&ref[offset], size));
+    }
+    TSUNIT_EQUAL(pkt_count, csa.encryptionCount());
+
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        ::memcpy(data.data(), plain.data(), plain.size());
+        TSUNIT_ASSERT(csa.encryptBatch(batch.data(), batch.size()));
+    }
+    bench.stop();
+    TSUNIT_ASSERT(data == ref);
+    TSUNIT_EQUAL(pkt_count * (1 + bench.iterations), csa.encryptionCount());
+
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        ::memcpy(data.data(), ref.data(), ref.size());
+        TSUNIT_ASSERT(csa.decryptBatch(batch.data(), batch.size()));
+    }
+    bench.stop();
+    TSUNIT_ASSERT(data == plain);
+
+    // Test vectors, all packets of a batch being identical.
+    const size_t tv_count = sizeof(tv_dvb_csa2) / sizeof(tv_dvb_csa2[0]);
+    for (size_t tvi = 0; tvi < tv_count; ++tvi) {
+        const TV_DVB_CSA2* tv = tv_dvb_csa2 + tvi;
+        TSUNIT_ASSERT(tv->size <= ts::PKT_MAX_PAYLOAD_SIZE);
+        TSUNIT_ASSERT(csa.setKey(tv->key, sizeof(tv->key)));
+        for (size_t i = 0; i < pkt_count; ++i) {
+            ::memcpy(&data[i * tv->size], tv->plain, tv->size);
+            batch[i].data = &data[i * tv->size];
+            batch[i].size = tv->size;
+        }
+        TSUNIT_ASSERT(csa.encryptBatch(batch.data(), pkt_count));
+        for (size_t i = 0; i < pkt_count; ++i) {
+            TSUNIT_EQUAL(0, ::memcmp(&data[i * tv->size], tv->cipher, tv->size));
+        }
+        TSUNIT_ASSERT(csa.decryptBatch(batch.data(), pkt_count));
+        for (size_t i = 0; i < pkt_count; ++i) {
+            TSUNIT_EQUAL(0, ::memcmp(&data[i * tv->size], tv->plain, tv->size));
+        }
+    }
+
+    // Key usage limitation applies to each packet.
+    csa.setEncryptionMax(10);
+    TSUNIT_ASSERT(csa.setKey(tv_dvb_csa2[0].key, sizeof(tv_dvb_csa2[0].key)));
+    TSUNIT_ASSERT(csa.encryptBatch(batch.data(), 6));
+    TSUNIT_ASSERT(!csa.encryptBatch(batch.data(), 6));
+    TSUNIT_ASSERT(csa.encryptBatch(batch.data(), 4));
+    TSUNIT_ASSERT(!csa.encryptBatch(batch.data(), 1));
+
+    bench.report(u"CryptoTest::testDVBCSA2_Batch");
+}
+
 void CryptoTest::testDVBCISSA()
 {
     utest::TSUnitBenchmark bench(u"TSUNIT_DVBCISSA_ITERATIONS");
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::DatagramPacer
+//
+//----------------------------------------------------------------------------
+
+#include "tsDatagramPacer.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class DatagramPacerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+
+    void testPCR();
+    void testTimeStamps();
+    void testDiscontinuity();
+    void testWait();
+
+    TSUNIT_TEST_BEGIN(DatagramPacerTest);
+    TSUNIT_TEST(testPCR);
+    TSUNIT_TEST(testTimeStamps);
+    TSUNIT_TEST(testDiscontinuity);
+    TSUNIT_TEST(testWait);
+    TSUNIT_TEST_END();
+
+private:
+    // 1 packet = 1 ms at this bitrate.
+    static constexpr uint64_t PCR_PER_PACKET = ts::SYSTEM_CLOCK_FREQ / 1000;
+    static constexpr size_t PACKET_COUNT = 700;
+    ts::TSPacketVector _packets {};
+    ts::TSPacketMetadataVector _mdata {};
+};
+
+TSUNIT_REGISTER(DatagramPacerTest);
+
+#if !defined(TS_CXX17)
+constexpr uint64_t DatagramPacerTest::PCR_PER_PACKET;
+constexpr size_t DatagramPacerTest::PACKET_COUNT;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void DatagramPacerTest::beforeTest()
+{
+    // A PCR every 10 packets, a timestamp every 5 packets, starting at 1 second.
+    _packets.resize(PACKET_COUNT);
+    _mdata.resize(PACKET_COUNT);
+    for (size_t i = 0; i < PACKET_COUNT; ++i) {
+        _packets[i].init(100);
+        if (i % 10 == 0) {
+            _packets[i].setPCR(ts::SYSTEM_CLOCK_FREQ + i * PCR_PER_PACKET, true);
+        }
+        _mdata[i].reset();
+        if (i % 5 == 0) {
+            _mdata[i].setInputTimeStamp(ts::SYSTEM_CLOCK_FREQ + i * PCR_PER_PACKET, ts::SYSTEM_CLOCK_FREQ, ts::TimeSource::HARDWARE);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void DatagramPacerTest::testPCR()
+{
+    ts::DatagramPacer pacer;
+    pacer.reset();
+
+    // Datagrams of 7 packets. The first one is due now.
+    ts::Monotonic first, due;
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[0], nullptr, 7, 0, first));
+    for (size_t i = 7; i + 7 <= PACKET_COUNT; i += 7) {
+        TSUNIT_ASSERT(pacer.dueTime(&_packets[i], nullptr, 7, 0, due));
+        TSUNIT_EQUAL(ts::NanoSecond(i) * ts::NanoSecPerMilliSec, due - first);
+    }
+}
+
+void DatagramPacerTest::testTimeStamps()
+{
+    ts::DatagramPacer pacer;
+    pacer.setUseTimeStamps(true);
+    pacer.reset();
+
+    // Without metadata, the datagrams cannot be scheduled.
+    ts::Monotonic first, due;
+    TSUNIT_ASSERT(!pacer.dueTime(&_packets[0], nullptr, 7, 0, first));
+
+    pacer.reset();
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[0], &_mdata[0], 7, 0, first));
+    for (size_t i = 7; i + 7 <= PACKET_COUNT; i += 7) {
+        TSUNIT_ASSERT(pacer.dueTime(&_packets[i], &_mdata[i], 7, 0, due));
+        TSUNIT_EQUAL(ts::NanoSecond(i) * ts::NanoSecPerMilliSec, due - first);
+    }
+}
+
+void DatagramPacerTest::testDiscontinuity()
+{
+    ts::DatagramPacer pacer;
+    pacer.reset();
+
+    // Without PCR nor bitrate, the first datagram cannot be scheduled.
+    ts::Monotonic first, due;
+    TSUNIT_ASSERT(!pacer.dueTime(&_packets[1], nullptr, 7, 0, first));
+
+    // Then, use the bitrate to extrapolate: 1 packet = 1 ms.
+    const ts::BitRate bitrate(ts::PKT_SIZE_BITS * 1000);
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[10], nullptr, 7, bitrate, first));
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[17], nullptr, 2, bitrate, due));
+    TSUNIT_EQUAL(7 * ts::NanoSecPerMilliSec, due - first);
+
+    // A PCR going backward resynchronizes the pacing on the current time.
+    ts::Monotonic before(true);
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[0], nullptr, 7, bitrate, due));
+    TSUNIT_ASSERT(due >= before);
+    TSUNIT_ASSERT(due - first < 5 * ts::NanoSecPerMilliSec);
+}
+
+void DatagramPacerTest::testWait()
+{
+    ts::DatagramPacer pacer;
+    pacer.reset();
+
+    ts::Monotonic due;
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[0], nullptr, 7, 0, due));
+    TSUNIT_ASSERT(pacer.dueTime(&_packets[7], nullptr, 7, 0, due));
+    pacer.wait(due);
+    const ts::Monotonic end(true);
+    TSUNIT_ASSERT(end >= due);
+    TSUNIT_ASSUME(end - due < 500 * ts::NanoSecPerMicroSec);
+}
@@ -25,6 +25,7 @@
 #include "tsTDT.h"
 #include "tsNames.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 #include "tables/psi_bat_cplus_packets.h"
 #include "tables/psi_bat_cplus_sections.h"
@@ -71,6 +72,8 @@ public:
     void testTDT();
     void testTOT();
     void testHEVC();
+    void testManyPIDs();
+    void testSectionHandler();
 
     TSUNIT_TEST_BEGIN(DemuxTest);
     TSUNIT_TEST(testPAT);
@@ -84,6 +87,8 @@ public:
     TSUNIT_TEST(testTDT);
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testHEVC);
+    TSUNIT_TEST(testManyPIDs);
+    TSUNIT_TEST(testSectionHandler);
     TSUNIT_TEST_END();
 
 private:
@@ -468,3 +473,112 @@ void DemuxTest::testHEVC()
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+void DemuxTest::testManyPIDs()
+{
+    // Build a multiplex with 300 PID's, each one carrying one PMT.
+    // The packets of all PID's are interleaved.
+    static const size_t pid_count = 300;
+    static const ts::PID first_pid = 100;
+
+    ts::DuckContext duck;
+    std::vector<ts::TSPacketVector> pid_packets(pid_count);
+    size_t max_packets = 0;
+
+    for (size_t i = 0; i < pid_count; ++i) {
+        const ts::PID pid = ts::PID(first_pid + i);
+        ts::PMT pmt(0, true, uint16_t(i + 1), pid);
+        for (uint16_t es = 0; es < 10; ++es) {
+            pmt.streams[ts::PID(1000 + 10 * i + es)].stream_type = ts::ST_MPEG2_VIDEO;
+        }
+        ts::BinaryTable table;
+        pmt.serialize(duck, table);
+        ts::OneShotPacketizer pzer(duck, pid);
+        pzer.addTable(table);
+        pzer.getPackets(pid_packets[i]);
+        max_packets = std::max(max_packets, pid_packets[i].size());
+    }
+
+    ts::TSPacketVector packets;
+    for (size_t pi = 0; pi < max_packets; ++pi) {
+        for (size_t i = 0; i < pid_count; ++i) {
+            if (pi < pid_packets[i].size()) {
+                packets.push_back(pid_packets[i][pi]);
+            }
+        }
+    }
+
+    // Demux the multiplex, repeatedly. The tables are reported once only.
+    utest::TSUnitBenchmark bench(u"TSUNIT_DEMUX_ITERATIONS");
+    ts::StandaloneTableDemux demux(duck, ts::AllPIDs);
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        for (const auto& pkt : packets) {
+            demux.feedPacket(pkt);
+        }
+    }
+    bench.stop();
+    bench.report(u"DemuxTest::testManyPIDs");
+
+    TSUNIT_EQUAL(pid_count, demux.tableCount());
+    for (size_t i = 0; i < demux.tableCount(); ++i) {
+        TSUNIT_EQUAL(ts::TID_PMT, demux.tableAt(i)->tableId());
+    }
+}
+
+namespace {
+    // Count and check sections and tables from a demux.
+    class SectionCounter: public ts::TableHandlerInterface, public ts::SectionHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(SectionCounter);
+    public:
+        SectionCounter(const uint8_t* ref, size_t ref_size) : _ref(ref), _ref_size(ref_size) {}
+        size_t sections = 0;
+        size_t tables = 0;
+        size_t errors = 0;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override { tables++; }
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& section) override
+        {
+            sections++;
+            if (!section.isValid() || section.size() != _ref_size || ::memcmp(section.content(), _ref, _ref_size) != 0) {
+                errors++;
+            }
+        }
+    private:
+        const uint8_t* const _ref;
+        const size_t _ref_size;
+    };
+}
+
+void DemuxTest::testSectionHandler()
+{
+    // The reference PAT is made of one single section.
+    ts::DuckContext duck;
+    const size_t pkt_count = sizeof(psi_pat_r4_packets) / ts::PKT_SIZE;
+    const ts::TSPacket* const pat_packets = reinterpret_cast<const ts::TSPacket*>(psi_pat_r4_packets);
+
+    // Demux the same PAT repeatedly, with and without table handler.
+    // The section handler shall receive all sections with identical content.
+    for (int with_table = 0; with_table < 2; ++with_table) {
+        SectionCounter counter(psi_pat_r4_sections, sizeof(psi_pat_r4_sections));
+        ts::SectionDemux demux(duck, with_table ? &counter : nullptr, &counter, ts::AllPIDs);
+        utest::TSUnitBenchmark bench(u"TSUNIT_DEMUX_ITERATIONS");
+        const size_t repeat = std::max<size_t>(100, bench.iterations);
+        uint8_t cc = 0;
+        bench.start();
+        for (size_t iter = 0; iter < repeat; ++iter) {
+            for (size_t i = 0; i < pkt_count; ++i) {
+                ts::TSPacket pkt(pat_packets[i]);
+                pkt.setCC(cc);
+                cc = (cc + 1) & ts::CC_MASK;
+                demux.feedPacket(pkt);
+            }
+        }
+        bench.stop();
+        bench.report(with_table ? u"DemuxTest::testSectionHandler (tables and sections)" : u"DemuxTest::testSectionHandler (sections only)");
+
+        TSUNIT_EQUAL(repeat, counter.sections);
+        TSUNIT_EQUAL(0, counter.errors);
+        TSUNIT_EQUAL(with_table ? 1 : 0, counter.tables);
+    }
+}
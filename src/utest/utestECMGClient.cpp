@@ -0,0 +1,430 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::ECMGClient.
+//
+//----------------------------------------------------------------------------
+
+#include "tsECMGClient.h"
+#include "tsTCPServer.h"
+#include "tsIPv4SocketAddress.h"
+#include "tsGuardCondition.h"
+#include "tsSysUtils.h"
+#include "tsNullReport.h"
+#include "tsReportBuffer.h"
+#include "utestTSUnitThread.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ECMGClientTest: public tsunit::Test
+{
+public:
+    void testPipelined();
+    void testSynchronous();
+    void testPendingFailure();
+
+    TSUNIT_TEST_BEGIN(ECMGClientTest);
+    TSUNIT_TEST(testPipelined);
+    TSUNIT_TEST(testSynchronous);
+    TSUNIT_TEST(testPendingFailure);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(ECMGClientTest);
+
+
+//----------------------------------------------------------------------------
+// A minimal local ECMG, in the spirit of tsecmg. The CW_provision requests
+// are accumulated and answered in reverse order, by batches of a given size,
+// to check that the ECM responses are correctly matched by the client.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // ECM content: stream id and CP number.
+    ts::ByteBlock MakeECM(uint16_t stream_id, uint16_t cp_number)
+    {
+        ts::ByteBlock ecm(4);
+        ts::PutUInt16(ecm.data(), stream_id);
+        ts::PutUInt16(ecm.data() + 2, cp_number);
+        return ecm;
+    }
+
+    class ECMGServer: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(ECMGServer);
+    public:
+        uint16_t port = 0;
+        size_t   provision_count = 0;
+        size_t   closed_streams = 0;
+        bool     channel_closed = false;
+
+        ECMGServer(const ts::ecmgscs::Protocol& protocol, size_t batch_size) :
+            utest::TSUnitThread(),
+            _protocol(protocol),
+            _batch_size(batch_size),
+            _connection(protocol)
+        {
+            TSUNIT_ASSERT(ts::IPInitialize());
+            TSUNIT_ASSERT(_server.open(CERR));
+            TSUNIT_ASSERT(_server.reusePort(true, CERR));
+            TSUNIT_ASSERT(_server.bind(ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, ts::IPv4SocketAddress::AnyPort), CERR));
+            TSUNIT_ASSERT(_server.listen(1, CERR));
+            ts::IPv4SocketAddress addr;
+            TSUNIT_ASSERT(_server.getLocalAddress(addr, CERR));
+            port = addr.port();
+        }
+
+        virtual ~ECMGServer() override
+        {
+            waitForTermination();
+            _server.close(CERR);
+        }
+
+        virtual void test() override
+        {
+            ts::IPv4SocketAddress client;
+            TSUNIT_ASSERT(_server.accept(_connection, client, CERR));
+
+            ts::tlv::MessagePtr msg;
+            std::vector<ts::ecmgscs::CWProvision> batch;
+            while (!channel_closed && _connection.receive(msg, nullptr, NULLREP)) {
+                switch (msg->tag()) {
+                    case ts::ecmgscs::Tags::channel_setup: {
+                        const ts::ecmgscs::ChannelSetup* setup = dynamic_cast<ts::ecmgscs::ChannelSetup*>(msg.pointer());
+                        TSUNIT_ASSERT(setup != nullptr);
+                        ts::ecmgscs::ChannelStatus status(_protocol);
+                        status.channel_id = setup->channel_id;
+                        status.section_TSpkt_flag = true;
+                        status.CW_per_msg = 2;
+                        status.lead_CW = 1;
+                        status.max_comp_time = 100;
+                        TSUNIT_ASSERT(_connection.send(status, CERR));
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::stream_setup: {
+                        const ts::ecmgscs::StreamSetup* setup = dynamic_cast<ts::ecmgscs::StreamSetup*>(msg.pointer());
+                        TSUNIT_ASSERT(setup != nullptr);
+                        ts::ecmgscs::StreamStatus status(_protocol);
+                        status.channel_id = setup->channel_id;
+                        status.stream_id = setup->stream_id;
+                        status.ECM_id = setup->ECM_id;
+                        TSUNIT_ASSERT(_connection.send(status, CERR));
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::CW_provision: {
+                        const ts::ecmgscs::CWProvision* req = dynamic_cast<ts::ecmgscs::CWProvision*>(msg.pointer());
+                        TSUNIT_ASSERT(req != nullptr);
+                        provision_count++;
+                        batch.push_back(*req);
+                        if (batch.size() >= _batch_size) {
+                            // Answer the batch in reverse order.
+                            for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+                                ts::ecmgscs::ECMResponse resp(_protocol);
+                                resp.channel_id = it->channel_id;
+                                resp.stream_id = it->stream_id;
+                                resp.CP_number = it->CP_number;
+                                resp.ECM_datagram = MakeECM(it->stream_id, it->CP_number);
+                                TSUNIT_ASSERT(_connection.send(resp, CERR));
+                            }
+                            batch.clear();
+                        }
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::stream_close_request: {
+                        const ts::ecmgscs::StreamCloseRequest* req = dynamic_cast<ts::ecmgscs::StreamCloseRequest*>(msg.pointer());
+                        TSUNIT_ASSERT(req != nullptr);
+                        ts::ecmgscs::StreamCloseResponse resp(_protocol);
+                        resp.channel_id = req->channel_id;
+                        resp.stream_id = req->stream_id;
+                        closed_streams++;
+                        TSUNIT_ASSERT(_connection.send(resp, CERR));
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::channel_close: {
+                        channel_closed = true;
+                        break;
+                    }
+                    default: {
+                        break;
+                    }
+                }
+            }
+            _connection.disconnect(NULLREP);
+            _connection.close(NULLREP);
+        }
+
+    private:
+        const ts::ecmgscs::Protocol&     _protocol;
+        const size_t                     _batch_size;
+        ts::TCPServer                    _server {};
+        ts::tlv::Connection<ts::Mutex>   _connection;
+    };
+
+    // Connect a client to the local ECMG, on stream 1.
+    void Connect(ts::ECMGClient& client, const ts::ecmgscs::Protocol& protocol, uint16_t port, ts::Report& report)
+    {
+        ts::ECMGClientArgs args;
+        args.ecmg_address.setAddress(ts::IPv4Address::LocalHost);
+        args.ecmg_address.setPort(port);
+        args.super_cas_id = 0x12345678;
+        args.cp_duration = 10000;
+        args.ecm_channel_id = 7;
+        args.ecm_stream_id = 1;
+        args.ecm_id = 101;
+
+        ts::ecmgscs::ChannelStatus channel_status(protocol);
+        ts::ecmgscs::StreamStatus stream_status(protocol);
+        TSUNIT_ASSERT(client.connect(args, channel_status, stream_status, nullptr, ts::tlv::Logger(ts::Severity::Debug, &report)));
+        TSUNIT_ASSERT(client.isConnected());
+        TSUNIT_EQUAL(7, channel_status.channel_id);
+        TSUNIT_EQUAL(1, stream_status.stream_id);
+        TSUNIT_EQUAL(101, stream_status.ECM_id);
+    }
+
+    // Asynchronous ECM handler, one per stream, check that all responses are for that stream.
+    class ECMHandler: public ts::ECMGClientHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(ECMHandler);
+    public:
+        ECMHandler(uint16_t stream_id, ts::Mutex& mutex, ts::Condition& cond, size_t& total) :
+            _stream_id(stream_id), _mutex(mutex), _cond(cond), _total(total) {}
+
+        std::set<uint16_t> cp_numbers {};
+        std::set<uint16_t> failed {};
+        size_t errors = 0;
+
+        virtual void handleECM(const ts::ecmgscs::ECMResponse& response) override
+        {
+            ts::GuardCondition lock(_mutex, _cond);
+            if (response.stream_id != _stream_id || response.ECM_datagram != MakeECM(_stream_id, response.CP_number)) {
+                errors++;
+            }
+            cp_numbers.insert(response.CP_number);
+            _total++;
+            lock.signal();
+        }
+
+        virtual void handleECMError(uint16_t stream_id, uint16_t cp_number, const ts::UString&) override
+        {
+            ts::GuardCondition lock(_mutex, _cond);
+            if (stream_id != _stream_id) {
+                errors++;
+            }
+            failed.insert(cp_number);
+            _total++;
+            lock.signal();
+        }
+
+    private:
+        const uint16_t _stream_id;
+        ts::Mutex&     _mutex;
+        ts::Condition& _cond;
+        size_t&        _total;
+    };
+
+    // A thread which synchronously generates ECM's on one stream.
+    class ECMThread: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(ECMThread);
+    public:
+        ECMThread(ts::ECMGClient& client, const ts::ecmgscs::Protocol& protocol, uint16_t stream_id) :
+            utest::TSUnitThread(), _client(client), _protocol(protocol), _stream_id(stream_id) {}
+
+        virtual ~ECMThread() override
+        {
+            waitForTermination();
+        }
+
+        virtual void test() override
+        {
+            const ts::ByteBlock cw(8, 0x55);
+            for (uint16_t cp = 0; cp < 4; ++cp) {
+                ts::ecmgscs::ECMResponse response(_protocol);
+                TSUNIT_ASSERT(_client.generateECM(_stream_id, cp, cw, cw, ts::ByteBlock(), 100, response));
+                TSUNIT_EQUAL(_stream_id, response.stream_id);
+                TSUNIT_EQUAL(cp, response.CP_number);
+                TSUNIT_ASSERT(response.ECM_datagram == MakeECM(_stream_id, cp));
+            }
+        }
+
+    private:
+        ts::ECMGClient&              _client;
+        const ts::ecmgscs::Protocol& _protocol;
+        const uint16_t               _stream_id;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+// Asynchronous requests on several streams, all pipelined before the first response.
+void ECMGClientTest::testPipelined()
+{
+    constexpr uint16_t STREAM_COUNT = 3;
+    constexpr uint16_t CP_COUNT = 4;
+
+    ts::ecmgscs::Protocol protocol;
+    ECMGServer server(protocol, STREAM_COUNT * CP_COUNT);
+    TSUNIT_ASSERT(server.start());
+
+    ts::ReportBuffer<ts::Mutex> log;
+    ts::ECMGClient client(protocol);
+    Connect(client, protocol, server.port, log);
+    for (uint16_t stream_id = 2; stream_id <= STREAM_COUNT; ++stream_id) {
+        ts::ecmgscs::StreamStatus stream_status(protocol);
+        TSUNIT_ASSERT(client.openStream(stream_id, uint16_t(100 + stream_id), 100, stream_status));
+        TSUNIT_EQUAL(stream_id, stream_status.stream_id);
+    }
+
+    // Cannot open the same stream twice.
+    ts::ecmgscs::StreamStatus dummy(protocol);
+    TSUNIT_ASSERT(!client.openStream(2, 102, 100, dummy));
+
+    ts::Mutex mutex;
+    ts::Condition cond;
+    size_t total = 0;
+    std::vector<ECMHandler*> handlers;
+    for (uint16_t stream_id = 1; stream_id <= STREAM_COUNT; ++stream_id) {
+        handlers.push_back(new ECMHandler(stream_id, mutex, cond, total));
+    }
+
+    // The ECMG does not respond before receiving all requests.
+    const ts::ByteBlock cw(8, 0xAA);
+    for (uint16_t cp = 0; cp < CP_COUNT; ++cp) {
+        for (uint16_t stream_id = 1; stream_id <= STREAM_COUNT; ++stream_id) {
+            TSUNIT_ASSERT(client.submitECM(stream_id, cp, cw, cw, ts::ByteBlock(), 100, handlers[stream_id - 1]));
+        }
+    }
+    {
+        ts::GuardCondition lock(mutex, cond);
+        while (total < STREAM_COUNT * CP_COUNT) {
+            TSUNIT_ASSERT(lock.waitCondition(5000));
+        }
+    }
+    for (auto h : handlers) {
+        TSUNIT_EQUAL(0, h->errors);
+        TSUNIT_EQUAL(CP_COUNT, h->cp_numbers.size());
+    }
+
+    // Latency statistics.
+    const ts::ECMGClient::LatencyStatistics stats(client.latencyStatistics());
+    TSUNIT_EQUAL(STREAM_COUNT * CP_COUNT, stats.latency.count());
+    TSUNIT_EQUAL(STREAM_COUNT * CP_COUNT, stats.max_pending);
+    size_t histo_total = 0;
+    for (auto count : stats.histogram) {
+        histo_total += count;
+    }
+    TSUNIT_EQUAL(STREAM_COUNT * CP_COUNT, histo_total);
+    client.reportStatistics(CERR, ts::Severity::Debug);
+
+    TSUNIT_ASSERT(client.closeStream(2));
+    TSUNIT_ASSERT(!client.submitECM(2, CP_COUNT, cw, cw, ts::ByteBlock(), 100, handlers[1]));
+    TSUNIT_ASSERT(client.disconnect());
+    TSUNIT_ASSERT(!client.isConnected());
+
+    server.waitForTermination();
+    TSUNIT_EQUAL(STREAM_COUNT * CP_COUNT, server.provision_count);
+    TSUNIT_EQUAL(STREAM_COUNT, server.closed_streams);
+    TSUNIT_ASSERT(server.channel_closed);
+
+    for (auto h : handlers) {
+        delete h;
+    }
+
+    debug() << "ECMGClientTest::testPipelined: " << log << std::endl;
+    TSUNIT_EQUAL(u"Error: ECM stream id 2 already open\nError: ECM stream id 2 not open", log.getMessages());
+}
+
+// Synchronous requests from concurrent threads, each one on its own stream.
+void ECMGClientTest::testSynchronous()
+{
+    constexpr uint16_t STREAM_COUNT = 3;
+
+    // The ECMG responds only when one request from each thread is received.
+    ts::ecmgscs::Protocol protocol;
+    ECMGServer server(protocol, STREAM_COUNT);
+    TSUNIT_ASSERT(server.start());
+
+    ts::ECMGClient client(protocol);
+    Connect(client, protocol, server.port, CERR);
+    for (uint16_t stream_id = 2; stream_id <= STREAM_COUNT; ++stream_id) {
+        ts::ecmgscs::StreamStatus stream_status(protocol);
+        TSUNIT_ASSERT(client.openStream(stream_id, uint16_t(100 + stream_id), 100, stream_status));
+    }
+
+    {
+        std::vector<ECMThread*> threads;
+        for (uint16_t stream_id = 1; stream_id <= STREAM_COUNT; ++stream_id) {
+            threads.push_back(new ECMThread(client, protocol, stream_id));
+            TSUNIT_ASSERT(threads.back()->start());
+        }
+        for (auto t : threads) {
+            delete t;
+        }
+    }
+
+    const ts::ECMGClient::LatencyStatistics stats(client.latencyStatistics());
+    TSUNIT_EQUAL(4 * STREAM_COUNT, stats.latency.count());
+    client.reportStatistics(CERR, ts::Severity::Debug);
+
+    TSUNIT_ASSERT(client.disconnect());
+    server.waitForTermination();
+    TSUNIT_EQUAL(4 * STREAM_COUNT, server.provision_count);
+    TSUNIT_EQUAL(STREAM_COUNT, server.closed_streams);
+}
+
+// Pending asynchronous requests are failed when the stream is closed or the ECMG is disconnected.
+void ECMGClientTest::testPendingFailure()
+{
+    constexpr uint16_t CP_COUNT = 4;
+
+    // The ECMG never responds.
+    ts::ecmgscs::Protocol protocol;
+    ECMGServer server(protocol, 1000);
+    TSUNIT_ASSERT(server.start());
+
+    ts::ECMGClient client(protocol);
+    Connect(client, protocol, server.port, CERR);
+    ts::ecmgscs::StreamStatus stream_status(protocol);
+    TSUNIT_ASSERT(client.openStream(2, 102, 100, stream_status));
+
+    ts::Mutex mutex;
+    ts::Condition cond;
+    size_t total = 0;
+    ECMHandler handler1(1, mutex, cond, total);
+    ECMHandler handler2(2, mutex, cond, total);
+
+    const ts::ByteBlock cw(8, 0xAA);
+    for (uint16_t cp = 0; cp < CP_COUNT; ++cp) {
+        TSUNIT_ASSERT(client.submitECM(1, cp, cw, cw, ts::ByteBlock(), 100, &handler1));
+        TSUNIT_ASSERT(client.submitECM(2, cp, cw, cw, ts::ByteBlock(), 100, &handler2));
+    }
+
+    // The handlers are notified before closeStream() and disconnect() return.
+    TSUNIT_ASSERT(client.closeStream(2));
+    TSUNIT_EQUAL(CP_COUNT, handler2.failed.size());
+    TSUNIT_EQUAL(0, handler1.failed.size());
+
+    TSUNIT_ASSERT(client.disconnect());
+    TSUNIT_EQUAL(CP_COUNT, handler1.failed.size());
+    TSUNIT_EQUAL(2 * CP_COUNT, total);
+    TSUNIT_EQUAL(0, handler1.errors);
+    TSUNIT_EQUAL(0, handler2.errors);
+    TSUNIT_ASSERT(handler1.cp_numbers.empty());
+    TSUNIT_ASSERT(handler2.cp_numbers.empty());
+
+    server.waitForTermination();
+    TSUNIT_EQUAL(2 * CP_COUNT, server.provision_count);
+}
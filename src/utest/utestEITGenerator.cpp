@@ -0,0 +1,261 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::EITGenerator
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITGenerator.h"
+#include "tsDuckContext.h"
+#include "tsEIT.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class EITGeneratorTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testIncrementalUpdate();
+    void testLargeEPG();
+
+    TSUNIT_TEST_BEGIN(EITGeneratorTest);
+    TSUNIT_TEST(testIncrementalUpdate);
+    TSUNIT_TEST(testLargeEPG);
+    TSUNIT_TEST_END();
+
+private:
+    // Reference time for all tests.
+    static const ts::Time Now;
+
+    // Append a binary event description, as found in an EIT section.
+    static void AppendEvent(ts::ByteBlock& data, uint16_t event_id, const ts::Time& start, ts::MilliSecond duration, const std::string& name);
+
+    // Build the binary events of one service, one event per hour during the specified number of days.
+    static void BuildEvents(ts::ByteBlock& data, size_t days, const std::string& name);
+
+    // Split a list of EIT sections into p/f and schedule, count events in schedule.
+    static size_t CountScheduleEvents(const ts::SectionPtrVector& sections);
+
+    // Count differences between two lists of sections.
+    static size_t CountDifferences(const ts::SectionPtrVector& sec1, const ts::SectionPtrVector& sec2);
+};
+
+TSUNIT_REGISTER(EITGeneratorTest);
+
+const ts::Time EITGeneratorTest::Now(2023, 3, 14, 10, 30);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void EITGeneratorTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void EITGeneratorTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Build EPG data.
+//----------------------------------------------------------------------------
+
+void EITGeneratorTest::AppendEvent(ts::ByteBlock& data, uint16_t event_id, const ts::Time& start, ts::MilliSecond duration, const std::string& name)
+{
+    uint8_t* ev = data.enlarge(ts::EIT::EIT_EVENT_FIXED_SIZE);
+    ts::PutUInt16(ev, event_id);
+    ts::EncodeMJD(start, ev + 2, ts::MJD_SIZE);
+    ev[7] = ts::EncodeBCD(int(duration / ts::MilliSecPerHour));
+    ev[8] = ts::EncodeBCD(int((duration / ts::MilliSecPerMin) % 60));
+    ev[9] = ts::EncodeBCD(int((duration / ts::MilliSecPerSec) % 60));
+    // Running status 0, not scrambled, one short_event_descriptor.
+    ts::PutUInt16(ev + 10, uint16_t(7 + name.size()));
+    data.appendUInt8(ts::DID_SHORT_EVENT);
+    data.appendUInt8(uint8_t(5 + name.size()));
+    data.append("eng", 3);
+    data.appendUInt8(uint8_t(name.size()));
+    data.append(name);
+    data.appendUInt8(0);
+}
+
+void EITGeneratorTest::BuildEvents(ts::ByteBlock& data, size_t days, const std::string& name)
+{
+    data.clear();
+    const ts::Time first(Now.thisDay());
+    for (size_t i = 0; i < days * 24; ++i) {
+        AppendEvent(data, uint16_t(i), first + ts::MilliSecond(i) * ts::MilliSecPerHour, ts::MilliSecPerHour, name);
+    }
+}
+
+size_t EITGeneratorTest::CountScheduleEvents(const ts::SectionPtrVector& sections)
+{
+    size_t count = 0;
+    for (const auto& sec : sections) {
+        if (!sec.isNull() && sec->isValid() && ts::EIT::IsSchedule(sec->tableId())) {
+            const uint8_t* data = sec->payload() + ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+            size_t size = sec->payloadSize() - ts::EIT::EIT_PAYLOAD_FIXED_SIZE;
+            while (size >= ts::EIT::EIT_EVENT_FIXED_SIZE) {
+                const size_t ev_size = std::min(size, ts::EIT::EIT_EVENT_FIXED_SIZE + (ts::GetUInt16(data + 10) & 0x0FFF));
+                data += ev_size;
+                size -= ev_size;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+size_t EITGeneratorTest::CountDifferences(const ts::SectionPtrVector& sec1, const ts::SectionPtrVector& sec2)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < std::max(sec1.size(), sec2.size()); ++i) {
+        if (i >= sec1.size() || i >= sec2.size() || sec1[i].isNull() || sec2[i].isNull() || !(*sec1[i] == *sec2[i])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void EITGeneratorTest::testIncrementalUpdate()
+{
+    ts::DuckContext duck;
+    ts::EITGenerator gen(duck, ts::PID_EIT, ts::EITOptions::GEN_ALL);
+    const ts::ServiceIdTriplet srv(0x0101, 0x0010, 0x0020);
+    gen.setTransportStreamId(srv.transport_stream_id);
+    gen.setCurrentTime(Now);
+
+    // Two days of events, one per hour. The events before 10:00 are obsolete.
+    ts::ByteBlock data;
+    BuildEvents(data, 2, "Event name");
+    TSUNIT_ASSERT(gen.loadEvents(srv, data.data(), data.size()));
+
+    ts::SectionPtrVector sec1;
+    gen.saveEITs(sec1);
+    TSUNIT_EQUAL(48 - 10, CountScheduleEvents(sec1));
+
+    // Reloading the same events does not change anything.
+    TSUNIT_ASSERT(gen.loadEvents(srv, data.data(), data.size()));
+    ts::SectionPtrVector sec2;
+    gen.saveEITs(sec2);
+    TSUNIT_EQUAL(sec1.size(), sec2.size());
+    TSUNIT_EQUAL(0, CountDifferences(sec1, sec2));
+
+    // Modify one event in the second day: only one section is updated.
+    data.clear();
+    AppendEvent(data, 30, Now.thisDay() + 30 * ts::MilliSecPerHour, ts::MilliSecPerHour, "Modified event name");
+    TSUNIT_ASSERT(gen.loadEvents(srv, data.data(), data.size()));
+    sec2.clear();
+    gen.saveEITs(sec2);
+    TSUNIT_EQUAL(sec1.size(), sec2.size());
+    TSUNIT_EQUAL(1, CountDifferences(sec1, sec2));
+    TSUNIT_EQUAL(48 - 10, CountScheduleEvents(sec2));
+
+    // Delete one event in the second day: only one section is updated.
+    TSUNIT_ASSERT(gen.deleteEvent(srv, 40));
+    TSUNIT_ASSERT(!gen.deleteEvent(srv, 40));
+    TSUNIT_ASSERT(!gen.deleteEvent(ts::ServiceIdTriplet(0x0102, 0x0010, 0x0020), 41));
+    ts::SectionPtrVector sec3;
+    gen.saveEITs(sec3);
+    TSUNIT_EQUAL(sec2.size(), sec3.size());
+    TSUNIT_EQUAL(1, CountDifferences(sec2, sec3));
+    TSUNIT_EQUAL(48 - 10 - 1, CountScheduleEvents(sec3));
+
+    // Move an event to another segment: the two segments are updated.
+    data.clear();
+    AppendEvent(data, 30, Now.thisDay() + 40 * ts::MilliSecPerHour, ts::MilliSecPerHour, "Moved event");
+    TSUNIT_ASSERT(gen.loadEvents(srv, data.data(), data.size()));
+    ts::SectionPtrVector sec4;
+    gen.saveEITs(sec4);
+    TSUNIT_EQUAL(sec3.size(), sec4.size());
+    TSUNIT_EQUAL(2, CountDifferences(sec3, sec4));
+    TSUNIT_EQUAL(48 - 10 - 1, CountScheduleEvents(sec4));
+
+    // Inject EIT's in a stream of null packets during 10 seconds at 1 Mb/s.
+    gen.setTransportStreamBitRate(1000000);
+    size_t eit_count = 0;
+    for (size_t i = 0; i < 6650; ++i) {
+        ts::TSPacket pkt(ts::NullPacket);
+        gen.processPacket(pkt);
+        if (pkt.getPID() == ts::PID_EIT) {
+            eit_count++;
+        }
+    }
+    debug() << "EITGeneratorTest::testIncrementalUpdate: " << eit_count << " EIT packets" << std::endl;
+    TSUNIT_ASSERT(eit_count > 0);
+}
+
+void EITGeneratorTest::testLargeEPG()
+{
+    // 400 services, 8 days of events, one event per hour.
+    static constexpr size_t SERVICE_COUNT = 400;
+    static constexpr size_t DAYS = 8;
+    static constexpr size_t UPDATE_COUNT = 100;
+
+    std::vector<ts::ByteBlock> epg(SERVICE_COUNT);
+    for (size_t i = 0; i < SERVICE_COUNT; ++i) {
+        BuildEvents(epg[i], DAYS, "Some event name");
+    }
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_EITGENERATOR_ITERATIONS");
+    size_t sections_count = 0;
+    size_t events_count = 0;
+
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        ts::DuckContext duck;
+        ts::EITGenerator gen(duck, ts::PID_EIT, ts::EITOptions::GEN_ALL);
+        gen.setTransportStreamId(1);
+        gen.setCurrentTime(Now);
+
+        // Load the complete EPG, then generate all EIT's.
+        for (size_t i = 0; i < SERVICE_COUNT; ++i) {
+            TSUNIT_ASSERT(gen.loadEvents(ts::ServiceIdTriplet(uint16_t(i), uint16_t(1 + i % 4), 1), epg[i].data(), epg[i].size()));
+        }
+        ts::SectionPtrVector sections;
+        gen.saveEITs(sections);
+        sections_count = sections.size();
+        events_count = CountScheduleEvents(sections);
+
+        // Update single events in various services, then regenerate the EIT's.
+        ts::ByteBlock data;
+        for (size_t i = 0; i < UPDATE_COUNT; ++i) {
+            data.clear();
+            const uint16_t ev_id = uint16_t(24 + (i * 7) % ((DAYS - 1) * 24));
+            AppendEvent(data, ev_id, Now.thisDay() + ts::MilliSecond(ev_id) * ts::MilliSecPerHour, ts::MilliSecPerHour, "Updated event name");
+            TSUNIT_ASSERT(gen.loadEvents(ts::ServiceIdTriplet(uint16_t(i * 3), uint16_t(1 + (i * 3) % 4), 1), data.data(), data.size()));
+        }
+        sections.clear();
+        gen.saveEITs(sections);
+        TSUNIT_EQUAL(sections_count, sections.size());
+    }
+    bench.stop();
+    bench.report(u"EITGeneratorTest::testLargeEPG");
+
+    debug() << "EITGeneratorTest::testLargeEPG: " << SERVICE_COUNT << " services, " << events_count << " events, "
+            << sections_count << " sections, " << UPDATE_COUNT << " updates" << std::endl;
+
+    TSUNIT_EQUAL(SERVICE_COUNT * (DAYS * 24 - 10), events_count);
+}
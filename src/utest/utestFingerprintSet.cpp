@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::FingerprintSet
+//
+//----------------------------------------------------------------------------
+
+#include "tsFingerprintSet.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class FingerprintSetTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testInsert();
+    void testEviction();
+
+    TSUNIT_TEST_BEGIN(FingerprintSetTest);
+    TSUNIT_TEST(testInsert);
+    TSUNIT_TEST(testEviction);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(FingerprintSetTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void FingerprintSetTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void FingerprintSetTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void FingerprintSetTest::testInsert()
+{
+    ts::FingerprintSet set(1000);
+    TSUNIT_EQUAL(1000, set.maxSize());
+    TSUNIT_ASSERT(!set.contains(12));
+
+    TSUNIT_ASSERT(set.insert(12));
+    TSUNIT_ASSERT(set.contains(12));
+    TSUNIT_ASSERT(!set.insert(12));
+
+    // Zero and one are the same fingerprint.
+    TSUNIT_ASSERT(set.insert(0));
+    TSUNIT_ASSERT(set.contains(1));
+    TSUNIT_ASSERT(!set.insert(1));
+
+    // Fingerprints with identical low-order bits.
+    for (uint64_t i = 1; i <= 100; ++i) {
+        TSUNIT_ASSERT(set.insert(i << 32));
+    }
+    for (uint64_t i = 1; i <= 100; ++i) {
+        TSUNIT_ASSERT(set.contains(i << 32));
+        TSUNIT_ASSERT(!set.insert(i << 32));
+    }
+    TSUNIT_ASSERT(!set.contains(101ULL << 32));
+
+    set.clear();
+    TSUNIT_ASSERT(!set.contains(12));
+    TSUNIT_ASSERT(!set.contains(1ULL << 32));
+}
+
+// Build well-distributed fingerprints from an index.
+static uint64_t Fingerprint(uint64_t index)
+{
+    return index * 0x0123456789ABCDEF;
+}
+
+void FingerprintSetTest::testEviction()
+{
+    // Two generations of 50 fingerprints.
+    ts::FingerprintSet set(100);
+
+    // Fill more than the maximum size, the oldest ones are forgotten.
+    for (uint64_t i = 1; i <= 120; ++i) {
+        TSUNIT_ASSERT(set.insert(Fingerprint(i)));
+    }
+    TSUNIT_ASSERT(!set.contains(Fingerprint(1)));
+    TSUNIT_ASSERT(!set.contains(Fingerprint(50)));
+    TSUNIT_ASSERT(set.contains(Fingerprint(51)));
+    TSUNIT_ASSERT(set.contains(Fingerprint(120)));
+
+    // A fingerprint which is seen again survives the next generation.
+    TSUNIT_ASSERT(!set.insert(Fingerprint(60)));
+    for (uint64_t i = 121; i <= 160; ++i) {
+        TSUNIT_ASSERT(set.insert(Fingerprint(i)));
+    }
+    TSUNIT_ASSERT(set.contains(Fingerprint(60)));
+    TSUNIT_ASSERT(!set.contains(Fingerprint(61)));
+    TSUNIT_ASSERT(set.contains(Fingerprint(160)));
+}
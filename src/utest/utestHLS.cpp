@@ -11,6 +11,17 @@
 //----------------------------------------------------------------------------
 
 #include "tshlsPlayList.h"
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsTCPServer.h"
+#include "tsTCPConnection.h"
+#include "tsIPv4SocketAddress.h"
+#include "tsGuardMutex.h"
+#include "tsSysUtils.h"
+#include "tsNullReport.h"
+#include "tsReportBuffer.h"
+#include "utestTSUnitThread.h"
 #include "tsunit.h"
 
 
@@ -31,6 +42,10 @@ public:
     void testMediaPlaylist();
     void testBuildMasterPlaylist();
     void testBuildMediaPlaylist();
+    void testMergeMediaPlaylist();
+    void testInputSequential();
+    void testInputPrefetch();
+    void testInputPrefetchCount();
 
     TSUNIT_TEST_BEGIN(HLSTest);
     TSUNIT_TEST(testMasterPlaylist);
@@ -38,10 +53,17 @@ public:
     TSUNIT_TEST(testMediaPlaylist);
     TSUNIT_TEST(testBuildMasterPlaylist);
     TSUNIT_TEST(testBuildMediaPlaylist);
+    TSUNIT_TEST(testMergeMediaPlaylist);
+    TSUNIT_TEST(testInputSequential);
+    TSUNIT_TEST(testInputPrefetch);
+    TSUNIT_TEST(testInputPrefetchCount);
     TSUNIT_TEST_END();
 
 private:
     int _previousSeverity;
+
+    // Run the hls input plugin on a local HTTP server, check the received packets.
+    void runInputPlugin(const ts::UStringVector& options, size_t segmentCount);
 };
 
 TSUNIT_REGISTER(HLSTest);
@@ -377,3 +399,303 @@ void HLSTest::testBuildMediaPlaylist()
 
     TSUNIT_EQUAL(refContent2, pl.textContent());
 }
+
+void HLSTest::testMergeMediaPlaylist()
+{
+    ts::hls::PlayList pl;
+    TSUNIT_ASSERT(pl.loadText(
+        u"#EXTM3U\n"
+        u"#EXT-X-TARGETDURATION:5\n"
+        u"#EXT-X-MEDIA-SEQUENCE:10\n"
+        u"#EXTINF:5,\n"
+        u"seg-0010.ts\n"
+        u"#EXTINF:5,\n"
+        u"seg-0011.ts\n"
+        u"#EXTINF:5,\n"
+        u"seg-0012.ts\n",
+        true, ts::hls::PlayListType::LIVE, CERR));
+    TSUNIT_ASSERT(pl.isUpdatable());
+    TSUNIT_EQUAL(10, pl.mediaSequence());
+    TSUNIT_EQUAL(3, pl.segmentCount());
+
+    // A more recent version of the playlist, as reloaded in another object.
+    ts::hls::PlayList pl2;
+    TSUNIT_ASSERT(pl2.loadText(
+        u"#EXTM3U\n"
+        u"#EXT-X-TARGETDURATION:5\n"
+        u"#EXT-X-MEDIA-SEQUENCE:11\n"
+        u"#EXTINF:5,\n"
+        u"seg-0011.ts\n"
+        u"#EXTINF:5,\n"
+        u"seg-0012.ts\n"
+        u"#EXTINF:5,\n"
+        u"seg-0013.ts\n"
+        u"#EXTINF:5,\n"
+        u"seg-0014.ts\n"
+        u"#EXT-X-ENDLIST\n",
+        true, ts::hls::PlayListType::LIVE, CERR));
+
+    // Segments are consumed from the first playlist in the meantime.
+    TSUNIT_ASSERT(pl.popFirstSegment());
+    TSUNIT_ASSERT(pl.popFirstSegment());
+    TSUNIT_EQUAL(12, pl.mediaSequence());
+
+    ts::hls::PlayList pl3(pl2);
+    TSUNIT_ASSERT(pl.merge(pl3, CERR));
+    TSUNIT_EQUAL(12, pl.mediaSequence());
+    TSUNIT_EQUAL(3, pl.segmentCount());
+    TSUNIT_EQUAL(u"seg-0012.ts", pl.segment(0).relativeURI);
+    TSUNIT_EQUAL(u"seg-0013.ts", pl.segment(1).relativeURI);
+    TSUNIT_EQUAL(u"seg-0014.ts", pl.segment(2).relativeURI);
+    TSUNIT_ASSERT(!pl.isUpdatable());
+
+    // Merging the same content again does not add anything.
+    ts::hls::PlayList pl4(pl2);
+    TSUNIT_ASSERT(!pl.merge(pl4, CERR));
+    TSUNIT_EQUAL(3, pl.segmentCount());
+}
+
+
+//----------------------------------------------------------------------------
+// A minimal HTTP server on the local host, serving a generated HLS media
+// playlist and its media segments.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    constexpr size_t SEGMENT_COUNT = 8;
+    constexpr size_t PACKETS_PER_SEGMENT = 100;
+
+    // Build the packet at some global index in the content. The packet index is stored in the payload.
+    ts::TSPacket MakePacket(size_t index)
+    {
+        ts::TSPacket pkt(ts::NullPacket);
+        pkt.setPID(100);
+        pkt.setCC(uint8_t(index % 16));
+        ts::PutUInt32(pkt.b + 4, uint32_t(index));
+        return pkt;
+    }
+
+    // Server state, shared between all connection threads.
+    class ServerState
+    {
+    public:
+        ts::Mutex mutex {};
+        size_t    requests = 0;
+        size_t    active = 0;
+        size_t    maxActive = 0;
+        std::vector<size_t> completed {};  // Indexes of served segments, in completion order.
+    };
+
+    // One client connection, served in its own thread. The first segments are served
+    // with longer delays than the next ones so that concurrent downloads complete out
+    // of order and must be reassembled by the plugin.
+    class HTTPSession: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(HTTPSession);
+    public:
+        ts::TCPConnection connection {};
+
+        explicit HTTPSession(ServerState& state) : utest::TSUnitThread(), _state(state) {}
+        virtual ~HTTPSession() override { waitForTermination(); }
+
+        virtual void test() override
+        {
+            {
+                ts::GuardMutex lock(_state.mutex);
+                _state.requests++;
+                _state.maxActive = std::max(_state.maxActive, ++_state.active);
+            }
+
+            // Read the request header, up to the empty line.
+            std::string request;
+            char buffer[1024];
+            size_t size = 0;
+            while (request.find("\r\n\r\n") == std::string::npos && connection.receive(buffer, sizeof(buffer), size, nullptr, CERR)) {
+                request.append(buffer, size);
+            }
+            ts::UString path;
+            ts::UStringVector words;
+            ts::UString::FromUTF8(request.substr(0, request.find("\r\n"))).split(words, u' ');
+            if (words.size() >= 2 && words[0] == u"GET") {
+                path = words[1];
+            }
+            CERR.debug(u"HLSTest: HTTP server: GET %s", {path});
+
+            // Build the response content.
+            ts::ByteBlock content;
+            ts::UString type(u"video/mp2t");
+            size_t segment = 0;
+            bool is_segment = false;
+            if (path == u"/playlist.m3u8") {
+                type = u"application/vnd.apple.mpegurl";
+                ts::UString text(u"#EXTM3U\n#EXT-X-VERSION:3\n#EXT-X-TARGETDURATION:1\n#EXT-X-MEDIA-SEQUENCE:0\n");
+                for (size_t i = 0; i < SEGMENT_COUNT; ++i) {
+                    text.format(u"#EXTINF:1.0,\nseg-%04d.ts\n", {i});
+                }
+                text.append(u"#EXT-X-ENDLIST\n");
+                content.appendUTF8(text);
+            }
+            else if (path.scan(u"/seg-%d.ts", {&segment}) && segment < SEGMENT_COUNT) {
+                for (size_t i = 0; i < PACKETS_PER_SEGMENT; ++i) {
+                    const ts::TSPacket pkt(MakePacket(segment * PACKETS_PER_SEGMENT + i));
+                    content.append(pkt.b, ts::PKT_SIZE);
+                }
+                ts::SleepThread(ts::MilliSecond(SEGMENT_COUNT - segment) * 20);
+                is_segment = true;
+            }
+
+            // Send the response and close the connection.
+            const std::string header(content.empty() ?
+                "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n" :
+                ts::UString::Format(u"HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %d\r\nConnection: close\r\n\r\n", {type, content.size()}).toUTF8());
+            connection.send(header.data(), header.size(), CERR);
+            connection.send(content.data(), content.size(), CERR);
+            connection.disconnect(CERR);
+            connection.close(CERR);
+
+            ts::GuardMutex lock(_state.mutex);
+            _state.active--;
+            if (is_segment) {
+                _state.completed.push_back(segment);
+            }
+        }
+
+    private:
+        ServerState& _state;
+    };
+
+    typedef ts::SafePtr<HTTPSession> HTTPSessionPtr;
+
+    // The server thread, accepting client connections.
+    class HTTPServer: public utest::TSUnitThread
+    {
+        TS_NOCOPY(HTTPServer);
+    public:
+        ServerState state {};
+        uint16_t    port = 0;
+
+        HTTPServer() : utest::TSUnitThread()
+        {
+            TSUNIT_ASSERT(ts::IPInitialize());
+            TSUNIT_ASSERT(_server.open(CERR));
+            TSUNIT_ASSERT(_server.reusePort(true, CERR));
+            TSUNIT_ASSERT(_server.bind(ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, ts::IPv4SocketAddress::AnyPort), CERR));
+            TSUNIT_ASSERT(_server.listen(16, CERR));
+            ts::IPv4SocketAddress addr;
+            TSUNIT_ASSERT(_server.getLocalAddress(addr, CERR));
+            port = addr.port();
+        }
+
+        virtual ~HTTPServer() override
+        {
+            // Unlock the server thread with a last dummy connection.
+            _terminate = true;
+            ts::TCPConnection client;
+            if (client.open(CERR) && client.connect(ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, port), CERR)) {
+                client.disconnect(NULLREP);
+            }
+            client.close(NULLREP);
+            waitForTermination();
+            _server.close(CERR);
+        }
+
+        virtual void test() override
+        {
+            std::list<HTTPSessionPtr> sessions;
+            for (;;) {
+                HTTPSessionPtr session(new HTTPSession(state));
+                ts::IPv4SocketAddress client;
+                if (!_server.accept(session->connection, client, CERR) || _terminate) {
+                    break;
+                }
+                session->start();
+                sessions.push_back(session);
+            }
+            // The destructors of the sessions wait for their termination.
+        }
+
+    private:
+        ts::TCPServer _server {};
+        volatile bool _terminate = false;
+    };
+
+    // An event handler for memory output plugin: fill a vector of packets.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        explicit Output(ts::TSPacketVector& output) : _output(output) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            if (data != nullptr) {
+                const size_t count = data->size() / ts::PKT_SIZE;
+                const size_t index = _output.size();
+                _output.resize(index + count);
+                ts::TSPacket::Copy(&_output[index], data->data(), count);
+            }
+        }
+    private:
+        ts::TSPacketVector& _output;
+    };
+}
+
+void HLSTest::runInputPlugin(const ts::UStringVector& options, size_t segmentCount)
+{
+    HTTPServer server;
+    TSUNIT_ASSERT(server.start());
+
+    ts::TSPacketVector packets;
+    Output output(packets);
+
+    ts::TSProcessorArgs opt;
+    opt.input = {u"hls", {ts::UString::Format(u"http://127.0.0.1:%d/playlist.m3u8", {server.port})}};
+    opt.input.args.insert(opt.input.args.end(), options.begin(), options.end());
+    opt.output = {u"memory", {}};
+
+    ts::ReportBuffer<ts::Mutex> log(ts::Severity::Warning);
+    ts::TSProcessor tsp(log);
+    tsp.registerEventHandler(&output, ts::PluginType::OUTPUT);
+    TSUNIT_ASSERT(tsp.start(opt));
+    tsp.waitForTermination();
+    TSUNIT_EQUAL(u"", log.getMessages());
+
+    {
+        ts::GuardMutex lock(server.state.mutex);
+        debug() << "HLSTest: " << ts::UString::Join(options) << ": " << server.state.requests
+                << " HTTP requests, max concurrent: " << server.state.maxActive << std::endl;
+        TSUNIT_EQUAL(segmentCount + 1, server.state.requests);
+        TSUNIT_EQUAL(segmentCount, server.state.completed.size());
+        if (std::find(options.begin(), options.end(), u"--prefetch") != options.end()) {
+            // Segments are downloaded concurrently and complete out of order.
+            TSUNIT_ASSERT(server.state.maxActive > 1);
+            TSUNIT_ASSERT(!std::is_sorted(server.state.completed.begin(), server.state.completed.end()));
+        }
+        else {
+            // Segments are downloaded one by one, in order.
+            TSUNIT_ASSERT(std::is_sorted(server.state.completed.begin(), server.state.completed.end()));
+        }
+    }
+
+    // All packets must be received in order, regardless of the completion order of the downloads.
+    TSUNIT_EQUAL(segmentCount * PACKETS_PER_SEGMENT, packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSUNIT_ASSERT(packets[i] == MakePacket(i));
+    }
+}
+
+void HLSTest::testInputSequential()
+{
+    runInputPlugin({}, SEGMENT_COUNT);
+}
+
+void HLSTest::testInputPrefetch()
+{
+    runInputPlugin({u"--prefetch", u"4"}, SEGMENT_COUNT);
+}
+
+void HLSTest::testInputPrefetchCount()
+{
+    runInputPlugin({u"--prefetch", u"3", u"--segment-count", u"5"}, 5);
+}
@@ -31,11 +31,13 @@ public:
     void testArithmetic();
     void testSysWait();
     void testWait();
+    void testPreciseWait();
 
     TSUNIT_TEST_BEGIN(MonotonicTest);
     TSUNIT_TEST(testArithmetic);
     TSUNIT_TEST(testSysWait);
     TSUNIT_TEST(testWait);
+    TSUNIT_TEST(testPreciseWait);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -132,3 +134,17 @@ void MonotonicTest::testWait()
     TSUNIT_ASSERT(end >= start + 100 - _msPrecision);
     TSUNIT_ASSUME(end < start + 150);
 }
+
+void MonotonicTest::testPreciseWait()
+{
+    ts::Monotonic due;
+    due.getSystemTime();
+    due += 20 * ts::NanoSecPerMilliSec;
+    due.preciseWait(ts::NanoSecPerMilliSec);
+
+    ts::Monotonic end;
+    end.getSystemTime();
+
+    TSUNIT_ASSERT(end >= due);
+    TSUNIT_ASSUME(end - due < 500 * ts::NanoSecPerMicroSec);
+}
@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the multiplexer (tsmux) engine.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMuxer.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsReportBuffer.h"
+#include "tsMonotonic.h"
+#include "tsSysUtils.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MuxerTest: public tsunit::Test
+{
+public:
+    void testInputWakeup();
+
+    TSUNIT_TEST_BEGIN(MuxerTest);
+    TSUNIT_TEST(testInputWakeup);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(MuxerTest);
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory input plugin: send packets one by one, after a delay.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        Input(size_t count, ts::MilliSecond delay);
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        const size_t _count;
+        const ts::MilliSecond _delay;
+        size_t _sent;
+    };
+
+    Input::Input(size_t count, ts::MilliSecond delay) :
+        _count(count),
+        _delay(delay),
+        _sent(0)
+    {
+    }
+
+    void Input::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr && _sent <= _count) {
+            // Let the multiplexer become idle before each packet and before the end of input.
+            // Packets which are still buffered in the output plugin when the input ends are dropped.
+            ts::SleepThread(_delay);
+            if (_sent < _count) {
+                ts::TSPacket pkt;
+                pkt.init(100, uint8_t(_sent & 0x0F), uint8_t(_sent));
+                data->append(pkt.b, ts::PKT_SIZE);
+            }
+            _sent++;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory output plugin: fill a vector of packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& output);
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        ts::TSPacketVector& _output;
+    };
+
+    Output::Output(ts::TSPacketVector& output) :
+        _output(output)
+    {
+    }
+
+    void Output::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const size_t packets_count = data->size() / ts::PKT_SIZE;
+            const size_t index = _output.size();
+            _output.resize(index + packets_count);
+            ts::TSPacket::Copy(&_output[index], data->data(), packets_count);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// The input is idle most of the time. The core waits for input packets with a
+// very long cadence and must be woken up by the input thread for each packet
+// and at the end of input.
+void MuxerTest::testInputWakeup()
+{
+    static constexpr size_t PACKET_COUNT = 10;
+    static constexpr ts::MilliSecond INPUT_DELAY = 20;
+    static constexpr ts::MicroSecond CADENCE = 10 * ts::MicroSecPerSec;
+
+    ts::ReportBuffer<ts::Mutex> log;
+    ts::TSPacketVector output_packets;
+    Input input(PACKET_COUNT, INPUT_DELAY);
+    Output output(output_packets);
+
+    ts::MuxerArgs opt;
+    opt.inputs.push_back(ts::PluginOptions(u"memory"));
+    opt.output.set(u"memory");
+    opt.outputBitRate = 1000000;
+    opt.inputOnce = true;
+    opt.outputOnce = true;
+    opt.cadence = CADENCE;
+
+    ts::Muxer mux(log);
+    mux.registerEventHandler(&input, ts::PluginType::INPUT);
+    mux.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+    const ts::Monotonic start(true);
+    TSUNIT_ASSERT(mux.start(opt));
+    mux.waitForTermination();
+    const ts::Monotonic end(true);
+
+    // Without wake-up by the input thread, each input packet would wait for the cadence.
+    TSUNIT_ASSERT(end - start < CADENCE * ts::NanoSecPerMicroSec);
+
+    // All input packets are output, in order.
+    size_t count = 0;
+    for (const auto& pkt : output_packets) {
+        if (pkt.getPID() == 100) {
+            TSUNIT_EQUAL(uint8_t(count), pkt.b[4]);
+            count++;
+        }
+    }
+    TSUNIT_EQUAL(PACKET_COUNT, count);
+    TSUNIT_ASSERT(log.emptyMessages());
+}
@@ -22,7 +22,9 @@
 #include "tsDVBAC3Descriptor.h"
 #include "tsComponentDescriptor.h"
 #include "tsPES.h"
+#include "tsConfigurationCache.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -78,6 +80,8 @@ public:
     void testIP();
     void testExtension();
     void testInheritance();
+    void testCache();
+    void testCacheStartup();
 
     TSUNIT_TEST_BEGIN(NamesTest);
     TSUNIT_TEST(testConfigFile);
@@ -121,6 +125,8 @@ public:
     TSUNIT_TEST(testIP);
     TSUNIT_TEST(testExtension);
     TSUNIT_TEST(testInheritance);
+    TSUNIT_TEST(testCache);
+    TSUNIT_TEST(testCacheStartup);
     TSUNIT_TEST_END();
 
 private:
@@ -147,12 +153,14 @@ void NamesTest::beforeTest()
         _tempFileName = ts::TempFile(u".names");
     }
     ts::DeleteFile(_tempFileName, NULLREP);
+    ts::DeleteFile(ts::ConfigurationCache::CacheFileName(_tempFileName), NULLREP);
 }
 
 // Test suite cleanup method.
 void NamesTest::afterTest()
 {
     ts::DeleteFile(_tempFileName, NULLREP);
+    ts::DeleteFile(ts::ConfigurationCache::CacheFileName(_tempFileName), NULLREP);
 }
 
 
@@ -529,3 +537,106 @@ void NamesTest::testInheritance()
     TSUNIT_EQUAL(u"value1", file.nameFromSection(u"level1", 1));
     TSUNIT_EQUAL(u"unknown (0x00)", file.nameFromSection(u"level1", 0));
 }
+
+void NamesTest::testCache()
+{
+    // Create a temporary names file.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringVector({
+        u"[level1]",
+        u"Bits = 8",
+        u"1 = value1",
+        u"0x10-0x1F = range1",
+        u"[Level2]",
+        u"Bits = 16",
+        u"Inherit = level1",
+        u"2 = value2",
+        u"0x0100 = \u00E9t\u00E9",
+        u"[empty]",
+    }), _tempFileName));
+
+    // Create the cache.
+    const ts::UString cacheName(ts::ConfigurationCache::CacheFileName(_tempFileName));
+    {
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(!file.isCached());
+        TSUNIT_ASSERT(file.saveCache(NULLREP));
+        TSUNIT_ASSERT(ts::FileExists(cacheName));
+    }
+
+    // Reload from the cache, same names are expected.
+    {
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(file.isCached());
+        TSUNIT_EQUAL(0, file.errorCount());
+        TSUNIT_ASSERT(file.nameExists(u"level2", 2));
+        TSUNIT_ASSERT(file.nameExists(u"LEVEL2", 1));
+        TSUNIT_ASSERT(!file.nameExists(u"level1", 2));
+        TSUNIT_ASSERT(!file.nameExists(u"empty", 0));
+        TSUNIT_ASSERT(!file.nameExists(u"nosection", 1));
+        TSUNIT_EQUAL(u"value1", file.nameFromSection(u"level1", 1));
+        TSUNIT_EQUAL(u"range1", file.nameFromSection(u"level1", 0x10));
+        TSUNIT_EQUAL(u"range1", file.nameFromSection(u"level1", 0x17));
+        TSUNIT_EQUAL(u"range1", file.nameFromSection(u"level1", 0x1F));
+        TSUNIT_EQUAL(u"unknown (0x20)", file.nameFromSection(u"level1", 0x20));
+        TSUNIT_EQUAL(u"unknown (0x0F)", file.nameFromSection(u"level1", 0x0F));
+        TSUNIT_EQUAL(u"value2", file.nameFromSection(u"level2", 2));
+        TSUNIT_EQUAL(u"range1", file.nameFromSection(u"level2", 0x12));
+        TSUNIT_EQUAL(u"\u00E9t\u00E9", file.nameFromSection(u"level2", 0x100));
+        TSUNIT_EQUAL(u"unknown (0x03)", file.nameFromSection(u"level2", 3));
+        TSUNIT_EQUAL(u"unknown (0x0000000000000003)", file.nameFromSection(u"nosection", 3));
+        TSUNIT_EQUAL(u"value1", file.nameFromSectionWithFallback(u"level2", 3, 1));
+    }
+
+    // Modify the text file, the cache is no longer used.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringVector({u"[level1]", u"Bits = 8", u"1 = other1"}), _tempFileName));
+    {
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(!file.isCached());
+        TSUNIT_EQUAL(u"other1", file.nameFromSection(u"level1", 1));
+        TSUNIT_ASSERT(!file.nameExists(u"level2", 2));
+    }
+}
+
+void NamesTest::testCacheStartup()
+{
+    // Work on a copy of the DTV names file to compare the startup time with and without cache.
+    const ts::NamesFile* const dtv = ts::NamesFile::Instance(ts::NamesFile::Predefined::DTV);
+    ts::UStringList lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, dtv->configurationFile()));
+    TSUNIT_ASSERT(ts::UString::Save(lines, _tempFileName));
+
+    // Load the text file.
+    utest::TSUnitBenchmark text_bench(u"TSUNIT_NAMES_ITERATIONS");
+    text_bench.start();
+    for (size_t iter = 0; iter < text_bench.iterations; ++iter) {
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(!file.isCached());
+    }
+    text_bench.stop();
+    text_bench.report(u"NamesTest::testCacheStartup (text)");
+
+    // Create the cache.
+    ts::NamesFile text(_tempFileName);
+    TSUNIT_ASSERT(text.saveCache(NULLREP));
+
+    // Load the cache.
+    utest::TSUnitBenchmark cache_bench(u"TSUNIT_NAMES_ITERATIONS");
+    cache_bench.start();
+    for (size_t iter = 0; iter < cache_bench.iterations; ++iter) {
+        ts::NamesFile file(_tempFileName);
+        TSUNIT_ASSERT(file.isCached());
+    }
+    cache_bench.stop();
+    cache_bench.report(u"NamesTest::testCacheStartup (cache)");
+
+    // Same names in text and cache.
+    ts::NamesFile cache(_tempFileName);
+    TSUNIT_ASSERT(cache.isCached());
+    for (ts::NamesFile::Value value = 0; value < 0x100; ++value) {
+        TSUNIT_EQUAL(text.nameFromSection(u"TableId", value), cache.nameFromSection(u"TableId", value));
+        TSUNIT_EQUAL(text.nameFromSection(u"DescriptorId", value), cache.nameFromSection(u"DescriptorId", value));
+    }
+    for (ts::NamesFile::Value value = 0; value < 0x10000; value += 7) {
+        TSUNIT_EQUAL(text.nameFromSection(u"CASystemId", value), cache.nameFromSection(u"CASystemId", value));
+    }
+}
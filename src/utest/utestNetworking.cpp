@@ -49,6 +49,7 @@ public:
     void testIPv6SocketAddress();
     void testTCPSocket();
     void testUDPSocket();
+    void testUDPSocketBatch();
     void testIPHeader();
     void testIPProtocol();
     void testTCPPacket();
@@ -65,6 +66,7 @@ public:
     TSUNIT_TEST(testIPv6SocketAddress);
     TSUNIT_TEST(testTCPSocket);
     TSUNIT_TEST(testUDPSocket);
+    TSUNIT_TEST(testUDPSocketBatch);
     TSUNIT_TEST(testIPHeader);
     TSUNIT_TEST(testIPProtocol);
     TSUNIT_TEST(testTCPPacket);
@@ -725,6 +727,62 @@ void NetworkingTest::testUDPSocket()
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+void NetworkingTest::testUDPSocketBatch()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12346;
+    const ts::IPv4SocketAddress serverAddress(ts::IPv4Address::LocalHost, portNumber);
+
+    // Create server socket.
+    ts::UDPSocket server(true);
+    TSUNIT_ASSERT(server.isOpen());
+    TSUNIT_ASSERT(server.reusePort(true, CERR));
+    TSUNIT_ASSERT(server.setReceiveTimestamps(true, CERR));
+    TSUNIT_ASSERT(server.bind(serverAddress, CERR));
+
+    // Create client socket.
+    ts::UDPSocket client(true);
+    TSUNIT_ASSERT(client.isOpen());
+    TSUNIT_ASSERT(client.bind(ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, ts::IPv4SocketAddress::AnyPort), CERR));
+    TSUNIT_ASSERT(client.setDefaultDestination(serverAddress, CERR));
+
+    // Send a batch of messages with distinct sizes and contents.
+    constexpr size_t count = 5;
+    uint8_t out[count][100];
+    ts::UDPSocket::Message out_msgs[count];
+    for (size_t i = 0; i < count; ++i) {
+        ::memset(out[i], int(i + 1), sizeof(out[i]));
+        out_msgs[i].data = out[i];
+        out_msgs[i].size = 10 * (i + 1);
+    }
+    TSUNIT_ASSERT(client.send(out_msgs, count, CERR));
+
+    // Receive all messages, possibly in several batches.
+    uint8_t in[count][200];
+    ts::UDPSocket::Message in_msgs[count];
+    size_t received = 0;
+    while (received < count) {
+        for (size_t i = received; i < count; ++i) {
+            in_msgs[i].data = in[i];
+            in_msgs[i].max_size = sizeof(in[i]);
+        }
+        size_t ret_count = 0;
+        TSUNIT_ASSERT(server.receive(in_msgs + received, count - received, ret_count, nullptr, CERR));
+        TSUNIT_ASSERT(ret_count > 0);
+        TSUNIT_ASSERT(received + ret_count <= count);
+        received += ret_count;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        debug() << "NetworkingTest::testUDPSocketBatch: message " << i << ", size: " << in_msgs[i].size
+                << ", sender: " << in_msgs[i].sender << ", destination: " << in_msgs[i].destination
+                << ", timestamp: " << in_msgs[i].timestamp << std::endl;
+        TSUNIT_EQUAL(10 * (i + 1), in_msgs[i].size);
+        TSUNIT_EQUAL(0, ::memcmp(in[i], out[i], in_msgs[i].size));
+        TSUNIT_ASSERT(ts::IPv4Address(in_msgs[i].sender) == ts::IPv4Address::LocalHost);
+    }
+}
+
 void NetworkingTest::testIPHeader()
 {
     static const uint8_t reference_header[] = {
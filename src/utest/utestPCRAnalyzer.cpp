@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PCRAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsPCRAnalyzer.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PCRAnalyzerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testBitrate();
+    void testWrapUp();
+
+    TSUNIT_TEST_BEGIN(PCRAnalyzerTest);
+    TSUNIT_TEST(testBitrate);
+    TSUNIT_TEST(testWrapUp);
+    TSUNIT_TEST_END();
+
+private:
+    // Build a constant bitrate TS with two PCR PID's, starting at the specified PCR.
+    static void BuildStream(ts::TSPacketVector& packets, size_t count, const ts::BitRate& bitrate, uint64_t first_pcr);
+};
+
+TSUNIT_REGISTER(PCRAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void PCRAnalyzerTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void PCRAnalyzerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Build a constant bitrate TS.
+//----------------------------------------------------------------------------
+
+void PCRAnalyzerTest::BuildStream(ts::TSPacketVector& packets, size_t count, const ts::BitRate& bitrate, uint64_t first_pcr)
+{
+    // PID 100: video with PCR every 20 packets, PID 101: audio, PID 200: other service with PCR every 37 packets.
+    uint8_t cc[3] = {0, 0, 0};
+    packets.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        ts::TSPacket& pkt(packets[i]);
+        const uint64_t pcr = (first_pcr + (ts::SYSTEM_CLOCK_FREQ * ts::PKT_SIZE_BITS * i) / bitrate.toInt()) % ts::PCR_SCALE;
+        if (i % 37 == 5) {
+            pkt.init(200, cc[2]++ & ts::CC_MASK);
+            pkt.setPCR(pcr, true);
+        }
+        else if (i % 4 == 3) {
+            pkt.init(101, cc[1]++ & ts::CC_MASK);
+        }
+        else if (i % 5 == 4) {
+            pkt.init(ts::PID_NULL);
+        }
+        else {
+            pkt.init(100, cc[0]++ & ts::CC_MASK);
+            if (i % 20 == 0) {
+                pkt.setPCR(pcr, true);
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void PCRAnalyzerTest::testBitrate()
+{
+    // About 10 seconds of a 20 Mb/s stream.
+    static const ts::BitRate bitrate = 20000000;
+    ts::TSPacketVector packets;
+    BuildStream(packets, 133000, bitrate, 12345678);
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_PCRANALYZER_ITERATIONS");
+    ts::PCRAnalyzer zer(1, 16);
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        zer.reset();
+        for (const auto& pkt : packets) {
+            zer.feedPacket(pkt);
+        }
+    }
+    bench.stop();
+    bench.report(u"PCRAnalyzerTest::testBitrate");
+
+    const ts::PCRAnalyzer::Status status(zer);
+    debug() << "PCRAnalyzerTest::testBitrate: " << status << std::endl;
+    TSUNIT_ASSERT(status.bitrate_valid);
+    TSUNIT_EQUAL(packets.size(), status.packet_count);
+    TSUNIT_EQUAL(2, status.pcr_pids);
+    TSUNIT_EQUAL(0, status.discontinuities);
+    TSUNIT_ASSERT(std::abs(status.bitrate_188.toInt() - bitrate.toInt()) < 1000);
+    TSUNIT_ASSERT(std::abs(status.instantaneous_bitrate_188.toInt() - bitrate.toInt()) < 1000);
+    // PID 101 has one packet out of 4, minus some packets which were stolen by PID 200.
+    const ts::PacketCounter count_101 = zer.packetCount(101);
+    TSUNIT_ASSERT(count_101 > packets.size() / 5);
+    TSUNIT_ASSERT(count_101 <= packets.size() / 4);
+    TSUNIT_ASSERT(std::abs(zer.bitrate188(101).toInt() - int64_t((bitrate.toInt() * count_101) / packets.size())) < 1000);
+    TSUNIT_EQUAL(0, zer.packetCount(102));
+    TSUNIT_ASSERT(zer.bitrate188(102) == 0);
+}
+
+void PCRAnalyzerTest::testWrapUp()
+{
+    // About 3 seconds of a 5 Mb/s stream, PCR wrapping up after 1 second.
+    static const ts::BitRate bitrate = 5000000;
+    ts::TSPacketVector packets;
+    BuildStream(packets, 10000, bitrate, ts::PCR_SCALE - ts::SYSTEM_CLOCK_FREQ);
+
+    ts::PCRAnalyzer zer(1, 16);
+    size_t count = 0;
+    for (const auto& pkt : packets) {
+        zer.feedPacket(pkt);
+        // Check instantaneous bitrate at each PCR once the first second is passed, including across the wrap up.
+        if (++count > 4000 && pkt.getPID() == 100 && pkt.hasPCR()) {
+            TSUNIT_ASSERT(std::abs(zer.instantaneousBitrate188().toInt() - bitrate.toInt()) < 1000);
+        }
+    }
+    TSUNIT_ASSERT(zer.bitrateIsValid());
+    TSUNIT_ASSERT(std::abs(zer.bitrate188().toInt() - bitrate.toInt()) < 1000);
+}
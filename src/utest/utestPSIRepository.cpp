@@ -14,6 +14,9 @@
 #include "tsAbstractTable.h"
 #include "tsMGT.h"
 #include "tsLDT.h"
+#include "tsCADescriptor.h"
+#include "tsApplicationDescriptor.h"
+#include "tsNames.h"
 #include "tsunit.h"
 
 
@@ -29,10 +32,14 @@ public:
 
     void testRegistrations();
     void testSharedTID();
+    void testTableIds();
+    void testDescriptors();
 
     TSUNIT_TEST_BEGIN(PSIRepositoryTest);
     TSUNIT_TEST(testRegistrations);
     TSUNIT_TEST(testSharedTID);
+    TSUNIT_TEST(testTableIds);
+    TSUNIT_TEST(testDescriptors);
     TSUNIT_TEST_END();
 };
 
@@ -118,3 +125,44 @@ void PSIRepositoryTest::testSharedTID()
     TSUNIT_ASSERT(ts::MGT::DisplaySection == ts::PSIRepository::Instance()->getSectionDisplay(ts::TID_LDT, ts::Standards::NONE, ts::PID_PSIP));
     TSUNIT_ASSERT(ts::LDT::DisplaySection == ts::PSIRepository::Instance()->getSectionDisplay(ts::TID_LDT, ts::Standards::NONE, ts::PID_LDT));
 }
+
+void PSIRepositoryTest::testTableIds()
+{
+    std::vector<ts::TID> ids;
+    ts::PSIRepository::Instance()->getRegisteredTableIds(ids);
+    debug() << "PSIRepositoryTest::testTableIds: " << ids.size() << " table ids" << std::endl;
+
+    TSUNIT_ASSERT(!ids.empty());
+    TSUNIT_ASSERT(std::find(ids.begin(), ids.end(), ts::TID_PAT) != ids.end());
+    TSUNIT_ASSERT(std::find(ids.begin(), ids.end(), ts::TID_PMT) != ids.end());
+    TSUNIT_ASSERT(std::find(ids.begin(), ids.end(), ts::TID_MGT) != ids.end());
+    TSUNIT_ASSERT(std::find(ids.begin(), ids.end(), ts::TID_NULL) == ids.end());
+
+    // Table ids are returned once, in increasing order.
+    for (size_t i = 1; i < ids.size(); ++i) {
+        TSUNIT_ASSERT(ids[i-1] < ids[i]);
+    }
+
+    // Unknown table id.
+    TSUNIT_EQUAL(ts::Standards::NONE, ts::PSIRepository::Instance()->getTableStandards(ts::TID_NULL));
+    TSUNIT_ASSERT(ts::PSIRepository::Instance()->getTableFactory(ts::TID_NULL, ts::Standards::NONE) == nullptr);
+}
+
+void PSIRepositoryTest::testDescriptors()
+{
+    const ts::PSIRepository* const repo = ts::PSIRepository::Instance();
+
+    // Standard descriptor, in any table.
+    TSUNIT_ASSERT(repo->getDescriptorDisplay(ts::EDID::Standard(ts::DID_CA)) == ts::CADescriptor::DisplayDescriptor);
+    TSUNIT_ASSERT(repo->getDescriptorDisplay(ts::EDID::Standard(ts::DID_CA), ts::TID_PMT) == ts::CADescriptor::DisplayDescriptor);
+    TSUNIT_ASSERT(repo->getDescriptorFactory(ts::EDID::Standard(ts::DID_CA), ts::TID_CAT) != nullptr);
+
+    // Table-specific descriptor.
+    TSUNIT_ASSERT(repo->hasTableSpecificName(ts::DID_AIT_APPLICATION, ts::TID_AIT));
+    TSUNIT_ASSERT(!repo->hasTableSpecificName(ts::DID_CA, ts::TID_PMT));
+    TSUNIT_EQUAL(ts::names::HasTableSpecificName(ts::DID_CA, ts::TID_AIT), repo->hasTableSpecificName(ts::DID_CA, ts::TID_AIT));
+    TSUNIT_ASSERT(!repo->hasTableSpecificName(ts::DID_AIT_APPLICATION, ts::TID_NULL));
+    TSUNIT_ASSERT(repo->getDescriptorDisplay(ts::EDID::Standard(ts::DID_AIT_APPLICATION), ts::TID_AIT) == ts::ApplicationDescriptor::DisplayDescriptor);
+    TSUNIT_ASSERT(repo->getDescriptorDisplay(ts::EDID::TableSpecific(ts::DID_AIT_APPLICATION, ts::TID_AIT)) == ts::ApplicationDescriptor::DisplayDescriptor);
+    TSUNIT_ASSERT(repo->getDescriptorDisplay(ts::EDID::Standard(ts::DID_AIT_APPLICATION), ts::TID_PMT) == nullptr);
+}
@@ -0,0 +1,336 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for pcap and pcap-ng files.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPcapFile.h"
+#include "tsIPv4Packet.h"
+#include "tsByteBlock.h"
+#include "tsFileUtils.h"
+#include "tsNullReport.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PcapTest: public tsunit::Test
+{
+public:
+    PcapTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testSharedPacket();
+    void testPcap();
+    void testPcapNg();
+    void testTruncated();
+    void testZeroCopy();
+
+    TSUNIT_TEST_BEGIN(PcapTest);
+    TSUNIT_TEST(testSharedPacket);
+    TSUNIT_TEST(testPcap);
+    TSUNIT_TEST(testPcapNg);
+    TSUNIT_TEST(testTruncated);
+    TSUNIT_TEST(testZeroCopy);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempFileName;
+
+    // Build sample files with synthetic Ethernet/IPv4/UDP frames.
+    static ts::ByteBlock MakeDatagram(size_t index);
+    static ts::ByteBlock MakeFrame(size_t index);
+    static ts::ByteBlock MakePcap(size_t count);
+    static ts::ByteBlock MakePcapNg(size_t count);
+
+    // Read all IPv4 packets in a file and check their content.
+    void checkFile(const ts::ByteBlock& content, size_t expected_count, bool zero_copy);
+};
+
+TSUNIT_REGISTER(PcapTest);
+
+// Number of frames in sample files.
+#define FRAME_COUNT 10
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+PcapTest::PcapTest() :
+    _tempFileName()
+{
+}
+
+// Test suite initialization method.
+void PcapTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".pcap");
+    }
+    ts::DeleteFile(_tempFileName, NULLREP);
+}
+
+// Test suite cleanup method.
+void PcapTest::afterTest()
+{
+    ts::DeleteFile(_tempFileName, NULLREP);
+}
+
+
+//----------------------------------------------------------------------------
+// Build sample data.
+//----------------------------------------------------------------------------
+
+// IPv4/UDP datagram from 10.0.0.1:(1000+index) to 239.1.1.1:1234, with a payload size of 100+index bytes.
+ts::ByteBlock PcapTest::MakeDatagram(size_t index)
+{
+    const size_t payload_size = 100 + index;
+    ts::ByteBlock ip;
+    ip.appendUInt8(0x45);                          // IPv4, 20-byte header
+    ip.appendUInt8(0x00);                          // type of service
+    ip.appendUInt16BE(uint16_t(28 + payload_size)); // total length
+    ip.appendUInt16BE(uint16_t(index));            // identification
+    ip.appendUInt16BE(0x4000);                     // don't fragment
+    ip.appendUInt8(64);                            // TTL
+    ip.appendUInt8(ts::IPv4_PROTO_UDP);
+    ip.appendUInt16BE(0x0000);                     // checksum, updated later
+    ip.appendUInt32BE(0x0A000001);                 // source address
+    ip.appendUInt32BE(0xEF010101);                 // destination address
+    ip.appendUInt16BE(uint16_t(1000 + index));     // UDP source port
+    ip.appendUInt16BE(1234);                       // UDP destination port
+    ip.appendUInt16BE(uint16_t(8 + payload_size)); // UDP length
+    ip.appendUInt16BE(0x0000);                     // no UDP checksum
+    ip.append(uint8_t(index), payload_size);
+    ts::IPv4Packet::UpdateIPHeaderChecksum(ip.data(), ip.size());
+    return ip;
+}
+
+// Ethernet frame containing the IPv4 datagram.
+ts::ByteBlock PcapTest::MakeFrame(size_t index)
+{
+    ts::ByteBlock frame;
+    frame.append(0x11, 6);     // destination MAC
+    frame.append(0x22, 6);     // source MAC
+    frame.appendUInt16BE(ts::ETHERTYPE_IPv4);
+    frame.append(MakeDatagram(index));
+    return frame;
+}
+
+// Classic pcap file, big endian, microsecond timestamps, Ethernet link type.
+ts::ByteBlock PcapTest::MakePcap(size_t count)
+{
+    ts::ByteBlock file;
+    file.appendUInt32BE(ts::PCAP_MAGIC_BE);
+    file.appendUInt16BE(2);           // major version
+    file.appendUInt16BE(4);           // minor version
+    file.appendUInt32BE(0);           // reserved
+    file.appendUInt32BE(0);           // reserved
+    file.appendUInt32BE(65535);       // snap length
+    file.appendUInt32BE(ts::LINKTYPE_ETHERNET);
+    for (size_t i = 0; i < count; ++i) {
+        const ts::ByteBlock frame(MakeFrame(i));
+        file.appendUInt32BE(uint32_t(i));          // timestamp, seconds
+        file.appendUInt32BE(uint32_t(1000 * i));   // timestamp, microseconds
+        file.appendUInt32BE(uint32_t(frame.size())); // captured size
+        file.appendUInt32BE(uint32_t(frame.size())); // original size
+        file.append(frame);
+    }
+    return file;
+}
+
+// Pcap-ng file, little endian, one interface with default microsecond timestamps.
+ts::ByteBlock PcapTest::MakePcapNg(size_t count)
+{
+    ts::ByteBlock file;
+    // Section header block.
+    file.appendUInt32LE(ts::PCAPNG_SECTION_HEADER);
+    file.appendUInt32LE(28);
+    file.appendUInt32LE(ts::PCAPNG_ORDER_BE);  // byte-order magic, little endian
+    file.appendUInt16LE(1);                    // major version
+    file.appendUInt16LE(0);                    // minor version
+    file.appendUInt64LE(0xFFFFFFFFFFFFFFFF);   // unspecified section length
+    file.appendUInt32LE(28);
+    // Interface description block.
+    file.appendUInt32LE(ts::PCAPNG_INTERFACE_DESC);
+    file.appendUInt32LE(20);
+    file.appendUInt16LE(ts::LINKTYPE_ETHERNET);
+    file.appendUInt16LE(0);                    // reserved
+    file.appendUInt32LE(65535);                // snap length
+    file.appendUInt32LE(20);
+    // Enhanced packet blocks.
+    for (size_t i = 0; i < count; ++i) {
+        const ts::ByteBlock frame(MakeFrame(i));
+        const size_t padding = (4 - frame.size() % 4) % 4;
+        const uint32_t size = uint32_t(32 + frame.size() + padding);
+        const uint64_t timestamp = uint64_t(1000000 * i + 1000 * i);
+        file.appendUInt32LE(ts::PCAPNG_ENHANCED_PACKET);
+        file.appendUInt32LE(size);
+        file.appendUInt32LE(0);                // interface id
+        file.appendUInt32LE(uint32_t(timestamp >> 32));
+        file.appendUInt32LE(uint32_t(timestamp));
+        file.appendUInt32LE(uint32_t(frame.size())); // captured size
+        file.appendUInt32LE(uint32_t(frame.size())); // original size
+        file.append(frame);
+        file.append(uint8_t(0), padding);
+        file.appendUInt32LE(size);
+    }
+    return file;
+}
+
+
+//----------------------------------------------------------------------------
+// Read all IPv4 packets in a file and check their content.
+//----------------------------------------------------------------------------
+
+void PcapTest::checkFile(const ts::ByteBlock& content, size_t expected_count, bool zero_copy)
+{
+    TSUNIT_ASSERT(content.saveToFile(_tempFileName, &CERR));
+
+    ts::PcapFile file;
+    file.setZeroCopy(zero_copy);
+    TSUNIT_ASSERT(file.open(_tempFileName, CERR));
+    TSUNIT_ASSERT(file.isOpen());
+    TSUNIT_ASSERT(file.isMemoryMapped());
+    TSUNIT_EQUAL(zero_copy, file.zeroCopy());
+
+    ts::IPv4Packet ip;
+    ts::MicroSecond timestamp = -1;
+    size_t count = 0;
+    while (file.readIPv4(ip, timestamp, NULLREP)) {
+        const ts::ByteBlock ref(MakeDatagram(count));
+        TSUNIT_ASSERT(ip.isValid());
+        TSUNIT_ASSERT(ip.isUDP());
+        TSUNIT_EQUAL(ref.size(), ip.size());
+        TSUNIT_EQUAL(0, ::memcmp(ref.data(), ip.data(), ref.size()));
+        TSUNIT_EQUAL(ts::UString::Format(u"10.0.0.1:%d", {1000 + count}), ip.sourceSocketAddress().toString());
+        TSUNIT_EQUAL(u"239.1.1.1:1234", ip.destinationSocketAddress().toString());
+        TSUNIT_EQUAL(100 + count, ip.protocolDataSize());
+        TSUNIT_EQUAL(ts::MicroSecond(1001000 * count), timestamp);
+        count++;
+    }
+
+    TSUNIT_EQUAL(expected_count, count);
+    TSUNIT_EQUAL(expected_count, file.ipv4PacketCount());
+    TSUNIT_ASSERT(file.endOfFile());
+    TSUNIT_EQUAL(0, file.firstTimestamp());
+    TSUNIT_EQUAL(ts::MicroSecond(1001000 * (expected_count - 1)), file.lastTimestamp());
+    file.close();
+    TSUNIT_ASSERT(!file.isOpen());
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void PcapTest::testSharedPacket()
+{
+    const ts::ByteBlock data(MakeDatagram(3));
+
+    ts::IPv4Packet copied(data.data(), data.size(), ts::ShareMode::COPY);
+    TSUNIT_ASSERT(copied.isValid());
+    TSUNIT_EQUAL(data.size(), copied.size());
+    TSUNIT_ASSERT(copied.data() != data.data());
+    TSUNIT_EQUAL(0, ::memcmp(data.data(), copied.data(), data.size()));
+
+    // A copy of a copied packet has its own data.
+    ts::IPv4Packet copied2(copied);
+    TSUNIT_ASSERT(copied2.data() != copied.data());
+    TSUNIT_EQUAL(0, ::memcmp(data.data(), copied2.data(), data.size()));
+
+    ts::IPv4Packet shared(data.data(), data.size(), ts::ShareMode::SHARE);
+    TSUNIT_ASSERT(shared.isValid());
+    TSUNIT_EQUAL(data.size(), shared.size());
+    TSUNIT_EQUAL(data.data(), shared.data());
+    TSUNIT_EQUAL(data.data() + 28, shared.protocolData());
+    TSUNIT_EQUAL(103, shared.protocolDataSize());
+    TSUNIT_EQUAL(u"10.0.0.1:1003", shared.sourceSocketAddress().toString());
+
+    // A copy of a shared packet references the same data, a reset in copy mode does not.
+    ts::IPv4Packet other(shared);
+    TSUNIT_EQUAL(data.data(), other.data());
+    TSUNIT_ASSERT(other.reset(data.data(), data.size(), ts::ShareMode::COPY));
+    TSUNIT_ASSERT(other.data() != data.data());
+    TSUNIT_EQUAL(0, ::memcmp(data.data(), other.data(), data.size()));
+}
+
+void PcapTest::testPcap()
+{
+    checkFile(MakePcap(FRAME_COUNT), FRAME_COUNT, false);
+}
+
+void PcapTest::testPcapNg()
+{
+    checkFile(MakePcapNg(FRAME_COUNT), FRAME_COUNT, false);
+}
+
+void PcapTest::testTruncated()
+{
+    // Cut the last frame in the middle. The previous frames are read, then end of file.
+    ts::ByteBlock pcap(MakePcap(FRAME_COUNT));
+    pcap.resize(pcap.size() - MakeFrame(FRAME_COUNT - 1).size() / 2);
+    checkFile(pcap, FRAME_COUNT - 1, false);
+
+    ts::ByteBlock pcapng(MakePcapNg(FRAME_COUNT));
+    pcapng.resize(pcapng.size() - MakeFrame(FRAME_COUNT - 1).size() / 2);
+    checkFile(pcapng, FRAME_COUNT - 1, true);
+
+    // Cut in the middle of the global header.
+    ts::ByteBlock header(MakePcap(FRAME_COUNT));
+    header.resize(12);
+    TSUNIT_ASSERT(header.saveToFile(_tempFileName, &CERR));
+    ts::PcapFile file;
+    TSUNIT_ASSERT(!file.open(_tempFileName, NULLREP));
+    TSUNIT_ASSERT(!file.isOpen());
+}
+
+void PcapTest::testZeroCopy()
+{
+    // Same content as in copy mode.
+    checkFile(MakePcap(FRAME_COUNT), FRAME_COUNT, true);
+    checkFile(MakePcapNg(FRAME_COUNT), FRAME_COUNT, true);
+
+    // In zero-copy mode, the returned packets point into the file mapping:
+    // two consecutive packets are exactly one capture record apart.
+    TSUNIT_ASSERT(MakePcap(FRAME_COUNT).saveToFile(_tempFileName, &CERR));
+    ts::PcapFile file;
+    file.setZeroCopy(true);
+    TSUNIT_ASSERT(file.open(_tempFileName, CERR));
+    TSUNIT_ASSERT(file.isMemoryMapped());
+
+    ts::IPv4Packet ip;
+    ts::MicroSecond timestamp = -1;
+    const uint8_t* previous = nullptr;
+    for (size_t i = 0; i < FRAME_COUNT; ++i) {
+        TSUNIT_ASSERT(file.readIPv4(ip, timestamp, CERR));
+        if (previous != nullptr) {
+            // Record header (16 bytes) + previous Ethernet frame.
+            TSUNIT_EQUAL(16 + MakeFrame(i - 1).size(), size_t(ip.data() - previous));
+        }
+        previous = ip.data();
+    }
+    file.close();
+
+    // In copy mode, the packets do not reference the mapping and remain valid after the file is closed.
+    file.setZeroCopy(false);
+    TSUNIT_ASSERT(file.open(_tempFileName, CERR));
+    TSUNIT_ASSERT(file.readIPv4(ip, timestamp, CERR));
+    file.close();
+    const ts::ByteBlock ref(MakeDatagram(0));
+    TSUNIT_ASSERT(ip.isValid());
+    TSUNIT_EQUAL(ref.size(), ip.size());
+    TSUNIT_EQUAL(0, ::memcmp(ref.data(), ip.data(), ref.size()));
+}
@@ -13,6 +13,8 @@
 #include "tsPluginRepository.h"
 #include "tsNullReport.h"
 #include "tsCerrReport.h"
+#include "tsFileUtils.h"
+#include "tsSysUtils.h"
 #include "tsunit.h"
 
 
@@ -29,11 +31,13 @@ public:
     void testRegistrations();
     void testEmbedded();
     void testLoaded();
+    void testIndex();
 
     TSUNIT_TEST_BEGIN(PluginRepositoryTest);
     TSUNIT_TEST(testRegistrations);
     TSUNIT_TEST(testEmbedded);
     TSUNIT_TEST(testLoaded);
+    TSUNIT_TEST(testIndex);
     TSUNIT_TEST_END();
 };
 
@@ -111,3 +115,30 @@ void PluginRepositoryTest::testLoaded()
     TSUNIT_ASSERT(repo->getOutput(u"merge", report) == nullptr);
     TSUNIT_ASSERT(repo->getProcessor(u"merge", report) != nullptr);
 }
+
+void PluginRepositoryTest::testIndex()
+{
+#if defined(TSDUCK_STATIC)
+    // Plugins are not shared libraries in a static build, there is no plugin index.
+    debug() << "PluginRepositoryTest::testIndex: static build, no plugin index" << std::endl;
+#else
+    ts::Report& report(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+    ts::PluginRepository* repo = ts::PluginRepository::Instance();
+
+    // The index is generated in the build directory, with the plugins shared libraries.
+    const ts::UString index(ts::DirectoryName(ts::ExecutableFile()) + ts::PathSeparator + ts::PluginRepository::INDEX_FILE_NAME);
+    TSUNIT_ASSERT(ts::FileExists(index));
+    ts::UStringList lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, index));
+    TSUNIT_ASSERT(ts::UString(u"processor:pcrextract:tsplugin_pcrextract" TS_SHARED_LIB_SUFFIX u":Extracts PCR, OPCR, PTS, DTS from TS packet for analysis").isContainedSimilarIn(lines));
+
+    // Indexed plugins are listed without loading them.
+    const ts::UString list(repo->listPlugins(true, report, ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_COMPACT));
+    TSUNIT_ASSERT(list.contain(u"pcrextract:Extracts PCR, OPCR, PTS, DTS from TS packet for analysis"));
+    TSUNIT_ASSERT(list.contain(u"merge:"));
+
+    // Load one plugin using the index.
+    TSUNIT_ASSERT(repo->getInput(u"pcrextract", report) == nullptr);
+    TSUNIT_ASSERT(repo->getProcessor(u"pcrextract", report) != nullptr);
+#endif
+}
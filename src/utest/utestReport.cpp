@@ -11,9 +11,12 @@
 //----------------------------------------------------------------------------
 
 #include "tsReportBuffer.h"
+#include "tsAsyncReport.h"
 #include "tsReportFile.h"
 #include "tsFileUtils.h"
 #include "tsNullReport.h"
+#include "tsSysUtils.h"
+#include "utestTSUnitThread.h"
 #include "tsunit.h"
 
 
@@ -34,6 +37,9 @@ public:
     void testPrintf();
     void testByName();
     void testByStream();
+    void testAsync();
+    void testAsyncThreads();
+    void testAsyncDropped();
 
     TSUNIT_TEST_BEGIN(ReportTest);
     TSUNIT_TEST(testSeverity);
@@ -41,6 +47,9 @@ public:
     TSUNIT_TEST(testPrintf);
     TSUNIT_TEST(testByName);
     TSUNIT_TEST(testByStream);
+    TSUNIT_TEST(testAsync);
+    TSUNIT_TEST(testAsyncThreads);
+    TSUNIT_TEST(testAsyncDropped);
     TSUNIT_TEST_END();
 
 private:
@@ -305,3 +314,131 @@ void ReportTest::testByStream()
     ts::UString::Load(value, _fileName);
     TSUNIT_ASSERT(value == ref);
 }
+
+// An asynchronous report which collects messages. The logging thread can be blocked.
+namespace {
+    class AsyncCollector : public ts::AsyncReport
+    {
+        TS_NOBUILD_NOCOPY(AsyncCollector);
+    public:
+        AsyncCollector(const ts::AsyncReportArgs& args, bool block = false) : ts::AsyncReport(ts::Severity::Info, args), blocked(block) {}
+        virtual ~AsyncCollector() override { terminate(); }
+        ts::UStringVector messages {};
+        std::atomic<bool> blocked {false};
+        std::atomic<bool> entered {false};
+    private:
+        virtual void asyncThreadLog(int severity, const ts::UString& message) override
+        {
+            entered = true;
+            while (blocked) {
+                ts::SleepThread(1);
+            }
+            messages.push_back(ts::Severity::Header(severity) + message);
+        }
+    };
+}
+
+// Test case: asynchronous log
+void ReportTest::testAsync()
+{
+    ts::AsyncReportArgs args;
+    args.sync_log = true;
+    args.log_msg_count = 16;
+    AsyncCollector log(args);
+
+    for (int i = 0; i < 1000; ++i) {
+        log.info(u"message %d", {i});
+    }
+    log.debug(u"not logged");
+    log.error(u"last message");
+    log.terminate();
+
+    TSUNIT_EQUAL(1001, log.messages.size());
+    TSUNIT_EQUAL(u"message 0", log.messages[0]);
+    TSUNIT_EQUAL(u"message 999", log.messages[999]);
+    TSUNIT_EQUAL(u"Error: last message", log.messages[1000]);
+    TSUNIT_EQUAL(0, log.droppedMessages());
+}
+
+// Thread for testAsyncThreads()
+namespace {
+    constexpr size_t ASYNC_THREAD_COUNT = 4;
+    constexpr size_t ASYNC_MESSAGE_COUNT = 2000;
+
+    class AsyncLogThread: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(AsyncLogThread);
+    public:
+        AsyncLogThread(ts::Report& log, size_t index) : utest::TSUnitThread(), _log(log), _index(index) {}
+        virtual ~AsyncLogThread() override { waitForTermination(); }
+        virtual void test() override
+        {
+            for (size_t i = 0; i < ASYNC_MESSAGE_COUNT; ++i) {
+                _log.info(u"%d:%d", {_index, i});
+            }
+        }
+    private:
+        ts::Report& _log;
+        size_t _index;
+    };
+}
+
+// Test case: asynchronous log from concurrent threads
+void ReportTest::testAsyncThreads()
+{
+    ts::AsyncReportArgs args;
+    args.sync_log = true;
+    args.log_msg_count = 32;
+    AsyncCollector log(args);
+
+    std::vector<AsyncLogThread*> threads;
+    for (size_t t = 0; t < ASYNC_THREAD_COUNT; ++t) {
+        threads.push_back(new AsyncLogThread(log, t));
+        threads.back()->start();
+    }
+    // Threads are joined when deallocated.
+    for (auto th : threads) {
+        delete th;
+    }
+    log.terminate();
+
+    // All messages are received, in order for each thread.
+    TSUNIT_EQUAL(ASYNC_THREAD_COUNT * ASYNC_MESSAGE_COUNT, log.messages.size());
+    std::vector<size_t> next(ASYNC_THREAD_COUNT, 0);
+    for (const auto& msg : log.messages) {
+        size_t t = 0, i = 0;
+        TSUNIT_ASSERT(msg.scan(u"%d:%d", {&t, &i}));
+        TSUNIT_ASSERT(t < ASYNC_THREAD_COUNT);
+        TSUNIT_EQUAL(next[t], i);
+        next[t] = i + 1;
+    }
+}
+
+// Test case: dropped messages in asynchronous log
+void ReportTest::testAsyncDropped()
+{
+    ts::AsyncReportArgs args;
+    args.log_msg_count = 4;
+    AsyncCollector log(args, true);
+
+    // The first message blocks the logging thread.
+    log.info(u"first");
+    while (!log.entered) {
+        ts::SleepThread(1);
+    }
+
+    // The ring can hold 4 messages, the other ones are dropped.
+    for (int i = 0; i < 10; ++i) {
+        log.info(u"message %d", {i});
+    }
+    TSUNIT_EQUAL(6, log.droppedMessages());
+
+    log.blocked = false;
+    log.terminate();
+
+    TSUNIT_EQUAL(6, log.messages.size());
+    TSUNIT_EQUAL(u"first", log.messages[0]);
+    TSUNIT_EQUAL(u"message 0", log.messages[1]);
+    TSUNIT_EQUAL(u"message 3", log.messages[4]);
+    TSUNIT_EQUAL(u"Warning: 6 log messages dropped, logging queue overflow", log.messages[5]);
+}
@@ -37,6 +37,7 @@ public:
     void testAssign();
     void testPackSections();
     void testSize();
+    void testFingerprint();
 
     TSUNIT_TEST_BEGIN(SectionTest);
     TSUNIT_TEST(testTOT);
@@ -46,6 +47,7 @@ public:
     TSUNIT_TEST(testAssign);
     TSUNIT_TEST(testPackSections);
     TSUNIT_TEST(testSize);
+    TSUNIT_TEST(testFingerprint);
     TSUNIT_TEST_END();
 
 private:
@@ -270,3 +272,26 @@ void SectionTest::testSize()
     TSUNIT_EQUAL(366, table.totalSize());
     TSUNIT_EQUAL(2, table.packetCount());
 }
+
+void SectionTest::testFingerprint()
+{
+    // Short section, the fingerprint uses a computed CRC32.
+    ts::Section tot(psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections), ts::PID_TOT, ts::CRC32::CHECK);
+    ts::Section tot2(tot, ts::ShareMode::COPY);
+    TSUNIT_ASSERT(tot.fingerprint() != 0);
+    TSUNIT_EQUAL(tot.fingerprint(), tot2.fingerprint());
+    tot2.setUInt8(0, tot2.payload()[0] ^ 0x01, false);
+    TSUNIT_ASSERT(tot.fingerprint() != tot2.fingerprint());
+
+    // Long section, the fingerprint uses the CRC32 field.
+    ts::Section nit(psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections), ts::PID_NIT, ts::CRC32::CHECK);
+    ts::Section nit2(nit, ts::ShareMode::COPY);
+    TSUNIT_ASSERT(nit.fingerprint() != 0);
+    TSUNIT_ASSERT(nit.fingerprint() != tot.fingerprint());
+    TSUNIT_EQUAL(nit.fingerprint(), nit2.fingerprint());
+    nit2.setVersion(uint8_t((nit.version() + 1) & ts::SVERSION_MASK), true);
+    TSUNIT_ASSERT(nit.fingerprint() != nit2.fingerprint());
+
+    // Invalid section.
+    TSUNIT_EQUAL(0, ts::Section().fingerprint());
+}
@@ -15,12 +15,18 @@
 #include "tsPMT.h"
 #include "tsCAT.h"
 #include "tsTDT.h"
+#include "tsEIT.h"
 #include "tsCAIdentifierDescriptor.h"
+#include "tsShortEventDescriptor.h"
 #include "tsFileUtils.h"
 #include "tsxmlElement.h"
+#include "tsxmlJSONConverter.h"
+#include "tsjsonValue.h"
+#include "tsTextFormatter.h"
 #include "tsDuckContext.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 #include "tables/psi_pat1_xml.h"
 #include "tables/psi_pat1_sections.h"
@@ -51,6 +57,8 @@ public:
     void testMultiSectionsCAT();
     void testMultiSectionsAtProgramLevelPMT();
     void testMultiSectionsAtStreamLevelPMT();
+    void testSerialization();
+    void testLargeXML();
 
     TSUNIT_TEST_BEGIN(SectionFileTest);
     TSUNIT_TEST(testConfigurationFile);
@@ -64,6 +72,8 @@ public:
     TSUNIT_TEST(testMultiSectionsCAT);
     TSUNIT_TEST(testMultiSectionsAtProgramLevelPMT);
     TSUNIT_TEST(testMultiSectionsAtStreamLevelPMT);
+    TSUNIT_TEST(testSerialization);
+    TSUNIT_TEST(testLargeXML);
     TSUNIT_TEST_END();
 
 private:
@@ -747,3 +757,114 @@ void SectionFileTest::testMemory()
     TSUNIT_EQUAL(0, ::memcmp(out2, psi_pat1_sections, sizeof(psi_pat1_sections)));
     TSUNIT_EQUAL(0, ::memcmp(out2 + 32, psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
 }
+
+void SectionFileTest::testSerialization()
+{
+    ts::DuckContext duck(&report());
+
+    // An empty file is serialized as an empty document.
+    ts::SectionFile file(duck);
+    TSUNIT_EQUAL(u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<tsduck/>\n", file.toXML());
+    TSUNIT_EQUAL(u"[\n]", file.toJSON());
+    ts::UStringList lines;
+    TSUNIT_ASSERT(file.saveXML(_tempFileNameXML));
+    TSUNIT_ASSERT(ts::UString::Load(lines, _tempFileNameXML));
+    TSUNIT_EQUAL(u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<tsduck/>", ts::UString::Join(lines, u"\n"));
+
+    // Load several tables.
+    TSUNIT_ASSERT(file.loadBuffer(psi_pat1_sections, sizeof(psi_pat1_sections)));
+    TSUNIT_ASSERT(file.loadBuffer(psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
+    TSUNIT_EQUAL(2, file.tables().size());
+
+    // Reference serialization: build the complete XML document, then convert it to JSON.
+    ts::xml::Document doc(report());
+    ts::xml::Element* root = doc.initialize(u"tsduck");
+    TSUNIT_ASSERT(root != nullptr);
+    for (const auto& table : file.tables()) {
+        TSUNIT_ASSERT(table->toXML(duck, root) != nullptr);
+    }
+    ts::xml::JSONConverter model(report());
+    TSUNIT_ASSERT(ts::SectionFile::LoadModel(model));
+    ts::TextFormatter text(report());
+    text.setString();
+    model.convertToJSON(doc)->print(text);
+
+    // Tables are serialized one by one, the result must be identical.
+    const ts::UString xml(file.toXML());
+    const ts::UString json(file.toJSON());
+    debug() << "SectionFileTest::testSerialization: XML:" << std::endl << xml << std::endl << "JSON:" << std::endl << json << std::endl;
+    TSUNIT_EQUAL(doc.toString(), xml);
+    TSUNIT_EQUAL(text.toString(), json);
+
+    // Same thing with files.
+    TSUNIT_ASSERT(file.saveXML(_tempFileNameXML));
+    TSUNIT_ASSERT(ts::UString::Load(lines, _tempFileNameXML));
+    TSUNIT_EQUAL(xml, ts::UString::Join(lines, u"\n") + u"\n");
+    TSUNIT_ASSERT(file.saveJSON(_tempFileNameXML));
+    TSUNIT_ASSERT(ts::UString::Load(lines, _tempFileNameXML));
+    TSUNIT_EQUAL(json, ts::UString::Join(lines, u"\n"));
+}
+
+void SectionFileTest::testLargeXML()
+{
+    // Large EPG: 32 services, 8 EIT schedule tables per service, 16 events per table.
+    static constexpr size_t SERVICE_COUNT = 32;
+    static constexpr size_t TABLE_COUNT = 8;
+    static constexpr size_t EVENT_COUNT = 16;
+
+    ts::DuckContext duck;
+    ts::SectionFile file(duck);
+    const ts::Time base(2023, 1, 1, 0, 0);
+    for (size_t srv = 0; srv < SERVICE_COUNT; ++srv) {
+        for (size_t tab = 0; tab < TABLE_COUNT; ++tab) {
+            ts::EIT eit(true, false, uint8_t(tab), 0, true, uint16_t(srv), 1, 1);
+            for (size_t ev = 0; ev < EVENT_COUNT; ++ev) {
+                ts::EIT::Event& event(eit.events[ev]);
+                event.event_id = uint16_t(tab * EVENT_COUNT + ev);
+                event.start_time = base + ts::MilliSecond(event.event_id) * ts::MilliSecPerHour;
+                event.duration = 3600;
+                event.descs.add(duck, ts::ShortEventDescriptor(u"eng", u"Some event name", u"Some event description"));
+            }
+            ts::BinaryTablePtr bin(new ts::BinaryTable);
+            eit.serialize(duck, *bin);
+            TSUNIT_ASSERT(bin->isValid());
+            file.add(bin);
+        }
+    }
+    const ts::UString xml(file.toXML());
+    TSUNIT_EQUAL(SERVICE_COUNT * TABLE_COUNT, file.tables().size());
+
+    // Compare the parsing of the complete XML document with the parsing on the fly.
+    utest::TSUnitBenchmark dom_bench(u"TSUNIT_SECTIONFILE_ITERATIONS");
+    utest::TSUnitBenchmark stream_bench(u"TSUNIT_SECTIONFILE_ITERATIONS");
+
+    for (size_t iter = 0; iter < dom_bench.iterations; ++iter) {
+
+        // Complete XML document, validated, then converted into tables.
+        dom_bench.start();
+        ts::BinaryTablePtrVector tables;
+        {
+            ts::xml::JSONConverter model(report());
+            TSUNIT_ASSERT(ts::SectionFile::LoadModel(model));
+            ts::xml::Document doc(report());
+            TSUNIT_ASSERT(doc.parse(xml));
+            TSUNIT_ASSERT(model.validate(doc));
+            for (const ts::xml::Element* node = doc.rootElement()->firstChildElement(); node != nullptr; node = node->nextSiblingElement()) {
+                ts::BinaryTablePtr bin(new ts::BinaryTable);
+                TSUNIT_ASSERT(bin->fromXML(duck, node));
+                tables.push_back(bin);
+            }
+        }
+        dom_bench.stop();
+        TSUNIT_EQUAL(SERVICE_COUNT * TABLE_COUNT, tables.size());
+
+        // Same thing on the fly, one table at a time.
+        stream_bench.start();
+        ts::SectionFile loaded(duck);
+        TSUNIT_ASSERT(loaded.parseXML(xml));
+        stream_bench.stop();
+        TSUNIT_EQUAL(SERVICE_COUNT * TABLE_COUNT, loaded.tables().size());
+    }
+    dom_bench.report(u"SectionFileTest::testLargeXML (complete document)");
+    stream_bench.report(u"SectionFileTest::testLargeXML (on the fly)");
+}
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzer.h"
+#include "tsOneShotPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testManyPIDs();
+
+    TSUNIT_TEST_BEGIN(TSAnalyzerTest);
+    TSUNIT_TEST(testManyPIDs);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSAnalyzerTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void TSAnalyzerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void TSAnalyzerTest::testManyPIDs()
+{
+    // Build a multiplex with 50 services, each one with 8 elementary streams.
+    // The packets of all elementary streams are interleaved.
+    static const size_t service_count = 50;
+    static const size_t es_count = 8;
+    static const size_t es_packets = 20;
+    static const ts::PID first_pmt_pid = 100;
+    static const ts::PID first_es_pid = 1000;
+
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    ts::PAT pat(0, true, 1);
+
+    for (size_t srv = 0; srv < service_count; ++srv) {
+        const uint16_t service_id = uint16_t(srv + 1);
+        const ts::PID pmt_pid = ts::PID(first_pmt_pid + srv);
+        pat.pmts[service_id] = pmt_pid;
+        ts::PMT pmt(0, true, service_id, ts::PID(first_es_pid + es_count * srv));
+        for (size_t es = 0; es < es_count; ++es) {
+            pmt.streams[ts::PID(first_es_pid + es_count * srv + es)].stream_type = es == 0 ? ts::ST_MPEG2_VIDEO : ts::ST_MPEG1_AUDIO;
+        }
+        ts::BinaryTable table;
+        pmt.serialize(duck, table);
+        ts::OneShotPacketizer pzer(duck, pmt_pid);
+        pzer.addTable(table);
+        ts::TSPacketVector pmt_packets;
+        pzer.getPackets(pmt_packets);
+        packets.insert(packets.end(), pmt_packets.begin(), pmt_packets.end());
+    }
+    {
+        ts::BinaryTable table;
+        pat.serialize(duck, table);
+        ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+        pzer.addTable(table);
+        ts::TSPacketVector pat_packets;
+        pzer.getPackets(pat_packets);
+        packets.insert(packets.begin(), pat_packets.begin(), pat_packets.end());
+    }
+    for (size_t pi = 0; pi < es_packets; ++pi) {
+        for (size_t i = 0; i < service_count * es_count; ++i) {
+            ts::TSPacket pkt;
+            pkt.init(ts::PID(first_es_pid + i), uint8_t(pi & ts::CC_MASK), uint8_t(i));
+            packets.push_back(pkt);
+        }
+    }
+
+    // Analyze the multiplex, repeatedly.
+    utest::TSUnitBenchmark bench(u"TSUNIT_TSANALYZER_ITERATIONS");
+    ts::TSAnalyzer analyzer(duck);
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        for (const auto& pkt : packets) {
+            analyzer.feedPacket(pkt);
+        }
+    }
+    bench.stop();
+    bench.report(u"TSAnalyzerTest::testManyPIDs");
+
+    std::vector<uint16_t> services;
+    analyzer.getServiceIds(services);
+    TSUNIT_EQUAL(service_count, services.size());
+
+    // PAT + PMT's + elementary streams.
+    std::vector<ts::PID> pids;
+    analyzer.getPIDs(pids);
+    TSUNIT_EQUAL(1 + service_count + service_count * es_count, pids.size());
+    TSUNIT_EQUAL(ts::PID_PAT, pids.front());
+    TSUNIT_EQUAL(ts::PID(first_es_pid + service_count * es_count - 1), pids.back());
+
+    analyzer.getPIDsOfService(pids, 3);
+    TSUNIT_EQUAL(1 + es_count, pids.size());
+    TSUNIT_EQUAL(ts::PID(first_pmt_pid + 2), pids.front());
+    TSUNIT_EQUAL(ts::PID(first_es_pid + 2 * es_count), pids[1]);
+
+    analyzer.getUnreferencedPIDs(pids);
+    TSUNIT_ASSERT(pids.empty());
+
+    // After a reset, all PID contexts are recreated.
+    analyzer.reset();
+    analyzer.getPIDs(pids);
+    TSUNIT_ASSERT(pids.empty());
+    analyzer.feedPacket(packets.back());
+    analyzer.getPIDs(pids);
+    TSUNIT_EQUAL(1, pids.size());
+    TSUNIT_EQUAL(ts::PID(first_es_pid + service_count * es_count - 1), pids.front());
+}
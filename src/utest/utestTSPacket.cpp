@@ -14,6 +14,7 @@
 #include "tsByteBlock.h"
 #include "tsMemory.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -34,6 +35,10 @@ public:
     void testSetPayloadSize();
     void testFlags();
     void testPrivateData();
+    void testFindInvalidSync();
+    void testExtractHeaders();
+    void testCountPIDs();
+    void testBulkThroughput();
 
     TSUNIT_TEST_BEGIN(TSPacketTest);
     TSUNIT_TEST(testPacket);
@@ -44,6 +49,10 @@ public:
     TSUNIT_TEST(testSetPayloadSize);
     TSUNIT_TEST(testFlags);
     TSUNIT_TEST(testPrivateData);
+    TSUNIT_TEST(testFindInvalidSync);
+    TSUNIT_TEST(testExtractHeaders);
+    TSUNIT_TEST(testCountPIDs);
+    TSUNIT_TEST(testBulkThroughput);
     TSUNIT_TEST_END();
 };
 
@@ -69,6 +78,22 @@ void TSPacketTest::afterTest()
 // Unitary tests.
 //----------------------------------------------------------------------------
 
+namespace {
+    // Build pseudo-random packets with valid sync bytes and random headers.
+    void RandomPackets(std::vector<ts::TSPacket>& packets, size_t count)
+    {
+        packets.resize(count);
+        uint32_t seed = 0x12345678;
+        for (auto& pkt : packets) {
+            for (auto& b : pkt.b) {
+                seed = seed * 1103515245 + 12345;
+                b = uint8_t(seed >> 16);
+            }
+            pkt.b[0] = ts::SYNC_BYTE;
+        }
+    }
+}
+
 void TSPacketTest::testPacket()
 {
     ts::TSPacket::SanityCheck();
@@ -521,3 +546,139 @@ void TSPacketTest::testPrivateData()
     pkt.getPrivateData(data);
     TSUNIT_ASSERT(data.empty());
 }
+
+void TSPacketTest::testFindInvalidSync()
+{
+    std::vector<ts::TSPacket> packets;
+    RandomPackets(packets, 67);
+
+    // All sizes, all valid.
+    for (size_t count = 0; count <= packets.size(); ++count) {
+        TSUNIT_EQUAL(count, ts::TSPacket::FindInvalidSync(packets.data(), count));
+    }
+
+    // One invalid packet at each position, with various start offsets.
+    for (size_t bad = 0; bad < packets.size(); ++bad) {
+        packets[bad].b[0] = 0x48;
+        for (size_t start = 0; start < 9; ++start) {
+            const size_t expected = bad < start ? packets.size() - start : bad - start;
+            TSUNIT_EQUAL(expected, ts::TSPacket::FindInvalidSync(packets.data() + start, packets.size() - start));
+        }
+        packets[bad].b[0] = ts::SYNC_BYTE;
+    }
+}
+
+void TSPacketTest::testExtractHeaders()
+{
+    std::vector<ts::TSPacket> packets;
+    RandomPackets(packets, 67);
+
+    for (size_t count = 0; count <= packets.size(); ++count) {
+        for (size_t start = 0; start < 9 && start <= count; ++start) {
+            const size_t size = count - start;
+            std::vector<ts::PID> pids(size + 1, 0xFFFF);
+            std::vector<uint8_t> cc(size + 1, 0xFF);
+            std::vector<uint8_t> pusi(size + 1, 0xFF);
+            std::vector<uint8_t> scrambling(size + 1, 0xFF);
+            ts::TSPacket::ExtractHeaders(packets.data() + start, size, pids.data(), cc.data(), pusi.data(), scrambling.data());
+            for (size_t i = 0; i < size; ++i) {
+                const ts::TSPacket& pkt(packets[start + i]);
+                TSUNIT_EQUAL(pkt.getPID(), pids[i]);
+                TSUNIT_EQUAL(pkt.getCC(), cc[i]);
+                TSUNIT_EQUAL(pkt.getPUSI() ? 1 : 0, pusi[i]);
+                TSUNIT_EQUAL(pkt.getScrambling(), scrambling[i]);
+            }
+            // Nothing written past the end.
+            TSUNIT_EQUAL(0xFFFF, pids[size]);
+            TSUNIT_EQUAL(0xFF, cc[size]);
+            TSUNIT_EQUAL(0xFF, pusi[size]);
+            TSUNIT_EQUAL(0xFF, scrambling[size]);
+
+            // Partial extraction.
+            std::vector<uint8_t> cc2(size + 1, 0xFF);
+            ts::TSPacket::ExtractHeaders(packets.data() + start, size, nullptr, cc2.data());
+            TSUNIT_ASSERT(cc == cc2);
+        }
+    }
+}
+
+void TSPacketTest::testCountPIDs()
+{
+    // Use a few PID's only, with runs of identical PID's.
+    std::vector<ts::TSPacket> packets;
+    RandomPackets(packets, 1000);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].setPID(ts::PID((i % 7) < 3 ? 0x0100 : 0x1000 + (i % 5)));
+    }
+    packets.back().setPID(ts::PID_NULL);
+
+    std::vector<ts::PacketCounter> ref(ts::PID_MAX, 0);
+    for (const auto& pkt : packets) {
+        ref[pkt.getPID()]++;
+    }
+    ref[0x0100] += 5;
+
+    std::vector<ts::PacketCounter> counters(ts::PID_MAX, 0);
+    counters[0x0100] = 5;
+    ts::TSPacket::CountPIDs(packets.data(), packets.size(), counters.data());
+    TSUNIT_ASSERT(ref == counters);
+}
+
+void TSPacketTest::testBulkThroughput()
+{
+    // Compare bulk operations on a large buffer with per-packet accessors: same results, CPU time.
+    // Typical PID distribution: mostly video, some audio, null packets and a few others.
+    std::vector<ts::TSPacket> packets;
+    RandomPackets(packets, 10000);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const size_t r = (i * 7919) % 100;
+        packets[i].setPID(r < 75 ? 0x0100 : (r < 85 ? 0x0101 : (r < 95 ? ts::PID(ts::PID_NULL) : ts::PID(0x0010 + r % 5))));
+    }
+
+    // Each benchmark iteration processes the buffer several times to get a measurable CPU time.
+    constexpr size_t repeat = 100;
+    utest::TSUnitBenchmark scalar_bench(u"TSUNIT_TSPACKET_ITERATIONS");
+    utest::TSUnitBenchmark bulk_bench(u"TSUNIT_TSPACKET_ITERATIONS");
+    std::vector<ts::PID> scalar_pids(packets.size());
+    std::vector<ts::PID> bulk_pids(packets.size());
+    std::vector<ts::PacketCounter> scalar_counters(ts::PID_MAX, 0);
+    std::vector<ts::PacketCounter> bulk_counters(ts::PID_MAX, 0);
+    size_t scalar_valid = 0;
+    size_t bulk_valid = 0;
+
+    for (size_t iter = 0; iter < scalar_bench.iterations; ++iter) {
+
+        // Per-packet accessors: sync check, PID extraction, PID histogram.
+        scalar_bench.start();
+        for (size_t r = 0; r < repeat; ++r) {
+            size_t n = 0;
+            while (n < packets.size() && packets[n].hasValidSync()) {
+                n++;
+            }
+            scalar_valid += n;
+            for (n = 0; n < packets.size(); ++n) {
+                scalar_pids[n] = packets[n].getPID();
+            }
+            for (const auto& pkt : packets) {
+                scalar_counters[pkt.getPID()]++;
+            }
+        }
+        scalar_bench.stop();
+
+        // Same thing with bulk operations.
+        bulk_bench.start();
+        for (size_t r = 0; r < repeat; ++r) {
+            bulk_valid += ts::TSPacket::FindInvalidSync(packets.data(), packets.size());
+            ts::TSPacket::ExtractHeaders(packets.data(), packets.size(), bulk_pids.data());
+            ts::TSPacket::CountPIDs(packets.data(), packets.size(), bulk_counters.data());
+        }
+        bulk_bench.stop();
+    }
+    scalar_bench.report(u"TSPacketTest::testBulkThroughput (per packet)");
+    bulk_bench.report(u"TSPacketTest::testBulkThroughput (bulk)");
+
+    TSUNIT_EQUAL(scalar_bench.iterations * repeat * packets.size(), scalar_valid);
+    TSUNIT_EQUAL(scalar_valid, bulk_valid);
+    TSUNIT_ASSERT(scalar_pids == bulk_pids);
+    TSUNIT_ASSERT(scalar_counters == bulk_counters);
+}
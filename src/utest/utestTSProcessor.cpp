@@ -14,6 +14,7 @@
 #include "tsPluginRepository.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -27,9 +28,13 @@ public:
     virtual void afterTest() override;
 
     void testProcessing();
+    void testSyncModes();
+    void testPacketBatch();
 
     TSUNIT_TEST_BEGIN(TSProcessorTest);
     TSUNIT_TEST(testProcessing);
+    TSUNIT_TEST(testSyncModes);
+    TSUNIT_TEST(testPacketBatch);
     TSUNIT_TEST_END();
 };
 
@@ -156,6 +161,44 @@ TestPlugin::Status TestPlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMeta
 }
 
 
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class using packet batches.
+// Drop one packet out of two, based on the packet index in the stream.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TestBatchPlugin : ts::ProcessorPlugin
+    {
+    public:
+        TestBatchPlugin(ts::TSP* t) : ts::ProcessorPlugin(t, u"Test batch plugin") {}
+        virtual bool start() override { batches = errors = 0; return true; }
+        virtual bool usePacketBatch() override { return true; }
+        virtual void processPacketBatch(ts::TSPacket*, ts::TSPacketMetadata*, Status*, size_t) override;
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP* t) { return new TestBatchPlugin(t); }
+
+        // Statistics, collected by the test (single plugin instance per test).
+        static size_t batches;
+        static size_t errors;
+    };
+
+    size_t TestBatchPlugin::batches = 0;
+    size_t TestBatchPlugin::errors = 0;
+}
+
+void TestBatchPlugin::processPacketBatch(ts::TSPacket* pkt, ts::TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    batches++;
+    for (size_t i = 0; i < count; ++i) {
+        if (status[i] != TSP_OK || !pkt[i].hasValidSync()) {
+            errors++;
+        }
+        if ((tsp->pluginPackets() + i) % 2 != 0) {
+            status[i] = TSP_DROP;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // A test plugin event handler.
 // We don't do the TSUNIT assertions in the event handler (called in plugin
@@ -303,3 +346,89 @@ void TSProcessorTest::testProcessing()
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
 }
+
+void TSProcessorTest::testSyncModes()
+{
+    ts::PluginRepository::Instance()->registerProcessor(u"test1", TestPlugin::CreateInstance);
+
+    static const ts::TSProcessorArgs::SyncMode modes[] = {ts::TSProcessorArgs::SyncMode::MUTEX, ts::TSProcessorArgs::SyncMode::LOCKFREE};
+    static const size_t plugin_count = 8;
+    static const size_t packet_count = 200000;
+
+    // Compare the CPU usage of the two synchronization modes.
+    for (auto mode : modes) {
+
+        const bool lockfree = mode == ts::TSProcessorArgs::SyncMode::LOCKFREE;
+        utest::TSUnitBenchmark bench(u"TSUNIT_TSPROCESSOR_ITERATIONS");
+
+        for (size_t iter = 0; iter < bench.iterations; ++iter) {
+
+            // Long chain of plugins with a small buffer to force many handoffs.
+            ts::TSProcessorArgs opt;
+            opt.app_name = u"TSProcessorTest::testSyncModes";
+            opt.sync_mode = mode;
+            opt.ts_buffer_size = ts::TSProcessorArgs::MIN_BUFFER_SIZE;
+            opt.max_flush_pkt = 10;
+            opt.input = {u"null", {ts::UString::Decimal(packet_count, 0, true, ts::UString())}};
+            for (size_t i = 0; i < plugin_count; ++i) {
+                opt.plugins.push_back({u"test1", {u"--count", u"1000000000"}});
+            }
+            opt.output = {u"drop"};
+
+            ts::TSProcessor tsproc(CERR);
+            TestEventHandler handler;
+            ts::TSProcessor::Criteria crit;
+            crit.event_code = TestPlugin::EVENT_STOP;
+            tsproc.registerEventHandler(&handler, crit);
+
+            bench.start();
+            TSUNIT_ASSERT(tsproc.start(opt));
+            tsproc.waitForTermination();
+            bench.stop();
+
+            // All plugins must have seen all packets.
+            TSUNIT_EQUAL(plugin_count, handler.logs.size());
+            for (const auto& log : handler.logs) {
+                TSUNIT_EQUAL(packet_count, log.packets);
+                TSUNIT_EQUAL(plugin_count + 2, log.count);
+            }
+        }
+
+        bench.report(lockfree ? u"TSProcessorTest::testSyncModes (lock-free)" : u"TSProcessorTest::testSyncModes (mutex)");
+    }
+}
+
+void TSProcessorTest::testPacketBatch()
+{
+    ts::PluginRepository::Instance()->registerProcessor(u"test1", TestPlugin::CreateInstance);
+    ts::PluginRepository::Instance()->registerProcessor(u"testbatch", TestBatchPlugin::CreateInstance);
+
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testPacketBatch";
+    opt.max_flush_pkt = 100;
+    opt.input = {u"null", {u"1001"}};
+    opt.plugins = {
+        {u"testbatch", {}},
+        {u"test1", {u"--count", u"1000"}},
+    };
+    opt.output = {u"drop"};
+
+    ts::TSProcessor tsproc(CERR);
+    TestEventHandler handler;
+    ts::TSProcessor::Criteria crit;
+    crit.event_code = TestPlugin::EVENT_STOP;
+    tsproc.registerEventHandler(&handler, crit);
+
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    debug() << "TSProcessorTest::testPacketBatch: " << TestBatchPlugin::batches << " batches" << std::endl;
+
+    // Packets are processed by batches and one packet out of two is dropped.
+    TSUNIT_EQUAL(0, TestBatchPlugin::errors);
+    TSUNIT_ASSERT(TestBatchPlugin::batches >= 11);
+    TSUNIT_ASSERT(TestBatchPlugin::batches < 1001);
+    TSUNIT_EQUAL(1, handler.logs.size());
+    TSUNIT_EQUAL(u"test1", handler.logs[0].name);
+    TSUNIT_EQUAL(501, handler.logs[0].packets);
+}
@@ -13,11 +13,13 @@
 #include "tsxmlModelDocument.h"
 #include "tsxmlElement.h"
 #include "tsxmlDeclaration.h"
+#include "tsxmlStreamingDocument.h"
 #include "tsSectionFile.h"
 #include "tsTextFormatter.h"
 #include "tsCerrReport.h"
 #include "tsReportBuffer.h"
 #include "tsFileUtils.h"
+#include "tsConfigurationCache.h"
 #include "tsunit.h"
 
 
@@ -46,6 +48,9 @@ public:
     void testSort();
     void testGetFloat();
     void testSetFloat();
+    void testCache();
+    void testStreaming();
+    void testStreamingInvalid();
 
     TSUNIT_TEST_BEGIN(XMLTest);
     TSUNIT_TEST(testDocument);
@@ -61,6 +66,9 @@ public:
     TSUNIT_TEST(testSort);
     TSUNIT_TEST(testGetFloat);
     TSUNIT_TEST(testSetFloat);
+    TSUNIT_TEST(testCache);
+    TSUNIT_TEST(testStreaming);
+    TSUNIT_TEST(testStreamingInvalid);
     TSUNIT_TEST_END();
 
 private:
@@ -88,12 +96,14 @@ void XMLTest::beforeTest()
         _tempFileName = ts::TempFile(u".tmp.xml");
     }
     ts::DeleteFile(_tempFileName, NULLREP);
+    ts::DeleteFile(ts::ConfigurationCache::CacheFileName(_tempFileName), NULLREP);
 }
 
 // Test suite cleanup method.
 void XMLTest::afterTest()
 {
     ts::DeleteFile(_tempFileName, NULLREP);
+    ts::DeleteFile(ts::ConfigurationCache::CacheFileName(_tempFileName), NULLREP);
 }
 
 ts::Report& XMLTest::report()
@@ -757,3 +767,143 @@ void XMLTest::testSetFloat()
         u"</root>\n",
         doc.toString());
 }
+
+void XMLTest::testCache()
+{
+    static const ts::UChar* const document =
+        u"<?xml version='1.0' encoding='UTF-8'?>\n"
+        u"<!-- leading comment -->\n"
+        u"<root attr1=\"val1\" Attr2=\"&lt;val2&gt;\">\n"
+        u"  <node1 a1=\"v1\">Text in node1</node1>\n"
+        u"  <node2><![CDATA[some <cdata> text]]></node2>\n"
+        u"  <!-- inner comment -->\n"
+        u"  <node3 x=\"\u00E9t\u00E9\"/>\n"
+        u"</root>\n";
+
+    TSUNIT_ASSERT(ts::UString(document).save(_tempFileName));
+
+    // Parse the text and create the cache.
+    ts::xml::Document text(report());
+    TSUNIT_ASSERT(text.load(_tempFileName, false));
+    TSUNIT_ASSERT(text.saveCache(_tempFileName));
+    TSUNIT_ASSERT(ts::FileExists(ts::ConfigurationCache::CacheFileName(_tempFileName)));
+
+    // Reload from the cache, same content is expected.
+    ts::ReportBuffer<> log(ts::Severity::Debug);
+    ts::xml::Document cache(log);
+    TSUNIT_ASSERT(cache.load(_tempFileName, true));
+    debug() << "XMLTest::testCache: " << log.getMessages() << std::endl;
+    TSUNIT_ASSERT(log.getMessages().contain(u"using cache file"));
+    TSUNIT_EQUAL(text.toString(), cache.toString());
+
+    const ts::xml::Element* root = cache.rootElement();
+    TSUNIT_ASSERT(root != nullptr);
+    TSUNIT_EQUAL(u"root", root->name());
+    TSUNIT_EQUAL(3, root->lineNumber());
+    TSUNIT_EQUAL(u"<val2>", root->attribute(u"attr2").value());
+    const ts::xml::Element* node2 = root->findFirstChild(u"node2");
+    TSUNIT_ASSERT(node2 != nullptr);
+    ts::UString str;
+    TSUNIT_ASSERT(node2->getText(str));
+    TSUNIT_EQUAL(u"some <cdata> text", str);
+
+    // Modify the text file, the cache is no longer used.
+    TSUNIT_ASSERT(ts::UString(u"<?xml version='1.0' encoding='UTF-8'?>\n<other/>\n").save(_tempFileName));
+    log.resetMessages();
+    ts::xml::Document modified(log);
+    TSUNIT_ASSERT(modified.load(_tempFileName, true));
+    TSUNIT_ASSERT(log.getMessages().contain(u"ignoring outdated cache file"));
+    TSUNIT_ASSERT(modified.rootElement() != nullptr);
+    TSUNIT_EQUAL(u"other", modified.rootElement()->name());
+}
+
+void XMLTest::testStreaming()
+{
+    static const ts::UChar* const document =
+        u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        u"<!-- leading comment -->\n"
+        u"<root attr1=\"val1\">\n"
+        u"  <node1 foo=\"bar\">  Text in node1  </node1>\n"
+        u"  <!-- comment between nodes -->\n"
+        u"  <node2>\n"
+        u"    <node21>\n"
+        u"      <node211/>\n"
+        u"    </node21>\n"
+        u"    <node22/>\n"
+        u"  </node2>\n"
+        u"  <node3/>\n"
+        u"</root>\n"
+        u"<!-- trailing comment -->\n";
+
+    ts::xml::StreamingDocument doc(report());
+    TSUNIT_ASSERT(doc.openText(document));
+    TSUNIT_ASSERT(doc.isValid());
+
+    // The root is available with its attributes but without children.
+    ts::xml::Element* root = doc.rootElement();
+    TSUNIT_ASSERT(root != nullptr);
+    TSUNIT_EQUAL(u"root", root->name());
+    TSUNIT_EQUAL(u"val1", root->attribute(u"attr1").value());
+    TSUNIT_ASSERT(!root->hasChildren());
+
+    ts::xml::Element* elem = doc.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node1", elem->name());
+    TSUNIT_EQUAL(4, elem->lineNumber());
+    TSUNIT_EQUAL(u"bar", elem->attribute(u"foo").value());
+    TSUNIT_EQUAL(u"  Text in node1  ", elem->text());
+    TSUNIT_ASSERT(elem->parent() == root);
+    TSUNIT_EQUAL(1, root->childrenCount());
+
+    // The previous element is deleted, only one child under the root at any time.
+    elem = doc.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node2", elem->name());
+    TSUNIT_EQUAL(6, elem->lineNumber());
+    TSUNIT_EQUAL(2, elem->childrenCount());
+    TSUNIT_ASSERT(elem->findFirstChild(u"node21") != nullptr);
+    TSUNIT_EQUAL(1, root->childrenCount());
+
+    elem = doc.nextElement();
+    TSUNIT_ASSERT(elem != nullptr);
+    TSUNIT_EQUAL(u"node3", elem->name());
+    TSUNIT_EQUAL(1, root->childrenCount());
+
+    TSUNIT_ASSERT(doc.nextElement() == nullptr);
+    TSUNIT_ASSERT(doc.isValid());
+    TSUNIT_ASSERT(!root->hasChildren());
+    TSUNIT_ASSERT(doc.nextElement() == nullptr);
+
+    // A standalone root is a complete document.
+    TSUNIT_ASSERT(doc.openText(u"<?xml version=\"1.0\"?>\n<root/>\n"));
+    TSUNIT_ASSERT(doc.isValid());
+    TSUNIT_ASSERT(doc.nextElement() == nullptr);
+    TSUNIT_ASSERT(doc.isValid());
+}
+
+void XMLTest::testStreamingInvalid()
+{
+    ts::ReportBuffer<> rep;
+    ts::xml::StreamingDocument doc(rep);
+
+    // No root element.
+    TSUNIT_ASSERT(!doc.openText(u"<?xml version='1.0' encoding='UTF-8'?>\n"));
+    TSUNIT_EQUAL(u"Error: invalid XML document, no root element found", rep.getMessages());
+    TSUNIT_ASSERT(!doc.isValid());
+
+    // Error in second element, the first one is correctly returned.
+    rep.resetMessages();
+    TSUNIT_ASSERT(doc.openText(u"<?xml version='1.0' encoding='UTF-8'?>\n<foo>\n<a/>\n<b>\n</foo>\n"));
+    TSUNIT_ASSERT(doc.nextElement() != nullptr);
+    TSUNIT_ASSERT(doc.nextElement() == nullptr);
+    TSUNIT_ASSERT(!doc.isValid());
+    TSUNIT_EQUAL(u"Error: line 5: parsing error, expected </b> to match <b> at line 4", rep.getMessages());
+
+    // Trailing element after the root.
+    rep.resetMessages();
+    TSUNIT_ASSERT(doc.openText(u"<?xml version='1.0' encoding='UTF-8'?>\n<foo>\n<a/>\n</foo>\n<bar/>\n"));
+    TSUNIT_ASSERT(doc.nextElement() != nullptr);
+    TSUNIT_ASSERT(doc.nextElement() == nullptr);
+    TSUNIT_ASSERT(!doc.isValid());
+    TSUNIT_EQUAL(u"Error: line 5: trailing Element, invalid XML document, need one single root element", rep.getMessages());
+}
@@ -0,0 +1,665 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+// Throughput benchmark for tsp plugins.
+//
+// A synthetic multiplex is generated in memory and fed into a complete
+// TSProcessor through the memory input plugin. Each benchmark runs one
+// chain of packet processor plugins for a given number of packets. The
+// packets are collected by the memory output plugin and dropped.
+//
+// Reported metrics:
+// - Throughput in packets/second and elapsed nanoseconds per packet,
+//   measured from the first input packet to the last output packet.
+// - Process CPU time per packet (including plugins startup).
+// - Number of memory allocations per 1000 packets, counted using a
+//   replacement of the global operator new. On Windows, the allocations
+//   which are performed inside the TSDuck DLL are not counted.
+// - Number of hardware cache misses per 1000 packets (Linux only, when the
+//   perf events are accessible, including plugins startup).
+//
+// The results can be produced in JSON format to track regressions
+// between TSDuck versions.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsArgsWithPlugins.h"
+#include "tsDuckContext.h"
+#include "tsTSProcessor.h"
+#include "tsTSProcessorArgs.h"
+#include "tsAsyncReport.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsPluginRepository.h"
+#include "tsOneShotPacketizer.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsMonotonic.h"
+#include "tsSysUtils.h"
+#include "tsVersionInfo.h"
+#include "tsjsonOutputArgs.h"
+#include "tsjsonObject.h"
+TS_MAIN(MainCode);
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Count all memory allocations in the process.
+//----------------------------------------------------------------------------
+
+namespace {
+    std::atomic<uint64_t> allocation_count(0);
+}
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Synthetic multiplex layout.
+    constexpr ts::PID FIRST_PMT_PID = 100;
+    constexpr ts::PID FIRST_ES_PID = 1000;
+    constexpr size_t  MAX_SERVICES = 100;
+    constexpr size_t  MAX_STREAMS = 10;
+    constexpr size_t  DEFAULT_SERVICES = 10;
+    constexpr size_t  DEFAULT_STREAMS = 4;
+    constexpr ts::PacketCounter DEFAULT_PACKETS = 1000000;
+    constexpr size_t  DEFAULT_BITRATE = 38000000;
+
+    // Description of one benchmark.
+    struct Benchmark
+    {
+        ts::UString             name;
+        ts::PluginOptionsVector plugins;
+    };
+    typedef std::vector<Benchmark> BenchmarkVector;
+
+    class Options: public ts::ArgsWithPlugins
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::DuckContext     duck;
+        ts::AsyncReportArgs log_args;
+        ts::TSProcessorArgs tsp_args;
+        ts::json::OutputArgs json;
+        bool                list;
+        ts::PacketCounter   packets;
+        size_t              services;
+        size_t              streams;
+        BenchmarkVector     benchmarks;
+    };
+
+    // Build a plugin chain from a command line fragment, using the same syntax as tsp.
+    ts::PluginOptionsVector Chain(const ts::UString& command)
+    {
+        ts::PluginOptionsVector plugins;
+        ts::UStringVector args;
+        command.split(args, u' ', true, true);
+        for (const auto& arg : args) {
+            if (arg == u"-P") {
+                plugins.push_back(ts::PluginOptions());
+            }
+            else if (!plugins.empty() && plugins.back().name.empty()) {
+                plugins.back().name = arg;
+            }
+            else if (!plugins.empty()) {
+                plugins.back().args.push_back(arg);
+            }
+        }
+        return plugins;
+    }
+
+    // The built-in benchmarks: each common plugin in isolation and some common chains.
+    BenchmarkVector BuiltinBenchmarks()
+    {
+        // Null device for plugins which unconditionally produce a report.
+#if defined(TS_WINDOWS)
+        const ts::UString null_device(u"NUL");
+#else
+        const ts::UString null_device(u"/dev/null");
+#endif
+        const ts::UString cw(u"0123456789ABCDEF");
+        const ts::UString es(ts::UString::Decimal(FIRST_ES_PID, 0, true, u""));
+        const ts::UString es2(ts::UString::Decimal(FIRST_ES_PID + 1, 0, true, u""));
+
+        return BenchmarkVector({
+            {u"none",        Chain(u"")},
+            {u"count",       Chain(u"-P count --output-file " + null_device)},
+            {u"continuity",  Chain(u"-P continuity")},
+            {u"filter",      Chain(u"-P filter --pid " + es)},
+            {u"remap",       Chain(u"-P remap " + es + u"=8000")},
+            {u"pcrbitrate",  Chain(u"-P pcrbitrate")},
+            {u"sifilter",    Chain(u"-P sifilter --pat --pmt --sdt")},
+            {u"zap",         Chain(u"-P zap 1")},
+            {u"svremove",    Chain(u"-P svremove 2")},
+            {u"pattern",     Chain(u"-P pattern FF --pid " + es)},
+            {u"analyze",     Chain(u"-P analyze --output-file " + null_device)},
+            {u"scrambler",   Chain(u"-P scrambler 1 --cw " + cw)},
+            {u"scrambler+descrambler", Chain(u"-P scrambler 1 --cw " + cw + u" -P descrambler 1 --cw " + cw)},
+            {u"filter+remap+count",    Chain(u"-P filter --negate --pid " + es2 + u" -P remap " + es + u"=8000 -P count --output-file " + null_device)},
+            {u"pat+pmt+sdt",           Chain(u"-P pat --remove-service 2 -P pmt --service 1 --remove-pid " + es2 + u" -P sdt --remove-service 2")},
+        });
+    }
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::ArgsWithPlugins(0, 0, 0, UNLIMITED_COUNT, 0, 0, u"Throughput benchmark for tsp plugins", u"[options] [-P processor-name [processor-options] ...]"),
+    duck(this),
+    log_args(),
+    tsp_args(),
+    json(),
+    list(false),
+    packets(0),
+    services(0),
+    streams(0),
+    benchmarks()
+{
+    duck.defineArgsForCAS(*this);
+    duck.defineArgsForCharset(*this);
+    duck.defineArgsForHFBand(*this);
+    duck.defineArgsForPDS(*this);
+    duck.defineArgsForTimeReference(*this);
+    duck.defineArgsForStandards(*this);
+    log_args.defineArgs(*this);
+    tsp_args.defineArgs(*this);
+    json.defineArgs(*this, true, u"Report the benchmark results in JSON format.");
+
+    setIntro(u"A synthetic transport stream is generated in memory and processed through "
+             u"chains of packet processor plugins. When packet processor plugins are specified "
+             u"on the command line, only this chain is benchmarked. Otherwise, the built-in "
+             u"benchmarks are run. All tsp options are accepted and apply to each benchmark.");
+
+    option(u"benchmark", 0, STRING, 0, UNLIMITED_COUNT);
+    help(u"benchmark", u"name",
+         u"Run only the specified built-in benchmark. Several --benchmark options can be specified. "
+         u"By default, all built-in benchmarks are run.");
+
+    option(u"list-benchmarks");
+    help(u"list-benchmarks", u"List the built-in benchmarks and exit.");
+
+    option(u"packets", 'n', POSITIVE);
+    help(u"packets", u"Number of TS packets to process in each benchmark. The default is " + ts::UString::Decimal(DEFAULT_PACKETS) + u".");
+
+    option(u"services", 0, INTEGER, 0, 1, 1, MAX_SERVICES);
+    help(u"services", u"Number of services in the synthetic transport stream. The default is " + ts::UString::Decimal(DEFAULT_SERVICES) + u".");
+
+    option(u"streams", 0, INTEGER, 0, 1, 1, MAX_STREAMS);
+    help(u"streams", u"Number of elementary streams per service in the synthetic transport stream. The default is " + ts::UString::Decimal(DEFAULT_STREAMS) + u".");
+
+    // Analyze the command.
+    analyze(argc, argv);
+
+    // Load option values.
+    duck.loadArgs(*this);
+    log_args.loadArgs(duck, *this);
+    tsp_args.loadArgs(duck, *this);
+    json.loadArgs(duck, *this);
+    list = present(u"list-benchmarks");
+    getIntValue(packets, u"packets", DEFAULT_PACKETS);
+    getIntValue(services, u"services", DEFAULT_SERVICES);
+    getIntValue(streams, u"streams", DEFAULT_STREAMS);
+
+    // Input and output are always memory plugins. The synthetic stream has a fixed bitrate.
+    tsp_args.input.set(u"memory");
+    tsp_args.output.set(u"memory");
+    if (tsp_args.fixed_bitrate == 0) {
+        tsp_args.fixed_bitrate = DEFAULT_BITRATE;
+    }
+
+    // Select the benchmarks.
+    if (!tsp_args.plugins.empty()) {
+        ts::UString name;
+        for (const auto& pl : tsp_args.plugins) {
+            name.append(name.empty() ? u"" : u" ");
+            name.append(pl.toString(ts::PluginType::PROCESSOR));
+        }
+        benchmarks.push_back({name, tsp_args.plugins});
+        if (present(u"benchmark")) {
+            error(u"--benchmark cannot be used with explicit plugins");
+        }
+    }
+    else if (!present(u"benchmark") || list) {
+        benchmarks = BuiltinBenchmarks();
+    }
+    else {
+        const BenchmarkVector all(BuiltinBenchmarks());
+        ts::UStringVector names;
+        getValues(names, u"benchmark");
+        for (const auto& name : names) {
+            const auto it = std::find_if(all.begin(), all.end(), [&name](const Benchmark& b) { return b.name.similar(name); });
+            if (it == all.end()) {
+                error(u"unknown benchmark \"%s\", use --list-benchmarks", {name});
+            }
+            else {
+                benchmarks.push_back(*it);
+            }
+        }
+    }
+
+    // Final checking
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// Synthetic transport stream input (memory input plugin event handler).
+//----------------------------------------------------------------------------
+
+namespace {
+    class SyntheticInput: public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(SyntheticInput);
+    public:
+        // Constructor: build the synthetic transport stream pattern.
+        SyntheticInput(Options& opt);
+
+        // Restart the input for a new benchmark.
+        void reset();
+
+        // Characteristics of the last run.
+        const ts::Monotonic& startTime() const { return _start_time; }
+        uint64_t startAllocations() const { return _start_alloc; }
+        ts::PacketCounter packetCount() const { return _count; }
+
+        // Implementation of PluginEventHandlerInterface.
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+    private:
+        Options&                   _opt;
+        ts::TSPacketVector         _pattern {};      // Repeated pattern of packets.
+        size_t                     _next {0};        // Next packet in pattern.
+        ts::PacketCounter          _count {0};       // Number of generated packets.
+        uint64_t                   _bitrate {0};     // Constant bitrate of the generated stream.
+        std::array<uint8_t, ts::PID_MAX> _cc {};     // Next continuity counter per PID.
+        ts::Monotonic              _start_time {};   // Time of first input packet.
+        uint64_t                   _start_alloc {0}; // Number of allocations at first input packet.
+
+        // Add the packets of a table in the pattern.
+        void addTable(const ts::AbstractTable& table, ts::PID pid);
+    };
+}
+
+// Constructor: build the synthetic transport stream pattern.
+SyntheticInput::SyntheticInput(Options& opt) :
+    _opt(opt)
+{
+    _bitrate = _opt.tsp_args.fixed_bitrate.toInt();
+
+    // PSI/SI: one PAT, one PMT per service, one SDT.
+    ts::PAT pat(0, true, 1);
+    ts::SDT sdt(true, 0, true, 1, 1);
+    for (size_t srv = 0; srv < _opt.services; ++srv) {
+        const uint16_t service_id = uint16_t(srv + 1);
+        const ts::PID pmt_pid = ts::PID(FIRST_PMT_PID + srv);
+        const ts::PID pcr_pid = ts::PID(FIRST_ES_PID + MAX_STREAMS * srv);
+        pat.pmts[service_id] = pmt_pid;
+        sdt.services[service_id].setName(_opt.duck, ts::UString::Format(u"Service %d", {service_id}));
+        ts::PMT pmt(0, true, service_id, pcr_pid);
+        for (size_t es = 0; es < _opt.streams; ++es) {
+            pmt.streams[ts::PID(pcr_pid + es)].stream_type = es == 0 ? ts::ST_MPEG2_VIDEO : ts::ST_MPEG1_AUDIO;
+        }
+        addTable(pmt, pmt_pid);
+    }
+    addTable(pat, ts::PID_PAT);
+    addTable(sdt, ts::PID_SDT);
+
+    // Elementary streams: on each round, 3 video packets (first one with a PCR) and one packet per audio.
+    static constexpr size_t ROUNDS = 50;
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        for (size_t srv = 0; srv < _opt.services; ++srv) {
+            const ts::PID pcr_pid = ts::PID(FIRST_ES_PID + MAX_STREAMS * srv);
+            for (size_t es = 0; es < _opt.streams; ++es) {
+                for (size_t i = 0; i < (es == 0 ? 3 : 1); ++i) {
+                    ts::TSPacket pkt;
+                    pkt.init(ts::PID(pcr_pid + es), 0, uint8_t(round + srv + es + i));
+                    pkt.setPUSI(i == 0 && round % 10 == 0);
+                    if (es == 0 && i == 0) {
+                        pkt.setPCR(0, true);
+                    }
+                    _pattern.push_back(pkt);
+                }
+            }
+        }
+    }
+}
+
+// Add the packets of a table in the pattern.
+void SyntheticInput::addTable(const ts::AbstractTable& table, ts::PID pid)
+{
+    ts::BinaryTable bin;
+    table.serialize(_opt.duck, bin);
+    ts::OneShotPacketizer pzer(_opt.duck, pid);
+    pzer.addTable(bin);
+    ts::TSPacketVector packets;
+    pzer.getPackets(packets);
+    _pattern.insert(_pattern.end(), packets.begin(), packets.end());
+}
+
+// Restart the input for a new benchmark.
+void SyntheticInput::reset()
+{
+    _next = 0;
+    _count = 0;
+    _cc.fill(0);
+    _start_alloc = 0;
+}
+
+// Implementation of PluginEventHandlerInterface.
+void SyntheticInput::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+    if (data == nullptr || data->outputData() == nullptr) {
+        return;
+    }
+    if (_count == 0) {
+        _start_time.getSystemTime();
+        _start_alloc = allocation_count.load(std::memory_order_relaxed);
+    }
+
+    ts::TSPacket* const buffer = reinterpret_cast<ts::TSPacket*>(data->outputData());
+    const size_t count = size_t(std::min<ts::PacketCounter>(data->maxSize() / ts::PKT_SIZE, _opt.packets - _count));
+
+    for (size_t i = 0; i < count; ++i) {
+        ts::TSPacket& pkt(buffer[i]);
+        pkt = _pattern[_next];
+        _next = (_next + 1) % _pattern.size();
+
+        // Generate continuous CC and PCR, consistent with the bitrate.
+        const ts::PID pid = pkt.getPID();
+        if (pkt.hasPayload()) {
+            pkt.setCC(_cc[pid]);
+            _cc[pid] = (_cc[pid] + 1) & ts::CC_MASK;
+        }
+        if (pkt.hasPCR()) {
+            const uint64_t bits = (_count + i) * ts::PKT_SIZE_BITS;
+            pkt.setPCR(((bits / _bitrate) * ts::SYSTEM_CLOCK_FREQ + ((bits % _bitrate) * ts::SYSTEM_CLOCK_FREQ) / _bitrate) % ts::PCR_SCALE);
+        }
+    }
+
+    _count += count;
+    data->updateSize(count * ts::PKT_SIZE);
+}
+
+
+//----------------------------------------------------------------------------
+// Output (memory output plugin event handler).
+//----------------------------------------------------------------------------
+
+namespace {
+    class BenchmarkOutput: public ts::PluginEventHandlerInterface
+    {
+        TS_NOCOPY(BenchmarkOutput);
+    public:
+        // Constructor.
+        BenchmarkOutput() = default;
+
+        // Restart the output for a new benchmark.
+        void reset() { _count = 0; _end_time = ts::Monotonic(); _end_alloc = 0; }
+
+        // Characteristics of the last run.
+        ts::PacketCounter packetCount() const { return _count; }
+        const ts::Monotonic& endTime() const { return _end_time; }
+        uint64_t endAllocations() const { return _end_alloc; }
+
+        // Implementation of PluginEventHandlerInterface.
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+
+    private:
+        ts::PacketCounter _count {0};     // Number of output packets.
+        ts::Monotonic     _end_time {};   // Time of last output packet.
+        uint64_t          _end_alloc {0}; // Number of allocations at last output packet.
+    };
+}
+
+// Implementation of PluginEventHandlerInterface.
+void BenchmarkOutput::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+    if (data != nullptr) {
+        _count += data->size() / ts::PKT_SIZE;
+        _end_time.getSystemTime();
+        _end_alloc = allocation_count.load(std::memory_order_relaxed);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Hardware cache misses counter for the process and all its new threads.
+//----------------------------------------------------------------------------
+
+namespace {
+    class CacheMissCounter
+    {
+        TS_NOCOPY(CacheMissCounter);
+    public:
+        // Constructor, destructor.
+        CacheMissCounter() = default;
+        ~CacheMissCounter() { close(); }
+
+        // Start counting, return false if not supported.
+        bool start();
+
+        // Stop counting and get the counter, return false if not supported.
+        bool stop(uint64_t& count);
+
+    private:
+        int _fd {-1};
+        void close();
+    };
+}
+
+bool CacheMissCounter::start()
+{
+    close();
+#if defined(TS_LINUX)
+    // Count in all threads which will be created by the TSProcessor (inherit).
+    ::perf_event_attr attr;
+    TS_ZERO(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    _fd = int(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    if (_fd >= 0 && (::ioctl(_fd, PERF_EVENT_IOC_RESET, 0) < 0 || ::ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0) < 0)) {
+        close();
+    }
+#endif
+    return _fd >= 0;
+}
+
+bool CacheMissCounter::stop(uint64_t& count)
+{
+    bool ok = false;
+#if defined(TS_LINUX)
+    // The counters of the terminated threads are accumulated in the parent counter.
+    ok = _fd >= 0 && ::ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0) >= 0 && ::read(_fd, &count, sizeof(count)) == ssize_t(sizeof(count));
+#endif
+    close();
+    return ok;
+}
+
+void CacheMissCounter::close()
+{
+#if defined(TS_UNIX)
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+    _fd = -1;
+}
+
+
+//----------------------------------------------------------------------------
+// Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    // If plugins were statically linked, disallow the dynamic loading of plugins.
+#if defined(TSDUCK_STATIC_PLUGINS)
+    ts::PluginRepository::Instance()->setSharedLibraryAllowed(false);
+#endif
+
+    // Get command line options.
+    Options opt(argc, argv);
+    CERR.setMaxSeverity(opt.maxSeverity());
+
+    if (opt.list) {
+        for (const auto& bench : opt.benchmarks) {
+            std::cout << bench.name.toJustifiedLeft(24) << " ";
+            for (const auto& pl : bench.plugins) {
+                std::cout << " " << pl.toString(ts::PluginType::PROCESSOR);
+            }
+            std::cout << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Prevent from being killed when writing on broken pipes.
+    ts::IgnorePipeSignal();
+
+    // Create an asynchronous error logger. Can be used in multi-threaded context.
+    ts::AsyncReport report(opt.maxSeverity(), opt.log_args);
+
+    SyntheticInput input(opt);
+    BenchmarkOutput output;
+    CacheMissCounter cache_misses;
+
+    ts::json::Object root;
+    root.add(u"version", ts::VersionInfo::GetVersion());
+    root.add(u"packets", int64_t(opt.packets));
+    root.add(u"services", int64_t(opt.services));
+    root.add(u"streams", int64_t(opt.streams));
+    root.add(u"bitrate", opt.tsp_args.fixed_bitrate.toInt());
+
+    bool success = true;
+    for (const auto& bench : opt.benchmarks) {
+
+        input.reset();
+        output.reset();
+
+        ts::TSProcessorArgs args(opt.tsp_args);
+        args.plugins = bench.plugins;
+
+        ts::TSProcessor tsproc(report);
+        tsproc.registerEventHandler(&input, ts::PluginType::INPUT);
+        tsproc.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+        ts::ProcessMetrics start_metrics;
+        ts::GetProcessMetrics(start_metrics);
+        const bool use_cache = cache_misses.start();
+
+        // Run the benchmark.
+        if (!tsproc.start(args)) {
+            report.error(u"benchmark %s: error starting plugins", {bench.name});
+            success = false;
+            continue;
+        }
+        tsproc.waitForTermination();
+
+        // When the chain drops all packets, there is no last output packet, use the end of processing.
+        const bool has_output = output.packetCount() > 0;
+        const ts::Monotonic end_time(has_output ? output.endTime() : ts::Monotonic(true));
+        const uint64_t end_alloc = has_output ? output.endAllocations() : allocation_count.load(std::memory_order_relaxed);
+
+        uint64_t cache_count = 0;
+        const bool cache_ok = use_cache && cache_misses.stop(cache_count);
+        ts::ProcessMetrics end_metrics;
+        ts::GetProcessMetrics(end_metrics);
+
+        // Compute metrics. Dropped packets are not output, use the number of input packets.
+        const ts::PacketCounter packets = std::max<ts::PacketCounter>(1, input.packetCount());
+        const ts::NanoSecond duration = std::max<ts::NanoSecond>(1, end_time - input.startTime());
+        const ts::NanoSecond cpu = (end_metrics.cpu_time - start_metrics.cpu_time) * ts::NanoSecPerMilliSec;
+        const uint64_t allocs = end_alloc - input.startAllocations();
+
+        const int64_t pkt_per_sec = int64_t((packets * ts::NanoSecPerSec) / duration);
+        const int64_t ns_per_pkt = duration / ts::NanoSecond(packets);
+        const int64_t cpu_ns_per_pkt = cpu / ts::NanoSecond(packets);
+        const int64_t allocs_per_kpkt = int64_t((allocs * 1000) / packets);
+        const int64_t cache_per_kpkt = int64_t((cache_count * 1000) / packets);
+
+        if (opt.json.useJSON()) {
+            ts::json::Value& jv(root.query(u"benchmarks[]", true));
+            jv.add(u"name", bench.name);
+            jv.add(u"input-packets", int64_t(input.packetCount()));
+            jv.add(u"output-packets", int64_t(output.packetCount()));
+            jv.add(u"duration-ns", duration);
+            jv.add(u"packets-per-second", pkt_per_sec);
+            jv.add(u"ns-per-packet", ns_per_pkt);
+            jv.add(u"cpu-ns-per-packet", cpu_ns_per_pkt);
+            jv.add(u"allocations", int64_t(allocs));
+            jv.add(u"allocations-per-1000-packets", allocs_per_kpkt);
+            if (cache_ok) {
+                jv.add(u"cache-misses", int64_t(cache_count));
+                jv.add(u"cache-misses-per-1000-packets", cache_per_kpkt);
+            }
+        }
+        if (!opt.json.useFile()) {
+            std::cout << ts::UString::Format(u"%-24s %12'd pkt/s, %6'd ns/pkt, %6'd cpu ns/pkt, %8'd alloc/1000 pkt", {bench.name, pkt_per_sec, ns_per_pkt, cpu_ns_per_pkt, allocs_per_kpkt});
+            if (cache_ok) {
+                std::cout << ts::UString::Format(u", %'d cache misses/1000 pkt", {cache_per_kpkt});
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    if (opt.json.useJSON()) {
+        opt.json.report(root, std::cout, report);
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
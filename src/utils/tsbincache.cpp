@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+// Generate the precompiled binary cache of configuration files
+// (build utility, not part of TSDuck).
+//
+// For each ".names" file or XML file, a file with the same name and a
+// ".bin" suffix is created. See ts::ConfigurationCache.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsArgs.h"
+#include "tsNamesFile.h"
+#include "tsxmlDocument.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector files;  // Configuration files.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::Args(u"Generate the binary cache of TSDuck configuration files", u"[options] file ..."),
+    files()
+{
+    option(u"", 0, FILENAME, 1, UNLIMITED_COUNT);
+    help(u"",
+         u"Configuration files to precompile, either \".names\" files or XML files. "
+         u"For each file, the binary cache is created in the same directory, "
+         u"with the same name and an additional \".bin\" suffix.");
+
+    analyze(argc, argv);
+    getValues(files, u"");
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    bool ok = true;
+
+    for (const auto& file : opt.files) {
+        if (file.endWith(u".names", ts::CASE_INSENSITIVE)) {
+            // Load the names file without extensions, the cache is always created.
+            ts::NamesFile names(file, false);
+            ok = names.saveCache(opt) && ok;
+        }
+        else if (file.endWith(u".xml", ts::CASE_INSENSITIVE)) {
+            // Parse the XML text, without searching the cache.
+            ts::xml::Document doc(opt);
+            ok = doc.load(file, false) && doc.saveCache(file) && ok;
+        }
+        else {
+            opt.error(u"unknown type of configuration file: %s", {file});
+            ok = false;
+        }
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+// Generate the index file of tsp plugins in a directory
+// (build utility, not part of TSDuck).
+//
+// See ts::PluginRepository::createIndex().
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsArgs.h"
+#include "tsPluginRepository.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UString directory;  // Directory of plugins.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::Args(u"Generate the index file of tsp plugins in a directory", u"[options] directory"),
+    directory()
+{
+    option(u"", 0, DIRECTORY, 1, 1);
+    help(u"",
+         u"Directory containing the shared libraries of tsp plugins. "
+         u"The index file is created in the same directory.");
+
+    analyze(argc, argv);
+    getValue(directory, u"");
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    return ts::PluginRepository::Instance()->createIndex(opt.directory, opt) ? EXIT_SUCCESS : EXIT_FAILURE;
+}